@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "Car.h"
+#include "DispatchPlanner.h"
+#include "RoadGraph.h"
+
+namespace
+{
+    // Two-way street grid (side x side junctions, ~1.2 km blocks)
+    RoadGraph makeTown(int side)
+    {
+        std::mt19937 random(5);
+        std::uniform_int_distribution<std::uint32_t> metres(1200, 1900);
+
+        std::vector<GeoPoint> nodes;
+        std::vector<RoadEdge> edges;
+        for (int row = 0; row < side; ++row)
+        {
+            for (int col = 0; col < side; ++col)
+            {
+                nodes.push_back(GeoPoint{48.0 + row * 0.01, 11.0 + col * 0.015});
+            }
+        }
+        auto street = [&](NodeId a, NodeId b)
+        {
+            const std::uint32_t length = metres(random);
+            edges.push_back(RoadEdge{a, b, length});
+            edges.push_back(RoadEdge{b, a, length});
+        };
+        for (int row = 0; row < side; ++row)
+        {
+            for (int col = 0; col < side; ++col)
+            {
+                const NodeId node = static_cast<NodeId>(row * side + col);
+                if (col + 1 < side)
+                {
+                    street(node, node + 1);
+                }
+                if (row + 1 < side)
+                {
+                    street(node, node + static_cast<NodeId>(side));
+                }
+            }
+        }
+        return RoadGraph::build(NetworkKind::Road, nodes, edges);
+    }
+
+    const RoadGraph &town()
+    {
+        static const RoadGraph graph = makeTown(50); // 2500 junctions
+        return graph;
+    }
+
+    std::vector<DeliveryOrder> orders(std::size_t count, std::uint32_t firstId, unsigned seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<NodeId> node(0, static_cast<NodeId>(town().nodeCount() - 1));
+        std::uniform_int_distribution<int> weight(10, 50);
+        std::vector<DeliveryOrder> out;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out.push_back(DeliveryOrder{firstId + static_cast<std::uint32_t>(i), NetworkKind::Road, node(random), weight(random)});
+        }
+        return out;
+    }
+
+    // 20 cars from four depots near the corners
+    std::vector<DispatchVehicle> fleet(std::vector<Car> &cars)
+    {
+        const NodeId depots[] = {255, 294, 2205, 2244};
+        std::vector<DispatchVehicle> vehicles;
+        for (std::size_t i = 0; i < cars.size(); ++i)
+        {
+            vehicles.push_back(DispatchVehicle{&cars[i], NetworkKind::Road, depots[i % 4]});
+        }
+        return vehicles;
+    }
+}
+
+// 200 orders for 20 cars, routes included; state.range(0) threads (0 = every core)
+static void BM_PlanFromScratch(benchmark::State &state)
+{
+    const std::vector<DeliveryOrder> batch = orders(200, 0, 1);
+    std::vector<Car> cars(20);
+    DispatchOptions options;
+    options.threads = static_cast<unsigned>(state.range(0));
+    std::uint64_t metres = 0;
+    for (auto _ : state)
+    {
+        DispatchPlanner planner(&town(), nullptr, fleet(cars), options);
+        metres = planner.plan(batch).totalMetres;
+    }
+
+    state.counters["km"] = static_cast<double>(metres) / 1000.0;
+}
+
+// 10 orders arriving on top of a planned batch of 200
+static void BM_AddOrders(benchmark::State &state)
+{
+    const std::vector<DeliveryOrder> batch = orders(200, 0, 1);
+    const std::vector<DeliveryOrder> late = orders(10, 1000, 2);
+    std::vector<Car> cars(20);
+    std::uint64_t metres = 0;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        DispatchPlanner planner(&town(), nullptr, fleet(cars));
+        planner.plan(batch);
+        state.ResumeTiming();
+
+        metres = planner.addOrders(late).totalMetres;
+    }
+
+    state.counters["km"] = static_cast<double>(metres) / 1000.0;
+}
+
+BENCHMARK(BM_PlanFromScratch)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_AddOrders)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
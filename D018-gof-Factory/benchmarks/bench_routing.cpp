@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+#include <random>
+#include <vector>
+#include "RoadGraph.h"
+#include "RouteQuery.h"
+
+namespace
+{
+    // City-sized road grid (side x side junctions, ~1.1 km blocks), some streets one-way
+    RoadGraph makeCity(int side)
+    {
+        std::mt19937 random(11);
+        std::uniform_real_distribution<double> detour(1.0, 1.6);
+        std::uniform_int_distribution<int> layout(0, 9);
+
+        std::vector<GeoPoint> nodes;
+        std::vector<RoadEdge> edges;
+        for (int row = 0; row < side; ++row)
+        {
+            for (int col = 0; col < side; ++col)
+            {
+                nodes.push_back(GeoPoint{48.0 + row * 0.01, 11.0 + col * 0.015});
+            }
+        }
+        auto street = [&](NodeId a, NodeId b)
+        {
+            const std::uint32_t metres = static_cast<std::uint32_t>(1200.0 * detour(random));
+            edges.push_back(RoadEdge{a, b, metres});
+            if (layout(random) > 0)
+            {
+                edges.push_back(RoadEdge{b, a, metres});
+            }
+        };
+        for (int row = 0; row < side; ++row)
+        {
+            for (int col = 0; col < side; ++col)
+            {
+                const NodeId node = static_cast<NodeId>(row * side + col);
+                if (col + 1 < side)
+                {
+                    street(node, node + 1);
+                }
+                if (row + 1 < side)
+                {
+                    street(node, node + static_cast<NodeId>(side));
+                }
+            }
+        }
+        return RoadGraph::build(NetworkKind::Road, nodes, edges, true);
+    }
+
+    const RoadGraph &city()
+    {
+        static const RoadGraph graph = makeCity(150); // 22500 junctions
+        return graph;
+    }
+
+    std::vector<RouteRequest> requests(std::size_t count)
+    {
+        std::mt19937 random(3);
+        std::uniform_int_distribution<NodeId> node(0, static_cast<NodeId>(city().nodeCount() - 1));
+        std::vector<RouteRequest> out(count);
+        for (RouteRequest &request : out)
+        {
+            request = RouteRequest{node(random), node(random)};
+        }
+        return out;
+    }
+}
+
+// Contraction hierarchy preprocessing of the whole city
+static void BM_ContractCity(benchmark::State &state)
+{
+    const int side = static_cast<int>(state.range(0));
+    for (auto _ : state)
+    {
+        RoadGraph graph = makeCity(side);
+        benchmark::DoNotOptimize(graph.nodeCount());
+    }
+}
+
+// One query at a time on one core
+static void BM_AStar(benchmark::State &state)
+{
+    RouteQuery query(city());
+    const std::vector<RouteRequest> batch = requests(1024);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        const RouteRequest &request = batch[i++ % batch.size()];
+        benchmark::DoNotOptimize(query.aStar(request.from, request.to));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_Hierarchy(benchmark::State &state)
+{
+    RouteQuery query(city());
+    const std::vector<RouteRequest> batch = requests(1024);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        const RouteRequest &request = batch[i++ % batch.size()];
+        benchmark::DoNotOptimize(query.hierarchy(request.from, request.to));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Batch of 10000 queries spread over state.range(0) threads
+static void BM_BatchDistances(benchmark::State &state)
+{
+    const std::vector<RouteRequest> batch = requests(10000);
+    std::vector<std::uint32_t> metres;
+    for (auto _ : state)
+    {
+        routeDistances(city(), batch, metres, static_cast<unsigned>(state.range(0)));
+        benchmark::DoNotOptimize(metres.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch.size()));
+}
+
+BENCHMARK(BM_ContractCity)->Arg(100)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_AStar)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Hierarchy)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BatchDistances)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+#include "Car.h"
+#include "Fleet.h"
+#include "Ship.h"
+#include "TransportFactory.h"
+
+// Baseline: one heap allocation per vehicle, like Creator::SomeOperation()
+static void BM_NewDelete(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        std::unique_ptr<Transport> car(new Car());
+        std::unique_ptr<Transport> ship(new Ship());
+        car->performDelivery(100);
+        ship->performDelivery(100);
+        benchmark::DoNotOptimize(car.get());
+        benchmark::DoNotOptimize(ship.get());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// Pooled: slots come from preallocated slabs
+static void BM_PooledFactory(benchmark::State &state)
+{
+    TransportFactory factory;
+    for (auto _ : state)
+    {
+        TransportHandle car = factory.createCar();
+        TransportHandle ship = factory.createShip();
+        car->performDelivery(100);
+        ship->performDelivery(100);
+        benchmark::DoNotOptimize(car.get());
+        benchmark::DoNotOptimize(ship.get());
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// Current loop: virtual performDelivery/needsMaintenance per vehicle
+static void BM_VirtualFleet(benchmark::State &state)
+{
+    std::vector<std::unique_ptr<Transport>> vehicles;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        if (i % 2 == 0)
+        {
+            vehicles.emplace_back(new Car());
+        }
+        else
+        {
+            vehicles.emplace_back(new Ship());
+        }
+    }
+
+    for (auto _ : state)
+    {
+        std::size_t needing = 0;
+        for (const std::unique_ptr<Transport> &vehicle : vehicles)
+        {
+            vehicle->performDelivery(100);
+            needing += vehicle->needsMaintenance() ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(needing);
+
+        for (const std::unique_ptr<Transport> &vehicle : vehicles)
+        {
+            vehicle->performMaintenance();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Same work on the column store, no virtual dispatch
+static void BM_ColumnFleet(benchmark::State &state)
+{
+    Fleet fleet;
+    for (int64_t i = 0; i < state.range(0); ++i)
+    {
+        if (i % 2 == 0)
+        {
+            fleet.add<CarColumns>();
+        }
+        else
+        {
+            fleet.add<ShipColumns>();
+        }
+    }
+
+    for (auto _ : state)
+    {
+        fleet.performDelivery(100);
+        benchmark::DoNotOptimize(fleet.needingMaintenance().size());
+        fleet.performMaintenance();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_NewDelete);
+BENCHMARK(BM_PooledFactory);
+BENCHMARK(BM_VirtualFleet)->RangeMultiplier(10)->Range(1000, 100000);
+BENCHMARK(BM_ColumnFleet)->RangeMultiplier(10)->Range(1000, 100000);
+
+BENCHMARK_MAIN();
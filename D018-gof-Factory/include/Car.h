@@ -9,6 +9,10 @@ private:
     int maxLoadKg_;
 
 public:
+    static constexpr int DEFAULT_TRIP_KM = 40; // trip length when no route is given
+    static constexpr int MAX_LOAD_KG = 500;
+    static constexpr int MAINTENANCE_KM = 100;  // service needed once driven beyond this
+
     Car();
 
     std::string deliver() const override;
@@ -17,5 +21,6 @@ public:
     bool needsMaintenance() const override;
 
     void performDelivery(int loadweight) override;
+    void performDelivery(int loadweight, int distanceKm) override;
     void performMaintenance() override;
 };
\ No newline at end of file
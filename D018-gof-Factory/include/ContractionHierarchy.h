@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "RoadGraph.h"
+
+// An edge of the hierarchy: a real edge (middle == NO_NODE) or a shortcut over middle
+struct HierarchyEdge
+{
+    NodeId from;
+    NodeId to;
+    std::uint32_t metres;
+    NodeId middle;
+};
+
+struct Hierarchy
+{
+    std::vector<HierarchyEdge> upward;   // rank(from) < rank(to)
+    std::vector<HierarchyEdge> downward; // rank(from) > rank(to)
+    std::vector<NodeId> order;           // order[rank] = node, least important first
+};
+
+/**
+ * Contraction hierarchy preprocessing.
+ *
+ * Nodes are contracted one at a time, least important first (fewest
+ * shortcuts added minus edges removed, plus contracted neighbours so the
+ * order spreads evenly); a priority is refreshed when its node reaches the
+ * front of the queue. Contracting v adds a shortcut u -> w for every
+ * u -> v -> w that a local witness search cannot beat without v. The
+ * witness search gives up after witnessSettleLimit nodes, which can only
+ * add unneeded shortcuts, never lose a shortest path.
+ *
+ * A query then runs a Dijkstra upward from both ends (RouteQuery) and
+ * settles a few hundred nodes instead of a large part of the network.
+ */
+Hierarchy contractHierarchy(std::size_t nodeCount, const std::vector<RoadEdge> &edges,
+                            std::size_t witnessSettleLimit = 128);
@@ -0,0 +1,135 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "RoadGraph.h"
+#include "Transport.h"
+
+// Goods to bring from a vehicle's depot to destination
+struct DeliveryOrder
+{
+    std::uint32_t id;
+    NetworkKind network; // roads for cars, sea lanes for ships
+    NodeId destination;
+    int weightKg;
+};
+
+// A vehicle the planner may use; it starts and ends every tour at depot
+struct DispatchVehicle
+{
+    Transport *transport;
+    NetworkKind network;
+    NodeId depot;
+};
+
+// One vehicle's tour: depot -> orders in this order -> depot, carried in one load
+struct VehicleRoute
+{
+    std::vector<std::uint32_t> orders; // order ids
+    int loadKg = 0;
+    std::uint64_t metres = 0;
+};
+
+struct DispatchPlan
+{
+    std::vector<VehicleRoute> routes;      // one per vehicle, empty when it stays at the depot
+    std::vector<std::uint32_t> unassigned; // too heavy, unreachable, or no vehicle available
+    std::uint64_t totalMetres = 0;
+};
+
+struct DispatchOptions
+{
+    unsigned threads = 0;         // 0 = every core
+    std::size_t starts = 8;       // independent local searches, spread over the threads
+    std::size_t rounds = 20;      // ruin-and-recreate rounds per start in plan()
+    std::size_t replanRounds = 5; // rounds per start in addOrders()
+    std::uint32_t seed = 1;
+};
+
+/**
+ * Assigns delivery orders to cars and ships and orders each tour.
+ *
+ * A vehicle is used only while it does not need maintenance, carries the
+ * whole batch of its tour at once (at most maxLoadCapacity()), and only
+ * takes orders on its own network. Distances are shortest routes between
+ * every depot and destination, computed once with routeDistances() and
+ * kept in a matrix per network.
+ *
+ * plan() builds tours by cheapest insertion, then improves them with
+ * local search (moving an order to another place, swapping two orders)
+ * and ruin-and-recreate rounds. Each start searches on its own thread
+ * with its own seed and the best plan wins, so the result depends on the
+ * seed and the number of starts but not on the number of threads.
+ *
+ * addOrders() keeps the current plan: it routes only the new destinations,
+ * inserts the new orders, moves the orders of vehicles that now need
+ * maintenance, and runs a shorter search from there.
+ */
+class DispatchPlanner
+{
+public:
+    // A network may be nullptr when no vehicle and no order uses it
+    DispatchPlanner(const RoadGraph *roads, const RoadGraph *seaLanes, std::vector<DispatchVehicle> vehicles,
+                    DispatchOptions options = {});
+
+    const DispatchPlan &plan(const std::vector<DeliveryOrder> &orders); // replaces every order
+    const DispatchPlan &addOrders(const std::vector<DeliveryOrder> &orders);
+    const DispatchPlan &current() const { return plan_; }
+
+    // Drive every tour (performDelivery(load, km)) and start over with no orders
+    void dispatch();
+
+    std::size_t routeQueries() const { return routeQueries_; } // shortest routes computed so far
+
+private:
+    // Depots and destinations of one network, and the routes between all of them
+    struct Network
+    {
+        const RoadGraph *graph = nullptr;
+        std::vector<NodeId> nodes;                       // location -> graph node
+        std::unordered_map<NodeId, std::uint32_t> index; // graph node -> location
+        std::vector<std::uint32_t> metres;               // routed x routed, row = from
+        std::size_t routed = 0;                          // locations in the matrix
+
+        std::uint32_t locate(NodeId node);
+        std::uint32_t at(std::uint32_t from, std::uint32_t to) const { return metres[from * routed + to]; }
+    };
+
+    // Orders are referred to by their index in orders_
+    struct Solution
+    {
+        std::vector<std::vector<std::uint32_t>> routes; // per vehicle, in visiting order
+        std::vector<int> loadKg;                        // per vehicle
+        std::vector<std::uint64_t> metres;              // per vehicle
+        std::vector<std::uint32_t> vehicleOf;           // per order, NO_VEHICLE when unassigned
+        std::vector<std::uint32_t> unassigned;
+        std::uint64_t totalMetres = 0;
+
+        bool betterThan(const Solution &other) const;
+    };
+
+    class Search; // local search over a Solution, one per thread
+
+    std::uint32_t addOrder(const DeliveryOrder &order);
+    void route(Network &network);
+    void refreshVehicles(std::vector<std::uint32_t> &released);
+    void improve(std::size_t rounds);
+    void publish();
+    Network &networkOf(NetworkKind kind) { return kind == NetworkKind::Road ? roads_ : seaLanes_; }
+    const Network &networkOf(NetworkKind kind) const { return kind == NetworkKind::Road ? roads_ : seaLanes_; }
+
+    Network roads_;
+    Network seaLanes_;
+    std::vector<DispatchVehicle> vehicles_;
+    std::vector<std::uint32_t> depots_; // location of each vehicle's depot in its network
+    std::vector<char> available_;       // vehicle did not need maintenance at the last (re)plan
+    std::vector<int> capacityKg_;       // maxLoadCapacity() at the last (re)plan
+    DispatchOptions options_;
+
+    std::vector<DeliveryOrder> orders_;
+    std::vector<std::uint32_t> locations_; // location of each order's destination in its network
+    Solution solution_;
+    DispatchPlan plan_;
+    std::size_t routeQueries_ = 0;
+};
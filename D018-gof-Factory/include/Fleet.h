@@ -0,0 +1,140 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+#include "TransportFactory.h"
+
+// Identifies one vehicle of a fleet: its concrete kind and index within that kind
+struct VehicleRef
+{
+    TransportKind kind;
+    std::size_t index;
+
+    bool operator==(const VehicleRef &other) const { return kind == other.kind && index == other.index; }
+};
+
+/**
+ * Every Car of a fleet stored column by column (structure of arrays).
+ * Bulk operations follow exactly the rules of Car, without virtual calls,
+ * as branch-free loops over plain int arrays that the compiler vectorizes.
+ */
+class CarColumns
+{
+public:
+    static constexpr TransportKind KIND = TransportKind::Car;
+
+    std::size_t add();                       // New Car, returns its index
+    std::size_t size() const { return distanceDriven_.size(); }
+
+    void performDelivery(int loadweight);    // Car::performDelivery on every car
+    void performDelivery(int loadweight, int distanceKm);
+    void performMaintenance();               // Car::performMaintenance on every car
+    void collectNeedingMaintenance(std::vector<VehicleRef> &out) const;
+
+    int maxLoadCapacity(std::size_t index) const { return maxLoadKg_[index]; }
+    bool needsMaintenance(std::size_t index) const { return maintenanceNeeded_[index] != 0; }
+    int distanceDriven(std::size_t index) const { return distanceDriven_[index]; }
+
+private:
+    std::vector<std::int32_t> distanceDriven_;
+    std::vector<std::int32_t> maintenanceNeeded_;
+    std::vector<std::int32_t> maxLoadKg_;
+};
+
+/**
+ * Every Ship of a fleet stored column by column, same rules as Ship
+ */
+class ShipColumns
+{
+public:
+    static constexpr TransportKind KIND = TransportKind::Ship;
+
+    std::size_t add();                       // New Ship, returns its index
+    std::size_t size() const { return tripsDone_.size(); }
+
+    void performDelivery(int loadweight);    // Ship::performDelivery on every ship
+    void performDelivery(int loadweight, int distanceKm);
+    void performMaintenance();               // Ship::performMaintenance on every ship
+    void collectNeedingMaintenance(std::vector<VehicleRef> &out) const;
+
+    int maxLoadCapacity(std::size_t index) const { return cargoCapacityKg_[index]; }
+    bool needsMaintenance(std::size_t index) const { return maintenanceNeeded_[index] != 0; }
+    int tripsDone(std::size_t index) const { return tripsDone_[index]; }
+
+private:
+    std::vector<std::int32_t> tripsDone_;
+    std::vector<std::int32_t> maintenanceNeeded_;
+    std::vector<std::int32_t> cargoCapacityKg_;
+};
+
+/**
+ * Fleet grouped by concrete type, one homogeneous column store per type.
+ *
+ * Bulk operations are expanded at compile time over the column types, so
+ * there is no per-vehicle virtual dispatch. A future transport type only
+ * needs its own Columns class added to the Fleet alias below.
+ */
+template <typename... Columns>
+class BasicFleet
+{
+public:
+    // Add a vehicle of the given column type
+    template <typename Kind>
+    VehicleRef add()
+    {
+        return VehicleRef{Kind::KIND, std::get<Kind>(columns_).add()};
+    }
+
+    template <typename Kind>
+    Kind &of() { return std::get<Kind>(columns_); }
+
+    template <typename Kind>
+    const Kind &of() const { return std::get<Kind>(columns_); }
+
+    // Deliver loadweight with every vehicle
+    void performDelivery(int loadweight)
+    {
+        std::apply([loadweight](Columns &...columns)
+                   { (columns.performDelivery(loadweight), ...); },
+                   columns_);
+    }
+
+    // Deliver loadweight with every vehicle over a route of distanceKm
+    void performDelivery(int loadweight, int distanceKm)
+    {
+        std::apply([loadweight, distanceKm](Columns &...columns)
+                   { (columns.performDelivery(loadweight, distanceKm), ...); },
+                   columns_);
+    }
+
+    // Service every vehicle
+    void performMaintenance()
+    {
+        std::apply([](Columns &...columns)
+                   { (columns.performMaintenance(), ...); },
+                   columns_);
+    }
+
+    // Vehicles needing maintenance, grouped by type
+    std::vector<VehicleRef> needingMaintenance() const
+    {
+        std::vector<VehicleRef> out;
+        std::apply([&out](const Columns &...columns)
+                   { (columns.collectNeedingMaintenance(out), ...); },
+                   columns_);
+        return out;
+    }
+
+    std::size_t size() const
+    {
+        return std::apply([](const Columns &...columns)
+                          { return (columns.size() + ...); },
+                          columns_);
+    }
+
+private:
+    std::tuple<Columns...> columns_;
+};
+
+using Fleet = BasicFleet<CarColumns, ShipColumns>;
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * Fixed-type object pool backed by preallocated slabs.
+ *
+ * Every slot is cache-line aligned and sized, so two pooled objects never
+ * share a cache line. Freed slots go onto an intrusive free list and are
+ * reused before a new slab is allocated; slabs are only released when the
+ * pool is destroyed. Not thread safe: use one pool per thread.
+ */
+template <typename T>
+class ObjectPool
+{
+public:
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    explicit ObjectPool(std::size_t slabSize = 1024) : slabSize_(slabSize == 0 ? 1 : slabSize)
+    {
+        addSlab();
+    }
+
+    ~ObjectPool() = default; // All objects must have been released by now
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    // Construct a T in a free slot
+    template <typename... Args>
+    T *acquire(Args &&...args)
+    {
+        if (free_ == nullptr)
+        {
+            addSlab();
+        }
+
+        Slot *slot = free_;
+        free_ = slot->next;
+        T *object = new (slot->storage) T(std::forward<Args>(args)...);
+        ++live_;
+        return object;
+    }
+
+    // Destroy object and put its slot back on the free list
+    void release(T *object)
+    {
+        object->~T();
+        Slot *slot = reinterpret_cast<Slot *>(object);
+        slot->next = free_;
+        free_ = slot;
+        --live_;
+    }
+
+    std::size_t live() const { return live_; }
+    std::size_t capacity() const { return slabs_.size() * slabSize_; }
+
+private:
+    // Either a live T or a link in the free list
+    union alignas(CACHE_LINE > alignof(T) ? CACHE_LINE : alignof(T)) Slot
+    {
+        Slot *next;
+        unsigned char storage[sizeof(T)];
+    };
+
+    void addSlab()
+    {
+        slabs_.emplace_back(new Slot[slabSize_]);
+        Slot *slab = slabs_.back().get();
+
+        // Thread the new slots onto the free list in address order
+        for (std::size_t i = slabSize_; i-- > 0;)
+        {
+            slab[i].next = free_;
+            free_ = &slab[i];
+        }
+    }
+
+    std::size_t slabSize_;
+    std::vector<std::unique_ptr<Slot[]>> slabs_;
+    Slot *free_ = nullptr;
+    std::size_t live_ = 0;
+};
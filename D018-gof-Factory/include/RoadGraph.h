@@ -0,0 +1,111 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+using NodeId = std::uint32_t;
+
+constexpr NodeId NO_NODE = std::numeric_limits<NodeId>::max();
+constexpr std::uint32_t UNREACHABLE = std::numeric_limits<std::uint32_t>::max();
+constexpr double EARTH_RADIUS_M = 6371008.8; // mean radius
+
+// Which vehicles can travel a network: roads for cars, sea lanes for ships
+enum class NetworkKind : std::uint32_t
+{
+    Road,
+    SeaLane
+};
+
+struct GeoPoint
+{
+    double lat; // degrees
+    double lon; // degrees
+};
+
+// One-way connection; add both directions for a two-way road
+struct RoadEdge
+{
+    NodeId from;
+    NodeId to;
+    std::uint32_t metres;
+};
+
+/**
+ * Edges of a graph in compressed sparse row form: the edges leaving node n
+ * are [offsets[n], offsets[n + 1]) in targets/metres (and middles).
+ */
+struct CsrView
+{
+    const std::uint32_t *offsets; // nodeCount + 1 entries
+    const NodeId *targets;
+    const std::uint32_t *metres;
+    const NodeId *middles; // hierarchy only: node a shortcut skips, NO_NODE for a real edge
+
+    std::uint32_t begin(NodeId node) const { return offsets[node]; }
+    std::uint32_t end(NodeId node) const { return offsets[node + 1]; }
+};
+
+/**
+ * Road or sea-lane network, immutable once built.
+ *
+ * The whole graph lives in one flat image laid out exactly like its file:
+ * a header followed by 8-byte aligned arrays (coordinates, unit vectors for
+ * the A* bound, the edges in CSR form and, when contracted, the upward and
+ * downward edges of a contraction hierarchy). build() fills the image in
+ * memory, save() writes it as is, and open() maps a saved file read-only
+ * with mmap, so loading costs no parsing and the pages are shared by every
+ * process routing on the same network.
+ *
+ * Queries never modify the graph: any number of threads can route on one
+ * RoadGraph, each with its own RouteQuery.
+ */
+class RoadGraph
+{
+public:
+    // Edge lengths below the straight line between their ends are raised to it (keeps A* exact).
+    // Throws std::invalid_argument for edges naming unknown nodes.
+    static RoadGraph build(NetworkKind kind, const std::vector<GeoPoint> &nodes, const std::vector<RoadEdge> &edges,
+                           bool contract = true);
+
+    // Map a file written by save(); throws std::runtime_error if it is missing or malformed
+    static RoadGraph open(const std::string &path);
+
+    void save(const std::string &path) const; // throws std::system_error
+
+    RoadGraph(RoadGraph &&other) noexcept;
+    RoadGraph &operator=(RoadGraph &&other) noexcept;
+    RoadGraph(const RoadGraph &) = delete;
+    RoadGraph &operator=(const RoadGraph &) = delete;
+    ~RoadGraph();
+
+    NetworkKind kind() const;
+    std::size_t nodeCount() const;
+    std::size_t edgeCount() const;
+    GeoPoint position(NodeId node) const;
+    bool isMapped() const { return mapping_ != nullptr; }
+
+    CsrView edges() const; // the network as built
+    bool hasHierarchy() const;
+
+    // The hierarchy is numbered by rank, so the top of it, which every query
+    // climbs to, sits together in memory. Nodes and targets are ranks here.
+    CsrView upward() const;   // at r: edges r -> higher rank
+    CsrView downward() const; // at r: edges higher rank -> r, targets are the sources
+    NodeId rankOf(NodeId node) const;
+    NodeId nodeAt(NodeId rank) const;
+
+    // Chord through the earth between two nodes: never longer than any route between them
+    double straightLineMetres(NodeId a, NodeId b) const;
+
+    NodeId nearest(GeoPoint point) const; // closest node by straight line, linear scan
+
+private:
+    RoadGraph() = default;
+
+    const std::uint8_t *base_ = nullptr; // header, then the sections
+    std::vector<std::uint64_t> owned_;   // image built in memory
+    void *mapping_ = nullptr;            // or mapped from a file
+    std::size_t mappedBytes_ = 0;
+};
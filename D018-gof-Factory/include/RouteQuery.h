@@ -0,0 +1,91 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "RoadGraph.h"
+
+struct RouteRequest
+{
+    NodeId from;
+    NodeId to;
+};
+
+/**
+ * Shortest routes on a RoadGraph; one RouteQuery per thread.
+ *
+ * Holds the search state (distances, parents, heaps) sized for the graph
+ * once, and resets it between queries by bumping a generation stamp, so a
+ * query allocates nothing after the first few.
+ *
+ * Every query returns metres, or UNREACHABLE when there is no route. When
+ * path is given it receives the nodes of the route from `from` to `to`
+ * along real edges (shortcuts unpacked).
+ */
+class RouteQuery
+{
+public:
+    explicit RouteQuery(const RoadGraph &graph);
+
+    // Contraction hierarchy when the graph has one, else A*
+    std::uint32_t route(NodeId from, NodeId to, std::vector<NodeId> *path = nullptr);
+
+    // A* over the plain edges, straight-line distance as the bound
+    std::uint32_t aStar(NodeId from, NodeId to, std::vector<NodeId> *path = nullptr);
+
+    // Bidirectional upward search; throws std::logic_error if the graph was not contracted
+    std::uint32_t hierarchy(NodeId from, NodeId to, std::vector<NodeId> *path = nullptr);
+
+    std::size_t settled() const { return settled_; } // nodes settled by the last query
+
+private:
+    struct HeapEntry
+    {
+        std::uint64_t key; // distance, plus the A* bound
+        std::uint32_t metres;
+        NodeId node;
+
+        bool operator>(const HeapEntry &other) const { return key > other.key; }
+    };
+
+    // Tentative distance of a node; valid only if stamp is the current generation
+    struct Label
+    {
+        std::uint32_t stamp;
+        std::uint32_t metres;
+    };
+
+    // One search direction
+    struct Search
+    {
+        std::vector<Label> labels; // stamp next to distance: one cache miss per node looked at
+        std::vector<NodeId> parent;
+        std::vector<std::uint32_t> parentEdge; // index into the CSR the parent was relaxed from
+        std::vector<HeapEntry> heap;
+
+        bool reached(NodeId node, std::uint32_t generation) const { return labels[node].stamp == generation; }
+    };
+
+    // Hierarchy edge still to be unpacked into real edges
+    struct Pending
+    {
+        NodeId from;
+        NodeId to;
+        NodeId middle;
+    };
+
+    void begin();
+    void reach(Search &search, NodeId node, std::uint32_t metres, std::uint64_t key, NodeId parent, std::uint32_t edge);
+    static HeapEntry pop(Search &search);
+    void unpack(NodeId from, NodeId to, NodeId middle, std::vector<NodeId> &path);
+
+    const RoadGraph &graph_;
+    Search forward_;
+    Search backward_;
+    std::uint32_t generation_ = 0;
+    std::size_t settled_ = 0;
+    std::vector<Pending> pending_;
+};
+
+// Distances for many requests, spread over threads (0 = every core); metres is resized to match
+void routeDistances(const RoadGraph &graph, const std::vector<RouteRequest> &requests,
+                    std::vector<std::uint32_t> &metres, unsigned threads = 0);
@@ -9,6 +9,9 @@ private:
     int cargoCapacityKg_;
 
 public:
+    static constexpr int MAX_CARGO_KG = 20000000;
+    static constexpr int MAINTENANCE_TRIPS = 5; // service needed after more trips than this
+
     Ship();
 
     std::string deliver() const override;
@@ -17,5 +20,6 @@ public:
     bool needsMaintenance() const override;
 
     void performDelivery(int loadweight) override;
+    void performDelivery(int loadweight, int distanceKm) override;
     void performMaintenance() override;
 };
\ No newline at end of file
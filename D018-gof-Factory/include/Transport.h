@@ -25,6 +25,9 @@ public:
     // Simulates delivery
     virtual void performDelivery(int loadweight) = 0;
 
+    // Simulates delivery over a route of distanceKm, e.g. from RouteQuery
+    virtual void performDelivery(int loadweight, int distanceKm) = 0;
+
     // Perform maintenance
     virtual void performMaintenance() = 0;
 };
@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include "Car.h"
+#include "ObjectPool.h"
+#include "Ship.h"
+#include "Transport.h"
+
+class TransportFactory;
+
+enum class TransportKind
+{
+    Car,
+    Ship
+};
+
+// Returns a pooled Transport to the factory it came from
+struct TransportDeleter
+{
+    TransportFactory *factory;
+    TransportKind kind;
+
+    void operator()(Transport *transport) const;
+};
+
+// RAII handle: the vehicle goes back to its pool when the handle dies
+using TransportHandle = std::unique_ptr<Transport, TransportDeleter>;
+
+/**
+ * Pooled factory for Transport products.
+ *
+ * Cars and Ships are constructed in cache-line aligned slots of per-type
+ * ObjectPools instead of with new/delete. The factory must outlive every
+ * handle it hands out.
+ */
+class TransportFactory
+{
+public:
+    explicit TransportFactory(std::size_t slabSize = 1024);
+
+    TransportHandle create(TransportKind kind);
+    TransportHandle createCar();
+    TransportHandle createShip();
+
+    // Vehicles currently handed out
+    std::size_t live() const;
+
+private:
+    friend struct TransportDeleter;
+    void recycle(TransportKind kind, Transport *transport);
+
+    ObjectPool<Car> cars_;
+    ObjectPool<Ship> ships_;
+};
@@ -1,6 +1,6 @@
 #include "Car.h"
 
-Car::Car() : distanceDriven_(0), maintenanceNeeded_(false), maxLoadKg_(500) {}
+Car::Car() : distanceDriven_(0), maintenanceNeeded_(false), maxLoadKg_(MAX_LOAD_KG) {}
 
 std::string Car::deliver() const
 {
@@ -23,6 +23,11 @@ bool Car::needsMaintenance() const
 };
 
 void Car::performDelivery(int loadweight)
+{
+    performDelivery(loadweight, DEFAULT_TRIP_KM);
+};
+
+void Car::performDelivery(int loadweight, int distanceKm)
 {
     if (loadweight > maxLoadKg_)
     {
@@ -32,9 +37,9 @@ void Car::performDelivery(int loadweight)
         /* code */
     }
 
-    distanceDriven_ += 40;
+    distanceDriven_ += distanceKm;
 
-    if (distanceDriven_ > 100)
+    if (distanceDriven_ > MAINTENANCE_KM)
     {
         maintenanceNeeded_ = true;
     }
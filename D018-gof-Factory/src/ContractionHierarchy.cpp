@@ -0,0 +1,258 @@
+#include "ContractionHierarchy.h"
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace
+{
+    // Edge of the graph still being contracted, seen from one of its ends
+    struct Arc
+    {
+        NodeId node;
+        std::uint32_t metres;
+        NodeId middle;
+    };
+
+    class Contractor
+    {
+    public:
+        Contractor(std::size_t nodeCount, const std::vector<RoadEdge> &edges, std::size_t settleLimit)
+            : out_(nodeCount), in_(nodeCount), contracted_(nodeCount, 0), deletedNeighbours_(nodeCount, 0),
+              priority_(nodeCount, 0), settleLimit_(settleLimit), distance_(nodeCount, 0), stamp_(nodeCount, 0),
+              targetStamp_(nodeCount, 0)
+        {
+            for (const RoadEdge &edge : edges)
+            {
+                if (edge.from != edge.to)
+                {
+                    addArc(edge.from, edge.to, edge.metres, NO_NODE);
+                }
+            }
+        }
+
+        Hierarchy run()
+        {
+            Hierarchy hierarchy;
+            using Entry = std::pair<int, NodeId>;
+            std::vector<Entry> queue;
+            queue.reserve(out_.size());
+            for (NodeId node = 0; node < out_.size(); ++node)
+            {
+                priority_[node] = priority(node);
+                queue.emplace_back(priority_[node], node);
+            }
+            std::make_heap(queue.begin(), queue.end(), std::greater<Entry>());
+
+            while (!queue.empty())
+            {
+                std::pop_heap(queue.begin(), queue.end(), std::greater<Entry>());
+                const Entry top = queue.back();
+                queue.pop_back();
+                const NodeId node = top.second;
+                if (contracted_[node] != 0 || top.first != priority_[node])
+                {
+                    continue; // stale entry
+                }
+
+                // Lazy update: contracting neighbours changes a priority, so check it before
+                // contracting instead of recomputing every neighbour after each contraction
+                const int fresh = priority(node);
+                if (fresh > top.first && !queue.empty() && fresh > queue.front().first)
+                {
+                    priority_[node] = fresh;
+                    queue.emplace_back(fresh, node);
+                    std::push_heap(queue.begin(), queue.end(), std::greater<Entry>());
+                    continue;
+                }
+
+                contract(node, hierarchy);
+            }
+            return hierarchy;
+        }
+
+    private:
+        // Keep only the shortest arc per ordered pair, so a shortcut unpacks unambiguously
+        void addArc(NodeId from, NodeId to, std::uint32_t metres, NodeId middle)
+        {
+            for (Arc &arc : out_[from])
+            {
+                if (arc.node == to)
+                {
+                    if (metres < arc.metres)
+                    {
+                        arc = Arc{to, metres, middle};
+                        for (Arc &back : in_[to])
+                        {
+                            if (back.node == from)
+                            {
+                                back = Arc{from, metres, middle};
+                            }
+                        }
+                    }
+                    return;
+                }
+            }
+            out_[from].push_back(Arc{to, metres, middle});
+            in_[to].push_back(Arc{from, metres, middle});
+        }
+
+        // Shortcuts contracting node would need; adds them when apply is set
+        int shortcuts(NodeId node, bool apply)
+        {
+            int count = 0;
+            for (const Arc &in : in_[node])
+            {
+                std::uint64_t longest = 0;
+                for (const Arc &out : out_[node])
+                {
+                    if (out.node != in.node)
+                    {
+                        longest = std::max<std::uint64_t>(longest, std::uint64_t{in.metres} + out.metres);
+                    }
+                }
+                if (longest == 0)
+                {
+                    continue;
+                }
+
+                witnessSearch(in.node, node, longest, out_[node]);
+                for (const Arc &out : out_[node])
+                {
+                    const std::uint64_t via = std::uint64_t{in.metres} + out.metres;
+                    if (out.node == in.node || reached(out.node, via))
+                    {
+                        continue;
+                    }
+                    ++count;
+                    if (apply)
+                    {
+                        // Any route on earth is far below 2^32 m
+                        addArc(in.node, out.node, static_cast<std::uint32_t>(via), node);
+                    }
+                }
+            }
+            return count;
+        }
+
+        int priority(NodeId node)
+        {
+            const int removed = static_cast<int>(in_[node].size() + out_[node].size());
+            return shortcuts(node, false) - removed + deletedNeighbours_[node];
+        }
+
+        void contract(NodeId node, Hierarchy &hierarchy)
+        {
+            shortcuts(node, true);
+
+            // Every arc left leads to a node contracted later, i.e. ranked higher
+            for (const Arc &arc : out_[node])
+            {
+                hierarchy.upward.push_back(HierarchyEdge{node, arc.node, arc.metres, arc.middle});
+                detach(in_[arc.node], node);
+                ++deletedNeighbours_[arc.node];
+            }
+            for (const Arc &arc : in_[node])
+            {
+                hierarchy.downward.push_back(HierarchyEdge{arc.node, node, arc.metres, arc.middle});
+                detach(out_[arc.node], node);
+                ++deletedNeighbours_[arc.node];
+            }
+            std::vector<Arc>().swap(out_[node]);
+            std::vector<Arc>().swap(in_[node]);
+            contracted_[node] = 1;
+            hierarchy.order.push_back(node);
+        }
+
+        static void detach(std::vector<Arc> &arcs, NodeId node)
+        {
+            arcs.erase(std::remove_if(arcs.begin(), arcs.end(), [node](const Arc &arc)
+                                      { return arc.node == node; }),
+                       arcs.end());
+        }
+
+        // Dijkstra from source avoiding skip, until every target is settled, or past limit
+        // metres, or after settleLimit_ nodes
+        void witnessSearch(NodeId source, NodeId skip, std::uint64_t limit, const std::vector<Arc> &targets)
+        {
+            if (++generation_ == 0)
+            {
+                std::fill(stamp_.begin(), stamp_.end(), 0);
+                std::fill(targetStamp_.begin(), targetStamp_.end(), 0);
+                generation_ = 1;
+            }
+            std::size_t unsettled = 0;
+            for (const Arc &target : targets)
+            {
+                if (target.node != source && targetStamp_[target.node] != generation_)
+                {
+                    targetStamp_[target.node] = generation_;
+                    ++unsettled;
+                }
+            }
+            heap_.clear();
+            stamp_[source] = generation_;
+            distance_[source] = 0;
+            heap_.emplace_back(0, source);
+
+            std::size_t settled = 0;
+            while (!heap_.empty() && settled < settleLimit_)
+            {
+                std::pop_heap(heap_.begin(), heap_.end(), std::greater<HeapEntry>());
+                const auto [metres, node] = heap_.back();
+                heap_.pop_back();
+                if (metres != distance_[node])
+                {
+                    continue;
+                }
+                if (metres > limit)
+                {
+                    break;
+                }
+                ++settled;
+                if (targetStamp_[node] == generation_ && --unsettled == 0)
+                {
+                    break;
+                }
+
+                for (const Arc &arc : out_[node])
+                {
+                    const std::uint64_t next = metres + arc.metres;
+                    if (arc.node != skip && next <= limit && !reached(arc.node, next))
+                    {
+                        stamp_[arc.node] = generation_;
+                        distance_[arc.node] = next;
+                        heap_.emplace_back(next, arc.node);
+                        std::push_heap(heap_.begin(), heap_.end(), std::greater<HeapEntry>());
+                    }
+                }
+            }
+        }
+
+        // Witness search found node within metres
+        bool reached(NodeId node, std::uint64_t metres) const
+        {
+            return stamp_[node] == generation_ && distance_[node] <= metres;
+        }
+
+        using HeapEntry = std::pair<std::uint64_t, NodeId>;
+
+        std::vector<std::vector<Arc>> out_;
+        std::vector<std::vector<Arc>> in_;
+        std::vector<std::uint8_t> contracted_;
+        std::vector<int> deletedNeighbours_;
+        std::vector<int> priority_;
+        std::size_t settleLimit_;
+
+        // Witness search workspace, reset by bumping generation_
+        std::vector<std::uint64_t> distance_;
+        std::vector<std::uint32_t> stamp_;
+        std::vector<std::uint32_t> targetStamp_; // nodes the current search is looking for
+        std::uint32_t generation_ = 0;
+        std::vector<HeapEntry> heap_;
+    };
+}
+
+Hierarchy contractHierarchy(std::size_t nodeCount, const std::vector<RoadEdge> &edges, std::size_t witnessSettleLimit)
+{
+    return Contractor(nodeCount, edges, witnessSettleLimit).run();
+}
@@ -0,0 +1,597 @@
+#include "DispatchPlanner.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include "RouteQuery.h"
+
+namespace
+{
+    constexpr std::uint32_t NO_VEHICLE = std::numeric_limits<std::uint32_t>::max();
+    constexpr std::uint32_t NO_LOCATION = std::numeric_limits<std::uint32_t>::max();
+    constexpr std::int64_t NO_ROUTE = std::numeric_limits<std::int64_t>::max() / 4; // sums of a few stay finite
+    constexpr std::size_t MAX_PASSES = 50;    // local search passes per solution
+    constexpr double RUIN_FRACTION = 0.15;    // share of orders a ruin-and-recreate round takes out
+}
+
+// NETWORK
+
+std::uint32_t DispatchPlanner::Network::locate(NodeId node)
+{
+    if (node >= graph->nodeCount())
+    {
+        throw std::invalid_argument("DispatchPlanner: node is not on the network");
+    }
+    const auto found = index.find(node);
+    if (found != index.end())
+    {
+        return found->second;
+    }
+    const std::uint32_t location = static_cast<std::uint32_t>(nodes.size());
+    nodes.push_back(node);
+    index.emplace(node, location);
+    return location;
+}
+
+// SOLUTION
+
+bool DispatchPlanner::Solution::betterThan(const Solution &other) const
+{
+    if (unassigned.size() != other.unassigned.size())
+    {
+        return unassigned.size() < other.unassigned.size();
+    }
+    return totalMetres < other.totalMetres;
+}
+
+// SEARCH
+
+/**
+ * Moves on a Solution. Reads the planner (orders, matrices, vehicles) but
+ * never changes it, so one Search per thread can run at the same time.
+ */
+class DispatchPlanner::Search
+{
+public:
+    Search(const DispatchPlanner &planner, std::uint32_t seed) : planner_(planner), random_(seed) {}
+
+    // Cheapest insertion, heaviest first so big orders still find room
+    void insertAll(Solution &solution, std::vector<std::uint32_t> pending)
+    {
+        std::stable_sort(pending.begin(), pending.end(), [this](std::uint32_t a, std::uint32_t b)
+                         { return planner_.orders_[a].weightKg > planner_.orders_[b].weightKg; });
+        for (std::uint32_t order : pending)
+        {
+            const Place place = cheapestPlace(solution, order);
+            if (place.cost == NO_ROUTE)
+            {
+                solution.unassigned.push_back(order);
+            }
+            else
+            {
+                insert(solution, place, order);
+            }
+        }
+    }
+
+    // Best of `rounds` ruin-and-recreate rounds, each followed by local search
+    Solution run(const Solution &start, std::size_t rounds)
+    {
+        Solution best = start;
+        localSearch(best);
+        for (std::size_t round = 0; round < rounds; ++round)
+        {
+            Solution candidate = best;
+            ruinAndRecreate(candidate);
+            localSearch(candidate);
+            if (candidate.betterThan(best))
+            {
+                best = std::move(candidate);
+            }
+        }
+        return best;
+    }
+
+private:
+    struct Place
+    {
+        std::int64_t cost;
+        std::uint32_t vehicle;
+        std::size_t position;
+    };
+
+    // Metres from one location to another on the vehicle's network
+    std::int64_t leg(std::uint32_t vehicle, std::uint32_t from, std::uint32_t to) const
+    {
+        const std::uint32_t metres = planner_.networkOf(planner_.vehicles_[vehicle].network).at(from, to);
+        return metres == UNREACHABLE ? NO_ROUTE : metres;
+    }
+
+    // Location of the stop at position; before the first and after the last is the depot
+    std::uint32_t stop(const Solution &solution, std::uint32_t vehicle, std::ptrdiff_t position) const
+    {
+        const std::vector<std::uint32_t> &route = solution.routes[vehicle];
+        if (position < 0 || position >= static_cast<std::ptrdiff_t>(route.size()))
+        {
+            return planner_.depots_[vehicle];
+        }
+        return planner_.locations_[route[static_cast<std::size_t>(position)]];
+    }
+
+    bool fits(const Solution &solution, std::uint32_t vehicle, std::uint32_t order, int freedKg = 0) const
+    {
+        const DeliveryOrder &delivery = planner_.orders_[order];
+        return planner_.available_[vehicle] != 0 && planner_.locations_[order] != NO_LOCATION &&
+               planner_.vehicles_[vehicle].network == delivery.network &&
+               solution.loadKg[vehicle] - freedKg + delivery.weightKg <= planner_.capacityKg_[vehicle];
+    }
+
+    // Extra metres of visiting location between positions - 1 and position
+    std::int64_t detour(const Solution &solution, std::uint32_t vehicle, std::size_t position, std::uint32_t location) const
+    {
+        const auto at = static_cast<std::ptrdiff_t>(position);
+        const std::uint32_t previous = stop(solution, vehicle, at - 1);
+        const std::uint32_t next = stop(solution, vehicle, at);
+        const std::int64_t in = leg(vehicle, previous, location);
+        const std::int64_t out = leg(vehicle, location, next);
+        if (in == NO_ROUTE || out == NO_ROUTE)
+        {
+            return NO_ROUTE;
+        }
+        return in + out - leg(vehicle, previous, next);
+    }
+
+    Place cheapestPlace(const Solution &solution, std::uint32_t order) const
+    {
+        Place best{NO_ROUTE, NO_VEHICLE, 0};
+        for (std::uint32_t vehicle = 0; vehicle < solution.routes.size(); ++vehicle)
+        {
+            if (!fits(solution, vehicle, order))
+            {
+                continue;
+            }
+            for (std::size_t position = 0; position <= solution.routes[vehicle].size(); ++position)
+            {
+                const std::int64_t cost = detour(solution, vehicle, position, planner_.locations_[order]);
+                if (cost < best.cost)
+                {
+                    best = Place{cost, vehicle, position};
+                }
+            }
+        }
+        return best;
+    }
+
+    void insert(Solution &solution, const Place &place, std::uint32_t order)
+    {
+        std::vector<std::uint32_t> &route = solution.routes[place.vehicle];
+        route.insert(route.begin() + static_cast<std::ptrdiff_t>(place.position), order);
+        solution.loadKg[place.vehicle] += planner_.orders_[order].weightKg;
+        solution.metres[place.vehicle] += static_cast<std::uint64_t>(place.cost);
+        solution.totalMetres += static_cast<std::uint64_t>(place.cost);
+        solution.vehicleOf[order] = place.vehicle;
+    }
+
+    // Take the order at position out of the vehicle's route; returns the metres saved
+    std::int64_t remove(Solution &solution, std::uint32_t vehicle, std::size_t position)
+    {
+        std::vector<std::uint32_t> &route = solution.routes[vehicle];
+        const std::uint32_t order = route[position];
+        route.erase(route.begin() + static_cast<std::ptrdiff_t>(position));
+        const std::int64_t saved = detour(solution, vehicle, position, planner_.locations_[order]);
+        solution.loadKg[vehicle] -= planner_.orders_[order].weightKg;
+        solution.metres[vehicle] -= static_cast<std::uint64_t>(saved);
+        solution.totalMetres -= static_cast<std::uint64_t>(saved);
+        solution.vehicleOf[order] = NO_VEHICLE;
+        return saved;
+    }
+
+    void localSearch(Solution &solution)
+    {
+        for (std::size_t pass = 0; pass < MAX_PASSES; ++pass)
+        {
+            const bool relocated = relocateAll(solution);
+            const bool swapped = swapAll(solution);
+            if (!relocated && !swapped)
+            {
+                return;
+            }
+        }
+    }
+
+    // Move each order, in random order, to its cheapest place anywhere
+    bool relocateAll(Solution &solution)
+    {
+        bool improved = false;
+
+        // Orders left over earlier may fit now that others moved
+        std::vector<std::uint32_t> waiting;
+        waiting.swap(solution.unassigned);
+        for (std::uint32_t order : waiting)
+        {
+            const Place place = cheapestPlace(solution, order);
+            if (place.cost == NO_ROUTE)
+            {
+                solution.unassigned.push_back(order);
+            }
+            else
+            {
+                insert(solution, place, order);
+                improved = true;
+            }
+        }
+
+        order_.clear();
+        for (std::uint32_t order = 0; order < solution.vehicleOf.size(); ++order)
+        {
+            if (solution.vehicleOf[order] != NO_VEHICLE)
+            {
+                order_.push_back(order);
+            }
+        }
+        std::shuffle(order_.begin(), order_.end(), random_);
+
+        for (std::uint32_t order : order_)
+        {
+            const std::uint32_t vehicle = solution.vehicleOf[order];
+            const std::vector<std::uint32_t> &route = solution.routes[vehicle];
+            const std::size_t position = static_cast<std::size_t>(std::find(route.begin(), route.end(), order) - route.begin());
+
+            const std::int64_t saved = remove(solution, vehicle, position);
+            const Place place = cheapestPlace(solution, order);
+            if (place.cost < saved)
+            {
+                insert(solution, place, order);
+                improved = true;
+            }
+            else
+            {
+                insert(solution, Place{saved, vehicle, position}, order); // put it back
+            }
+        }
+        return improved;
+    }
+
+    // Exchange two orders between two vehicles of the same network
+    bool swapAll(Solution &solution)
+    {
+        bool improved = false;
+        const std::uint32_t vehicles = static_cast<std::uint32_t>(solution.routes.size());
+        for (std::uint32_t a = 0; a < vehicles; ++a)
+        {
+            for (std::uint32_t b = a + 1; b < vehicles; ++b)
+            {
+                if (planner_.vehicles_[a].network != planner_.vehicles_[b].network)
+                {
+                    continue;
+                }
+                for (std::size_t i = 0; i < solution.routes[a].size(); ++i)
+                {
+                    for (std::size_t j = 0; j < solution.routes[b].size(); ++j)
+                    {
+                        improved |= trySwap(solution, a, i, b, j);
+                    }
+                }
+            }
+        }
+        return improved;
+    }
+
+    bool trySwap(Solution &solution, std::uint32_t a, std::size_t i, std::uint32_t b, std::size_t j)
+    {
+        const std::uint32_t first = solution.routes[a][i];
+        const std::uint32_t second = solution.routes[b][j];
+        const int firstKg = planner_.orders_[first].weightKg;
+        const int secondKg = planner_.orders_[second].weightKg;
+        if (!fits(solution, a, second, firstKg) || !fits(solution, b, first, secondKg))
+        {
+            return false;
+        }
+
+        const std::int64_t changeA = replaced(solution, a, i, planner_.locations_[second]);
+        const std::int64_t changeB = replaced(solution, b, j, planner_.locations_[first]);
+        if (changeA == NO_ROUTE || changeB == NO_ROUTE || changeA + changeB >= 0)
+        {
+            return false;
+        }
+
+        solution.routes[a][i] = second;
+        solution.routes[b][j] = first;
+        solution.loadKg[a] += secondKg - firstKg;
+        solution.loadKg[b] += firstKg - secondKg;
+        solution.metres[a] = static_cast<std::uint64_t>(static_cast<std::int64_t>(solution.metres[a]) + changeA);
+        solution.metres[b] = static_cast<std::uint64_t>(static_cast<std::int64_t>(solution.metres[b]) + changeB);
+        solution.totalMetres = static_cast<std::uint64_t>(static_cast<std::int64_t>(solution.totalMetres) + changeA + changeB);
+        solution.vehicleOf[first] = b;
+        solution.vehicleOf[second] = a;
+        return true;
+    }
+
+    // Metres gained by visiting location instead of the stop at position
+    std::int64_t replaced(const Solution &solution, std::uint32_t vehicle, std::size_t position, std::uint32_t location) const
+    {
+        const auto at = static_cast<std::ptrdiff_t>(position);
+        const std::uint32_t previous = stop(solution, vehicle, at - 1);
+        const std::uint32_t current = stop(solution, vehicle, at);
+        const std::uint32_t next = stop(solution, vehicle, at + 1);
+        const std::int64_t in = leg(vehicle, previous, location);
+        const std::int64_t out = leg(vehicle, location, next);
+        if (in == NO_ROUTE || out == NO_ROUTE)
+        {
+            return NO_ROUTE;
+        }
+        return in + out - leg(vehicle, previous, current) - leg(vehicle, current, next);
+    }
+
+    void ruinAndRecreate(Solution &solution)
+    {
+        order_.clear();
+        for (std::uint32_t order = 0; order < solution.vehicleOf.size(); ++order)
+        {
+            if (solution.vehicleOf[order] != NO_VEHICLE)
+            {
+                order_.push_back(order);
+            }
+        }
+        if (order_.empty())
+        {
+            return;
+        }
+        std::shuffle(order_.begin(), order_.end(), random_);
+        order_.resize(std::max<std::size_t>(1, static_cast<std::size_t>(order_.size() * RUIN_FRACTION)));
+
+        for (std::uint32_t order : order_)
+        {
+            const std::uint32_t vehicle = solution.vehicleOf[order];
+            const std::vector<std::uint32_t> &route = solution.routes[vehicle];
+            remove(solution, vehicle, static_cast<std::size_t>(std::find(route.begin(), route.end(), order) - route.begin()));
+        }
+        std::vector<std::uint32_t> pending(order_);
+        pending.insert(pending.end(), solution.unassigned.begin(), solution.unassigned.end());
+        solution.unassigned.clear();
+
+        // Random order instead of heaviest first, so rounds explore different plans
+        std::shuffle(pending.begin(), pending.end(), random_);
+        for (std::uint32_t order : pending)
+        {
+            const Place place = cheapestPlace(solution, order);
+            if (place.cost == NO_ROUTE)
+            {
+                solution.unassigned.push_back(order);
+            }
+            else
+            {
+                insert(solution, place, order);
+            }
+        }
+    }
+
+    const DispatchPlanner &planner_;
+    std::mt19937 random_;
+    std::vector<std::uint32_t> order_; // scratch list of order indexes
+};
+
+// PLANNER
+
+DispatchPlanner::DispatchPlanner(const RoadGraph *roads, const RoadGraph *seaLanes, std::vector<DispatchVehicle> vehicles,
+                                 DispatchOptions options)
+    : vehicles_(std::move(vehicles)), options_(options)
+{
+    roads_.graph = roads;
+    seaLanes_.graph = seaLanes;
+    for (const DispatchVehicle &vehicle : vehicles_)
+    {
+        Network &network = networkOf(vehicle.network);
+        if (network.graph == nullptr || vehicle.transport == nullptr)
+        {
+            throw std::invalid_argument("DispatchPlanner: vehicle without a transport or a network");
+        }
+        depots_.push_back(network.locate(vehicle.depot));
+    }
+    available_.assign(vehicles_.size(), 0);
+    capacityKg_.assign(vehicles_.size(), 0);
+    solution_.routes.resize(vehicles_.size());
+    solution_.loadKg.assign(vehicles_.size(), 0);
+    solution_.metres.assign(vehicles_.size(), 0);
+    publish();
+}
+
+const DispatchPlan &DispatchPlanner::plan(const std::vector<DeliveryOrder> &orders)
+{
+    orders_.clear();
+    locations_.clear();
+    solution_ = Solution{};
+    solution_.routes.resize(vehicles_.size());
+    solution_.loadKg.assign(vehicles_.size(), 0);
+    solution_.metres.assign(vehicles_.size(), 0);
+
+    std::vector<std::uint32_t> pending;
+    for (const DeliveryOrder &order : orders)
+    {
+        pending.push_back(addOrder(order));
+    }
+    std::vector<std::uint32_t> released;
+    refreshVehicles(released);
+    route(roads_);
+    route(seaLanes_);
+
+    Search(*this, options_.seed).insertAll(solution_, pending);
+    improve(options_.rounds);
+    publish();
+    return plan_;
+}
+
+const DispatchPlan &DispatchPlanner::addOrders(const std::vector<DeliveryOrder> &orders)
+{
+    std::vector<std::uint32_t> pending;
+    for (const DeliveryOrder &order : orders)
+    {
+        pending.push_back(addOrder(order));
+    }
+
+    // Orders of vehicles that went into maintenance, and earlier leftovers, need a place too
+    refreshVehicles(pending);
+    pending.insert(pending.end(), solution_.unassigned.begin(), solution_.unassigned.end());
+    solution_.unassigned.clear();
+    route(roads_);
+    route(seaLanes_);
+
+    Search(*this, options_.seed).insertAll(solution_, pending);
+    improve(options_.replanRounds);
+    publish();
+    return plan_;
+}
+
+void DispatchPlanner::dispatch()
+{
+    for (std::size_t vehicle = 0; vehicle < vehicles_.size(); ++vehicle)
+    {
+        if (!solution_.routes[vehicle].empty())
+        {
+            const int km = static_cast<int>((solution_.metres[vehicle] + 999) / 1000);
+            vehicles_[vehicle].transport->performDelivery(solution_.loadKg[vehicle], km);
+        }
+    }
+
+    // Routes between known places stay in the matrices for the next orders
+    plan(std::vector<DeliveryOrder>{});
+}
+
+std::uint32_t DispatchPlanner::addOrder(const DeliveryOrder &order)
+{
+    Network &network = networkOf(order.network);
+    orders_.push_back(order);
+    locations_.push_back(network.graph != nullptr ? network.locate(order.destination) : NO_LOCATION);
+    solution_.vehicleOf.push_back(NO_VEHICLE);
+    return static_cast<std::uint32_t>(orders_.size() - 1);
+}
+
+// Route the pairs that involve a location added since the last call
+void DispatchPlanner::route(Network &network)
+{
+    const std::size_t count = network.nodes.size();
+    if (network.graph == nullptr || network.routed == count)
+    {
+        return;
+    }
+
+    std::vector<RouteRequest> requests;
+    for (std::uint32_t from = 0; from < count; ++from)
+    {
+        for (std::uint32_t to = 0; to < count; ++to)
+        {
+            if (from >= network.routed || to >= network.routed)
+            {
+                requests.push_back(RouteRequest{network.nodes[from], network.nodes[to]});
+            }
+        }
+    }
+    std::vector<std::uint32_t> metres;
+    routeDistances(*network.graph, requests, metres, options_.threads);
+    routeQueries_ += requests.size();
+
+    std::vector<std::uint32_t> matrix(count * count);
+    std::size_t next = 0;
+    for (std::size_t from = 0; from < count; ++from)
+    {
+        for (std::size_t to = 0; to < count; ++to)
+        {
+            const bool known = from < network.routed && to < network.routed;
+            matrix[from * count + to] = known ? network.metres[from * network.routed + to] : metres[next++];
+        }
+    }
+    network.metres.swap(matrix);
+    network.routed = count;
+}
+
+// Re-read maintenance and capacity; orders of vehicles no longer available go to released
+void DispatchPlanner::refreshVehicles(std::vector<std::uint32_t> &released)
+{
+    for (std::size_t vehicle = 0; vehicle < vehicles_.size(); ++vehicle)
+    {
+        const Transport &transport = *vehicles_[vehicle].transport;
+        available_[vehicle] = transport.needsMaintenance() ? 0 : 1;
+        capacityKg_[vehicle] = transport.maxLoadCapacity();
+
+        std::vector<std::uint32_t> &route = solution_.routes[vehicle];
+        if (available_[vehicle] == 0 || solution_.loadKg[vehicle] > capacityKg_[vehicle])
+        {
+            for (std::uint32_t order : route)
+            {
+                solution_.vehicleOf[order] = NO_VEHICLE;
+                released.push_back(order);
+            }
+            route.clear();
+            solution_.totalMetres -= solution_.metres[vehicle];
+            solution_.metres[vehicle] = 0;
+            solution_.loadKg[vehicle] = 0;
+        }
+    }
+}
+
+// Run options_.starts searches from solution_ over the threads and keep the best
+void DispatchPlanner::improve(std::size_t rounds)
+{
+    const std::size_t starts = std::max<std::size_t>(1, options_.starts);
+    std::vector<Solution> results(starts);
+    std::size_t workers = options_.threads != 0 ? options_.threads : std::max(1u, std::thread::hardware_concurrency());
+    workers = std::min(workers, starts);
+
+    std::atomic<std::size_t> next{0};
+    auto work = [&]()
+    {
+        for (std::size_t start = next++; start < starts; start = next++)
+        {
+            Search search(*this, options_.seed + static_cast<std::uint32_t>(start) + 1);
+            results[start] = search.run(solution_, rounds);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t i = 1; i < workers; ++i)
+    {
+        pool.emplace_back(work);
+    }
+    work();
+    for (std::thread &thread : pool)
+    {
+        thread.join();
+    }
+
+    // Ties go to the lowest start, so the thread count never changes the plan
+    std::size_t best = 0;
+    for (std::size_t start = 1; start < starts; ++start)
+    {
+        if (results[start].betterThan(results[best]))
+        {
+            best = start;
+        }
+    }
+    if (!solution_.betterThan(results[best]))
+    {
+        solution_ = std::move(results[best]);
+    }
+}
+
+void DispatchPlanner::publish()
+{
+    plan_.routes.assign(vehicles_.size(), VehicleRoute{});
+    for (std::size_t vehicle = 0; vehicle < vehicles_.size(); ++vehicle)
+    {
+        for (std::uint32_t order : solution_.routes[vehicle])
+        {
+            plan_.routes[vehicle].orders.push_back(orders_[order].id);
+        }
+        plan_.routes[vehicle].loadKg = solution_.loadKg[vehicle];
+        plan_.routes[vehicle].metres = solution_.metres[vehicle];
+    }
+    plan_.unassigned.clear();
+    for (std::uint32_t order : solution_.unassigned)
+    {
+        plan_.unassigned.push_back(orders_[order].id);
+    }
+    plan_.totalMetres = solution_.totalMetres;
+}
@@ -0,0 +1,104 @@
+#include "Fleet.h"
+#include "Car.h"
+#include "Ship.h"
+
+// CAR COLUMNS
+
+std::size_t CarColumns::add()
+{
+    // Same initial state as Car::Car()
+    distanceDriven_.push_back(0);
+    maintenanceNeeded_.push_back(0);
+    maxLoadKg_.push_back(Car::MAX_LOAD_KG);
+    return distanceDriven_.size() - 1;
+}
+
+void CarColumns::performDelivery(int loadweight)
+{
+    performDelivery(loadweight, Car::DEFAULT_TRIP_KM);
+}
+
+void CarColumns::performDelivery(int loadweight, int distanceKm)
+{
+    std::int32_t *distance = distanceDriven_.data();
+    std::int32_t *maintenance = maintenanceNeeded_.data();
+    const std::int32_t *maxLoad = maxLoadKg_.data();
+    const std::size_t count = size();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        distance[i] += distanceKm;
+        maintenance[i] |= static_cast<std::int32_t>(loadweight > maxLoad[i]) | static_cast<std::int32_t>(distance[i] > Car::MAINTENANCE_KM);
+    }
+}
+
+void CarColumns::performMaintenance()
+{
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        maintenanceNeeded_[i] = 0;
+        distanceDriven_[i] = 0;
+    }
+}
+
+void CarColumns::collectNeedingMaintenance(std::vector<VehicleRef> &out) const
+{
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        if (maintenanceNeeded_[i] != 0)
+        {
+            out.push_back(VehicleRef{KIND, i});
+        }
+    }
+}
+
+// SHIP COLUMNS
+
+std::size_t ShipColumns::add()
+{
+    // Same initial state as Ship::Ship()
+    tripsDone_.push_back(0);
+    maintenanceNeeded_.push_back(0);
+    cargoCapacityKg_.push_back(Ship::MAX_CARGO_KG);
+    return tripsDone_.size() - 1;
+}
+
+void ShipColumns::performDelivery(int loadweight)
+{
+    performDelivery(loadweight, 0);
+}
+
+// Like Ship, serviced by trip count: the distance does not matter
+void ShipColumns::performDelivery(int loadweight, int /* distanceKm */)
+{
+    std::int32_t *trips = tripsDone_.data();
+    std::int32_t *maintenance = maintenanceNeeded_.data();
+    const std::int32_t *capacity = cargoCapacityKg_.data();
+    const std::size_t count = size();
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        trips[i] += 1;
+        maintenance[i] |= static_cast<std::int32_t>(loadweight > capacity[i]) | static_cast<std::int32_t>(trips[i] > Ship::MAINTENANCE_TRIPS);
+    }
+}
+
+void ShipColumns::performMaintenance()
+{
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        maintenanceNeeded_[i] = 0;
+        tripsDone_[i] = 0;
+    }
+}
+
+void ShipColumns::collectNeedingMaintenance(std::vector<VehicleRef> &out) const
+{
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+        if (maintenanceNeeded_[i] != 0)
+        {
+            out.push_back(VehicleRef{KIND, i});
+        }
+    }
+}
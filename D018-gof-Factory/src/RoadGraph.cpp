@@ -0,0 +1,470 @@
+#include "RoadGraph.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <unistd.h>
+#include "ContractionHierarchy.h"
+
+namespace
+{
+    constexpr char MAGIC[8] = {'T', 'T', 'R', 'O', 'U', 'T', 'E', '\0'};
+    constexpr std::uint32_t VERSION = 1;
+    constexpr double DEGREES_TO_RADIANS = 3.14159265358979323846 / 180.0;
+
+    // Arrays of the image, in file order
+    enum Section : std::size_t
+    {
+        Positions,   // GeoPoint per node
+        UnitVectors, // UnitVector per node
+        EdgeOffsets,
+        EdgeTargets,
+        EdgeMetres,
+        UpOffsets,
+        UpTargets,
+        UpMetres,
+        UpMiddles,
+        DownOffsets,
+        DownTargets,
+        DownMetres,
+        DownMiddles,
+        NodeRanks,   // rank per node
+        RankedNodes, // node per rank
+        SECTION_COUNT
+    };
+
+    // Point on the unit sphere: chords between them bound routes from below
+    struct UnitVector
+    {
+        double x;
+        double y;
+        double z;
+    };
+
+    struct FileHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t kind;
+        std::uint32_t nodeCount;
+        std::uint32_t edgeCount;
+        std::uint32_t upCount;   // hierarchy edges, 0 when not contracted
+        std::uint32_t downCount;
+        std::uint32_t hierarchy; // 1 when contracted
+        std::uint32_t reserved;
+        std::uint64_t totalBytes;
+        std::uint64_t sectionOffset[SECTION_COUNT]; // 8-byte aligned, from the start of the file
+        std::uint64_t sectionBytes[SECTION_COUNT];
+    };
+
+    static_assert(sizeof(FileHeader) % 8 == 0, "sections after the header must stay 8-byte aligned");
+
+    const FileHeader &headerOf(const std::uint8_t *base)
+    {
+        return *reinterpret_cast<const FileHeader *>(base);
+    }
+
+    template <typename T>
+    const T *sectionOf(const std::uint8_t *base, Section section)
+    {
+        return reinterpret_cast<const T *>(base + headerOf(base).sectionOffset[section]);
+    }
+
+    UnitVector toUnitVector(GeoPoint point)
+    {
+        const double lat = point.lat * DEGREES_TO_RADIANS;
+        const double lon = point.lon * DEGREES_TO_RADIANS;
+        return UnitVector{std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon), std::sin(lat)};
+    }
+
+    double chordMetres(const UnitVector &a, const UnitVector &b)
+    {
+        const double dx = a.x - b.x;
+        const double dy = a.y - b.y;
+        const double dz = a.z - b.z;
+        return EARTH_RADIUS_M * std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+
+    // Rows non-decreasing and ending at count, every target a node. In the
+    // hierarchy edges also climb: the target ranks above the row and the
+    // middle below it, so unpacking a shortcut always terminates.
+    bool validCsr(const CsrView &view, std::uint64_t nodes, std::uint64_t count, bool hierarchy)
+    {
+        if (view.offsets[0] != 0 || view.offsets[nodes] != count)
+        {
+            return false;
+        }
+        for (NodeId node = 0; node < nodes; ++node)
+        {
+            if (view.offsets[node] > view.offsets[node + 1])
+            {
+                return false;
+            }
+            for (std::uint32_t edge = view.begin(node); edge < view.end(node); ++edge)
+            {
+                const NodeId target = view.targets[edge];
+                if (target >= nodes || (hierarchy && target <= node))
+                {
+                    return false;
+                }
+                if (hierarchy && view.middles[edge] != NO_NODE && view.middles[edge] >= node)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Bucket edges by the node they are stored at (counting sort, stable)
+    template <typename Edge, typename At, typename Fill>
+    void writeCsr(const std::vector<Edge> &edges, std::size_t nodeCount, std::uint32_t *offsets, At at, Fill fill)
+    {
+        std::fill(offsets, offsets + nodeCount + 1, 0);
+        for (const Edge &edge : edges)
+        {
+            ++offsets[at(edge) + 1];
+        }
+        for (std::size_t node = 0; node < nodeCount; ++node)
+        {
+            offsets[node + 1] += offsets[node];
+        }
+
+        std::vector<std::uint32_t> cursor(offsets, offsets + nodeCount);
+        for (const Edge &edge : edges)
+        {
+            fill(cursor[at(edge)]++, edge);
+        }
+    }
+}
+
+RoadGraph RoadGraph::build(NetworkKind kind, const std::vector<GeoPoint> &nodes, const std::vector<RoadEdge> &edges,
+                           bool contract)
+{
+    if (nodes.size() >= NO_NODE || edges.size() >= UNREACHABLE)
+    {
+        throw std::invalid_argument("RoadGraph: too many nodes or edges");
+    }
+
+    const std::size_t nodeCount = nodes.size();
+    std::vector<UnitVector> units(nodeCount);
+    std::transform(nodes.begin(), nodes.end(), units.begin(), toUnitVector);
+
+    std::vector<RoadEdge> checked(edges);
+    for (RoadEdge &edge : checked)
+    {
+        if (edge.from >= nodeCount || edge.to >= nodeCount)
+        {
+            throw std::invalid_argument("RoadGraph: edge refers to a node that does not exist");
+        }
+        const double straight = std::ceil(chordMetres(units[edge.from], units[edge.to]));
+        edge.metres = std::max(edge.metres, static_cast<std::uint32_t>(straight));
+    }
+
+    Hierarchy hierarchy;
+    if (contract)
+    {
+        hierarchy = contractHierarchy(nodeCount, checked);
+    }
+
+    // Lay the sections out one after the other, each 8-byte aligned
+    std::uint64_t sectionBytes[SECTION_COUNT] = {};
+    sectionBytes[Positions] = nodeCount * sizeof(GeoPoint);
+    sectionBytes[UnitVectors] = nodeCount * sizeof(UnitVector);
+    sectionBytes[EdgeOffsets] = (nodeCount + 1) * sizeof(std::uint32_t);
+    sectionBytes[EdgeTargets] = checked.size() * sizeof(NodeId);
+    sectionBytes[EdgeMetres] = checked.size() * sizeof(std::uint32_t);
+    if (contract)
+    {
+        sectionBytes[UpOffsets] = sectionBytes[DownOffsets] = (nodeCount + 1) * sizeof(std::uint32_t);
+        sectionBytes[UpTargets] = sectionBytes[UpMetres] = sectionBytes[UpMiddles] = hierarchy.upward.size() * sizeof(std::uint32_t);
+        sectionBytes[DownTargets] = sectionBytes[DownMetres] = sectionBytes[DownMiddles] = hierarchy.downward.size() * sizeof(std::uint32_t);
+        sectionBytes[NodeRanks] = sectionBytes[RankedNodes] = nodeCount * sizeof(NodeId);
+    }
+
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.kind = static_cast<std::uint32_t>(kind);
+    header.nodeCount = static_cast<std::uint32_t>(nodeCount);
+    header.edgeCount = static_cast<std::uint32_t>(checked.size());
+    header.upCount = static_cast<std::uint32_t>(hierarchy.upward.size());
+    header.downCount = static_cast<std::uint32_t>(hierarchy.downward.size());
+    header.hierarchy = contract ? 1 : 0;
+
+    std::uint64_t offset = sizeof(FileHeader);
+    for (std::size_t section = 0; section < SECTION_COUNT; ++section)
+    {
+        header.sectionOffset[section] = offset;
+        header.sectionBytes[section] = sectionBytes[section];
+        offset += (sectionBytes[section] + 7) / 8 * 8;
+    }
+    header.totalBytes = offset;
+
+    RoadGraph graph;
+    graph.owned_.assign(offset / 8, 0);
+    std::uint8_t *base = reinterpret_cast<std::uint8_t *>(graph.owned_.data());
+    graph.base_ = base;
+    std::memcpy(base, &header, sizeof(header));
+
+    auto section = [base, &header](Section which)
+    {
+        return reinterpret_cast<std::uint32_t *>(base + header.sectionOffset[which]);
+    };
+
+    std::copy(nodes.begin(), nodes.end(), reinterpret_cast<GeoPoint *>(base + header.sectionOffset[Positions]));
+    std::copy(units.begin(), units.end(), reinterpret_cast<UnitVector *>(base + header.sectionOffset[UnitVectors]));
+
+    writeCsr(checked, nodeCount, section(EdgeOffsets), [](const RoadEdge &edge)
+             { return edge.from; },
+             [&](std::uint32_t at, const RoadEdge &edge)
+             {
+                 section(EdgeTargets)[at] = edge.to;
+                 section(EdgeMetres)[at] = edge.metres;
+             });
+
+    if (contract)
+    {
+        NodeId *ranks = section(NodeRanks);
+        NodeId *ranked = section(RankedNodes);
+        for (NodeId rank = 0; rank < nodeCount; ++rank)
+        {
+            ranked[rank] = hierarchy.order[rank];
+            ranks[hierarchy.order[rank]] = rank;
+        }
+        for (std::vector<HierarchyEdge> *edges : {&hierarchy.upward, &hierarchy.downward})
+        {
+            for (HierarchyEdge &edge : *edges)
+            {
+                edge.from = ranks[edge.from];
+                edge.to = ranks[edge.to];
+                edge.middle = edge.middle == NO_NODE ? NO_NODE : ranks[edge.middle];
+            }
+        }
+
+        // Upward edges are stored at their source, downward ones at their target
+        writeCsr(hierarchy.upward, nodeCount, section(UpOffsets), [](const HierarchyEdge &edge)
+                 { return edge.from; },
+                 [&](std::uint32_t at, const HierarchyEdge &edge)
+                 {
+                     section(UpTargets)[at] = edge.to;
+                     section(UpMetres)[at] = edge.metres;
+                     section(UpMiddles)[at] = edge.middle;
+                 });
+        writeCsr(hierarchy.downward, nodeCount, section(DownOffsets), [](const HierarchyEdge &edge)
+                 { return edge.to; },
+                 [&](std::uint32_t at, const HierarchyEdge &edge)
+                 {
+                     section(DownTargets)[at] = edge.from;
+                     section(DownMetres)[at] = edge.metres;
+                     section(DownMiddles)[at] = edge.middle;
+                 });
+    }
+    return graph;
+}
+
+RoadGraph RoadGraph::open(const std::string &path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw std::runtime_error("RoadGraph: cannot open " + path);
+    }
+
+    struct stat info{};
+    const std::size_t size = ::fstat(fd, &info) == 0 ? static_cast<std::size_t>(info.st_size) : 0;
+    void *mapping = size >= sizeof(FileHeader) ? ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+    ::close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        throw std::runtime_error("RoadGraph: cannot map " + path);
+    }
+
+    RoadGraph graph;
+    graph.base_ = static_cast<const std::uint8_t *>(mapping);
+    graph.mapping_ = mapping;
+    graph.mappedBytes_ = size;
+
+    // The file may come from anywhere: check the layout, then every offset and node id once
+    const FileHeader &header = headerOf(graph.base_);
+    bool valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION &&
+                 header.totalBytes == size && header.nodeCount < NO_NODE;
+    const std::uint64_t nodes = header.nodeCount;
+    const std::uint64_t expected[SECTION_COUNT] = {
+        nodes * sizeof(GeoPoint), nodes * sizeof(UnitVector),
+        (nodes + 1) * 4, header.edgeCount * 4ull, header.edgeCount * 4ull,
+        header.hierarchy ? (nodes + 1) * 4 : 0, header.upCount * 4ull, header.upCount * 4ull, header.upCount * 4ull,
+        header.hierarchy ? (nodes + 1) * 4 : 0, header.downCount * 4ull, header.downCount * 4ull, header.downCount * 4ull,
+        header.hierarchy ? nodes * 4 : 0, header.hierarchy ? nodes * 4 : 0};
+    for (std::size_t section = 0; valid && section < SECTION_COUNT; ++section)
+    {
+        // Written as a subtraction so a huge offset cannot wrap past the end
+        valid = header.sectionBytes[section] == expected[section] && header.sectionOffset[section] % 8 == 0 &&
+                header.sectionOffset[section] >= sizeof(FileHeader) && header.sectionBytes[section] <= size &&
+                header.sectionOffset[section] <= size - header.sectionBytes[section];
+    }
+    valid = valid && validCsr(graph.edges(), nodes, header.edgeCount, false);
+    if (valid && header.hierarchy)
+    {
+        valid = validCsr(graph.upward(), nodes, header.upCount, true) &&
+                validCsr(graph.downward(), nodes, header.downCount, true);
+        const NodeId *ranks = sectionOf<NodeId>(graph.base_, NodeRanks);
+        const NodeId *ranked = sectionOf<NodeId>(graph.base_, RankedNodes);
+        for (NodeId rank = 0; valid && rank < nodes; ++rank)
+        {
+            valid = ranked[rank] < nodes && ranks[ranked[rank]] == rank;
+        }
+    }
+    if (!valid)
+    {
+        throw std::runtime_error("RoadGraph: not a road graph file " + path); // graph unmaps it
+    }
+    return graph;
+}
+
+void RoadGraph::save(const std::string &path) const
+{
+    const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "RoadGraph: open " + path);
+    }
+
+    const std::uint8_t *cursor = base_;
+    std::size_t left = headerOf(base_).totalBytes;
+    while (left > 0)
+    {
+        const ssize_t written = ::write(fd, cursor, left);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written < 0)
+        {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "RoadGraph: write " + path);
+        }
+        cursor += written;
+        left -= static_cast<std::size_t>(written);
+    }
+    ::close(fd);
+}
+
+RoadGraph::RoadGraph(RoadGraph &&other) noexcept
+    : base_(other.base_), owned_(std::move(other.owned_)), mapping_(other.mapping_), mappedBytes_(other.mappedBytes_)
+{
+    other.base_ = nullptr;
+    other.mapping_ = nullptr;
+    other.mappedBytes_ = 0;
+}
+
+RoadGraph &RoadGraph::operator=(RoadGraph &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (mapping_ != nullptr)
+        {
+            ::munmap(mapping_, mappedBytes_);
+        }
+        base_ = other.base_;
+        owned_ = std::move(other.owned_);
+        mapping_ = other.mapping_;
+        mappedBytes_ = other.mappedBytes_;
+        other.base_ = nullptr;
+        other.mapping_ = nullptr;
+        other.mappedBytes_ = 0;
+    }
+    return *this;
+}
+
+RoadGraph::~RoadGraph()
+{
+    if (mapping_ != nullptr)
+    {
+        ::munmap(mapping_, mappedBytes_);
+    }
+}
+
+NetworkKind RoadGraph::kind() const
+{
+    return static_cast<NetworkKind>(headerOf(base_).kind);
+}
+
+std::size_t RoadGraph::nodeCount() const
+{
+    return headerOf(base_).nodeCount;
+}
+
+std::size_t RoadGraph::edgeCount() const
+{
+    return headerOf(base_).edgeCount;
+}
+
+GeoPoint RoadGraph::position(NodeId node) const
+{
+    return sectionOf<GeoPoint>(base_, Positions)[node];
+}
+
+CsrView RoadGraph::edges() const
+{
+    return CsrView{sectionOf<std::uint32_t>(base_, EdgeOffsets), sectionOf<NodeId>(base_, EdgeTargets),
+                   sectionOf<std::uint32_t>(base_, EdgeMetres), nullptr};
+}
+
+bool RoadGraph::hasHierarchy() const
+{
+    return headerOf(base_).hierarchy != 0;
+}
+
+CsrView RoadGraph::upward() const
+{
+    return CsrView{sectionOf<std::uint32_t>(base_, UpOffsets), sectionOf<NodeId>(base_, UpTargets),
+                   sectionOf<std::uint32_t>(base_, UpMetres), sectionOf<NodeId>(base_, UpMiddles)};
+}
+
+CsrView RoadGraph::downward() const
+{
+    return CsrView{sectionOf<std::uint32_t>(base_, DownOffsets), sectionOf<NodeId>(base_, DownTargets),
+                   sectionOf<std::uint32_t>(base_, DownMetres), sectionOf<NodeId>(base_, DownMiddles)};
+}
+
+NodeId RoadGraph::rankOf(NodeId node) const
+{
+    return sectionOf<NodeId>(base_, NodeRanks)[node];
+}
+
+NodeId RoadGraph::nodeAt(NodeId rank) const
+{
+    return sectionOf<NodeId>(base_, RankedNodes)[rank];
+}
+
+double RoadGraph::straightLineMetres(NodeId a, NodeId b) const
+{
+    const UnitVector *units = sectionOf<UnitVector>(base_, UnitVectors);
+    return chordMetres(units[a], units[b]);
+}
+
+NodeId RoadGraph::nearest(GeoPoint point) const
+{
+    const UnitVector target = toUnitVector(point);
+    const UnitVector *units = sectionOf<UnitVector>(base_, UnitVectors);
+    NodeId best = NO_NODE;
+    double bestDot = -2.0;
+    for (NodeId node = 0; node < nodeCount(); ++node)
+    {
+        // Largest dot product = shortest chord
+        const double dot = units[node].x * target.x + units[node].y * target.y + units[node].z * target.z;
+        if (dot > bestDot)
+        {
+            bestDot = dot;
+            best = node;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,291 @@
+#include "RouteQuery.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+    constexpr std::size_t REQUESTS_PER_CLAIM = 64; // routeDistances hands out work in blocks this size
+
+    // Middle node of the hierarchy edge stored at `at` that leads to `target`
+    NodeId middleOf(const CsrView &view, NodeId at, NodeId target)
+    {
+        for (std::uint32_t edge = view.begin(at); edge < view.end(at); ++edge)
+        {
+            if (view.targets[edge] == target)
+            {
+                return view.middles[edge];
+            }
+        }
+        throw std::logic_error("RouteQuery: shortcut without its halves");
+    }
+}
+
+RouteQuery::RouteQuery(const RoadGraph &graph) : graph_(graph)
+{
+    for (Search *search : {&forward_, &backward_})
+    {
+        search->labels.assign(graph.nodeCount(), Label{0, 0});
+        search->parent.assign(graph.nodeCount(), NO_NODE);
+        search->parentEdge.assign(graph.nodeCount(), 0);
+    }
+}
+
+std::uint32_t RouteQuery::route(NodeId from, NodeId to, std::vector<NodeId> *path)
+{
+    return graph_.hasHierarchy() ? hierarchy(from, to, path) : aStar(from, to, path);
+}
+
+std::uint32_t RouteQuery::aStar(NodeId from, NodeId to, std::vector<NodeId> *path)
+{
+    begin();
+    const CsrView edges = graph_.edges();
+
+    // Edges are never shorter than the straight line (RoadGraph::build), so this never overestimates;
+    // the metre of slack absorbs rounding
+    auto bound = [this, to](NodeId node) -> std::uint64_t
+    {
+        const double straight = graph_.straightLineMetres(node, to) - 1.0;
+        return straight > 0.0 ? static_cast<std::uint64_t>(straight) : 0;
+    };
+
+    reach(forward_, from, 0, bound(from), NO_NODE, 0);
+    while (!forward_.heap.empty())
+    {
+        const HeapEntry entry = pop(forward_);
+        if (entry.metres != forward_.labels[entry.node].metres)
+        {
+            continue; // superseded by a shorter way there
+        }
+
+        if (entry.node == to)
+        {
+            if (path != nullptr)
+            {
+                path->clear();
+                for (NodeId node = to; node != NO_NODE; node = forward_.parent[node])
+                {
+                    path->push_back(node);
+                }
+                std::reverse(path->begin(), path->end());
+            }
+            return entry.metres;
+        }
+        ++settled_;
+
+        for (std::uint32_t edge = edges.begin(entry.node); edge < edges.end(entry.node); ++edge)
+        {
+            const NodeId target = edges.targets[edge];
+            const std::uint32_t metres = entry.metres + edges.metres[edge];
+            if (!forward_.reached(target, generation_) || metres < forward_.labels[target].metres)
+            {
+                reach(forward_, target, metres, metres + bound(target), entry.node, edge);
+            }
+        }
+    }
+
+    if (path != nullptr)
+    {
+        path->clear();
+    }
+    return UNREACHABLE;
+}
+
+std::uint32_t RouteQuery::hierarchy(NodeId from, NodeId to, std::vector<NodeId> *path)
+{
+    if (!graph_.hasHierarchy())
+    {
+        throw std::logic_error("RouteQuery: the graph was built without a contraction hierarchy");
+    }
+
+    begin();
+    const CsrView up = graph_.upward();
+    const CsrView down = graph_.downward();
+    constexpr std::uint64_t NONE = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t best = NONE;
+    NodeId meet = NO_NODE;
+
+    // Searches run on ranks
+    const NodeId source = graph_.rankOf(from);
+    const NodeId target = graph_.rankOf(to);
+    reach(forward_, source, 0, 0, NO_NODE, 0);
+    reach(backward_, target, 0, 0, NO_NODE, 0);
+    for (;;)
+    {
+        const std::uint64_t forwardMin = forward_.heap.empty() ? NONE : forward_.heap.front().key;
+        const std::uint64_t backwardMin = backward_.heap.empty() ? NONE : backward_.heap.front().key;
+        if (std::min(forwardMin, backwardMin) >= best)
+        {
+            break; // neither side can still improve on best
+        }
+
+        // Forward climbs upward edges; backward climbs downward edges against their direction
+        const bool forward = forwardMin <= backwardMin;
+        Search &search = forward ? forward_ : backward_;
+        const Search &other = forward ? backward_ : forward_;
+        const CsrView &climb = forward ? up : down;
+        const CsrView &descend = forward ? down : up;
+
+        const HeapEntry entry = pop(search);
+        if (entry.metres != search.labels[entry.node].metres)
+        {
+            continue;
+        }
+        ++settled_;
+
+        if (other.reached(entry.node, generation_))
+        {
+            const std::uint64_t total = std::uint64_t{entry.metres} + other.labels[entry.node].metres;
+            if (total < best)
+            {
+                best = total;
+                meet = entry.node;
+            }
+        }
+
+        // Stall on demand: reaching a higher node more cheaply proves this label is not on a shortest route
+        bool stalled = false;
+        for (std::uint32_t edge = descend.begin(entry.node); edge < descend.end(entry.node) && !stalled; ++edge)
+        {
+            const NodeId higher = descend.targets[edge];
+            stalled = search.reached(higher, generation_) &&
+                      std::uint64_t{search.labels[higher].metres} + descend.metres[edge] < entry.metres;
+        }
+        if (stalled)
+        {
+            continue;
+        }
+
+        for (std::uint32_t edge = climb.begin(entry.node); edge < climb.end(entry.node); ++edge)
+        {
+            const NodeId higher = climb.targets[edge];
+            const std::uint32_t metres = entry.metres + climb.metres[edge];
+            if (!search.reached(higher, generation_) || metres < search.labels[higher].metres)
+            {
+                reach(search, higher, metres, metres, entry.node, edge);
+            }
+        }
+    }
+
+    if (path != nullptr)
+    {
+        path->clear();
+        if (best != NONE)
+        {
+            // from .. meet: upward edges, found walking back from meet
+            std::vector<Pending> climbed;
+            for (NodeId node = meet; node != source; node = forward_.parent[node])
+            {
+                climbed.push_back(Pending{forward_.parent[node], node, up.middles[forward_.parentEdge[node]]});
+            }
+
+            path->push_back(from);
+            for (auto edge = climbed.rbegin(); edge != climbed.rend(); ++edge)
+            {
+                unpack(edge->from, edge->to, edge->middle, *path);
+            }
+            // meet .. to: downward edges
+            for (NodeId node = meet; node != target; node = backward_.parent[node])
+            {
+                unpack(node, backward_.parent[node], down.middles[backward_.parentEdge[node]], *path);
+            }
+        }
+    }
+    return best == NONE ? UNREACHABLE : static_cast<std::uint32_t>(best);
+}
+
+void RouteQuery::begin()
+{
+    if (++generation_ == 0)
+    {
+        std::fill(forward_.labels.begin(), forward_.labels.end(), Label{0, 0});
+        std::fill(backward_.labels.begin(), backward_.labels.end(), Label{0, 0});
+        generation_ = 1;
+    }
+    forward_.heap.clear();
+    backward_.heap.clear();
+    settled_ = 0;
+}
+
+void RouteQuery::reach(Search &search, NodeId node, std::uint32_t metres, std::uint64_t key, NodeId parent, std::uint32_t edge)
+{
+    search.labels[node] = Label{generation_, metres};
+    search.parent[node] = parent;
+    search.parentEdge[node] = edge;
+    search.heap.push_back(HeapEntry{key, metres, node});
+    std::push_heap(search.heap.begin(), search.heap.end(), std::greater<HeapEntry>());
+}
+
+RouteQuery::HeapEntry RouteQuery::pop(Search &search)
+{
+    std::pop_heap(search.heap.begin(), search.heap.end(), std::greater<HeapEntry>());
+    const HeapEntry entry = search.heap.back();
+    search.heap.pop_back();
+    return entry;
+}
+
+// Ranks in, nodes out
+void RouteQuery::unpack(NodeId from, NodeId to, NodeId middle, std::vector<NodeId> &path)
+{
+    // A shortcut from -> to over middle is from -> middle (stored downward at middle)
+    // then middle -> to (stored upward at middle); middle ranks below both ends
+    const CsrView up = graph_.upward();
+    const CsrView down = graph_.downward();
+    pending_.clear();
+    pending_.push_back(Pending{from, to, middle});
+    while (!pending_.empty())
+    {
+        const Pending edge = pending_.back();
+        pending_.pop_back();
+        if (edge.middle == NO_NODE)
+        {
+            path.push_back(graph_.nodeAt(edge.to));
+            continue;
+        }
+        pending_.push_back(Pending{edge.middle, edge.to, middleOf(up, edge.middle, edge.to)});
+        pending_.push_back(Pending{edge.from, edge.middle, middleOf(down, edge.middle, edge.from)});
+    }
+}
+
+void routeDistances(const RoadGraph &graph, const std::vector<RouteRequest> &requests,
+                    std::vector<std::uint32_t> &metres, unsigned threads)
+{
+    metres.assign(requests.size(), UNREACHABLE);
+    const std::size_t blocks = (requests.size() + REQUESTS_PER_CLAIM - 1) / REQUESTS_PER_CLAIM;
+    std::size_t workers = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+    workers = std::max<std::size_t>(1, std::min(workers, blocks));
+
+    // Threads claim blocks of requests until none are left, so slow routes do not idle the rest
+    std::atomic<std::size_t> next{0};
+    auto work = [&]()
+    {
+        RouteQuery query(graph);
+        for (;;)
+        {
+            const std::size_t begin = next.fetch_add(REQUESTS_PER_CLAIM, std::memory_order_relaxed);
+            if (begin >= requests.size())
+            {
+                return;
+            }
+            const std::size_t end = std::min(begin + REQUESTS_PER_CLAIM, requests.size());
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                metres[i] = query.route(requests[i].from, requests[i].to);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (std::size_t i = 1; i < workers; ++i)
+    {
+        pool.emplace_back(work);
+    }
+    work();
+    for (std::thread &thread : pool)
+    {
+        thread.join();
+    }
+}
@@ -1,6 +1,6 @@
 #include "Ship.h"
 
-Ship::Ship() : tripsDone_(0), maintenanceNeeded_(false), cargoCapacityKg_(20000000) {}
+Ship::Ship() : tripsDone_(0), maintenanceNeeded_(false), cargoCapacityKg_(MAX_CARGO_KG) {}
 
 std::string Ship::deliver() const
 {
@@ -23,6 +23,12 @@ bool Ship::needsMaintenance() const
 };
 
 void Ship::performDelivery(int loadweight)
+{
+    performDelivery(loadweight, 0);
+};
+
+// Ships are serviced by trip count, so the length of the sea lane does not matter
+void Ship::performDelivery(int loadweight, int /* distanceKm */)
 {
     ++tripsDone_;
 
@@ -31,7 +37,7 @@ void Ship::performDelivery(int loadweight)
         maintenanceNeeded_ = true;
     };
 
-    if (tripsDone_ > 5)
+    if (tripsDone_ > MAINTENANCE_TRIPS)
     {
         maintenanceNeeded_ = true;
     }
@@ -0,0 +1,41 @@
+#include "TransportFactory.h"
+
+void TransportDeleter::operator()(Transport *transport) const
+{
+    factory->recycle(kind, transport);
+}
+
+TransportFactory::TransportFactory(std::size_t slabSize) : cars_(slabSize), ships_(slabSize) {}
+
+TransportHandle TransportFactory::create(TransportKind kind)
+{
+    return kind == TransportKind::Car ? createCar() : createShip();
+}
+
+TransportHandle TransportFactory::createCar()
+{
+    return TransportHandle(cars_.acquire(), TransportDeleter{this, TransportKind::Car});
+}
+
+TransportHandle TransportFactory::createShip()
+{
+    return TransportHandle(ships_.acquire(), TransportDeleter{this, TransportKind::Ship});
+}
+
+std::size_t TransportFactory::live() const
+{
+    return cars_.live() + ships_.live();
+}
+
+void TransportFactory::recycle(TransportKind kind, Transport *transport)
+{
+    // The handle only ever holds the concrete type of its pool
+    if (kind == TransportKind::Car)
+    {
+        cars_.release(static_cast<Car *>(transport));
+    }
+    else
+    {
+        ships_.release(static_cast<Ship *>(transport));
+    }
+}
@@ -1,6 +1,13 @@
 #include <iostream>
+#include <memory>
+#include <vector>
 #include "Ship.h"
 #include "Car.h"
+#include "DispatchPlanner.h"
+#include "ObjectPool.h"
+#include "RoadGraph.h"
+#include "RouteQuery.h"
+#include "TransportFactory.h"
 // #include "gnss.h"
 
 // PRODUCT
@@ -39,6 +46,19 @@ public:
 
 // CREATOR
 
+class Creator;
+
+// Returns a pooled Product to the creator that made it
+struct ProductDeleter
+{
+    const Creator *creator;
+
+    void operator()(Product *product) const;
+};
+
+// RAII handle: the product goes back to its creator's pool when the handle dies
+using ProductHandle = std::unique_ptr<Product, ProductDeleter>;
+
 /**
  * Declares a factory method that retuns an object of Product Class
  * Creator's subclasses usually provide a implementation of the method
@@ -49,38 +69,66 @@ class Creator
 {
 public:
     virtual ~Creator() {};
-    virtual Product *FactoryMethod() const = 0;
+    virtual ProductHandle FactoryMethod() const = 0;
 
     std::string SomeOperation() const
     {
         // Call factory method to create Product Object
-        Product *product = this->FactoryMethod();
+        ProductHandle product = this->FactoryMethod();
 
-        // Use the product
+        // Use the product; it goes back to the pool at the end of the scope
 
-        std::string result = "CREATOR: Creator's code has been worked with " + product->Operation();
-        delete product;
-        return result;
+        return "CREATOR: Creator's code has been worked with " + product->Operation();
     };
+
+private:
+    friend struct ProductDeleter;
+    virtual void Recycle(Product *product) const = 0;
 };
 
+void ProductDeleter::operator()(Product *product) const
+{
+    creator->Recycle(product);
+}
+
 // CONCRETE CREATOR
 
+/**
+ * Concrete creators construct their products in an ObjectPool slot instead
+ * of with new/delete, so calling SomeOperation() over and over never
+ * reaches malloc once the first slab exists
+ */
 class ConcreteCreator1 : public Creator
 {
 public:
-    Product *FactoryMethod() const override
+    ProductHandle FactoryMethod() const override
     {
-        return new ConcreteProduct1();
+        return ProductHandle(pool_.acquire(), ProductDeleter{this});
     };
+
+private:
+    void Recycle(Product *product) const override
+    {
+        pool_.release(static_cast<ConcreteProduct1 *>(product));
+    }
+
+    mutable ObjectPool<ConcreteProduct1> pool_{4};
 };
 class ConcreteCreator2 : public Creator
 {
 public:
-    Product *FactoryMethod() const override
+    ProductHandle FactoryMethod() const override
     {
-        return new ConcreteProduct2();
+        return ProductHandle(pool_.acquire(), ProductDeleter{this});
     };
+
+private:
+    void Recycle(Product *product) const override
+    {
+        pool_.release(static_cast<ConcreteProduct2 *>(product));
+    }
+
+    mutable ObjectPool<ConcreteProduct2> pool_{4};
 };
 
 // CLIENT
@@ -91,44 +139,119 @@ void ClientCode(const Creator &creator)
               << creator.SomeOperation() << std::endl;
 }
 
-void operateTransport(Transport &transport)
+// A few Bavarian towns: 0 Munich, 1 Augsburg, 2 Ingolstadt, 3 Landshut, 4 Rosenheim
+RoadGraph makeBavarianRoads()
+{
+    const std::vector<GeoPoint> towns = {
+        {48.1372, 11.5756}, {48.3705, 10.8978}, {48.7665, 11.4258}, {48.5442, 12.1469}, {47.8571, 12.1181}};
+    std::vector<RoadEdge> roads;
+    for (const RoadEdge &road : std::vector<RoadEdge>{{0, 1, 65000}, {0, 2, 80000}, {0, 3, 75000}, {0, 4, 65000}, {1, 2, 90000}, {2, 3, 95000}})
+    {
+        roads.push_back(road);
+        roads.push_back(RoadEdge{road.to, road.from, road.metres});
+    }
+    return RoadGraph::build(NetworkKind::Road, towns, roads);
+}
+
+// North Sea ports: 0 Hamburg, 1 Rotterdam, 2 Antwerp, 3 Felixstowe
+RoadGraph makeNorthSeaLanes()
 {
+    const std::vector<GeoPoint> ports = {{53.5461, 9.9661}, {51.9490, 4.1453}, {51.2637, 4.3996}, {51.9553, 1.3511}};
+    std::vector<RoadEdge> lanes;
+    for (const RoadEdge &lane : std::vector<RoadEdge>{{0, 1, 500000}, {1, 2, 150000}, {1, 3, 200000}, {2, 3, 250000}, {0, 3, 650000}})
+    {
+        lanes.push_back(lane);
+        lanes.push_back(RoadEdge{lane.to, lane.from, lane.metres});
+    }
+    return RoadGraph::build(NetworkKind::SeaLane, ports, lanes);
+}
+
+// Deliveries from stop to stop, each leg as long as the shortest route on the network
+void deliverAlongRoutes(Transport &transport, const RoadGraph &network, const std::vector<NodeId> &stops)
+{
+    RouteQuery routes(network);
     std::cout << "---------\n";
-    std::cout << "Transport Type: " << transport.type() << "\n";
-    std::cout << "Max load capacity: " << transport.maxLoadCapacity() << "\n";
-    std::cout << "Starting deliveries: " << "\n";
+    std::cout << "Transport Type: " << transport.type() << " on " << (network.kind() == NetworkKind::Road ? "roads" : "sea lanes") << "\n";
 
-    for (size_t i = 0; i < 6; ++i)
+    for (size_t i = 0; i + 1 < stops.size(); ++i)
     {
-        /* code */
-        transport.performDelivery(100);
-        std::cout << "After delivery: " << (i + 1) << " Needs maintenance? " << (transport.needsMaintenance() ? "Yes" : "No") << "\n";
+        const std::uint32_t metres = routes.route(stops[i], stops[i + 1]);
+        if (metres == UNREACHABLE)
+        {
+            std::cout << "Leg " << (i + 1) << ": no route\n";
+            continue;
+        }
+        const int km = static_cast<int>((metres + 999) / 1000);
+        transport.performDelivery(100, km);
+        std::cout << "Leg " << (i + 1) << ": " << km << " km. Needs maintenance? " << (transport.needsMaintenance() ? "Yes" : "No") << "\n";
     }
 
     std::cout << "" << "\n";
-};
+}
+
+// Plan a batch of orders over the whole fleet, show the tours and drive them
+void dispatchFleet(DispatchPlanner &planner, const std::vector<DispatchVehicle> &fleet, const std::vector<DeliveryOrder> &orders)
+{
+    const DispatchPlan &plan = planner.plan(orders);
+    std::cout << "---------\n";
+    std::cout << "Dispatching " << orders.size() << " orders, " << (plan.totalMetres + 999) / 1000 << " km in total\n";
+
+    for (size_t i = 0; i < fleet.size(); ++i)
+    {
+        const Transport &transport = *fleet[i].transport;
+        const VehicleRoute &route = plan.routes[i];
+        std::cout << transport.type() << " " << (i + 1) << ": " << route.orders.size() << " orders, " << route.loadKg << " of "
+                  << transport.maxLoadCapacity() << " kg, " << (route.metres + 999) / 1000 << " km\n";
+    }
+    if (!plan.unassigned.empty())
+    {
+        std::cout << plan.unassigned.size() << " orders left for the next batch\n";
+    }
+
+    planner.dispatch();
+    for (size_t i = 0; i < fleet.size(); ++i)
+    {
+        std::cout << fleet[i].transport->type() << " " << (i + 1) << " needs maintenance? " << (fleet[i].transport->needsMaintenance() ? "Yes" : "No") << "\n";
+    }
+
+    std::cout << "" << "\n";
+}
 
 int main()
 {
     std::cout << "App launched with Concrete Creator \n";
 
-    Creator *creator1 = new ConcreteCreator1();
-    ClientCode(*creator1);
+    const ConcreteCreator1 creator1;
+    ClientCode(creator1);
 
     std::cout << std::endl;
 
-    Creator *creator2 = new ConcreteCreator2();
-    ClientCode(*creator2);
-
-    delete creator1;
-    delete creator2;
+    const ConcreteCreator2 creator2;
+    ClientCode(creator2);
 
     std::cout << "------------------------ \n";
-    Car car;
-    Ship ship;
 
-    operateTransport(car);
-    operateTransport(ship);
+    // Vehicles come from pooled slabs and go back when the handles die
+    TransportFactory factory;
+    TransportHandle car = factory.createCar();
+    TransportHandle van = factory.createCar();
+    TransportHandle ship = factory.createShip();
+    const RoadGraph roads = makeBavarianRoads();
+    const RoadGraph seaLanes = makeNorthSeaLanes();
+
+    // Cars leave from Munich, the ship from Hamburg; more goods than one car can carry
+    const std::vector<DispatchVehicle> fleet = {
+        {car.get(), NetworkKind::Road, 0}, {van.get(), NetworkKind::Road, 0}, {ship.get(), NetworkKind::SeaLane, 0}};
+    DispatchPlanner planner(&roads, &seaLanes, fleet);
+    dispatchFleet(planner, fleet,
+                  {{1, NetworkKind::Road, 1, 300}, {2, NetworkKind::Road, 2, 150}, {3, NetworkKind::Road, 3, 200},
+                   {4, NetworkKind::Road, 4, 250}, {5, NetworkKind::SeaLane, 1, 8000}, {6, NetworkKind::SeaLane, 3, 12000}});
+
+    // Same vehicles, serviced, now on single routes: Augsburg -> Rosenheim goes through Munich
+    car->performMaintenance();
+    ship->performMaintenance();
+    deliverAlongRoutes(*car, roads, {1, 4, 0});
+    deliverAlongRoutes(*ship, seaLanes, {0, 2, 3});
 
     return 0;
 }
\ No newline at end of file
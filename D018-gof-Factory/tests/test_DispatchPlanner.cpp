@@ -0,0 +1,257 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+#include "Car.h"
+#include "DispatchPlanner.h"
+#include "RoadGraph.h"
+#include "RouteQuery.h"
+#include "Ship.h"
+
+namespace
+{
+    // Two-way streets on a side x side grid around Munich, blocks about 1.2 km apart
+    RoadGraph makeTown(int side, unsigned seed = 3)
+    {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<std::uint32_t> metres(1200, 1900);
+
+        std::vector<GeoPoint> nodes;
+        std::vector<RoadEdge> edges;
+        for (int row = 0; row < side; ++row)
+        {
+            for (int col = 0; col < side; ++col)
+            {
+                nodes.push_back(GeoPoint{48.0 + row * 0.01, 11.0 + col * 0.015});
+            }
+        }
+        auto street = [&](NodeId a, NodeId b)
+        {
+            const std::uint32_t length = metres(random);
+            edges.push_back(RoadEdge{a, b, length});
+            edges.push_back(RoadEdge{b, a, length});
+        };
+        for (int row = 0; row < side; ++row)
+        {
+            for (int col = 0; col < side; ++col)
+            {
+                const NodeId node = static_cast<NodeId>(row * side + col);
+                if (col + 1 < side)
+                {
+                    street(node, node + 1);
+                }
+                if (row + 1 < side)
+                {
+                    street(node, node + static_cast<NodeId>(side));
+                }
+            }
+        }
+        return RoadGraph::build(NetworkKind::Road, nodes, edges);
+    }
+
+    // Three ports on a line: 0 - 1 - 2
+    RoadGraph makeCoast()
+    {
+        const std::vector<GeoPoint> ports = {{54.0, 8.0}, {54.0, 9.0}, {54.0, 10.0}};
+        const std::vector<RoadEdge> lanes = {{0, 1, 70000}, {1, 0, 70000}, {1, 2, 70000}, {2, 1, 70000}};
+        return RoadGraph::build(NetworkKind::SeaLane, ports, lanes);
+    }
+
+    std::vector<DeliveryOrder> randomOrders(std::size_t count, std::size_t nodes, int maxKg, unsigned seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<NodeId> node(0, static_cast<NodeId>(nodes - 1));
+        std::uniform_int_distribution<int> weight(10, maxKg);
+        std::vector<DeliveryOrder> orders;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            orders.push_back(DeliveryOrder{static_cast<std::uint32_t>(i), NetworkKind::Road, node(random), weight(random)});
+        }
+        return orders;
+    }
+
+    // Every order once: in some route or unassigned
+    std::multiset<std::uint32_t> plannedIds(const DispatchPlan &plan)
+    {
+        std::multiset<std::uint32_t> ids(plan.unassigned.begin(), plan.unassigned.end());
+        for (const VehicleRoute &route : plan.routes)
+        {
+            ids.insert(route.orders.begin(), route.orders.end());
+        }
+        return ids;
+    }
+}
+
+TEST(DispatchPlanner, Loads_Stay_Within_Max_Load_Capacity)
+{
+    const RoadGraph town = makeTown(6);
+    Car first, second, third;
+    DispatchPlanner planner(&town, nullptr, {{&first, NetworkKind::Road, 0}, {&second, NetworkKind::Road, 0}, {&third, NetworkKind::Road, 0}});
+
+    std::vector<DeliveryOrder> orders;
+    for (std::uint32_t id = 0; id < 6; ++id)
+    {
+        orders.push_back(DeliveryOrder{id, NetworkKind::Road, static_cast<NodeId>(5 + id * 5), 200});
+    }
+    const DispatchPlan &plan = planner.plan(orders);
+
+    EXPECT_TRUE(plan.unassigned.empty());
+    std::uint64_t total = 0;
+    for (const VehicleRoute &route : plan.routes)
+    {
+        EXPECT_LE(route.loadKg, first.maxLoadCapacity());
+        EXPECT_EQ(route.loadKg, static_cast<int>(route.orders.size()) * 200);
+        total += route.metres;
+    }
+    EXPECT_EQ(total, plan.totalMetres);
+    EXPECT_EQ(plannedIds(plan).size(), orders.size());
+}
+
+TEST(DispatchPlanner, Vehicles_Needing_Maintenance_Get_No_Orders)
+{
+    const RoadGraph town = makeTown(5);
+    Car worn, fresh;
+    worn.performDelivery(100, 500);
+    ASSERT_TRUE(worn.needsMaintenance());
+
+    DispatchPlanner planner(&town, nullptr, {{&worn, NetworkKind::Road, 0}, {&fresh, NetworkKind::Road, 24}});
+    const DispatchPlan &plan = planner.plan(randomOrders(4, town.nodeCount(), 100, 5));
+
+    EXPECT_TRUE(plan.routes[0].orders.empty());
+    EXPECT_EQ(plan.routes[1].orders.size(), 4u);
+}
+
+TEST(DispatchPlanner, Orders_Go_To_Vehicles_Of_Their_Network)
+{
+    const RoadGraph town = makeTown(4);
+    const RoadGraph coast = makeCoast();
+    Car car;
+    Ship ship;
+    DispatchPlanner planner(&town, &coast, {{&car, NetworkKind::Road, 0}, {&ship, NetworkKind::SeaLane, 0}});
+
+    const DispatchPlan &plan = planner.plan({{1, NetworkKind::Road, 15, 100},
+                                             {2, NetworkKind::SeaLane, 2, 5000},
+                                             {3, NetworkKind::Road, 3, 900}}); // heavier than any car takes
+
+    EXPECT_EQ(plan.routes[0].orders, std::vector<std::uint32_t>{1});
+    EXPECT_EQ(plan.routes[1].orders, std::vector<std::uint32_t>{2});
+    EXPECT_EQ(plan.routes[1].metres, 140000u * 2);
+    EXPECT_EQ(plan.unassigned, std::vector<std::uint32_t>{3});
+}
+
+TEST(DispatchPlanner, Single_Tour_Is_Optimal_On_Small_Instance)
+{
+    const RoadGraph town = makeTown(6, 9);
+    Car car;
+    DispatchPlanner planner(&town, nullptr, {{&car, NetworkKind::Road, 14}});
+    const std::vector<DeliveryOrder> orders = randomOrders(6, town.nodeCount(), 50, 21);
+    const DispatchPlan &plan = planner.plan(orders);
+
+    // Try every visiting order
+    RouteQuery routes(town);
+    std::vector<NodeId> stops;
+    for (const DeliveryOrder &order : orders)
+    {
+        stops.push_back(order.destination);
+    }
+    std::sort(stops.begin(), stops.end());
+    std::uint64_t best = UINT64_MAX;
+    do
+    {
+        std::uint64_t metres = routes.route(14, stops.front()) + routes.route(stops.back(), 14);
+        for (std::size_t i = 0; i + 1 < stops.size(); ++i)
+        {
+            metres += routes.route(stops[i], stops[i + 1]);
+        }
+        best = std::min(best, metres);
+    } while (std::next_permutation(stops.begin(), stops.end()));
+
+    EXPECT_EQ(plan.totalMetres, best);
+}
+
+TEST(DispatchPlanner, Thread_Count_Does_Not_Change_The_Plan)
+{
+    const RoadGraph town = makeTown(12);
+    const std::vector<DeliveryOrder> orders = randomOrders(60, town.nodeCount(), 120, 8);
+
+    std::vector<DispatchPlan> plans;
+    for (unsigned threads : {1u, 4u})
+    {
+        std::vector<Car> cars(5);
+        std::vector<DispatchVehicle> vehicles;
+        for (std::size_t i = 0; i < cars.size(); ++i)
+        {
+            vehicles.push_back(DispatchVehicle{&cars[i], NetworkKind::Road, static_cast<NodeId>(i * 20)});
+        }
+        DispatchOptions options;
+        options.threads = threads;
+        DispatchPlanner planner(&town, nullptr, vehicles, options);
+        plans.push_back(planner.plan(orders));
+    }
+
+    EXPECT_EQ(plans[0].totalMetres, plans[1].totalMetres);
+    for (std::size_t i = 0; i < plans[0].routes.size(); ++i)
+    {
+        EXPECT_EQ(plans[0].routes[i].orders, plans[1].routes[i].orders);
+    }
+}
+
+TEST(DispatchPlanner, Added_Orders_Route_Only_New_Destinations)
+{
+    const RoadGraph town = makeTown(8);
+    Car first, second;
+    DispatchPlanner planner(&town, nullptr, {{&first, NetworkKind::Road, 0}, {&second, NetworkKind::Road, 63}});
+    const std::vector<DeliveryOrder> orders = randomOrders(10, town.nodeCount(), 40, 2);
+    planner.plan(orders);
+    const std::size_t before = planner.routeQueries();
+
+    std::set<NodeId> places = {0, 63};
+    for (const DeliveryOrder &order : orders)
+    {
+        places.insert(order.destination);
+    }
+    const std::size_t known = places.size();
+    NodeId fresh = 0;
+    while (places.count(fresh) != 0)
+    {
+        ++fresh;
+    }
+
+    // Two orders to one new place: routes to and from every known place, and to itself
+    const DispatchPlan &plan = planner.addOrders({{100, NetworkKind::Road, fresh, 30}, {101, NetworkKind::Road, fresh, 30}});
+
+    EXPECT_EQ(planner.routeQueries() - before, 2 * known + 1);
+    EXPECT_EQ(plannedIds(plan).size(), 12u);
+    EXPECT_TRUE(plan.unassigned.empty());
+}
+
+TEST(DispatchPlanner, Replanning_Moves_Orders_Off_Vehicles_Needing_Maintenance)
+{
+    const RoadGraph town = makeTown(6);
+    Car first, second;
+    DispatchPlanner planner(&town, nullptr, {{&first, NetworkKind::Road, 0}, {&second, NetworkKind::Road, 35}});
+    planner.plan(randomOrders(8, town.nodeCount(), 50, 4));
+
+    first.performDelivery(0, 500);
+    const DispatchPlan &plan = planner.addOrders({});
+
+    EXPECT_TRUE(plan.routes[0].orders.empty());
+    EXPECT_EQ(plan.routes[1].orders.size(), 8u);
+}
+
+TEST(DispatchPlanner, Dispatch_Drives_The_Tours_And_Clears_The_Plan)
+{
+    const RoadGraph town = makeTown(25);
+    Car car;
+    DispatchPlanner planner(&town, nullptr, {{&car, NetworkKind::Road, 0}});
+    const DispatchPlan &plan = planner.plan({{1, NetworkKind::Road, 624, 100}}); // far corner and back
+
+    ASSERT_GT(plan.totalMetres, 100000u);
+    planner.dispatch();
+
+    EXPECT_TRUE(car.needsMaintenance()); // more than 100 km driven
+    EXPECT_TRUE(planner.current().routes[0].orders.empty());
+    EXPECT_EQ(planner.current().totalMetres, 0u);
+}
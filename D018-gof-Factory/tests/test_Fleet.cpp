@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "Car.h"
+#include "Fleet.h"
+#include "Ship.h"
+
+TEST(Fleet, Add_Groups_Vehicles_By_Type)
+{
+    Fleet fleet;
+    EXPECT_EQ(fleet.add<CarColumns>(), (VehicleRef{TransportKind::Car, 0}));
+    EXPECT_EQ(fleet.add<ShipColumns>(), (VehicleRef{TransportKind::Ship, 0}));
+    EXPECT_EQ(fleet.add<CarColumns>(), (VehicleRef{TransportKind::Car, 1}));
+    EXPECT_EQ(fleet.size(), 3u);
+    EXPECT_EQ(fleet.of<CarColumns>().maxLoadCapacity(1), Car().maxLoadCapacity());
+    EXPECT_EQ(fleet.of<ShipColumns>().maxLoadCapacity(0), Ship().maxLoadCapacity());
+}
+
+TEST(Fleet, Bulk_Delivery_Matches_Virtual_Transport)
+{
+    Fleet fleet;
+    Car car;
+    Ship ship;
+    fleet.add<CarColumns>();
+    fleet.add<ShipColumns>();
+
+    // Includes an overweight load for the car
+    const int loads[] = {100, 600, 100, 100, 100, 100, 100};
+    for (int load : loads)
+    {
+        car.performDelivery(load);
+        ship.performDelivery(load);
+        fleet.performDelivery(load);
+
+        EXPECT_EQ(fleet.of<CarColumns>().needsMaintenance(0), car.needsMaintenance());
+        EXPECT_EQ(fleet.of<ShipColumns>().needsMaintenance(0), ship.needsMaintenance());
+    }
+
+    car.performMaintenance();
+    ship.performMaintenance();
+    fleet.performMaintenance();
+    EXPECT_EQ(fleet.of<CarColumns>().needsMaintenance(0), car.needsMaintenance());
+    EXPECT_EQ(fleet.of<ShipColumns>().needsMaintenance(0), ship.needsMaintenance());
+}
+
+TEST(Fleet, Routed_Delivery_Matches_Virtual_Transport)
+{
+    Fleet fleet;
+    Car car;
+    Ship ship;
+    fleet.add<CarColumns>();
+    fleet.add<ShipColumns>();
+
+    const int distancesKm[] = {30, 45, 20, 650};
+    for (int km : distancesKm)
+    {
+        car.performDelivery(100, km);
+        ship.performDelivery(100, km);
+        fleet.performDelivery(100, km);
+
+        EXPECT_EQ(fleet.of<CarColumns>().needsMaintenance(0), car.needsMaintenance());
+        EXPECT_EQ(fleet.of<ShipColumns>().needsMaintenance(0), ship.needsMaintenance());
+    }
+    EXPECT_EQ(fleet.of<CarColumns>().distanceDriven(0), 30 + 45 + 20 + 650);
+    EXPECT_EQ(fleet.of<ShipColumns>().tripsDone(0), 4);
+}
+
+TEST(Fleet, Lists_Vehicles_Needing_Maintenance)
+{
+    Fleet fleet;
+    for (int i = 0; i < 3; ++i)
+    {
+        fleet.add<CarColumns>();
+        fleet.add<ShipColumns>();
+    }
+
+    // Three deliveries: every car passes 100 km, no ship reaches 5 trips
+    for (int i = 0; i < 3; ++i)
+    {
+        fleet.performDelivery(100);
+    }
+
+    const std::vector<VehicleRef> expected = {
+        {TransportKind::Car, 0}, {TransportKind::Car, 1}, {TransportKind::Car, 2}};
+    EXPECT_EQ(fleet.needingMaintenance(), expected);
+}
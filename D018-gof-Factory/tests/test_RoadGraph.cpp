@@ -0,0 +1,343 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Car.h"
+#include "RoadGraph.h"
+#include "RouteQuery.h"
+
+namespace
+{
+    // Streets on a rows x cols grid around Munich: mostly two-way, some one-way, some missing
+    RoadGraph makeGrid(int rows, int cols, bool contract, unsigned seed = 7)
+    {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<double> detour(1.0, 1.6);
+        std::uniform_int_distribution<int> layout(0, 9);
+
+        std::vector<GeoPoint> nodes;
+        for (int row = 0; row < rows; ++row)
+        {
+            for (int col = 0; col < cols; ++col)
+            {
+                nodes.push_back(GeoPoint{48.0 + row * 0.01, 11.0 + col * 0.015});
+            }
+        }
+
+        std::vector<RoadEdge> edges;
+        auto street = [&](int a, int b)
+        {
+            const int kind = layout(random);
+            if (kind == 0)
+            {
+                return; // no street here
+            }
+            // Blocks are about 1.1 km apart; streets wind a little
+            const double metres = 1200.0 * detour(random);
+            edges.push_back(RoadEdge{static_cast<NodeId>(a), static_cast<NodeId>(b), static_cast<std::uint32_t>(metres)});
+            if (kind > 1)
+            {
+                edges.push_back(RoadEdge{static_cast<NodeId>(b), static_cast<NodeId>(a), static_cast<std::uint32_t>(metres)});
+            }
+        };
+        for (int row = 0; row < rows; ++row)
+        {
+            for (int col = 0; col < cols; ++col)
+            {
+                const int node = row * cols + col;
+                if (col + 1 < cols)
+                {
+                    street(node, node + 1);
+                }
+                if (row + 1 < rows)
+                {
+                    street(node, node + cols);
+                }
+            }
+        }
+        return RoadGraph::build(NetworkKind::Road, nodes, edges, contract);
+    }
+
+    // Plain Dijkstra over the graph's edges
+    std::uint32_t dijkstra(const RoadGraph &graph, NodeId from, NodeId to)
+    {
+        const CsrView edges = graph.edges();
+        std::vector<std::uint64_t> metres(graph.nodeCount(), UINT64_MAX);
+        using Entry = std::pair<std::uint64_t, NodeId>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        metres[from] = 0;
+        queue.emplace(0, from);
+        while (!queue.empty())
+        {
+            const auto [distance, node] = queue.top();
+            queue.pop();
+            if (node == to)
+            {
+                return static_cast<std::uint32_t>(distance);
+            }
+            if (distance != metres[node])
+            {
+                continue;
+            }
+            for (std::uint32_t edge = edges.begin(node); edge < edges.end(node); ++edge)
+            {
+                const std::uint64_t next = distance + edges.metres[edge];
+                if (next < metres[edges.targets[edge]])
+                {
+                    metres[edges.targets[edge]] = next;
+                    queue.emplace(next, edges.targets[edge]);
+                }
+            }
+        }
+        return UNREACHABLE;
+    }
+
+    // Length of a node path along real edges, UNREACHABLE if two nodes are not connected
+    std::uint32_t pathMetres(const RoadGraph &graph, const std::vector<NodeId> &path)
+    {
+        const CsrView edges = graph.edges();
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i + 1 < path.size(); ++i)
+        {
+            std::uint32_t shortest = UNREACHABLE;
+            for (std::uint32_t edge = edges.begin(path[i]); edge < edges.end(path[i]); ++edge)
+            {
+                if (edges.targets[edge] == path[i + 1])
+                {
+                    shortest = std::min(shortest, edges.metres[edge]);
+                }
+            }
+            if (shortest == UNREACHABLE)
+            {
+                return UNREACHABLE;
+            }
+            total += shortest;
+        }
+        return static_cast<std::uint32_t>(total);
+    }
+
+    std::vector<RouteRequest> randomRequests(const RoadGraph &graph, std::size_t count, unsigned seed)
+    {
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<NodeId> node(0, static_cast<NodeId>(graph.nodeCount() - 1));
+        std::vector<RouteRequest> requests;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            requests.push_back(RouteRequest{node(random), node(random)});
+        }
+        return requests;
+    }
+}
+
+TEST(RoadGraph, Stores_Edges_In_Csr_And_Never_Below_Straight_Line)
+{
+    const std::vector<GeoPoint> nodes = {{48.0, 11.0}, {48.01, 11.0}, {48.0, 11.01}};
+    const std::vector<RoadEdge> edges = {{0, 1, 2000}, {0, 2, 1}, {2, 0, 900}};
+    const RoadGraph graph = RoadGraph::build(NetworkKind::Road, nodes, edges, false);
+
+    ASSERT_EQ(graph.nodeCount(), 3u);
+    ASSERT_EQ(graph.edgeCount(), 3u);
+    EXPECT_FALSE(graph.hasHierarchy());
+    EXPECT_FALSE(graph.isMapped());
+
+    const CsrView csr = graph.edges();
+    EXPECT_EQ(csr.end(0) - csr.begin(0), 2u);
+    EXPECT_EQ(csr.end(1) - csr.begin(1), 0u);
+    EXPECT_EQ(csr.targets[csr.begin(2)], 0u);
+    EXPECT_EQ(csr.metres[csr.begin(0)], 2000u);
+
+    // 0.01 degrees of longitude at 48 N is about 744 m
+    const double straight = graph.straightLineMetres(0, 2);
+    EXPECT_NEAR(straight, 744.0, 2.0);
+    EXPECT_GE(csr.metres[csr.begin(0) + 1], straight);
+    EXPECT_EQ(csr.metres[csr.begin(2)], 900u);
+
+    EXPECT_EQ(graph.nearest(GeoPoint{48.009, 11.001}), 1u);
+    EXPECT_THROW(RoadGraph::build(NetworkKind::Road, nodes, {{0, 3, 10}}), std::invalid_argument);
+}
+
+TEST(RouteQuery, AStar_Matches_Dijkstra)
+{
+    const RoadGraph graph = makeGrid(30, 30, false);
+    RouteQuery query(graph);
+    std::vector<NodeId> path;
+    for (const RouteRequest &request : randomRequests(graph, 200, 1))
+    {
+        const std::uint32_t expected = dijkstra(graph, request.from, request.to);
+        ASSERT_EQ(query.aStar(request.from, request.to, &path), expected);
+        if (expected != UNREACHABLE)
+        {
+            ASSERT_EQ(path.front(), request.from);
+            ASSERT_EQ(path.back(), request.to);
+            ASSERT_EQ(pathMetres(graph, path), expected);
+        }
+        else
+        {
+            ASSERT_TRUE(path.empty());
+        }
+    }
+    EXPECT_THROW(query.hierarchy(0, 1), std::logic_error);
+}
+
+TEST(RouteQuery, Hierarchy_Matches_Dijkstra_And_Unpacks_Real_Paths)
+{
+    const RoadGraph graph = makeGrid(30, 30, true);
+    ASSERT_TRUE(graph.hasHierarchy());
+
+    RouteQuery query(graph);
+    std::vector<NodeId> path;
+    std::size_t unreachable = 0;
+    for (const RouteRequest &request : randomRequests(graph, 300, 2))
+    {
+        const std::uint32_t expected = dijkstra(graph, request.from, request.to);
+        ASSERT_EQ(query.hierarchy(request.from, request.to, &path), expected) << request.from << " -> " << request.to;
+        ASSERT_EQ(query.aStar(request.from, request.to), expected);
+        if (expected == UNREACHABLE)
+        {
+            ++unreachable;
+            ASSERT_TRUE(path.empty());
+            continue;
+        }
+        ASSERT_EQ(path.front(), request.from);
+        ASSERT_EQ(path.back(), request.to);
+        ASSERT_EQ(pathMetres(graph, path), expected);
+    }
+
+    EXPECT_EQ(query.route(5, 5), 0u);
+    EXPECT_LT(unreachable, 300u);
+}
+
+TEST(RouteQuery, Hierarchy_Settles_Fewer_Nodes_Than_AStar)
+{
+    const RoadGraph graph = makeGrid(60, 60, true);
+    RouteQuery query(graph);
+    std::size_t aStarSettled = 0;
+    std::size_t hierarchySettled = 0;
+    for (const RouteRequest &request : randomRequests(graph, 100, 3))
+    {
+        query.aStar(request.from, request.to);
+        aStarSettled += query.settled();
+        query.hierarchy(request.from, request.to);
+        hierarchySettled += query.settled();
+    }
+    EXPECT_LT(hierarchySettled * 2, aStarSettled);
+}
+
+TEST(RoadGraph, Saved_File_Is_Mapped_And_Routes_The_Same)
+{
+    const std::string path = testing::TempDir() + "road_graph_test.ttr";
+    const RoadGraph built = makeGrid(20, 20, true);
+    built.save(path);
+
+    RoadGraph mapped = RoadGraph::open(path);
+    EXPECT_TRUE(mapped.isMapped());
+    EXPECT_EQ(mapped.kind(), NetworkKind::Road);
+    EXPECT_EQ(mapped.nodeCount(), built.nodeCount());
+    EXPECT_EQ(mapped.edgeCount(), built.edgeCount());
+    EXPECT_DOUBLE_EQ(mapped.position(17).lon, built.position(17).lon);
+
+    RouteQuery fromMemory(built);
+    RouteQuery fromFile(mapped);
+    for (const RouteRequest &request : randomRequests(built, 100, 4))
+    {
+        ASSERT_EQ(fromFile.route(request.from, request.to), fromMemory.route(request.from, request.to));
+    }
+
+    // Moving keeps the mapping alive
+    RoadGraph moved = std::move(mapped);
+    EXPECT_TRUE(moved.isMapped());
+    EXPECT_EQ(RouteQuery(moved).route(0, 399), fromMemory.route(0, 399));
+    std::remove(path.c_str());
+}
+
+TEST(RoadGraph, Open_Rejects_Missing_And_Damaged_Files)
+{
+    const std::string path = testing::TempDir() + "road_graph_damaged.ttr";
+    EXPECT_THROW(RoadGraph::open(path + ".missing"), std::runtime_error);
+
+    makeGrid(5, 5, true).save(path);
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // Cut short
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+    EXPECT_THROW(RoadGraph::open(path), std::runtime_error);
+
+    // Wrong magic
+    bytes[0] = 'X';
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    EXPECT_THROW(RoadGraph::open(path), std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(RoadGraph, Open_Rejects_Arrays_Pointing_Outside_The_Graph)
+{
+    const std::string path = testing::TempDir() + "road_graph_corrupt.ttr";
+    makeGrid(5, 5, true).save(path);
+    std::string saved;
+    {
+        std::ifstream in(path, std::ios::binary);
+        saved.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    // File header: magic, eight u32 fields and the total size, then a u64 offset per section
+    constexpr std::size_t SECTION_OFFSETS = 48;
+    enum Section { EdgeOffsets = 2, EdgeTargets = 3, UpMiddles = 8 };
+    auto sectionAt = [&saved](Section section)
+    {
+        std::uint64_t offset = 0;
+        std::memcpy(&offset, saved.data() + SECTION_OFFSETS + section * 8, sizeof(offset));
+        return static_cast<std::size_t>(offset);
+    };
+    auto openWith = [&](std::size_t at, auto value)
+    {
+        std::string bytes = saved;
+        std::memcpy(&bytes[at], &value, sizeof(value));
+        std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        return RoadGraph::open(path);
+    };
+
+    EXPECT_NO_THROW(openWith(0, saved[0]));
+    EXPECT_THROW(openWith(sectionAt(EdgeTargets), std::uint32_t{25}), std::runtime_error);     // node 25 of 25
+    EXPECT_THROW(openWith(sectionAt(EdgeOffsets) + 4 * 3, std::uint32_t{1000}), std::runtime_error); // row runs backwards
+    EXPECT_THROW(openWith(sectionAt(UpMiddles), std::uint32_t{24}), std::runtime_error);       // middle above the row
+    EXPECT_THROW(openWith(SECTION_OFFSETS, std::uint64_t{UINT64_MAX - 7}), std::runtime_error); // offset + size wraps
+    std::remove(path.c_str());
+}
+
+TEST(RouteQuery, Parallel_Batch_Matches_One_Thread)
+{
+    const RoadGraph graph = makeGrid(40, 40, true);
+    const std::vector<RouteRequest> requests = randomRequests(graph, 1000, 5);
+
+    std::vector<std::uint32_t> parallel;
+    routeDistances(graph, requests, parallel, 4);
+    ASSERT_EQ(parallel.size(), requests.size());
+
+    RouteQuery query(graph);
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        ASSERT_EQ(parallel[i], query.route(requests[i].from, requests[i].to));
+    }
+}
+
+TEST(Transport, Car_Delivery_Distance_Comes_From_Route)
+{
+    Car car;
+    car.performDelivery(100, 60);
+    EXPECT_FALSE(car.needsMaintenance());
+    car.performDelivery(100, 60); // 120 km driven
+    EXPECT_TRUE(car.needsMaintenance());
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <set>
+#include <vector>
+#include "ObjectPool.h"
+#include "TransportFactory.h"
+
+TEST(ObjectPool, Slots_Are_Cache_Line_Aligned_And_Reused)
+{
+    ObjectPool<Car> pool(4);
+    Car *first = pool.acquire();
+    Car *second = pool.acquire();
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) % 64, 0u);
+    EXPECT_GE(reinterpret_cast<std::uintptr_t>(second) - reinterpret_cast<std::uintptr_t>(first), 64u);
+    EXPECT_EQ(pool.live(), 2u);
+
+    pool.release(first);
+    EXPECT_EQ(pool.acquire(), first);
+    pool.release(first);
+    pool.release(second);
+    EXPECT_EQ(pool.live(), 0u);
+}
+
+TEST(ObjectPool, Grows_By_Whole_Slabs)
+{
+    ObjectPool<Ship> pool(8);
+    std::vector<Ship *> ships;
+    for (int i = 0; i < 20; ++i)
+    {
+        ships.push_back(pool.acquire());
+    }
+    EXPECT_EQ(pool.capacity(), 24u);
+    EXPECT_EQ(std::set<Ship *>(ships.begin(), ships.end()).size(), 20u);
+
+    for (Ship *ship : ships)
+    {
+        pool.release(ship);
+    }
+}
+
+TEST(TransportFactory, Handles_Return_Vehicles_To_The_Pool)
+{
+    TransportFactory factory(16);
+    {
+        TransportHandle car = factory.createCar();
+        TransportHandle ship = factory.create(TransportKind::Ship);
+        EXPECT_EQ(car->type(), "CAR");
+        EXPECT_EQ(ship->type(), "SHIP");
+        EXPECT_EQ(factory.live(), 2u);
+    }
+    EXPECT_EQ(factory.live(), 0u);
+}
+
+TEST(TransportFactory, Recycled_Vehicles_Start_Fresh)
+{
+    TransportFactory factory(1);
+    Transport *address = nullptr;
+    {
+        TransportHandle car = factory.createCar();
+        address = car.get();
+        for (int i = 0; i < 3; ++i)
+        {
+            car->performDelivery(100);
+        }
+        EXPECT_TRUE(car->needsMaintenance());
+    }
+
+    TransportHandle again = factory.createCar();
+    EXPECT_EQ(again.get(), address);
+    EXPECT_FALSE(again->needsMaintenance());
+}
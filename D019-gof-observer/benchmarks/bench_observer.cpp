@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "event_bus.h"
+#include "telemetry.h"
+#include "typed_event_bus.h"
+
+// Subscribers touch the data so the work cannot be optimised away
+
+class StringSink : public IObserver
+{
+public:
+    void Update(const std::string &message_from_subject) override
+    {
+        benchmark::DoNotOptimize(message_from_subject.data());
+    }
+};
+
+class TypedSink : public ITypedObserver<GnssFix>
+{
+public:
+    void Update(const Payload<GnssFix> &sample) override
+    {
+        benchmark::DoNotOptimize(sample->latitude);
+    }
+};
+
+constexpr std::size_t BATCH = 1024;
+
+// Format every sample into a string, then dispatch the string
+static void BM_StringPath(benchmark::State &state)
+{
+    EventBus bus;
+    std::vector<StringSink> sinks(static_cast<std::size_t>(state.range(0)));
+    for (StringSink &sink : sinks)
+    {
+        bus.Attach(&sink);
+    }
+
+    std::string message;
+    GnssFix fix{0, 1, 9, 1.3521, 103.8198};
+    for (auto _ : state)
+    {
+        for (std::size_t i = 0; i < BATCH; ++i)
+        {
+            fix.timestamp_ns = i;
+            message.clear();
+            FormatTo(message, fix);
+            bus.Publish(message);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+// Fill a shared batch buffer, then dispatch each sample by reference
+static void BM_TypedPath(benchmark::State &state)
+{
+    TypedEventBus<GnssFix> bus;
+    std::vector<TypedSink> sinks(static_cast<std::size_t>(state.range(0)));
+    for (TypedSink &sink : sinks)
+    {
+        bus.Attach(&sink);
+    }
+
+    for (auto _ : state)
+    {
+        PayloadBuffer<GnssFix> batch(BATCH);
+        for (std::size_t i = 0; i < BATCH; ++i)
+        {
+            batch[i] = GnssFix{i, 1, 9, 1.3521, 103.8198};
+            bus.Publish(batch.at(i));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+BENCHMARK(BM_StringPath)->Arg(1)->Arg(8)->Arg(32);
+BENCHMARK(BM_TypedPath)->Arg(1)->Arg(8)->Arg(32);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include "observer.h"
+#include "subscriber_list.h"
+
+/**
+ * Thread-safe publisher for IObserver subscribers.
+ *
+ * Unlike Subject, any number of threads may Publish() at once while others
+ * Attach() and Detach(). Publishing takes no lock, does not print and passes
+ * the caller's message by reference instead of copying it.
+ */
+class EventBus
+{
+public:
+    bool Attach(IObserver *observer); // false if already attached
+    bool Detach(IObserver *observer); // false if not attached
+
+    // Deliver message to every attached observer on the calling thread.
+    // Any number of calls may run at once, also nested from Update(); past
+    // SubscriberList::MAX_READERS of them, detached observers' lists are only
+    // freed once the extra calls have returned.
+    void Publish(const std::string &message) const;
+
+    // Wait for in-flight Publish() calls, after which detached observers may be deleted
+    void Synchronize();
+
+    std::size_t ObserverCount() const;
+
+private:
+    SubscriberList<IObserver> observers_;
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <string>
+
+// Subscriber Interface
+class IObserver
+{
+public:
+    virtual ~IObserver() {};
+    virtual void Update(const std::string &message_from_subject) = 0;
+};
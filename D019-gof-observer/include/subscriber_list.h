@@ -0,0 +1,229 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Subscriber list that many threads can walk while others attach and detach.
+ *
+ * Readers (forEach) never lock: they walk an immutable snapshot of the list,
+ * protected by a hazard pointer so it cannot be freed under them. There are
+ * MAX_READERS hazard slots; a forEach that finds them all taken (more
+ * concurrent or nested forEach calls than that) pins through a shared
+ * overflow count instead, which stays lock free but keeps writers from
+ * freeing any retired snapshot until the overflowing readers are done.
+ * Writers (attach/detach) copy the list, swap the new snapshot in and retire
+ * the old one; a retired snapshot is deleted once no hazard pointer holds it.
+ * Writers serialize on a mutex, which is fine because they are rare.
+ */
+template <typename T>
+class SubscriberList
+{
+public:
+    // Concurrent forEach calls with a slot of their own; more still work, see above
+    static constexpr std::size_t MAX_READERS = 64;
+
+    SubscriberList() : current_(new Snapshot{}) {}
+
+    ~SubscriberList()
+    {
+        // No reader may still be running when the list is destroyed
+        delete current_.load();
+        for (const Snapshot *snapshot : retired_)
+        {
+            delete snapshot;
+        }
+    }
+
+    SubscriberList(const SubscriberList &) = delete;
+    SubscriberList &operator=(const SubscriberList &) = delete;
+
+    // Add a subscriber, false if it was already attached
+    bool attach(T *subscriber)
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        const Snapshot *old = current_.load(std::memory_order_relaxed);
+        if (std::find(old->items.begin(), old->items.end(), subscriber) != old->items.end())
+        {
+            return false;
+        }
+
+        Snapshot *next = new Snapshot{old->items};
+        next->items.push_back(subscriber);
+        replace(next);
+        return true;
+    }
+
+    // Remove a subscriber, false if it was not attached.
+    // Dispatches already in flight may still reach it, see synchronize().
+    bool detach(T *subscriber)
+    {
+        std::lock_guard<std::mutex> lock(writer_mutex_);
+        const Snapshot *old = current_.load(std::memory_order_relaxed);
+        auto found = std::find(old->items.begin(), old->items.end(), subscriber);
+        if (found == old->items.end())
+        {
+            return false;
+        }
+
+        Snapshot *next = new Snapshot{old->items};
+        next->items.erase(next->items.begin() + (found - old->items.begin()));
+        replace(next);
+        return true;
+    }
+
+    // Wait until every forEach that started before this call has finished.
+    // After detach() + synchronize() a subscriber can be safely deleted.
+    // Must not be called from inside a forEach callback.
+    void synchronize()
+    {
+        std::unique_lock<std::mutex> lock(writer_mutex_);
+        while (!retired_.empty())
+        {
+            reclaim();
+            if (!retired_.empty())
+            {
+                lock.unlock();
+                std::this_thread::yield();
+                lock.lock();
+            }
+        }
+    }
+
+    // Call fn(subscriber) for each subscriber in the current snapshot, lock free
+    template <typename Fn>
+    void forEach(Fn &&fn) const
+    {
+        HazardGuard guard(*this);
+        for (T *subscriber : guard.snapshot->items)
+        {
+            fn(subscriber);
+        }
+    }
+
+    std::size_t size() const
+    {
+        HazardGuard guard(*this);
+        return guard.snapshot->items.size();
+    }
+
+private:
+    // Immutable once published
+    struct Snapshot
+    {
+        std::vector<T *> items;
+    };
+
+    // One cache line per reader so publishers on different cores do not share lines
+    struct alignas(64) HazardSlot
+    {
+        std::atomic<bool> busy{false};
+        std::atomic<const Snapshot *> snapshot{nullptr};
+    };
+
+    // Claims a hazard slot, or counts as an overflow reader, and pins the current snapshot for one forEach
+    struct HazardGuard
+    {
+        explicit HazardGuard(const SubscriberList &list) : list(list), slot(list.claimSlot())
+        {
+            if (!slot)
+            {
+                // Pins every snapshot: reclaim() sees the count or we see its replacement
+                list.overflow_readers_.fetch_add(1, std::memory_order_seq_cst);
+                snapshot = list.current_.load(std::memory_order_seq_cst);
+                return;
+            }
+            snapshot = list.current_.load(std::memory_order_acquire);
+            for (;;)
+            {
+                slot->snapshot.store(snapshot, std::memory_order_seq_cst);
+                const Snapshot *again = list.current_.load(std::memory_order_seq_cst);
+                if (again == snapshot)
+                {
+                    break;
+                }
+                snapshot = again;
+            }
+        }
+
+        ~HazardGuard()
+        {
+            if (!slot)
+            {
+                list.overflow_readers_.fetch_sub(1, std::memory_order_release);
+                return;
+            }
+            slot->snapshot.store(nullptr, std::memory_order_release);
+            slot->busy.store(false, std::memory_order_release);
+        }
+
+        const SubscriberList &list;
+        HazardSlot *slot;
+        const Snapshot *snapshot;
+    };
+
+    // A free slot after one sweep over all of them, nullptr if every slot is busy
+    HazardSlot *claimSlot() const
+    {
+        // Start from a per-thread position so threads rarely collide
+        static thread_local const std::size_t start = std::hash<std::thread::id>{}(std::this_thread::get_id()) % MAX_READERS;
+        for (std::size_t n = 0; n < MAX_READERS; ++n)
+        {
+            HazardSlot &slot = slots_[(start + n) % MAX_READERS];
+            if (!slot.busy.load(std::memory_order_relaxed) && !slot.busy.exchange(true, std::memory_order_acquire))
+            {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    // Publish next and retire the previous snapshot. Caller holds writer_mutex_.
+    void replace(const Snapshot *next)
+    {
+        const Snapshot *old = current_.exchange(next, std::memory_order_seq_cst);
+        retired_.push_back(old);
+        reclaim();
+    }
+
+    // Delete retired snapshots no reader is pinning. Caller holds writer_mutex_.
+    void reclaim()
+    {
+        if (overflow_readers_.load(std::memory_order_seq_cst) != 0)
+        {
+            return; // an overflow reader may hold any of them
+        }
+        auto pinned = [this](const Snapshot *snapshot)
+        {
+            for (const HazardSlot &slot : slots_)
+            {
+                if (slot.snapshot.load(std::memory_order_seq_cst) == snapshot)
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        auto keep = std::remove_if(retired_.begin(), retired_.end(), [&](const Snapshot *snapshot)
+                                   {
+                                       if (pinned(snapshot))
+                                       {
+                                           return false;
+                                       }
+                                       delete snapshot;
+                                       return true; });
+        retired_.erase(keep, retired_.end());
+    }
+
+    std::atomic<const Snapshot *> current_;
+    mutable HazardSlot slots_[MAX_READERS];
+    mutable std::atomic<std::size_t> overflow_readers_{0};
+    std::mutex writer_mutex_;
+    std::vector<const Snapshot *> retired_;
+};
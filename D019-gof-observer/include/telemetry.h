@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/**
+ * Fixed-layout telemetry samples passed by reference through TypedEventBus.
+ * Plain data only, so every subscriber reads the very same bytes.
+ */
+struct GnssFix
+{
+    std::uint64_t timestamp_ns; // sample time
+    std::uint32_t vehicle_id;   // which vehicle
+    std::uint32_t satellites;   // satellites in view
+    double latitude;            // degrees
+    double longitude;           // degrees
+};
+
+struct EngineSample
+{
+    std::uint64_t timestamp_ns; // sample time
+    std::uint32_t vehicle_id;   // which vehicle
+    float rpm;                  // revolutions per minute
+    float coolant_c;            // coolant temperature, Celsius
+    float fuel_rate_lph;        // litres per hour
+    float load_pct;             // engine load, percent
+};
+
+static_assert(std::is_trivially_copyable<GnssFix>::value, "GnssFix must stay plain data");
+static_assert(std::is_trivially_copyable<EngineSample>::value, "EngineSample must stay plain data");
+
+// Text form used by the string (IObserver) path, appended to out
+void FormatTo(std::string &out, const GnssFix &fix);
+void FormatTo(std::string &out, const EngineSample &sample);
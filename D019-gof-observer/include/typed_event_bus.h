@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "observer.h"
+#include "subscriber_list.h"
+
+/**
+ * Reference-counted, read-only sample. Subscribers read the bytes in place
+ * and may keep a copy of the handle to hold on to the sample after Update.
+ */
+template <typename T>
+using Payload = std::shared_ptr<const T>;
+
+template <typename T, typename... Args>
+Payload<T> MakePayload(Args &&...args)
+{
+    return std::make_shared<const T>(T{std::forward<Args>(args)...});
+}
+
+/**
+ * One shared allocation holding many samples. at(i) hands out a Payload that
+ * points into the buffer and shares its reference count, so publishing a
+ * whole batch costs a single allocation.
+ */
+template <typename T>
+class PayloadBuffer
+{
+public:
+    explicit PayloadBuffer(std::size_t count) : samples_(std::make_shared<std::vector<T>>(count)) {}
+
+    T &operator[](std::size_t index) { return (*samples_)[index]; }
+    std::size_t size() const { return samples_->size(); }
+
+    // Aliasing handle: same control block as the buffer, no allocation
+    Payload<T> at(std::size_t index) const
+    {
+        return Payload<T>(samples_, &(*samples_)[index]);
+    }
+
+private:
+    std::shared_ptr<std::vector<T>> samples_;
+};
+
+// Typed subscriber interface, receives the shared sample by reference
+template <typename T>
+class ITypedObserver
+{
+public:
+    virtual ~ITypedObserver() {};
+    virtual void Update(const Payload<T> &sample) = 0;
+};
+
+/**
+ * EventBus for fixed-layout samples: same lock-free dispatch, but the sample
+ * is never formatted, copied or serialized on the way to subscribers.
+ */
+template <typename T>
+class TypedEventBus
+{
+public:
+    bool Attach(ITypedObserver<T> *observer) { return observers_.attach(observer); }
+    bool Detach(ITypedObserver<T> *observer) { return observers_.detach(observer); }
+
+    // Same concurrency limits as EventBus::Publish()
+    void Publish(const Payload<T> &sample) const
+    {
+        observers_.forEach([&sample](ITypedObserver<T> *observer)
+                           { observer->Update(sample); });
+    }
+
+    void Synchronize() { observers_.synchronize(); }
+    std::size_t ObserverCount() const { return observers_.size(); }
+
+private:
+    SubscriberList<ITypedObserver<T>> observers_;
+};
+
+/**
+ * Adapter that lets an existing string IObserver subscribe to a TypedEventBus.
+ * The sample is formatted with FormatTo() into a per-thread buffer that is
+ * reused between messages.
+ */
+template <typename T>
+class StringObserverAdapter : public ITypedObserver<T>
+{
+public:
+    explicit StringObserverAdapter(IObserver &observer) : observer_(observer) {}
+
+    void Update(const Payload<T> &sample) override
+    {
+        thread_local std::string message;
+        message.clear();
+        FormatTo(message, *sample);
+        observer_.Update(message);
+    }
+
+private:
+    IObserver &observer_;
+};
@@ -0,0 +1,27 @@
+#include "event_bus.h"
+
+bool EventBus::Attach(IObserver *observer)
+{
+    return observers_.attach(observer);
+}
+
+bool EventBus::Detach(IObserver *observer)
+{
+    return observers_.detach(observer);
+}
+
+void EventBus::Publish(const std::string &message) const
+{
+    observers_.forEach([&message](IObserver *observer)
+                       { observer->Update(message); });
+}
+
+void EventBus::Synchronize()
+{
+    observers_.synchronize();
+}
+
+std::size_t EventBus::ObserverCount() const
+{
+    return observers_.size();
+}
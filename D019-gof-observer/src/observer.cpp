@@ -1,14 +1,9 @@
 #include <iostream>
 #include <list>
 #include <string>
-
-// Subscriber Interface
-class IObserver
-{
-public:
-    virtual ~IObserver() {};
-    virtual void Update(const std::string &message_from_subject) = 0;
-};
+#include "observer.h"
+#include "telemetry.h"
+#include "typed_event_bus.h"
 
 // Publisher Interface
 class ISubject
@@ -130,6 +125,13 @@ void clientCode()
 
     subject->createMessage("Hello world");
 
+    // Typed path: the string observer still works through the adapter
+    TypedEventBus<GnssFix> gnss_bus;
+    StringObserverAdapter<GnssFix> adapter(*observer1);
+    gnss_bus.Attach(&adapter);
+    gnss_bus.Publish(MakePayload<GnssFix>(GnssFix{0, 1, 9, 1.3521, 103.8198}));
+    gnss_bus.Detach(&adapter);
+
     observer1->RemoveMeFromTheList();
     observer2->RemoveMeFromTheList();
     observer3->RemoveMeFromTheList();
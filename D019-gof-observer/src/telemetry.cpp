@@ -0,0 +1,45 @@
+#include "telemetry.h"
+#include <cinttypes>
+#include <cstdarg>
+#include <cstdio>
+
+namespace
+{
+    // printf into the end of out; lines that outgrow the stack buffer are formatted again at full size
+    void AppendFormatted(std::string &out, const char *format, ...)
+    {
+        char buffer[128];
+        std::va_list args;
+        va_start(args, format);
+        std::va_list retry;
+        va_copy(retry, args);
+        const int length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+
+        if (length >= 0 && static_cast<std::size_t>(length) < sizeof(buffer))
+        {
+            out.append(buffer, static_cast<std::size_t>(length));
+        }
+        else if (length >= 0)
+        {
+            const std::size_t start = out.size();
+            out.resize(start + static_cast<std::size_t>(length) + 1); // vsnprintf writes the terminator too
+            std::vsnprintf(&out[start], static_cast<std::size_t>(length) + 1, format, retry);
+            out.resize(start + static_cast<std::size_t>(length));
+        }
+        va_end(retry);
+    }
+}
+
+void FormatTo(std::string &out, const GnssFix &fix)
+{
+    AppendFormatted(out, "GNSS vehicle=%" PRIu32 " t=%" PRIu64 " lat=%.7f lon=%.7f sats=%" PRIu32,
+                    fix.vehicle_id, fix.timestamp_ns, fix.latitude, fix.longitude, fix.satellites);
+}
+
+void FormatTo(std::string &out, const EngineSample &sample)
+{
+    AppendFormatted(out, "ENGINE vehicle=%" PRIu32 " t=%" PRIu64 " rpm=%.1f coolant=%.1f fuel=%.2f load=%.1f",
+                    sample.vehicle_id, sample.timestamp_ns, sample.rpm, sample.coolant_c, sample.fuel_rate_lph,
+                    sample.load_pct);
+}
@@ -0,0 +1,208 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "event_bus.h"
+
+// Counts deliveries, safe to call from many threads
+class CountingObserver : public IObserver
+{
+public:
+    void Update(const std::string &message_from_subject) override
+    {
+        last_size_.store(message_from_subject.size(), std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    long count() const { return count_.load(); }
+    std::size_t lastSize() const { return last_size_.load(); }
+
+private:
+    std::atomic<long> count_{0};
+    std::atomic<std::size_t> last_size_{0};
+};
+
+// Detaches itself the first time it is notified
+class SelfDetachingObserver : public IObserver
+{
+public:
+    explicit SelfDetachingObserver(EventBus &bus) : bus_(bus) {}
+
+    void Update(const std::string &) override
+    {
+        ++count_;
+        bus_.Detach(this);
+    }
+
+    int count_ = 0;
+
+private:
+    EventBus &bus_;
+};
+
+TEST(EventBus, Attach_Detach_And_Publish)
+{
+    EventBus bus;
+    CountingObserver first;
+    CountingObserver second;
+
+    EXPECT_TRUE(bus.Attach(&first));
+    EXPECT_TRUE(bus.Attach(&second));
+    EXPECT_FALSE(bus.Attach(&first));
+    EXPECT_EQ(bus.ObserverCount(), 2u);
+
+    bus.Publish("Hello world");
+    EXPECT_EQ(first.count(), 1);
+    EXPECT_EQ(second.count(), 1);
+    EXPECT_EQ(first.lastSize(), 11u);
+
+    EXPECT_TRUE(bus.Detach(&first));
+    EXPECT_FALSE(bus.Detach(&first));
+    bus.Publish("again");
+    EXPECT_EQ(first.count(), 1);
+    EXPECT_EQ(second.count(), 2);
+}
+
+TEST(EventBus, Observer_Can_Detach_During_Dispatch)
+{
+    EventBus bus;
+    SelfDetachingObserver once(bus);
+    CountingObserver always;
+    bus.Attach(&once);
+    bus.Attach(&always);
+
+    bus.Publish("first");
+    bus.Publish("second");
+
+    EXPECT_EQ(once.count_, 1);
+    EXPECT_EQ(always.count(), 2);
+    EXPECT_EQ(bus.ObserverCount(), 1u);
+}
+
+TEST(EventBus, Concurrent_Publishers_With_Churning_Subscribers)
+{
+    constexpr int PUBLISHERS = 4;
+    constexpr int MESSAGES = 20000;
+
+    EventBus bus;
+    CountingObserver stable;
+    bus.Attach(&stable);
+
+    std::atomic<bool> done{false};
+    std::thread churn([&]
+                      {
+        // Observers come and go while publishers are running
+        while (!done.load())
+        {
+            CountingObserver transient;
+            bus.Attach(&transient);
+            bus.Detach(&transient);
+            bus.Synchronize();
+        } });
+
+    std::vector<std::thread> publishers;
+    for (int p = 0; p < PUBLISHERS; ++p)
+    {
+        publishers.emplace_back([&bus]
+                                {
+            const std::string message = "telemetry sample";
+            for (int i = 0; i < MESSAGES; ++i)
+            {
+                bus.Publish(message);
+            } });
+    }
+
+    for (std::thread &publisher : publishers)
+    {
+        publisher.join();
+    }
+    done.store(true);
+    churn.join();
+
+    // The observer attached for the whole run sees every message exactly once
+    EXPECT_EQ(stable.count(), static_cast<long>(PUBLISHERS) * MESSAGES);
+    EXPECT_EQ(bus.ObserverCount(), 1u);
+}
+
+// Publishes again from inside Update until `depth` dispatches are nested
+class RepublishingObserver : public IObserver
+{
+public:
+    RepublishingObserver(EventBus &bus, int depth) : bus_(bus), depth_(depth) {}
+
+    void Update(const std::string &message) override
+    {
+        if (++count_ < depth_)
+        {
+            bus_.Publish(message);
+        }
+    }
+
+    int count_ = 0;
+
+private:
+    EventBus &bus_;
+    int depth_;
+};
+
+TEST(EventBus, Publish_Nested_Deeper_Than_The_Hazard_Slots)
+{
+    constexpr int DEPTH = static_cast<int>(SubscriberList<IObserver>::MAX_READERS) * 2;
+
+    EventBus bus;
+    RepublishingObserver nested(bus, DEPTH);
+    bus.Attach(&nested);
+    bus.Publish("deep");
+
+    EXPECT_EQ(nested.count_, DEPTH);
+}
+
+TEST(EventBus, More_Publishers_Inside_At_Once_Than_Hazard_Slots)
+{
+    constexpr int PUBLISHERS = static_cast<int>(SubscriberList<IObserver>::MAX_READERS) + 36;
+
+    // Holds every publisher inside Update until all of them got there
+    class GateObserver : public IObserver
+    {
+    public:
+        void Update(const std::string &) override
+        {
+            inside_.fetch_add(1);
+            while (inside_.load() < PUBLISHERS)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        std::atomic<int> inside_{0};
+    };
+
+    EventBus bus;
+    GateObserver gate;
+    CountingObserver counter;
+    bus.Attach(&gate);
+    bus.Attach(&counter);
+
+    std::vector<std::thread> publishers;
+    for (int p = 0; p < PUBLISHERS; ++p)
+    {
+        publishers.emplace_back([&bus]
+                                { bus.Publish("at once"); });
+    }
+
+    // Observers still come and go while every slot is taken
+    CountingObserver transient;
+    bus.Attach(&transient);
+    bus.Detach(&transient);
+
+    for (std::thread &publisher : publishers)
+    {
+        publisher.join();
+    }
+    bus.Synchronize();
+
+    EXPECT_EQ(counter.count(), PUBLISHERS);
+    EXPECT_EQ(bus.ObserverCount(), 2u);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "telemetry.h"
+#include "typed_event_bus.h"
+
+// Remembers the address of every sample it was handed
+class RecordingObserver : public ITypedObserver<GnssFix>
+{
+public:
+    void Update(const Payload<GnssFix> &sample) override
+    {
+        seen.push_back(sample.get());
+        kept = sample;
+    }
+
+    std::vector<const GnssFix *> seen;
+    Payload<GnssFix> kept;
+};
+
+class StringRecorder : public IObserver
+{
+public:
+    void Update(const std::string &message_from_subject) override
+    {
+        messages.push_back(message_from_subject);
+    }
+
+    std::vector<std::string> messages;
+};
+
+TEST(TypedEventBus, Subscribers_Share_The_Same_Bytes)
+{
+    TypedEventBus<GnssFix> bus;
+    RecordingObserver first;
+    RecordingObserver second;
+    bus.Attach(&first);
+    bus.Attach(&second);
+
+    Payload<GnssFix> fix = MakePayload<GnssFix>(GnssFix{100, 7, 9, 1.5, 103.5});
+    bus.Publish(fix);
+
+    ASSERT_EQ(first.seen.size(), 1u);
+    ASSERT_EQ(second.seen.size(), 1u);
+    EXPECT_EQ(first.seen[0], fix.get());
+    EXPECT_EQ(second.seen[0], fix.get());
+
+    // Both subscribers kept a handle, no copy of the sample was made
+    EXPECT_EQ(fix.use_count(), 3);
+}
+
+TEST(TypedEventBus, Batch_Payloads_Point_Into_One_Buffer)
+{
+    PayloadBuffer<EngineSample> batch(4);
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        batch[i].vehicle_id = static_cast<std::uint32_t>(i);
+        batch[i].rpm = 800.0f + 100.0f * static_cast<float>(i);
+    }
+
+    Payload<EngineSample> third = batch.at(2);
+    EXPECT_EQ(third->vehicle_id, 2u);
+    EXPECT_FLOAT_EQ(third->rpm, 1000.0f);
+    EXPECT_EQ(third.get() + 1, batch.at(3).get());
+}
+
+TEST(StringObserverAdapter, Existing_String_Observer_Receives_Formatted_Sample)
+{
+    TypedEventBus<GnssFix> bus;
+    StringRecorder recorder;
+    StringObserverAdapter<GnssFix> adapter(recorder);
+    bus.Attach(&adapter);
+
+    bus.Publish(MakePayload<GnssFix>(GnssFix{42, 3, 8, 1.3521, 103.8198}));
+
+    ASSERT_EQ(recorder.messages.size(), 1u);
+    EXPECT_EQ(recorder.messages[0], "GNSS vehicle=3 t=42 lat=1.3521000 lon=103.8198000 sats=8");
+}
+
+TEST(StringObserverAdapter, Huge_Values_Are_Formatted_In_Full)
+{
+    std::string text = "prefix ";
+    FormatTo(text, GnssFix{42, 3, 8, 1e300, -1e300});
+
+    EXPECT_EQ(text.rfind("prefix GNSS vehicle=3 t=42 lat=1", 0), 0u);
+    EXPECT_GT(text.size(), 600u);
+    EXPECT_EQ(text.substr(text.size() - 7), " sats=8");
+}
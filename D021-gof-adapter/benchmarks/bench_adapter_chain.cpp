@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <string>
+#include "adapter.h"
+#include "adapter_chain.h"
+
+// Same translation both ways: "Adapter Translated << " + reversed text + "\n"
+
+// Current path: Target::Request() through a virtual call, a new std::string per step
+static void BM_TargetAdapter(benchmark::State &state)
+{
+    Adaptee adaptee;
+    Adapter adapter(&adaptee);
+    const Target *target = &adapter;
+    for (auto _ : state)
+    {
+        std::string out = target->Request();
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Chain path: two stages into the chain's buffers, a view back
+static void BM_AdapterChain(benchmark::State &state)
+{
+    Adaptee adaptee;
+    ChainAdapter adapted(adaptee, MakeAdapterChain<128>(Reverse{}, Wrap{"Adapter Translated << ", "\n"}));
+    for (auto _ : state)
+    {
+        std::string_view out = adapted.Request();
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Legacy frame clean-up written the std::string way: one new string per step
+static void BM_StringSteps4(benchmark::State &state)
+{
+    const std::string frame = "  $PLEG,speed=42;heading=270;fuel=61  \r\n";
+    for (auto _ : state)
+    {
+        std::string text = frame;
+        text.erase(0, text.find_first_not_of(" \t\r\n"));
+        text.erase(text.find_last_not_of(" \t\r\n") + 1);
+        std::string body = text.substr(6);
+        std::transform(body.begin(), body.end(), body.begin(), [](char c)
+                       { return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c; });
+        std::string out = "{" + body + "}";
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// The same four steps as one chain: two of them are views, two write once each
+static void BM_AdapterChain4(benchmark::State &state)
+{
+    const std::string frame = "  $PLEG,speed=42;heading=270;fuel=61  \r\n";
+    auto chain = MakeAdapterChain<128>(Trim{}, StripPrefix{"$PLEG,"}, ToUpper{}, Wrap{"{", "}"});
+    for (auto _ : state)
+    {
+        std::string_view out = chain(frame);
+        benchmark::DoNotOptimize(out.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_TargetAdapter);
+BENCHMARK(BM_AdapterChain);
+BENCHMARK(BM_StringSteps4);
+BENCHMARK(BM_AdapterChain4);
+
+BENCHMARK_MAIN();
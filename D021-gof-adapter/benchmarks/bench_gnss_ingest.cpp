@@ -0,0 +1,143 @@
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "gnss_ingest.h"
+
+namespace
+{
+    // A recorded device log: GGA, RMC and JSON lines for a vehicle driving around
+    std::string MakeLog(std::size_t lines)
+    {
+        std::string log;
+        char line[160];
+        for (std::size_t i = 0; i < lines; ++i)
+        {
+            const double minutes = 7.038 + static_cast<double>(i % 5000) * 1e-3;
+            const unsigned second = static_cast<unsigned>(i % 60);
+            int size = 0;
+            switch (i % 3)
+            {
+            case 0:
+                size = std::snprintf(line, sizeof(line), "$GPGGA,1235%02u.00,48%07.4f,N,011%07.4f,E,1,08,0.9,545.4,M,46.9,M,,",
+                                     second, minutes, minutes);
+                break;
+            case 1:
+                size = std::snprintf(line, sizeof(line), "$GPRMC,1235%02u.00,A,48%07.4f,N,011%07.4f,E,022.4,084.4,230394,003.1,W",
+                                     second, minutes, minutes);
+                break;
+            default:
+                size = std::snprintf(line, sizeof(line), R"({"vehicle":%zu,"timestamp":%zu,"latitude":%.7f,"longitude":%.7f})",
+                                     i % 1000, i * 100, 48.0 + minutes / 60.0, 11.0 + minutes / 60.0);
+                break;
+            }
+            log.append(line, static_cast<std::size_t>(size));
+            if (line[0] == '$')
+            {
+                std::snprintf(line, sizeof(line), "*%02X", XorBytes(log.data() + log.size() - size + 1, log.data() + log.size()));
+                log += line;
+            }
+            log += '\n';
+        }
+        return log;
+    }
+
+    const std::string &Log()
+    {
+        static const std::string log = MakeLog(300000);
+        return log;
+    }
+
+    // The string-at-a-time way: getline, split into std::strings, std::stod
+    double NaiveParse(const std::string &log)
+    {
+        std::istringstream in(log);
+        std::string line;
+        double sum = 0.0;
+        while (std::getline(in, line))
+        {
+            if (line.empty())
+            {
+                continue;
+            }
+            if (line[0] == '$')
+            {
+                std::vector<std::string> fields;
+                std::stringstream split(line.substr(1, line.find('*') - 1));
+                std::string field;
+                while (std::getline(split, field, ','))
+                {
+                    fields.push_back(field);
+                }
+                const bool gga = fields[0].compare(2, 3, "GGA") == 0;
+                const double raw = std::stod(fields[gga ? 2 : 3]);
+                sum += static_cast<int>(raw / 100) + (raw - static_cast<int>(raw / 100) * 100) / 60.0;
+            }
+            else
+            {
+                const std::size_t key = line.find("\"latitude\":");
+                sum += std::stod(line.substr(key + 11));
+            }
+        }
+        return sum;
+    }
+}
+
+static void BM_NaiveParse(benchmark::State &state)
+{
+    const std::string &log = Log();
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(NaiveParse(log));
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * log.size()));
+}
+
+// Whole log through the adapter, fed in chunks of state.range(0) bytes as if read from a file
+static void BM_IngestAdapter(benchmark::State &state)
+{
+    const std::string &log = Log();
+    const std::size_t chunk = static_cast<std::size_t>(state.range(0));
+    std::size_t fixes = 0;
+    for (auto _ : state)
+    {
+        GnssIngestAdapter adapter;
+        double sum = 0.0;
+        for (std::size_t at = 0; at < log.size(); at += chunk)
+        {
+            fixes += adapter.Feed(std::string_view(log).substr(at, chunk), [&](const GnssFix &fix)
+                                  { sum += fix.latitude; });
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * log.size()));
+    state.SetItemsProcessed(static_cast<std::int64_t>(fixes));
+}
+
+// Delimiter scan alone: every newline in the log
+static void BM_FindNewlines(benchmark::State &state)
+{
+    const std::string &log = Log();
+    for (auto _ : state)
+    {
+        std::size_t lines = 0;
+        const char *cursor = log.data();
+        const char *const end = cursor + log.size();
+        while ((cursor = FindByte(cursor, end, '\n')) != end)
+        {
+            ++lines;
+            ++cursor;
+        }
+        benchmark::DoNotOptimize(lines);
+    }
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * log.size()));
+}
+
+BENCHMARK(BM_NaiveParse)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_IngestAdapter)->Arg(4096)->Arg(65536)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_FindNewlines)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
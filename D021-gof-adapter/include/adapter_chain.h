@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include "adapter.h"
+
+/**
+ * Adapters composed at compile time into one pipeline.
+ *
+ * A stage is any type with
+ *
+ *     std::size_t MaxSize(std::size_t inputSize) const;                  // bound on its output
+ *     std::string_view operator()(std::string_view input, char *out) const;
+ *
+ * and returns either a slice of its input (zero-copy: Trim, StripPrefix) or
+ * the bytes it wrote to out (Reverse, Wrap, ...). AdapterChain owns two
+ * Capacity-byte buffers and alternates between them, always writing to the
+ * one the current input does not live in. The stages are stored by value
+ * and called directly, so a chain of any length costs no virtual calls and
+ * no heap allocations.
+ *
+ * The view returned by a chain stays valid until the chain runs again.
+ */
+
+// Reverse the bytes, the translation Adapter::Request() does
+struct Reverse
+{
+    std::size_t MaxSize(std::size_t inputSize) const { return inputSize; }
+
+    std::string_view operator()(std::string_view input, char *out) const
+    {
+        std::reverse_copy(input.begin(), input.end(), out);
+        return std::string_view(out, input.size());
+    }
+};
+
+// prefix + input + suffix
+struct Wrap
+{
+    std::string_view prefix;
+    std::string_view suffix;
+
+    std::size_t MaxSize(std::size_t inputSize) const { return prefix.size() + inputSize + suffix.size(); }
+
+    std::string_view operator()(std::string_view input, char *out) const
+    {
+        char *cursor = std::copy(prefix.begin(), prefix.end(), out);
+        cursor = std::copy(input.begin(), input.end(), cursor);
+        cursor = std::copy(suffix.begin(), suffix.end(), cursor);
+        return std::string_view(out, static_cast<std::size_t>(cursor - out));
+    }
+};
+
+// ASCII upper case
+struct ToUpper
+{
+    std::size_t MaxSize(std::size_t inputSize) const { return inputSize; }
+
+    std::string_view operator()(std::string_view input, char *out) const
+    {
+        std::transform(input.begin(), input.end(), out, [](char c)
+                       { return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c; });
+        return std::string_view(out, input.size());
+    }
+};
+
+// Zero-copy: drop leading and trailing spaces, tabs and line ends
+struct Trim
+{
+    std::size_t MaxSize(std::size_t) const { return 0; }
+
+    std::string_view operator()(std::string_view input, char *) const
+    {
+        const std::size_t first = input.find_first_not_of(" \t\r\n");
+        if (first == std::string_view::npos)
+        {
+            return input.substr(0, 0);
+        }
+        return input.substr(first, input.find_last_not_of(" \t\r\n") - first + 1);
+    }
+};
+
+// Zero-copy: drop a protocol header such as "$PLEG," when present
+struct StripPrefix
+{
+    std::string_view prefix;
+
+    std::size_t MaxSize(std::size_t) const { return 0; }
+
+    std::string_view operator()(std::string_view input, char *) const
+    {
+        if (input.substr(0, prefix.size()) == prefix)
+        {
+            input.remove_prefix(prefix.size());
+        }
+        return input;
+    }
+};
+
+template <std::size_t Capacity, typename... Stages>
+class AdapterChain
+{
+public:
+    static constexpr std::size_t CAPACITY = Capacity;
+    static constexpr std::size_t STAGES = sizeof...(Stages);
+
+    explicit AdapterChain(Stages... stages) : stages_(std::move(stages)...) {}
+
+    // Throws std::length_error if a stage could outgrow Capacity (a sizing bug, not bad input)
+    std::string_view operator()(std::string_view input)
+    {
+        return Run<0>(input);
+    }
+
+    // A longer chain with next appended; this one is left as it was
+    template <typename Next>
+    AdapterChain<Capacity, Stages..., Next> Then(Next next) const
+    {
+        return std::apply([&next](const Stages &...stages)
+                          { return AdapterChain<Capacity, Stages..., Next>(stages..., std::move(next)); },
+                          stages_);
+    }
+
+private:
+    template <std::size_t I>
+    std::string_view Run(std::string_view input)
+    {
+        if constexpr (I == STAGES)
+        {
+            return input;
+        }
+        else
+        {
+            const auto &stage = std::get<I>(stages_);
+            if (stage.MaxSize(input.size()) > Capacity)
+            {
+                throw std::length_error("AdapterChain: stage output exceeds the buffer capacity");
+            }
+            // Never write into the buffer the input is being read from
+            char *out = Holds(buffers_[0], input) ? buffers_[1].data() : buffers_[0].data();
+            return Run<I + 1>(stage(input, out));
+        }
+    }
+
+    static bool Holds(const std::array<char, Capacity> &buffer, std::string_view view)
+    {
+        return !view.empty() && view.data() >= buffer.data() && view.data() < buffer.data() + Capacity;
+    }
+
+    std::tuple<Stages...> stages_;
+    std::array<char, Capacity> buffers_[2];
+};
+
+// AdapterChain<Capacity, Stages...> with the stage types deduced
+template <std::size_t Capacity, typename... Stages>
+AdapterChain<Capacity, Stages...> MakeAdapterChain(Stages... stages)
+{
+    return AdapterChain<Capacity, Stages...>(std::move(stages)...);
+}
+
+/**
+ * Object adapter over an Adaptee, like Adapter, but Request() hands back a
+ * view into the chain's buffer instead of a new std::string.
+ */
+template <typename Chain>
+class ChainAdapter
+{
+public:
+    ChainAdapter(const Adaptee &adaptee, Chain chain) : adaptee_(adaptee), chain_(std::move(chain)) {}
+
+    std::string_view Request() { return chain_(adaptee_.SpecificRequestView()); }
+
+private:
+    const Adaptee &adaptee_;
+    Chain chain_;
+};
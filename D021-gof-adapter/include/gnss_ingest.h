@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * Adapter from recorded device logs to GNSS fixes.
+ *
+ * The Adaptees here are text formats: NMEA 0183 $--GGA / $--RMC sentences
+ * and flat JSON location records, one record per line, mixed freely. The
+ * Target is a GnssFix handed to a sink, carrying the same latitude and
+ * longitude (degrees) that gnss::GNSS works with.
+ *
+ * Lines and NMEA fields are found with SSE2 delimiter scans over
+ * std::string_view slices of the input. Nothing is copied or allocated per
+ * record; only a line split across two Feed() calls is carried over, in a
+ * fixed buffer inside the adapter.
+ */
+
+enum class FixSource : std::uint8_t
+{
+    Gga,
+    Rmc,
+    Json
+};
+
+struct GnssFix
+{
+    std::uint64_t timestamp_ms; // JSON "timestamp", or ms since midnight UTC for NMEA
+    std::uint32_t vehicle_id;   // JSON "vehicle", 0 for NMEA
+    double latitude;            // degrees, south negative
+    double longitude;           // degrees, west negative
+    float speed_knots;          // RMC only, else 0
+    float course_deg;           // RMC only, else 0
+    std::uint8_t satellites;    // GGA only, else 0
+    FixSource source;
+};
+
+// Delimiter scans, SSE2 when available
+const char *FindByte(const char *begin, const char *end, char byte); // end if absent
+std::size_t SplitFields(std::string_view text, char delimiter, std::string_view *fields, std::size_t maxFields);
+std::uint8_t XorBytes(const char *begin, const char *end); // NMEA checksum
+
+class GnssIngestAdapter
+{
+public:
+    static constexpr std::size_t MAX_LINE = 512; // longer lines are dropped as rejected
+
+    enum class LineResult
+    {
+        Fix,      // fix written
+        NoFix,    // well formed, but the receiver had no fix (GGA quality 0, RMC status V)
+        Ignored,  // blank line or a sentence type we do not translate
+        Rejected  // malformed, bad checksum or too long
+    };
+
+    struct Stats
+    {
+        std::uint64_t fixes = 0;
+        std::uint64_t no_fix = 0;
+        std::uint64_t ignored = 0;
+        std::uint64_t rejected = 0;
+    };
+
+    // Parse a chunk of the stream, calling sink(const GnssFix &) per fix; returns the fixes found.
+    // A trailing partial line waits for the next chunk.
+    template <typename Sink>
+    std::size_t Feed(std::string_view chunk, Sink &&sink);
+
+    // End of stream: parse a last line that had no newline
+    template <typename Sink>
+    std::size_t Finish(Sink &&sink);
+
+    // One complete line, without its newline ('\r' is fine); updates Stats
+    LineResult ParseLine(std::string_view line, GnssFix &fix);
+
+    const Stats &GetStats() const { return stats_; }
+
+private:
+    template <typename Sink>
+    std::size_t Emit(std::string_view line, Sink &sink)
+    {
+        GnssFix fix;
+        if (ParseLine(line, fix) == LineResult::Fix)
+        {
+            sink(static_cast<const GnssFix &>(fix));
+            return 1;
+        }
+        return 0;
+    }
+
+    LineResult ParseNmea(std::string_view line, GnssFix &fix);
+    LineResult ParseJson(std::string_view line, GnssFix &fix);
+    void Carry(const char *begin, const char *end);
+
+    char carry_[MAX_LINE];
+    std::size_t carry_size_ = 0;
+    bool discarding_ = false; // inside a line that outgrew carry_
+    Stats stats_;
+};
+
+template <typename Sink>
+std::size_t GnssIngestAdapter::Feed(std::string_view chunk, Sink &&sink)
+{
+    const char *cursor = chunk.data();
+    const char *const end = cursor + chunk.size();
+    std::size_t fixes = 0;
+
+    // Finish the line the previous chunk ended in
+    if (carry_size_ > 0 || discarding_)
+    {
+        const char *newline = FindByte(cursor, end, '\n');
+        if (newline == end)
+        {
+            Carry(cursor, end);
+            return 0;
+        }
+        Carry(cursor, newline);
+        if (discarding_)
+        {
+            discarding_ = false;
+            ++stats_.rejected;
+        }
+        else
+        {
+            fixes += Emit(std::string_view(carry_, carry_size_), sink);
+        }
+        carry_size_ = 0;
+        cursor = newline + 1;
+    }
+
+    while (cursor < end)
+    {
+        const char *newline = FindByte(cursor, end, '\n');
+        if (newline == end)
+        {
+            Carry(cursor, end);
+            break;
+        }
+        fixes += Emit(std::string_view(cursor, static_cast<std::size_t>(newline - cursor)), sink);
+        cursor = newline + 1;
+    }
+    return fixes;
+}
+
+template <typename Sink>
+std::size_t GnssIngestAdapter::Finish(Sink &&sink)
+{
+    std::size_t fixes = 0;
+    if (discarding_)
+    {
+        ++stats_.rejected;
+    }
+    else if (carry_size_ > 0)
+    {
+        fixes = Emit(std::string_view(carry_, carry_size_), sink);
+    }
+    carry_size_ = 0;
+    discarding_ = false;
+    return fixes;
+}
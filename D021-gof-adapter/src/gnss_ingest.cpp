@@ -0,0 +1,554 @@
+#include "gnss_ingest.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GNSS_INGEST_SSE2 1
+#endif
+
+namespace
+{
+    constexpr std::size_t MAX_NMEA_FIELDS = 24;
+
+    using LineResult = GnssIngestAdapter::LineResult;
+
+    constexpr double POWERS_OF_TEN[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    bool ParseDouble(std::string_view text, double &out)
+    {
+        // Fast path for plain decimals (Clinger): a mantissa below 2^53 and a power of
+        // ten up to 1e22 are both exact doubles, so one division is correctly rounded
+        // and gives the same bits as from_chars
+        const char *p = text.data();
+        const char *const end = p + text.size();
+        const bool negative = p < end && *p == '-';
+        p += negative;
+
+        std::uint64_t mantissa = 0;
+        int digits = 0;
+        int fraction = -1; // digits after '.', -1 until one is seen
+        for (; p < end; ++p)
+        {
+            const unsigned digit = static_cast<unsigned>(*p - '0');
+            if (digit < 10)
+            {
+                mantissa = mantissa * 10 + digit;
+                ++digits;
+                fraction += fraction >= 0;
+            }
+            else if (*p == '.' && fraction < 0)
+            {
+                fraction = 0;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        if (p == end && digits > 0 && digits <= 15 && fraction != 0)
+        {
+            const double value = static_cast<double>(mantissa) / POWERS_OF_TEN[fraction > 0 ? fraction : 0];
+            out = negative ? -value : value;
+            return true;
+        }
+
+        // Exponents, long mantissas and anything odd go through the full parser
+        const auto [parsed, error] = std::from_chars(text.data(), end, out);
+        return error == std::errc() && parsed == end;
+    }
+
+    template <typename Int>
+    bool ParseUnsigned(std::string_view text, Int &out)
+    {
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), out);
+        return error == std::errc() && end == text.data() + text.size();
+    }
+
+    int HexDigit(char c)
+    {
+        if (c >= '0' && c <= '9')
+        {
+            return c - '0';
+        }
+        if (c >= 'A' && c <= 'F')
+        {
+            return c - 'A' + 10;
+        }
+        if (c >= 'a' && c <= 'f')
+        {
+            return c - 'a' + 10;
+        }
+        return -1;
+    }
+
+    // hhmmss[.sss] -> ms since midnight
+    bool ParseTime(std::string_view text, std::uint64_t &ms)
+    {
+        ms = 0;
+        if (text.empty())
+        {
+            return true;
+        }
+        if (text.size() < 6)
+        {
+            return false;
+        }
+        int digits[6];
+        for (int i = 0; i < 6; ++i)
+        {
+            digits[i] = text[i] - '0';
+            if (digits[i] < 0 || digits[i] > 9)
+            {
+                return false;
+            }
+        }
+        ms = (digits[0] * 10 + digits[1]) * 3600000ull + (digits[2] * 10 + digits[3]) * 60000ull +
+             (digits[4] * 10 + digits[5]) * 1000ull;
+
+        if (text.size() > 7 && text[6] == '.')
+        {
+            // Up to three fraction digits are milliseconds
+            std::uint64_t scale = 100;
+            for (std::size_t i = 7; i < text.size() && scale > 0; ++i, scale /= 10)
+            {
+                const int digit = text[i] - '0';
+                if (digit < 0 || digit > 9)
+                {
+                    return false;
+                }
+                ms += static_cast<std::uint64_t>(digit) * scale;
+            }
+        }
+        return true;
+    }
+
+    // NMEA (d)ddmm.mmmm plus hemisphere -> signed degrees
+    bool ParseCoordinate(std::string_view value, std::string_view hemisphere, char positive, char negative,
+                         double limit, double &degrees)
+    {
+        // from_chars also takes nan, inf and exponents; keep raw in range before the integer cast
+        double raw;
+        if (hemisphere.size() != 1 || !ParseDouble(value, raw) || !std::isfinite(raw) || raw < 0.0 ||
+            raw >= limit * 100.0 + 60.0)
+        {
+            return false;
+        }
+        const double whole = static_cast<double>(static_cast<std::uint32_t>(raw / 100.0));
+        const double minutes = raw - whole * 100.0;
+        degrees = whole + minutes / 60.0;
+        if (minutes >= 60.0 || degrees > limit)
+        {
+            return false;
+        }
+        if (hemisphere[0] == negative)
+        {
+            degrees = -degrees;
+        }
+        else if (hemisphere[0] != positive)
+        {
+            return false;
+        }
+        return true;
+    }
+
+    std::string_view SkipSpace(std::string_view text)
+    {
+        std::size_t i = 0;
+        while (i < text.size() && (text[i] == ' ' || text[i] == '\t'))
+        {
+            ++i;
+        }
+        return text.substr(i);
+    }
+
+    // Past the closing quote of a string whose opening quote is already consumed; npos if unterminated
+    std::size_t StringEnd(std::string_view text)
+    {
+        const char *const begin = text.data();
+        const char *const end = begin + text.size();
+        const char *cursor = begin;
+        while (true)
+        {
+            const char *quote = FindByte(cursor, end, '"');
+            if (quote == end)
+            {
+                return std::string_view::npos;
+            }
+            // Escaped if preceded by an odd run of backslashes
+            std::size_t backslashes = 0;
+            while (quote - backslashes > begin && quote[-1 - static_cast<std::ptrdiff_t>(backslashes)] == '\\')
+            {
+                ++backslashes;
+            }
+            if (backslashes % 2 == 0)
+            {
+                return static_cast<std::size_t>(quote - begin) + 1;
+            }
+            cursor = quote + 1;
+        }
+    }
+}
+
+const char *FindByte(const char *begin, const char *end, char byte)
+{
+#ifdef GNSS_INGEST_SSE2
+    const __m128i needle = _mm_set1_epi8(byte);
+    while (end - begin >= 16)
+    {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+        const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+        if (mask != 0)
+        {
+            return begin + __builtin_ctz(static_cast<unsigned>(mask));
+        }
+        begin += 16;
+    }
+#endif
+    const void *found = std::memchr(begin, byte, static_cast<std::size_t>(end - begin));
+    return found ? static_cast<const char *>(found) : end;
+}
+
+std::size_t SplitFields(std::string_view text, char delimiter, std::string_view *fields, std::size_t maxFields)
+{
+    if (maxFields == 0)
+    {
+        return 0;
+    }
+    const char *const data = text.data();
+    const std::size_t size = text.size();
+    std::size_t count = 0;
+    std::size_t start = 0;
+
+    // Every delimiter closes a field; stop early once the array is full
+    auto close = [&](std::size_t at)
+    {
+        fields[count++] = std::string_view(data + start, at - start);
+        start = at + 1;
+        return count < maxFields;
+    };
+
+    std::size_t i = 0;
+#ifdef GNSS_INGEST_SSE2
+    const __m128i needle = _mm_set1_epi8(delimiter);
+    for (; i + 16 <= size; i += 16)
+    {
+        unsigned mask = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i)), needle)));
+        while (mask != 0)
+        {
+            if (!close(i + static_cast<std::size_t>(__builtin_ctz(mask))))
+            {
+                return count;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i < size; ++i)
+    {
+        if (data[i] == delimiter && !close(i))
+        {
+            return count;
+        }
+    }
+    fields[count++] = std::string_view(data + start, size - start);
+    return count;
+}
+
+std::uint8_t XorBytes(const char *begin, const char *end)
+{
+    std::uint8_t sum = 0;
+#ifdef GNSS_INGEST_SSE2
+    if (end - begin >= 16)
+    {
+        __m128i acc = _mm_setzero_si128();
+        while (end - begin >= 16)
+        {
+            acc = _mm_xor_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin)));
+            begin += 16;
+        }
+        alignas(16) std::uint8_t lanes[16];
+        _mm_store_si128(reinterpret_cast<__m128i *>(lanes), acc);
+        for (std::uint8_t lane : lanes)
+        {
+            sum ^= lane;
+        }
+    }
+#endif
+    for (; begin < end; ++begin)
+    {
+        sum ^= static_cast<std::uint8_t>(*begin);
+    }
+    return sum;
+}
+
+void GnssIngestAdapter::Carry(const char *begin, const char *end)
+{
+    const std::size_t size = static_cast<std::size_t>(end - begin);
+    if (discarding_ || carry_size_ + size > MAX_LINE)
+    {
+        discarding_ = true;
+        carry_size_ = 0;
+        return;
+    }
+    std::memcpy(carry_ + carry_size_, begin, size);
+    carry_size_ += size;
+}
+
+GnssIngestAdapter::LineResult GnssIngestAdapter::ParseLine(std::string_view line, GnssFix &fix)
+{
+    LineResult result = LineResult::Rejected;
+
+    if (!line.empty() && line.back() == '\r')
+    {
+        line.remove_suffix(1);
+    }
+    fix = GnssFix{};
+
+    if (line.size() > MAX_LINE)
+    {
+        result = LineResult::Rejected;
+    }
+    else if (line.empty())
+    {
+        result = LineResult::Ignored;
+    }
+    else if (line[0] == '$')
+    {
+        result = ParseNmea(line, fix);
+    }
+    else if (line[0] == '{')
+    {
+        result = ParseJson(line, fix);
+    }
+
+    switch (result)
+    {
+    case LineResult::Fix:
+        ++stats_.fixes;
+        break;
+    case LineResult::NoFix:
+        ++stats_.no_fix;
+        break;
+    case LineResult::Ignored:
+        ++stats_.ignored;
+        break;
+    case LineResult::Rejected:
+        ++stats_.rejected;
+        break;
+    }
+    return result;
+}
+
+GnssIngestAdapter::LineResult GnssIngestAdapter::ParseNmea(std::string_view line, GnssFix &fix)
+{
+    // $<body>*HH
+    if (line.size() < 4 || line[line.size() - 3] != '*')
+    {
+        return LineResult::Rejected;
+    }
+    const int high = HexDigit(line[line.size() - 2]);
+    const int low = HexDigit(line[line.size() - 1]);
+    const std::string_view body = line.substr(1, line.size() - 4);
+    if (high < 0 || low < 0 || XorBytes(body.data(), body.data() + body.size()) != (high << 4 | low))
+    {
+        return LineResult::Rejected;
+    }
+
+    std::string_view fields[MAX_NMEA_FIELDS];
+    const std::size_t count = SplitFields(body, ',', fields, MAX_NMEA_FIELDS);
+    const std::string_view type = fields[0];
+    if (type.size() != 5)
+    {
+        return LineResult::Rejected;
+    }
+    const std::string_view formatter = type.substr(2); // any talker: GP, GN, GL, ...
+
+    if (formatter == "GGA")
+    {
+        // time, lat, N/S, lon, E/W, quality, satellites, ...
+        if (count < 8)
+        {
+            return LineResult::Rejected;
+        }
+        unsigned quality = 0;
+        if (!ParseUnsigned(fields[6], quality) || !ParseTime(fields[1], fix.timestamp_ms))
+        {
+            return LineResult::Rejected;
+        }
+        if (quality == 0 || fields[2].empty())
+        {
+            return LineResult::NoFix;
+        }
+        unsigned satellites = 0;
+        if ((!fields[7].empty() && !ParseUnsigned(fields[7], satellites)) ||
+            !ParseCoordinate(fields[2], fields[3], 'N', 'S', 90.0, fix.latitude) ||
+            !ParseCoordinate(fields[4], fields[5], 'E', 'W', 180.0, fix.longitude))
+        {
+            return LineResult::Rejected;
+        }
+        fix.satellites = static_cast<std::uint8_t>(satellites > 255 ? 255 : satellites);
+        fix.source = FixSource::Gga;
+        return LineResult::Fix;
+    }
+
+    if (formatter == "RMC")
+    {
+        // time, status, lat, N/S, lon, E/W, speed (knots), course, date, ...
+        if (count < 9 || fields[2].size() != 1)
+        {
+            return LineResult::Rejected;
+        }
+        if (!ParseTime(fields[1], fix.timestamp_ms))
+        {
+            return LineResult::Rejected;
+        }
+        if (fields[2][0] != 'A')
+        {
+            return LineResult::NoFix;
+        }
+        double speed = 0.0;
+        double course = 0.0;
+        if (!ParseCoordinate(fields[3], fields[4], 'N', 'S', 90.0, fix.latitude) ||
+            !ParseCoordinate(fields[5], fields[6], 'E', 'W', 180.0, fix.longitude) ||
+            (!fields[7].empty() && !ParseDouble(fields[7], speed)) ||
+            (!fields[8].empty() && !ParseDouble(fields[8], course)))
+        {
+            return LineResult::Rejected;
+        }
+        fix.speed_knots = static_cast<float>(speed);
+        fix.course_deg = static_cast<float>(course);
+        fix.source = FixSource::Rmc;
+        return LineResult::Fix;
+    }
+
+    return LineResult::Ignored;
+}
+
+GnssIngestAdapter::LineResult GnssIngestAdapter::ParseJson(std::string_view line, GnssFix &fix)
+{
+    // Flat object of scalars: {"vehicle":7,"timestamp":1000,"latitude":1.35,"longitude":103.8}
+    std::string_view rest = SkipSpace(line.substr(1));
+    bool haveLatitude = false;
+    bool haveLongitude = false;
+
+    if (!rest.empty() && rest[0] == '}')
+    {
+        return LineResult::Rejected;
+    }
+
+    while (true)
+    {
+        if (rest.empty() || rest[0] != '"')
+        {
+            return LineResult::Rejected;
+        }
+        const std::size_t keyEnd = StringEnd(rest.substr(1));
+        if (keyEnd == std::string_view::npos)
+        {
+            return LineResult::Rejected;
+        }
+        const std::string_view key = rest.substr(1, keyEnd - 1);
+        rest = SkipSpace(rest.substr(1 + keyEnd));
+        if (rest.empty() || rest[0] != ':')
+        {
+            return LineResult::Rejected;
+        }
+        rest = SkipSpace(rest.substr(1));
+        if (rest.empty())
+        {
+            return LineResult::Rejected;
+        }
+
+        std::string_view value;
+        if (rest[0] == '"')
+        {
+            const std::size_t valueEnd = StringEnd(rest.substr(1));
+            if (valueEnd == std::string_view::npos)
+            {
+                return LineResult::Rejected;
+            }
+            value = rest.substr(0, 1 + valueEnd);
+            rest = rest.substr(1 + valueEnd);
+        }
+        else
+        {
+            // Scalar up to the next ',' or '}'
+            const char *const end = rest.data() + rest.size();
+            const char *comma = FindByte(rest.data(), end, ',');
+            const char *brace = FindByte(rest.data(), comma, '}');
+            const std::size_t size = static_cast<std::size_t>(brace - rest.data());
+            value = rest.substr(0, size);
+            while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+            {
+                value.remove_suffix(1);
+            }
+            if (value.empty() || value[0] == '{' || value[0] == '[')
+            {
+                return LineResult::Rejected; // nested values are not location records
+            }
+            rest = rest.substr(size);
+        }
+
+        if (key == "latitude")
+        {
+            haveLatitude = ParseDouble(value, fix.latitude) && fix.latitude >= -90.0 && fix.latitude <= 90.0;
+            if (!haveLatitude)
+            {
+                return LineResult::Rejected;
+            }
+        }
+        else if (key == "longitude")
+        {
+            haveLongitude = ParseDouble(value, fix.longitude) && fix.longitude >= -180.0 && fix.longitude <= 180.0;
+            if (!haveLongitude)
+            {
+                return LineResult::Rejected;
+            }
+        }
+        else if (key == "vehicle")
+        {
+            if (!ParseUnsigned(value, fix.vehicle_id))
+            {
+                return LineResult::Rejected;
+            }
+        }
+        else if (key == "timestamp")
+        {
+            if (!ParseUnsigned(value, fix.timestamp_ms))
+            {
+                return LineResult::Rejected;
+            }
+        }
+
+        rest = SkipSpace(rest);
+        if (rest.empty())
+        {
+            return LineResult::Rejected;
+        }
+        if (rest[0] == '}')
+        {
+            if (!SkipSpace(rest.substr(1)).empty())
+            {
+                return LineResult::Rejected;
+            }
+            break;
+        }
+        if (rest[0] != ',')
+        {
+            return LineResult::Rejected;
+        }
+        rest = SkipSpace(rest.substr(1));
+    }
+
+    if (!haveLatitude || !haveLongitude)
+    {
+        return LineResult::Rejected;
+    }
+    fix.source = FixSource::Json;
+    return LineResult::Fix;
+}
@@ -1,10 +1,27 @@
 #include <iostream>
+#include <string_view>
+#include "gnss_ingest.h"
 
 void clientCode();
 
+// A few lines of a recorded device log, translated into fixes
+void ingestCode()
+{
+    constexpr std::string_view log =
+        "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\n"
+        "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\n"
+        "{\"vehicle\":7,\"timestamp\":1000,\"latitude\":1.3521,\"longitude\":103.8198}\n";
+
+    GnssIngestAdapter adapter;
+    adapter.Feed(log, [](const GnssFix &fix)
+                 { std::cout << "Ingest: fix at " << fix.latitude << ", " << fix.longitude << "\n"; });
+    adapter.Finish([](const GnssFix &) {});
+}
+
 int main()
 {
     std::cout << "Running Observer tests.. \n";
     clientCode();
+    ingestCode();
     return 0;
-}
\ No newline at end of file
+}
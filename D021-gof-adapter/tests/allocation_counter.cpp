@@ -0,0 +1,28 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include "allocation_counter.h"
+
+// Count every allocation in the test binary so hot paths can be checked allocation free
+namespace
+{
+    std::atomic<std::size_t> allocations{0};
+}
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+std::size_t AllocationCount()
+{
+    return allocations.load();
+}
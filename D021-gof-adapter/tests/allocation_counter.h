@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstddef>
+
+// Every operator new in the test binary so far; replaced in allocation_counter.cpp
+std::size_t AllocationCount();
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include "adapter.h"
+#include "adapter_chain.h"
+#include "allocation_counter.h"
+
+namespace
+{
+    const Wrap TRANSLATED{"Adapter Translated << ", "\n"};
+
+    bool Inside(std::string_view view, const std::string &text)
+    {
+        return view.data() >= text.data() && view.data() + view.size() <= text.data() + text.size();
+    }
+}
+
+TEST(AdapterChainTest, MatchesClassicAdapter)
+{
+    Adaptee adaptee;
+    Adapter adapter(&adaptee);
+
+    ChainAdapter adapted(adaptee, MakeAdapterChain<128>(Reverse{}, TRANSLATED));
+    EXPECT_EQ(adapted.Request(), adapter.Request());
+}
+
+TEST(AdapterChainTest, ZeroCopyStagesReturnSlicesOfTheInput)
+{
+    const std::string frame = "  $PLEG,hello  \r\n";
+    auto chain = MakeAdapterChain<64>(Trim{}, StripPrefix{"$PLEG,"});
+
+    const std::string_view out = chain(frame);
+    EXPECT_EQ(out, "hello");
+    EXPECT_TRUE(Inside(out, frame));
+}
+
+TEST(AdapterChainTest, AlternatesBuffersAcrossMixedStages)
+{
+    // Writers after zero-copy stages must not overwrite the bytes they read
+    auto chain = MakeAdapterChain<64>(Reverse{}, Trim{}, Reverse{}, ToUpper{}, Trim{}, Wrap{"<", ">"}, Reverse{});
+    EXPECT_EQ(chain("  abc def "), ">FED CBA<");
+    EXPECT_EQ(decltype(chain)::STAGES, 7u);
+
+    // Reversing twice is the identity, for every length around the buffer edges
+    auto twice = MakeAdapterChain<64>(Reverse{}, Reverse{});
+    for (std::size_t size = 0; size <= 64; ++size)
+    {
+        const std::string text(size, static_cast<char>('a' + size % 26));
+        EXPECT_EQ(twice(text), text);
+    }
+}
+
+TEST(AdapterChainTest, ThenAppendsAStage)
+{
+    const auto base = MakeAdapterChain<64>(Trim{});
+    auto longer = base.Then(ToUpper{}).Then(Wrap{"[", "]"});
+    EXPECT_EQ(longer(" gps "), "[GPS]");
+    EXPECT_EQ(decltype(longer)::STAGES, 3u);
+}
+
+TEST(AdapterChainTest, OutgrowingTheBufferThrows)
+{
+    auto chain = MakeAdapterChain<8>(Wrap{"<<", ">>"});
+    EXPECT_EQ(chain("1234"), "<<1234>>");
+    EXPECT_THROW(chain("12345"), std::length_error);
+}
+
+TEST(AdapterChainTest, NoAllocationPerCall)
+{
+    Adaptee adaptee;
+    ChainAdapter adapted(adaptee, MakeAdapterChain<128>(Trim{}, Reverse{}, ToUpper{}, TRANSLATED));
+
+    std::size_t bytes = 0;
+    const std::size_t before = AllocationCount();
+    for (int i = 0; i < 1000; ++i)
+    {
+        bytes += adapted.Request().size();
+    }
+    EXPECT_EQ(AllocationCount(), before);
+    EXPECT_GT(bytes, 0u);
+}
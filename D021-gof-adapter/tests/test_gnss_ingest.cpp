@@ -0,0 +1,247 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "allocation_counter.h"
+#include "gnss_ingest.h"
+
+namespace
+{
+    const std::string GGA = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47";
+    const std::string RMC = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A";
+    const std::string JSON = R"({"vehicle":7,"timestamp":1000,"latitude":1.3521,"longitude":103.8198})";
+
+    // Append *HH to a sentence body that starts with '$'
+    std::string WithChecksum(const std::string &sentence)
+    {
+        char suffix[4];
+        std::snprintf(suffix, sizeof(suffix), "*%02X", XorBytes(sentence.data() + 1, sentence.data() + sentence.size()));
+        return sentence + suffix;
+    }
+
+    std::vector<GnssFix> ParseAll(GnssIngestAdapter &adapter, const std::string &text, std::size_t chunk)
+    {
+        std::vector<GnssFix> fixes;
+        for (std::size_t at = 0; at < text.size(); at += chunk)
+        {
+            adapter.Feed(std::string_view(text).substr(at, chunk), [&](const GnssFix &fix)
+                         { fixes.push_back(fix); });
+        }
+        adapter.Finish([&](const GnssFix &fix)
+                       { fixes.push_back(fix); });
+        return fixes;
+    }
+}
+
+TEST(DelimiterScanTest, FindByteMatchesMemchr)
+{
+    std::string text(100, 'x');
+    for (std::size_t at = 0; at < text.size(); ++at)
+    {
+        text[at] = '\n';
+        EXPECT_EQ(FindByte(text.data(), text.data() + text.size(), '\n'), text.data() + at);
+        EXPECT_EQ(FindByte(text.data() + at + 1, text.data() + text.size(), '\n'), text.data() + text.size());
+        text[at] = 'x';
+    }
+}
+
+TEST(DelimiterScanTest, SplitFieldsAcrossBlocks)
+{
+    std::string_view fields[32];
+    const std::string text = "a,,bcdefghijklmnopqrstuvwxyz,0123456789012345,,z,";
+    ASSERT_EQ(SplitFields(text, ',', fields, 32), 7u);
+    EXPECT_EQ(fields[0], "a");
+    EXPECT_EQ(fields[1], "");
+    EXPECT_EQ(fields[2], "bcdefghijklmnopqrstuvwxyz");
+    EXPECT_EQ(fields[3], "0123456789012345");
+    EXPECT_EQ(fields[5], "z");
+    EXPECT_EQ(fields[6], "");
+
+    // Full array: the last field keeps nothing past its delimiter
+    EXPECT_EQ(SplitFields(text, ',', fields, 3), 3u);
+    EXPECT_EQ(fields[2], "bcdefghijklmnopqrstuvwxyz");
+}
+
+TEST(DelimiterScanTest, XorMatchesScalar)
+{
+    std::string text;
+    for (int i = 0; i < 70; ++i)
+    {
+        text.push_back(static_cast<char>('A' + i % 26));
+        std::uint8_t expected = 0;
+        for (char c : text)
+        {
+            expected ^= static_cast<std::uint8_t>(c);
+        }
+        EXPECT_EQ(XorBytes(text.data(), text.data() + text.size()), expected);
+    }
+}
+
+TEST(GnssIngestTest, ParsesGga)
+{
+    GnssIngestAdapter adapter;
+    GnssFix fix;
+    ASSERT_EQ(adapter.ParseLine(GGA, fix), GnssIngestAdapter::LineResult::Fix);
+    EXPECT_EQ(fix.source, FixSource::Gga);
+    EXPECT_NEAR(fix.latitude, 48.0 + 7.038 / 60.0, 1e-12);
+    EXPECT_NEAR(fix.longitude, 11.0 + 31.0 / 60.0, 1e-12);
+    EXPECT_EQ(fix.satellites, 8);
+    EXPECT_EQ(fix.timestamp_ms, (12 * 3600 + 35 * 60 + 19) * 1000u);
+}
+
+TEST(GnssIngestTest, ParsesRmcWithHemispheres)
+{
+    GnssIngestAdapter adapter;
+    GnssFix fix;
+    ASSERT_EQ(adapter.ParseLine(RMC + "\r", fix), GnssIngestAdapter::LineResult::Fix);
+    EXPECT_EQ(fix.source, FixSource::Rmc);
+    EXPECT_FLOAT_EQ(fix.speed_knots, 22.4f);
+    EXPECT_FLOAT_EQ(fix.course_deg, 84.4f);
+
+    const std::string south = WithChecksum("$GNRMC,010203.250,A,0121.126,S,10349.188,W,0.0,,010124,,");
+    ASSERT_EQ(adapter.ParseLine(south, fix), GnssIngestAdapter::LineResult::Fix);
+    EXPECT_NEAR(fix.latitude, -(1.0 + 21.126 / 60.0), 1e-12);
+    EXPECT_NEAR(fix.longitude, -(103.0 + 49.188 / 60.0), 1e-12);
+    EXPECT_EQ(fix.timestamp_ms, 3723250u);
+}
+
+TEST(GnssIngestTest, ParsesJsonRecords)
+{
+    GnssIngestAdapter adapter;
+    GnssFix fix;
+    ASSERT_EQ(adapter.ParseLine(JSON, fix), GnssIngestAdapter::LineResult::Fix);
+    EXPECT_EQ(fix.source, FixSource::Json);
+    EXPECT_EQ(fix.vehicle_id, 7u);
+    EXPECT_EQ(fix.timestamp_ms, 1000u);
+    EXPECT_DOUBLE_EQ(fix.latitude, 1.3521);
+    EXPECT_DOUBLE_EQ(fix.longitude, 103.8198);
+
+    // Spacing, key order and unknown keys (strings with escapes included) do not matter
+    const std::string loose = R"({ "name" : "bus \"7\", depot" , "longitude" : -0.5 ,"latitude":51.5, "ok":true })";
+    ASSERT_EQ(adapter.ParseLine(loose, fix), GnssIngestAdapter::LineResult::Fix);
+    EXPECT_DOUBLE_EQ(fix.latitude, 51.5);
+    EXPECT_DOUBLE_EQ(fix.longitude, -0.5);
+}
+
+TEST(GnssIngestTest, RejectsBrokenInput)
+{
+    GnssIngestAdapter adapter;
+    GnssFix fix;
+    using Result = GnssIngestAdapter::LineResult;
+
+    std::string badChecksum = GGA;
+    badChecksum.back() = '8';
+    EXPECT_EQ(adapter.ParseLine(badChecksum, fix), Result::Rejected);
+    EXPECT_EQ(adapter.ParseLine(GGA.substr(0, GGA.size() - 3), fix), Result::Rejected); // no checksum
+    EXPECT_EQ(adapter.ParseLine(WithChecksum("$GPGGA,123519,4807.038,X,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"), fix),
+              Result::Rejected);
+    EXPECT_EQ(adapter.ParseLine(WithChecksum("$GPGGA,123519,4867.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"), fix),
+              Result::Rejected); // 67 minutes
+
+    EXPECT_EQ(adapter.ParseLine(R"({"latitude":1.0})", fix), Result::Rejected);
+    EXPECT_EQ(adapter.ParseLine(R"({"latitude":1.0,"longitude":2.0)", fix), Result::Rejected);
+    EXPECT_EQ(adapter.ParseLine(R"({"latitude":"1.0","longitude":2.0})", fix), Result::Rejected);
+    EXPECT_EQ(adapter.ParseLine(R"({"latitude":1.0,"longitude":2.0,"path":[1,2]})", fix), Result::Rejected);
+    EXPECT_EQ(adapter.ParseLine(R"({"latitude":91.0,"longitude":2.0})", fix), Result::Rejected);
+    EXPECT_EQ(adapter.ParseLine("hello", fix), Result::Rejected);
+
+    EXPECT_EQ(adapter.GetStats().rejected, 10u);
+    EXPECT_EQ(adapter.GetStats().fixes, 0u);
+}
+
+TEST(GnssIngestTest, RejectsNonFiniteAndHugeCoordinates)
+{
+    GnssIngestAdapter adapter;
+    GnssFix fix;
+    using Result = GnssIngestAdapter::LineResult;
+
+    for (const char *latitude : {"nan", "-nan", "inf", "infinity", "1e300", "9060"})
+    {
+        const std::string sentence = std::string("$GPGGA,123519,") + latitude + ",N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,";
+        EXPECT_EQ(adapter.ParseLine(WithChecksum(sentence), fix), Result::Rejected) << latitude;
+    }
+    EXPECT_EQ(adapter.ParseLine(WithChecksum("$GPRMC,123519,A,4807.038,N,1e300,E,022.4,084.4,230394,003.1,W"), fix),
+              Result::Rejected);
+
+    // An exponent that lands in range is still a coordinate
+    ASSERT_EQ(adapter.ParseLine(WithChecksum("$GPGGA,123519,4.807038e3,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"), fix),
+              Result::Fix);
+    EXPECT_NEAR(fix.latitude, 48.1173, 1e-4);
+}
+
+TEST(GnssIngestTest, CountsNoFixAndIgnored)
+{
+    GnssIngestAdapter adapter;
+    GnssFix fix;
+    using Result = GnssIngestAdapter::LineResult;
+
+    EXPECT_EQ(adapter.ParseLine(WithChecksum("$GPGGA,123519,,,,,0,00,,,M,,M,,"), fix), Result::NoFix);
+    EXPECT_EQ(adapter.ParseLine(WithChecksum("$GPRMC,123519,V,,,,,,,230394,,"), fix), Result::NoFix);
+    EXPECT_EQ(adapter.ParseLine(WithChecksum("$GPGSV,3,1,11,03,03,111,00"), fix), Result::Ignored);
+    EXPECT_EQ(adapter.ParseLine("\r", fix), Result::Ignored);
+
+    EXPECT_EQ(adapter.GetStats().no_fix, 2u);
+    EXPECT_EQ(adapter.GetStats().ignored, 2u);
+}
+
+TEST(GnssIngestTest, ChunkBoundariesDoNotMatter)
+{
+    std::string log;
+    for (int i = 0; i < 200; ++i)
+    {
+        log += GGA + "\r\n" + RMC + "\n" + JSON + "\n";
+    }
+    log += JSON; // no trailing newline: Finish() picks it up
+
+    GnssIngestAdapter whole;
+    const std::vector<GnssFix> expected = ParseAll(whole, log, log.size());
+    ASSERT_EQ(expected.size(), 601u);
+
+    for (std::size_t chunk : {1u, 2u, 7u, 16u, 61u, 4096u})
+    {
+        GnssIngestAdapter adapter;
+        const std::vector<GnssFix> fixes = ParseAll(adapter, log, chunk);
+        ASSERT_EQ(fixes.size(), expected.size()) << "chunk " << chunk;
+        for (std::size_t i = 0; i < fixes.size(); ++i)
+        {
+            ASSERT_EQ(fixes[i].latitude, expected[i].latitude);
+            ASSERT_EQ(fixes[i].longitude, expected[i].longitude);
+            ASSERT_EQ(fixes[i].source, expected[i].source);
+        }
+        EXPECT_EQ(adapter.GetStats().rejected, 0u);
+    }
+}
+
+TEST(GnssIngestTest, OverlongLineIsDroppedAndStreamRecovers)
+{
+    const std::string log = std::string(2000, 'x') + "\n" + GGA + "\n";
+
+    GnssIngestAdapter adapter;
+    const std::vector<GnssFix> fixes = ParseAll(adapter, log, 100);
+    EXPECT_EQ(fixes.size(), 1u);
+    EXPECT_EQ(adapter.GetStats().rejected, 1u);
+}
+
+TEST(GnssIngestTest, NoAllocationPerRecord)
+{
+    std::string log;
+    for (int i = 0; i < 1000; ++i)
+    {
+        log += GGA + "\n" + RMC + "\n" + JSON + "\n";
+    }
+
+    GnssIngestAdapter adapter;
+    double sum = 0.0;
+    const std::size_t before = AllocationCount();
+    for (std::size_t at = 0; at < log.size(); at += 333)
+    {
+        adapter.Feed(std::string_view(log).substr(at, 333), [&](const GnssFix &fix)
+                     { sum += fix.latitude; });
+    }
+    adapter.Finish([&](const GnssFix &fix)
+                   { sum += fix.latitude; });
+    EXPECT_EQ(AllocationCount(), before);
+    EXPECT_EQ(adapter.GetStats().fixes, 3000u);
+    EXPECT_GT(sum, 0.0);
+}
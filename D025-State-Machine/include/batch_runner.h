@@ -0,0 +1,160 @@
+#ifndef BATCH_RUNNER_H
+
+#define BATCH_RUNNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "state_machine.h"
+#include "worker_pool.h"
+
+/**
+ * Runs N independent machines that share one fsm::Table.
+ *
+ * The current state of every machine is one byte in a contiguous array.
+ * A batch of events is applied to all machines in a single pass, split into
+ * contiguous chunks across a WorkerPool. Instead of calling the table's
+ * actions (which may print), the runner appends an ActionRecord to the buffer
+ * of the worker that handled the machine; callers drain them afterwards.
+ */
+template <const auto &TableRef>
+class BatchRunner
+{
+public:
+    using TableType = std::remove_cv_t<std::remove_reference_t<decltype(TableRef)>>;
+    using State = typename TableType::State;
+    using Event = typename TableType::Event;
+    using Action = typename TableType::Action;
+
+    static_assert(TableType::STATE_COUNT <= 256, "states must fit in one byte");
+
+    // An action that would have run for one machine during a batch
+    struct ActionRecord
+    {
+        std::uint32_t machine;
+        Action action;
+    };
+
+    // Marks "no event for this machine" in apply(const Event *)
+    static constexpr Event NO_EVENT = static_cast<Event>(TableType::EVENT_COUNT);
+
+    BatchRunner(std::size_t machines, State initial, unsigned threads = std::thread::hardware_concurrency(),
+                bool recordActions = true)
+        : states_(machines, static_cast<std::uint8_t>(initial)), pool_(threads), buffers_(pool_.size()),
+          record_(recordActions)
+    {
+    }
+
+    // Send the same event to every machine
+    void apply(Event event)
+    {
+        run([event](std::size_t)
+            { return event; });
+    }
+
+    // events[i] goes to machine i (size() entries), NO_EVENT skips a machine
+    void apply(const Event *events)
+    {
+        run([events](std::size_t machine)
+            { return events[machine]; });
+    }
+
+    // Send one event to one machine on the calling thread (actions go to worker 0's buffer).
+    // Not safe to call while an apply() is running.
+    bool dispatch(std::size_t machine, Event event)
+    {
+        return stepOne(machine, event, buffers_[0].records);
+    }
+
+    std::size_t size() const { return states_.size(); }
+    unsigned threadCount() const { return pool_.size(); }
+    State state(std::size_t machine) const { return static_cast<State>(states_[machine]); }
+    const std::uint8_t *states() const { return states_.data(); }
+
+    // Actions collected by one worker since the last clearActions()
+    const std::vector<ActionRecord> &actions(unsigned worker) const { return buffers_[worker].records; }
+
+    // Visit every collected action, worker by worker (machine order within a worker)
+    template <typename Fn>
+    void forEachAction(Fn &&fn) const
+    {
+        for (const ActionBuffer &buffer : buffers_)
+        {
+            for (const ActionRecord &record : buffer.records)
+            {
+                fn(record);
+            }
+        }
+    }
+
+    void clearActions()
+    {
+        for (ActionBuffer &buffer : buffers_)
+        {
+            buffer.records.clear();
+        }
+    }
+
+private:
+    // Own cache line per worker so appends never share lines
+    struct alignas(64) ActionBuffer
+    {
+        std::vector<ActionRecord> records;
+    };
+
+    // Chunks are multiples of 64 machines, one cache line of states
+    static constexpr std::size_t GRAIN = 64;
+
+    template <typename EventOf>
+    void run(EventOf eventOf)
+    {
+        pool_.parallelFor(states_.size(), GRAIN, [&](unsigned worker, std::size_t begin, std::size_t end)
+                          { step(eventOf, buffers_[worker].records, begin, end); });
+    }
+
+    template <typename EventOf>
+    void step(EventOf &eventOf, std::vector<ActionRecord> &records, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            stepOne(i, eventOf(i), records);
+        }
+    }
+
+    bool stepOne(std::size_t machine, Event event, std::vector<ActionRecord> &records)
+    {
+        if (TableType::index(event) >= TableType::EVENT_COUNT)
+        {
+            return false;
+        }
+
+        const auto &cell = TableRef.lookup(static_cast<State>(states_[machine]), event);
+        if (!cell.handled)
+        {
+            return false;
+        }
+
+        states_[machine] = static_cast<std::uint8_t>(cell.targetState);
+
+        if (record_)
+        {
+            const auto id = static_cast<std::uint32_t>(machine);
+            if (cell.action)
+            {
+                records.push_back(ActionRecord{id, cell.action});
+            }
+            if (Action enter = TableRef.entry(cell.targetState))
+            {
+                records.push_back(ActionRecord{id, enter});
+            }
+        }
+        return true;
+    }
+
+    std::vector<std::uint8_t> states_;
+    WorkerPool pool_;
+    std::vector<ActionBuffer> buffers_;
+    const bool record_;
+};
+
+#endif // !BATCH_RUNNER_H
@@ -0,0 +1,145 @@
+#ifndef STATE_MACHINE_H
+
+#define STATE_MACHINE_H
+
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * Generic table-driven state machine engine.
+ *
+ * States and events are enums (0..N-1), actions are any callable pointer type.
+ * The transition table is a constexpr [state][event] array, so dispatching an
+ * event is one indexed load plus the action calls: O(1), no allocation, no
+ * virtual calls. A StateMachine instance only stores its current state.
+ */
+namespace fsm
+{
+    // One outgoing transition of a state, as written in the per-state arrays
+    template <typename StateT, typename EventT, typename ActionT>
+    struct Transition
+    {
+        EventT event;
+        StateT targetState;
+        ActionT action;
+    };
+
+    template <typename StateT, typename EventT, typename ActionT, std::size_t NumStates, std::size_t NumEvents>
+    class Table
+    {
+    public:
+        using State = StateT;
+        using Event = EventT;
+        using Action = ActionT;
+        using TransitionType = Transition<StateT, EventT, ActionT>;
+
+        static constexpr std::size_t STATE_COUNT = NumStates;
+        static constexpr std::size_t EVENT_COUNT = NumEvents;
+
+        // Resolved entry of the [state][event] table
+        struct Cell
+        {
+            StateT targetState;
+            ActionT action;
+            bool handled;
+        };
+
+        constexpr Table() : cells_{}, entry_{} {}
+
+        // Register the outgoing transitions of one state
+        template <std::size_t N>
+        constexpr Table &on(StateT from, const TransitionType (&transitions)[N])
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                cells_[index(from)][index(transitions[i].event)] = Cell{transitions[i].targetState, transitions[i].action, true};
+            }
+            return *this;
+        }
+
+        // Register the action run whenever the machine enters a state
+        constexpr Table &onEnter(StateT state, ActionT action)
+        {
+            entry_[index(state)] = action;
+            return *this;
+        }
+
+        constexpr const Cell &lookup(StateT state, EventT event) const
+        {
+            return cells_[index(state)][index(event)];
+        }
+
+        constexpr ActionT entry(StateT state) const
+        {
+            return entry_[index(state)];
+        }
+
+        template <typename EnumT>
+        static constexpr std::size_t index(EnumT value)
+        {
+            return static_cast<std::size_t>(value);
+        }
+
+    private:
+        Cell cells_[NumStates][NumEvents];
+        ActionT entry_[NumStates];
+    };
+
+    /**
+     * One machine instance driven by a constexpr Table with static storage.
+     * Extra arguments to start()/dispatch() are forwarded to the actions.
+     */
+    template <const auto &TableRef>
+    class StateMachine
+    {
+    public:
+        using TableType = std::remove_cv_t<std::remove_reference_t<decltype(TableRef)>>;
+        using State = typename TableType::State;
+        using Event = typename TableType::Event;
+
+        explicit constexpr StateMachine(State initial) : state_(initial) {}
+
+        // Run the entry action of the initial state
+        template <typename... Args>
+        void start(Args &&...args) const
+        {
+            if (auto enter = TableRef.entry(state_))
+            {
+                enter(args...);
+            }
+        }
+
+        // Returns false (and stays put) if the current state ignores the event
+        template <typename... Args>
+        bool dispatch(Event event, Args &&...args)
+        {
+            const auto &cell = TableRef.lookup(state_, event);
+            if (!cell.handled)
+            {
+                return false;
+            }
+
+            if (cell.action)
+            {
+                cell.action(args...);
+            }
+
+            state_ = cell.targetState;
+
+            if (auto enter = TableRef.entry(state_))
+            {
+                enter(args...);
+            }
+            return true;
+        }
+
+        constexpr State state() const { return state_; }
+
+        static constexpr const TableType &table() { return TableRef; }
+
+    private:
+        State state_;
+    };
+}
+
+#endif // !STATE_MACHINE_H
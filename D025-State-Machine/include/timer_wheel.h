@@ -0,0 +1,154 @@
+#ifndef TIMER_WHEEL_H
+
+#define TIMER_WHEEL_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Hierarchical timing wheel (4 levels x 256 slots) over integer ticks.
+ *
+ * schedule() and cancel() are O(1): timers live in a node pool and are linked
+ * into the slot matching their expiry. advanceTo() walks time forward, fires
+ * level 0 slots and cascades upper slots down as their range comes due; empty
+ * stretches are skipped using a per-level occupancy bitmap.
+ * Timers further out than 2^32 ticks wait in an overflow list.
+ *
+ * The wheel has no clock of its own. Drive it with VirtualClock to run
+ * simulated time as fast as possible, or with SteadyClock for real time.
+ */
+class TimerWheel
+{
+public:
+    using Tick = std::uint64_t;
+
+    // Handle returned by schedule(); stale handles are ignored by cancel()
+    using TimerId = std::uint64_t;
+    static constexpr TimerId INVALID_TIMER = 0;
+
+    explicit TimerWheel(Tick start = 0);
+
+    // Fire payload at tick expiry (a past expiry fires on the next advance)
+    TimerId schedule(Tick expiry, std::uint64_t payload);
+
+    // Fire payload delay ticks from now()
+    TimerId scheduleAfter(Tick delay, std::uint64_t payload) { return schedule(now_ + delay, payload); }
+
+    // Returns false if the timer already fired or was cancelled
+    bool cancel(TimerId id);
+
+    // Move time to target and call onExpire(payload, expiry) for every timer
+    // due on the way, in expiry order. Callbacks may schedule and cancel.
+    template <typename Fn>
+    std::size_t advanceTo(Tick target, Fn &&onExpire);
+
+    Tick now() const { return now_; }
+    std::size_t pending() const { return active_; }
+
+    // Reserve room for count simultaneous timers
+    void reserve(std::size_t count) { nodes_.reserve(count); }
+
+private:
+    static constexpr unsigned LEVELS = 4;
+    static constexpr unsigned SLOT_BITS = 8;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr std::uint32_t NIL = 0xFFFFFFFFu;
+    static constexpr std::uint32_t OVERFLOW_SLOT = LEVELS * SLOTS;
+    static constexpr std::uint32_t FIRING_SLOT = OVERFLOW_SLOT + 1; // slot being fired by advanceTo()
+    static constexpr std::uint32_t NO_SLOT = OVERFLOW_SLOT + 2;
+
+    struct Node
+    {
+        Tick expiry;
+        std::uint64_t payload;
+        std::uint32_t prev;
+        std::uint32_t next;
+        std::uint32_t generation;
+        std::uint32_t slot; // level * SLOTS + index, OVERFLOW_SLOT, FIRING_SLOT or NO_SLOT when free
+    };
+
+    void place(std::uint32_t node);
+    void link(std::uint32_t slot, std::uint32_t node);
+    void unlink(std::uint32_t node);
+    void release(std::uint32_t node);
+    std::uint32_t takeSlot(std::uint32_t slot);
+    void startFiring(std::uint32_t slot);
+    void cascade();
+    Tick nextStop(Tick target) const;
+    int nextOccupied(unsigned level, unsigned from) const;
+
+    Tick now_;
+    std::size_t active_ = 0;
+    std::vector<Node> nodes_;
+    std::uint32_t free_ = NIL;
+    std::uint32_t heads_[LEVELS * SLOTS + 2];     // + overflow and firing lists
+    std::uint64_t occupied_[LEVELS][SLOTS / 64]; // non-empty slots per level
+};
+
+template <typename Fn>
+std::size_t TimerWheel::advanceTo(Tick target, Fn &&onExpire)
+{
+    std::size_t fired = 0;
+    while (now_ < target)
+    {
+        now_ = nextStop(target);
+
+        if ((now_ & (SLOTS - 1)) == 0)
+        {
+            cascade();
+        }
+
+        // Move the slot to the firing list so callbacks can schedule into it
+        // again and cancel timers that have not fired yet
+        startFiring(static_cast<std::uint32_t>(now_ & (SLOTS - 1)));
+        while (heads_[FIRING_SLOT] != NIL)
+        {
+            const std::uint32_t node = heads_[FIRING_SLOT];
+            const Tick expiry = nodes_[node].expiry;
+            const std::uint64_t payload = nodes_[node].payload;
+            unlink(node);
+            release(node);
+            onExpire(payload, expiry);
+            ++fired;
+        }
+    }
+    return fired;
+}
+
+/**
+ * Simulated time: ticks only move when the caller says so
+ */
+class VirtualClock
+{
+public:
+    explicit VirtualClock(TimerWheel::Tick start = 0) : now_(start) {}
+
+    TimerWheel::Tick now() const { return now_; }
+    void advance(TimerWheel::Tick ticks) { now_ += ticks; }
+
+private:
+    TimerWheel::Tick now_;
+};
+
+/**
+ * Wall-clock time: ticks of a fixed duration since construction
+ */
+class SteadyClock
+{
+public:
+    explicit SteadyClock(std::chrono::nanoseconds tick = std::chrono::milliseconds(1))
+        : start_(std::chrono::steady_clock::now()), tick_(tick) {}
+
+    TimerWheel::Tick now() const
+    {
+        return static_cast<TimerWheel::Tick>((std::chrono::steady_clock::now() - start_) / tick_);
+    }
+
+private:
+    std::chrono::steady_clock::time_point start_;
+    std::chrono::nanoseconds tick_;
+};
+
+#endif // !TIMER_WHEEL_H
@@ -0,0 +1,54 @@
+#ifndef TRAFFIC_GRID_H
+
+#define TRAFFIC_GRID_H
+
+#include <cstddef>
+#include "batch_runner.h"
+#include "timer_wheel.h"
+#include "traffic_light.h"
+
+// How long each light stays in a state, in timer ticks
+struct PhaseDurations
+{
+    TimerWheel::Tick red;
+    TimerWheel::Tick green;
+    TimerWheel::Tick yellow;
+};
+
+/**
+ * A city of traffic lights driven by a TimerWheel.
+ *
+ * Every light has one pending timer. When it fires, EVT_TIMER_EXPIRE is
+ * dispatched to that light through BatchRunner and the next timer is
+ * scheduled from the expiry tick (not from now, so lights never drift).
+ */
+class TrafficGrid
+{
+public:
+    // Throws std::invalid_argument if any phase lasts zero ticks
+    TrafficGrid(std::size_t intersections, PhaseDurations phases, bool recordActions = false);
+
+    // Run virtual time up to tick, returns the number of timer events dispatched
+    std::size_t advanceTo(TimerWheel::Tick tick);
+
+    // Catch up with a VirtualClock or SteadyClock
+    template <typename Clock>
+    std::size_t poll(const Clock &clock)
+    {
+        return advanceTo(clock.now());
+    }
+
+    std::size_t size() const { return lights_.size(); }
+    StateID state(std::size_t intersection) const { return lights_.state(intersection); }
+    TimerWheel::Tick now() const { return wheel_.now(); }
+    const BatchRunner<trafficTable> &lights() const { return lights_; }
+
+private:
+    TimerWheel::Tick durationOf(StateID state) const;
+
+    BatchRunner<trafficTable> lights_;
+    TimerWheel wheel_;
+    PhaseDurations phases_;
+};
+
+#endif // !TRAFFIC_GRID_H
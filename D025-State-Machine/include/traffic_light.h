@@ -3,27 +3,25 @@
 #define TRAFFIC_LIGHT_H
 
 #include <iostream>
+#include "state_machine.h"
 
 enum Event
 {
-    EVT_TIMER_EXPIRE
+    EVT_TIMER_EXPIRE,
+    EVT_COUNT // number of events, keep last
 };
 
 enum StateID
 {
     STATE_RED,
     STATE_GREEN,
-    STATE_YELLOW
+    STATE_YELLOW,
+    STATE_COUNT // number of states, keep last
 };
 
 typedef void (*TransitionFunction)();
 
-struct Transition
-{
-    Event event;
-    StateID targetState;
-    TransitionFunction action;
-};
+using Transition = fsm::Transition<StateID, Event, TransitionFunction>;
 
 void enterRed();
 void enterGreen();
@@ -33,5 +31,29 @@ void toGreen();
 void toYellow();
 void toRed();
 
+// Transition functions
+inline constexpr Transition redTransitions[] = {{EVT_TIMER_EXPIRE, STATE_GREEN, toGreen}};
+inline constexpr Transition greenTransitions[] = {{EVT_TIMER_EXPIRE, STATE_YELLOW, toYellow}};
+inline constexpr Transition yellowTransitions[] = {{EVT_TIMER_EXPIRE, STATE_RED, toRed}};
+
+using TrafficTable = fsm::Table<StateID, Event, TransitionFunction, STATE_COUNT, EVT_COUNT>;
+
+constexpr TrafficTable buildTrafficTable()
+{
+    TrafficTable table;
+    table.on(STATE_RED, redTransitions)
+        .on(STATE_GREEN, greenTransitions)
+        .on(STATE_YELLOW, yellowTransitions)
+        .onEnter(STATE_RED, enterRed)
+        .onEnter(STATE_GREEN, enterGreen)
+        .onEnter(STATE_YELLOW, enterYellow);
+    return table;
+}
+
+// Resolved at compile time, shared by every traffic light
+inline constexpr TrafficTable trafficTable = buildTrafficTable();
+
+using TrafficLight = fsm::StateMachine<trafficTable>;
+
 void trafficLogic();
-#endif // !TRAFFIC_LIGHT_H
\ No newline at end of file
+#endif // !TRAFFIC_LIGHT_H
@@ -0,0 +1,137 @@
+#ifndef WORKER_POOL_H
+
+#define WORKER_POOL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed set of worker threads that split a range of indices between them.
+ * The calling thread works as worker 0, so a pool of 1 spawns no thread.
+ */
+class WorkerPool
+{
+public:
+    // Chunk job: (worker index, first index, one past last index)
+    using Job = std::function<void(unsigned, std::size_t, std::size_t)>;
+
+    explicit WorkerPool(unsigned workers = std::thread::hardware_concurrency())
+        : workers_(std::max(1u, workers))
+    {
+        for (unsigned worker = 1; worker < workers_; ++worker)
+        {
+            threads_.emplace_back([this, worker]
+                                  { workerLoop(worker); });
+        }
+    }
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            ++generation_;
+        }
+        wake_.notify_all();
+        for (std::thread &thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    unsigned size() const { return workers_; }
+
+    // Split [0, count) into one contiguous chunk per worker, rounded to
+    // multiples of grain, and return once every chunk is done
+    void parallelFor(std::size_t count, std::size_t grain, const Job &job)
+    {
+        const std::size_t perWorker = (count + workers_ - 1) / workers_;
+        chunk_ = std::max(grain, (perWorker + grain - 1) / grain * grain);
+        count_ = count;
+
+        if (workers_ == 1)
+        {
+            job(0, 0, count);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = &job;
+            pending_ = workers_ - 1;
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        runChunk(0, job);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]
+                   { return pending_ == 0; });
+        job_ = nullptr;
+    }
+
+private:
+    void runChunk(unsigned worker, const Job &job) const
+    {
+        const std::size_t begin = std::min(count_, chunk_ * worker);
+        const std::size_t end = std::min(count_, begin + chunk_);
+        if (begin < end)
+        {
+            job(worker, begin, end);
+        }
+    }
+
+    void workerLoop(unsigned worker)
+    {
+        std::size_t seen = 0;
+        for (;;)
+        {
+            const Job *job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&]
+                           { return generation_ != seen; });
+                seen = generation_;
+                if (stopping_)
+                {
+                    return;
+                }
+                job = job_;
+            }
+
+            runChunk(worker, *job);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0)
+            {
+                done_.notify_one();
+            }
+        }
+    }
+
+    const unsigned workers_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::size_t generation_ = 0;
+    unsigned pending_ = 0;
+    bool stopping_ = false;
+    const Job *job_ = nullptr;
+
+    // Layout of the current job, written before workers are woken
+    std::size_t count_ = 0;
+    std::size_t chunk_ = 0;
+};
+
+#endif // !WORKER_POOL_H
@@ -1,11 +1,30 @@
+#include <chrono>
 #include <iostream>
 #include "traffic_light.h"
+#include "traffic_grid.h"
 
 // void clientCode();
 void trafficLogic();
 
+// A simulated day for a city of traffic lights, 1 tick = 100 ms
+void citySimulation()
+{
+    constexpr std::size_t INTERSECTIONS = 10000;
+    constexpr TimerWheel::Tick DAY = 24 * 60 * 60 * 10;
+
+    TrafficGrid city(INTERSECTIONS, PhaseDurations{300, 250, 50});
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t events = city.advanceTo(DAY);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "🏙️  Simulated 24h of " << INTERSECTIONS << " traffic lights: "
+              << events << " timer events in " << elapsed.count() << " s\n";
+}
+
 int main()
 {
     trafficLogic();
+    citySimulation();
     return 0;
-}
\ No newline at end of file
+}
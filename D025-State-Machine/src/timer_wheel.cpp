@@ -0,0 +1,213 @@
+#include "timer_wheel.h"
+
+TimerWheel::TimerWheel(Tick start) : now_(start), occupied_{}
+{
+    for (std::uint32_t &head : heads_)
+    {
+        head = NIL;
+    }
+}
+
+TimerWheel::TimerId TimerWheel::schedule(Tick expiry, std::uint64_t payload)
+{
+    // The current tick has already been fired
+    if (expiry <= now_)
+    {
+        expiry = now_ + 1;
+    }
+
+    std::uint32_t node;
+    if (free_ != NIL)
+    {
+        node = free_;
+        free_ = nodes_[node].next;
+    }
+    else
+    {
+        node = static_cast<std::uint32_t>(nodes_.size());
+        nodes_.push_back(Node{0, 0, NIL, NIL, 1, NO_SLOT});
+    }
+
+    nodes_[node].expiry = expiry;
+    nodes_[node].payload = payload;
+    place(node);
+    ++active_;
+
+    return (static_cast<TimerId>(nodes_[node].generation) << 32) | node;
+}
+
+bool TimerWheel::cancel(TimerId id)
+{
+    const auto node = static_cast<std::uint32_t>(id & 0xFFFFFFFFu);
+    const auto generation = static_cast<std::uint32_t>(id >> 32);
+    if (node >= nodes_.size() || nodes_[node].generation != generation || nodes_[node].slot == NO_SLOT)
+    {
+        return false;
+    }
+
+    unlink(node);
+    release(node);
+    return true;
+}
+
+// Lowest level whose higher bits agree with now_, so the slot is still ahead
+void TimerWheel::place(std::uint32_t node)
+{
+    const Tick expiry = nodes_[node].expiry;
+    for (unsigned level = 0; level < LEVELS; ++level)
+    {
+        const unsigned above = SLOT_BITS * (level + 1);
+        if ((expiry >> above) == (now_ >> above))
+        {
+            const auto index = static_cast<std::uint32_t>((expiry >> (SLOT_BITS * level)) & (SLOTS - 1));
+            link(level * SLOTS + index, node);
+            return;
+        }
+    }
+    link(OVERFLOW_SLOT, node);
+}
+
+void TimerWheel::link(std::uint32_t slot, std::uint32_t node)
+{
+    Node &entry = nodes_[node];
+    entry.slot = slot;
+    entry.prev = NIL;
+    entry.next = heads_[slot];
+    if (entry.next != NIL)
+    {
+        nodes_[entry.next].prev = node;
+    }
+    heads_[slot] = node;
+
+    if (slot < OVERFLOW_SLOT)
+    {
+        occupied_[slot / SLOTS][(slot % SLOTS) / 64] |= std::uint64_t{1} << (slot % 64);
+    }
+}
+
+void TimerWheel::unlink(std::uint32_t node)
+{
+    const Node &entry = nodes_[node];
+    if (entry.prev != NIL)
+    {
+        nodes_[entry.prev].next = entry.next;
+    }
+    else
+    {
+        heads_[entry.slot] = entry.next;
+    }
+    if (entry.next != NIL)
+    {
+        nodes_[entry.next].prev = entry.prev;
+    }
+
+    if (entry.slot < OVERFLOW_SLOT && heads_[entry.slot] == NIL)
+    {
+        occupied_[entry.slot / SLOTS][(entry.slot % SLOTS) / 64] &= ~(std::uint64_t{1} << (entry.slot % 64));
+    }
+}
+
+void TimerWheel::release(std::uint32_t node)
+{
+    Node &entry = nodes_[node];
+    entry.slot = NO_SLOT;
+    entry.generation = entry.generation + 1 == 0 ? 1 : entry.generation + 1;
+    entry.next = free_;
+    free_ = node;
+    --active_;
+}
+
+// Empty a slot and return its list, nodes still linked to each other
+std::uint32_t TimerWheel::takeSlot(std::uint32_t slot)
+{
+    const std::uint32_t head = heads_[slot];
+    heads_[slot] = NIL;
+    if (slot != OVERFLOW_SLOT)
+    {
+        occupied_[slot / SLOTS][(slot % SLOTS) / 64] &= ~(std::uint64_t{1} << (slot % 64));
+    }
+    return head;
+}
+
+// Hand a level 0 slot's timers to advanceTo(), still cancellable
+void TimerWheel::startFiring(std::uint32_t slot)
+{
+    const std::uint32_t head = takeSlot(slot);
+    for (std::uint32_t node = head; node != NIL; node = nodes_[node].next)
+    {
+        nodes_[node].slot = FIRING_SLOT;
+    }
+    heads_[FIRING_SLOT] = head;
+}
+
+// now_ just crossed into a new level 0 rotation: pull due upper slots down
+void TimerWheel::cascade()
+{
+    for (unsigned level = 1; level <= LEVELS; ++level)
+    {
+        std::uint32_t slot = OVERFLOW_SLOT;
+        if (level < LEVELS)
+        {
+            slot = level * SLOTS + static_cast<std::uint32_t>((now_ >> (SLOT_BITS * level)) & (SLOTS - 1));
+        }
+
+        std::uint32_t node = takeSlot(slot);
+        while (node != NIL)
+        {
+            const std::uint32_t next = nodes_[node].next;
+            place(node);
+            node = next;
+        }
+
+        // Only continue upwards when this level wrapped too
+        if (level < LEVELS && slot != level * SLOTS)
+        {
+            break;
+        }
+    }
+}
+
+// Next tick worth stopping at: the earliest occupied slot on any level (for
+// upper levels that is the tick where the slot cascades), the next overflow
+// sweep or target. Empty stretches are skipped entirely.
+TimerWheel::Tick TimerWheel::nextStop(Tick target) const
+{
+    Tick stop = target;
+
+    for (unsigned level = 0; level < LEVELS; ++level)
+    {
+        const unsigned shift = SLOT_BITS * level;
+        const unsigned current = static_cast<unsigned>((now_ >> shift) & (SLOTS - 1));
+        const int next = nextOccupied(level, current + 1);
+        if (next >= 0)
+        {
+            const Tick base = (now_ >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+            const Tick due = base + (static_cast<Tick>(next) << shift);
+            stop = due < stop ? due : stop;
+        }
+    }
+
+    if (heads_[OVERFLOW_SLOT] != NIL)
+    {
+        const unsigned span = SLOT_BITS * LEVELS;
+        const Tick sweep = ((now_ >> span) + 1) << span;
+        stop = sweep < stop ? sweep : stop;
+    }
+
+    return stop;
+}
+
+// First occupied slot index >= from on a level, -1 if none
+int TimerWheel::nextOccupied(unsigned level, unsigned from) const
+{
+    while (from < SLOTS)
+    {
+        const std::uint64_t bits = occupied_[level][from / 64] >> (from % 64);
+        if (bits != 0)
+        {
+            return static_cast<int>(from + static_cast<unsigned>(__builtin_ctzll(bits)));
+        }
+        from = (from / 64 + 1) * 64;
+    }
+    return -1;
+}
@@ -0,0 +1,41 @@
+#include "traffic_grid.h"
+#include <stdexcept>
+
+TrafficGrid::TrafficGrid(std::size_t intersections, PhaseDurations phases, bool recordActions)
+    : lights_(intersections, STATE_RED, 1, recordActions), phases_(phases)
+{
+    // A zero phase would reschedule a light at the tick it just fired, forever
+    if (phases.red == 0 || phases.green == 0 || phases.yellow == 0)
+    {
+        throw std::invalid_argument("TrafficGrid: phase durations must be at least one tick");
+    }
+
+    wheel_.reserve(intersections);
+
+    // Stagger the first switch so the city is not in lockstep
+    for (std::size_t i = 0; i < intersections; ++i)
+    {
+        wheel_.schedule(1 + i % phases_.red, i);
+    }
+}
+
+std::size_t TrafficGrid::advanceTo(TimerWheel::Tick tick)
+{
+    return wheel_.advanceTo(tick, [this](std::uint64_t intersection, TimerWheel::Tick expiry)
+                            {
+        lights_.dispatch(intersection, EVT_TIMER_EXPIRE);
+        wheel_.schedule(expiry + durationOf(lights_.state(intersection)), intersection); });
+}
+
+TimerWheel::Tick TrafficGrid::durationOf(StateID state) const
+{
+    switch (state)
+    {
+    case STATE_GREEN:
+        return phases_.green;
+    case STATE_YELLOW:
+        return phases_.yellow;
+    default:
+        return phases_.red;
+    }
+}
@@ -10,54 +10,21 @@ void toGreen() { std::cout << "Transition: RED -> GREEN\n"; }
 void toYellow() { std::cout << "Transition: GREEN -> YELLOW\n"; }
 void toRed() { std::cout << "Transition: YELLOW -> RED\n"; }
 
-// Transition functions
-Transition redTransitions[] = {
-    {EVT_TIMER_EXPIRE, STATE_GREEN, toGreen}};
-
-Transition greenTransitions[] = {{EVT_TIMER_EXPIRE, STATE_YELLOW, toYellow}};
-
-Transition yellowTransitions[] = {{EVT_TIMER_EXPIRE, STATE_RED, toRed}};
-
 void trafficLogic()
 {
     std::cout << "🚦 Traffic Light State Machine \n";
 
     // Start in red state
-    StateID currentState = STATE_RED;
+    TrafficLight light(STATE_RED);
     std::cout << "Starting in 🔴 RED \n";
-    enterRed();
+    light.start();
 
     // RED to GREEN
     // GREEN to YELLOW
     // YELLOW to RED
-
-    // for (int i = 0; i < 3; ++i)
-    // {
-    //     Event event = EVT_TIMER_EXPIRE;
-    //     std::cout << "Event : EVT_TIMER_EXPIRE received \n";
-
-    //     switch (currentState)
-    //     {
-    //     case STATE_RED:
-    //         toGreen();
-    //         currentState = STATE_GREEN;
-    //         enterGreen();
-    //         break;
-
-    //     case STATE_GREEN:
-    //         toYellow();
-    //         currentState = STATE_YELLOW;
-    //         enterYellow();
-    //         break;
-
-    //     case STATE_YELLOW:
-    //         toRed();
-    //         currentState = STATE_RED;
-    //         enterRed();
-    //         break;
-
-    //     default:
-    //         break;
-    //     }
-    // }
-}
\ No newline at end of file
+    for (int i = 0; i < 3; ++i)
+    {
+        std::cout << "Event : EVT_TIMER_EXPIRE received \n";
+        light.dispatch(EVT_TIMER_EXPIRE);
+    }
+}
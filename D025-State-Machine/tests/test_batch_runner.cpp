@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <vector>
+#include "batch_runner.h"
+#include "traffic_light.h"
+
+using TrafficGrid = BatchRunner<trafficTable>;
+
+TEST(BatchRunnerTest, BroadcastAdvancesEveryMachine)
+{
+    TrafficGrid grid(1000, STATE_RED, 1);
+    grid.apply(EVT_TIMER_EXPIRE);
+    for (std::size_t i = 0; i < grid.size(); ++i)
+    {
+        ASSERT_EQ(grid.state(i), STATE_GREEN);
+    }
+
+    // One transition action and one entry action per machine
+    std::map<TransitionFunction, int> counts;
+    grid.forEachAction([&](const TrafficGrid::ActionRecord &record)
+                       { ++counts[record.action]; });
+    EXPECT_EQ(counts[toGreen], 1000);
+    EXPECT_EQ(counts[enterGreen], 1000);
+    EXPECT_EQ(counts.size(), 2u);
+}
+
+TEST(BatchRunnerTest, PerMachineEventsAndSkips)
+{
+    TrafficGrid grid(4, STATE_RED, 1);
+    const Event events[] = {EVT_TIMER_EXPIRE, TrafficGrid::NO_EVENT, EVT_TIMER_EXPIRE, TrafficGrid::NO_EVENT};
+    grid.apply(events);
+
+    EXPECT_EQ(grid.state(0), STATE_GREEN);
+    EXPECT_EQ(grid.state(1), STATE_RED);
+    EXPECT_EQ(grid.state(2), STATE_GREEN);
+    EXPECT_EQ(grid.state(3), STATE_RED);
+    EXPECT_EQ(grid.actions(0).size(), 4u);
+    EXPECT_EQ(grid.actions(0)[0].machine, 0u);
+    EXPECT_EQ(grid.actions(0)[2].machine, 2u);
+}
+
+TEST(BatchRunnerTest, ThreadCountDoesNotChangeResults)
+{
+    constexpr std::size_t MACHINES = 100003;
+
+    // Machine i gets an event on batch b when (i + b) % 3 != 0
+    std::vector<std::vector<Event>> batches(7, std::vector<Event>(MACHINES));
+    for (std::size_t b = 0; b < batches.size(); ++b)
+    {
+        for (std::size_t i = 0; i < MACHINES; ++i)
+        {
+            batches[b][i] = (i + b) % 3 != 0 ? EVT_TIMER_EXPIRE : TrafficGrid::NO_EVENT;
+        }
+    }
+
+    TrafficGrid single(MACHINES, STATE_RED, 1);
+    TrafficGrid multi(MACHINES, STATE_RED, 4);
+    ASSERT_EQ(multi.threadCount(), 4u);
+
+    for (const std::vector<Event> &batch : batches)
+    {
+        single.apply(batch.data());
+        multi.apply(batch.data());
+    }
+
+    std::size_t singleActions = 0;
+    std::size_t multiActions = 0;
+    single.forEachAction([&](const TrafficGrid::ActionRecord &)
+                         { ++singleActions; });
+    multi.forEachAction([&](const TrafficGrid::ActionRecord &)
+                        { ++multiActions; });
+
+    EXPECT_EQ(singleActions, multiActions);
+    for (std::size_t i = 0; i < MACHINES; ++i)
+    {
+        ASSERT_EQ(single.state(i), multi.state(i)) << "machine " << i;
+    }
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "timer_wheel.h"
+#include "traffic_grid.h"
+
+using Fired = std::vector<std::pair<std::uint64_t, TimerWheel::Tick>>;
+
+TEST(TimerWheelTest, FiresAtExpiryInOrder)
+{
+    TimerWheel wheel;
+    wheel.schedule(300, 3);
+    wheel.schedule(5, 1);
+    wheel.schedule(70000, 4);
+    wheel.schedule(256, 2);
+
+    Fired fired;
+    auto record = [&](std::uint64_t payload, TimerWheel::Tick expiry)
+    { fired.emplace_back(payload, expiry); };
+
+    EXPECT_EQ(wheel.advanceTo(4, record), 0u);
+    EXPECT_EQ(wheel.advanceTo(256, record), 2u);
+    EXPECT_EQ(wheel.advanceTo(100000, record), 2u);
+
+    const Fired expected = {{1, 5}, {2, 256}, {3, 300}, {4, 70000}};
+    EXPECT_EQ(fired, expected);
+    EXPECT_EQ(wheel.pending(), 0u);
+}
+
+TEST(TimerWheelTest, CancelledTimersNeverFire)
+{
+    TimerWheel wheel;
+    const TimerWheel::TimerId keep = wheel.schedule(10, 1);
+    const TimerWheel::TimerId drop = wheel.schedule(10, 2);
+
+    EXPECT_TRUE(wheel.cancel(drop));
+    EXPECT_FALSE(wheel.cancel(drop));
+    EXPECT_FALSE(wheel.cancel(TimerWheel::INVALID_TIMER));
+
+    Fired fired;
+    wheel.advanceTo(20, [&](std::uint64_t payload, TimerWheel::Tick expiry)
+                    { fired.emplace_back(payload, expiry); });
+    ASSERT_EQ(fired.size(), 1u);
+    EXPECT_EQ(fired[0].first, 1u);
+
+    // Handle of a timer that already fired is stale
+    EXPECT_FALSE(wheel.cancel(keep));
+}
+
+TEST(TimerWheelTest, MatchesSortedReferenceAcrossAllLevels)
+{
+    std::mt19937_64 random(42);
+    TimerWheel wheel(1000);
+
+    std::vector<std::pair<TimerWheel::Tick, std::uint64_t>> reference;
+    for (std::uint64_t i = 0; i < 20000; ++i)
+    {
+        // Mix of near, mid and far timers, including past the 2^32 overflow
+        const int bucket = static_cast<int>(random() % 4);
+        const TimerWheel::Tick range = bucket == 0 ? 300 : bucket == 1 ? 100000 : bucket == 2 ? 50000000 : (1ull << 34);
+        const TimerWheel::Tick expiry = 1001 + random() % range;
+        wheel.schedule(expiry, i);
+        reference.emplace_back(expiry, i);
+    }
+    std::sort(reference.begin(), reference.end());
+
+    std::vector<TimerWheel::Tick> firedExpiries;
+    TimerWheel::Tick last = 0;
+    bool inOrder = true;
+    for (TimerWheel::Tick t = 1000; t <= (1ull << 34) + 2000; t += (1ull << 28))
+    {
+        wheel.advanceTo(t, [&](std::uint64_t, TimerWheel::Tick expiry)
+                        {
+            inOrder = inOrder && expiry >= last && expiry <= t;
+            last = expiry;
+            firedExpiries.push_back(expiry); });
+    }
+
+    EXPECT_TRUE(inOrder);
+    ASSERT_EQ(firedExpiries.size(), reference.size());
+    for (std::size_t i = 0; i < reference.size(); ++i)
+    {
+        ASSERT_EQ(firedExpiries[i], reference[i].first);
+    }
+}
+
+TEST(TimerWheelTest, CallbacksCanReschedule)
+{
+    TimerWheel wheel;
+    wheel.schedule(10, 0);
+
+    int count = 0;
+    wheel.advanceTo(1000, [&](std::uint64_t payload, TimerWheel::Tick expiry)
+                    {
+        ++count;
+        wheel.schedule(expiry + 10, payload); });
+
+    EXPECT_EQ(count, 100);
+    EXPECT_EQ(wheel.pending(), 1u);
+}
+
+TEST(TimerWheelTest, CallbacksCanCancelTimersDueInTheSameSlot)
+{
+    TimerWheel wheel;
+    TimerWheel::TimerId ids[3];
+    for (std::uint64_t payload = 0; payload < 3; ++payload)
+    {
+        ids[payload] = wheel.schedule(10, payload);
+    }
+
+    std::vector<std::uint64_t> fired;
+    bool cancelled = false;
+    wheel.advanceTo(20, [&](std::uint64_t payload, TimerWheel::Tick)
+                    {
+        fired.push_back(payload);
+        if (!cancelled)
+        {
+            // Cancel whichever sibling has not fired yet
+            for (std::uint64_t other = 0; other < 3 && !cancelled; ++other)
+            {
+                if (other != payload)
+                {
+                    cancelled = wheel.cancel(ids[other]);
+                }
+            }
+        } });
+
+    EXPECT_TRUE(cancelled);
+    EXPECT_EQ(fired.size(), 2u);
+    EXPECT_EQ(wheel.pending(), 0u);
+
+    // The freed nodes are reused cleanly
+    wheel.schedule(30, 7);
+    fired.clear();
+    wheel.advanceTo(40, [&](std::uint64_t payload, TimerWheel::Tick)
+                    { fired.push_back(payload); });
+    EXPECT_EQ(fired, std::vector<std::uint64_t>{7});
+    EXPECT_EQ(wheel.pending(), 0u);
+}
+
+TEST(TrafficGridTest, LightsCycleOnTimerExpiry)
+{
+    // 1 tick = 1 s: red 30 s, green 25 s, yellow 5 s, one cycle = 60 s
+    TrafficGrid grid(1, PhaseDurations{30, 25, 5}, true);
+    VirtualClock clock;
+
+    EXPECT_EQ(grid.state(0), STATE_RED);
+    clock.advance(1);
+    EXPECT_EQ(grid.poll(clock), 1u);
+    EXPECT_EQ(grid.state(0), STATE_GREEN);
+    clock.advance(25);
+    grid.poll(clock);
+    EXPECT_EQ(grid.state(0), STATE_YELLOW);
+    clock.advance(5);
+    grid.poll(clock);
+    EXPECT_EQ(grid.state(0), STATE_RED);
+
+    // A simulated day: 1440 cycles of three switches each
+    TrafficGrid city(1000, PhaseDurations{30, 25, 5});
+    const std::size_t events = city.advanceTo(24 * 60 * 60);
+    EXPECT_GE(events, 1000u * 1440u * 3u - 3000u);
+    EXPECT_LE(events, 1000u * 1440u * 3u + 3000u);
+}
+
+TEST(TrafficGridTest, RejectsZeroPhaseDurations)
+{
+    EXPECT_THROW(TrafficGrid(4, PhaseDurations{0, 25, 5}), std::invalid_argument);
+    EXPECT_THROW(TrafficGrid(4, PhaseDurations{30, 0, 5}), std::invalid_argument);
+    EXPECT_THROW(TrafficGrid(4, PhaseDurations{30, 25, 0}), std::invalid_argument);
+}
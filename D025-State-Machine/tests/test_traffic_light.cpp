@@ -6,3 +6,90 @@ TEST(TrafficLightTest, BasicSanity)
     // Example: just check that the function runs
     EXPECT_NO_THROW(trafficLogic());
 }
+
+TEST(TrafficLightTest, TableIsResolvedAtCompileTime)
+{
+    static_assert(trafficTable.lookup(STATE_RED, EVT_TIMER_EXPIRE).targetState == STATE_GREEN, "RED -> GREEN");
+    static_assert(trafficTable.lookup(STATE_GREEN, EVT_TIMER_EXPIRE).targetState == STATE_YELLOW, "GREEN -> YELLOW");
+    static_assert(trafficTable.lookup(STATE_YELLOW, EVT_TIMER_EXPIRE).targetState == STATE_RED, "YELLOW -> RED");
+    static_assert(sizeof(TrafficLight) == sizeof(StateID), "a machine only stores its state");
+    SUCCEED();
+}
+
+TEST(TrafficLightTest, CyclesThroughAllStates)
+{
+    TrafficLight light(STATE_RED);
+    EXPECT_TRUE(light.dispatch(EVT_TIMER_EXPIRE));
+    EXPECT_EQ(light.state(), STATE_GREEN);
+    EXPECT_TRUE(light.dispatch(EVT_TIMER_EXPIRE));
+    EXPECT_EQ(light.state(), STATE_YELLOW);
+    EXPECT_TRUE(light.dispatch(EVT_TIMER_EXPIRE));
+    EXPECT_EQ(light.state(), STATE_RED);
+}
+
+// A second machine on the same engine, with actions that take a context
+namespace
+{
+    enum class Door
+    {
+        Closed,
+        Open,
+        Locked,
+        Count
+    };
+
+    enum class DoorEvent
+    {
+        Push,
+        Pull,
+        Lock,
+        Count
+    };
+
+    struct DoorLog
+    {
+        int opened = 0;
+        int entered = 0;
+    };
+
+    using DoorAction = void (*)(DoorLog &);
+    using DoorTransition = fsm::Transition<Door, DoorEvent, DoorAction>;
+    using DoorTable = fsm::Table<Door, DoorEvent, DoorAction, static_cast<std::size_t>(Door::Count), static_cast<std::size_t>(DoorEvent::Count)>;
+
+    constexpr DoorTransition closedTransitions[] = {
+        {DoorEvent::Push, Door::Open, [](DoorLog &log)
+         { ++log.opened; }},
+        {DoorEvent::Lock, Door::Locked, nullptr}};
+    constexpr DoorTransition openTransitions[] = {{DoorEvent::Pull, Door::Closed, nullptr}};
+
+    constexpr DoorTable buildDoorTable()
+    {
+        DoorTable table;
+        table.on(Door::Closed, closedTransitions)
+            .on(Door::Open, openTransitions)
+            .onEnter(Door::Open, [](DoorLog &log)
+                     { ++log.entered; });
+        return table;
+    }
+
+    constexpr DoorTable doorTable = buildDoorTable();
+}
+
+TEST(StateMachineEngine, ForwardsContextAndIgnoresUnhandledEvents)
+{
+    fsm::StateMachine<doorTable> door(Door::Closed);
+    DoorLog log;
+
+    EXPECT_FALSE(door.dispatch(DoorEvent::Pull, log));
+    EXPECT_EQ(door.state(), Door::Closed);
+
+    EXPECT_TRUE(door.dispatch(DoorEvent::Push, log));
+    EXPECT_EQ(door.state(), Door::Open);
+    EXPECT_EQ(log.opened, 1);
+    EXPECT_EQ(log.entered, 1);
+
+    EXPECT_TRUE(door.dispatch(DoorEvent::Pull, log));
+    EXPECT_TRUE(door.dispatch(DoorEvent::Lock, log));
+    EXPECT_EQ(door.state(), Door::Locked);
+    EXPECT_FALSE(door.dispatch(DoorEvent::Push, log));
+}
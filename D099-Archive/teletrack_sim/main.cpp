@@ -1,19 +1,111 @@
-#include "gnss_simulator.h"
-#include "engine_simulator.h"
-#include "logger.h"
+#include "engine_fleet.h"
 #include "aggregator.h"
+#include "async_logger.h"
+#include "loopback_broker.h"
+#include "mqtt_publisher.h"
+#include "telemetry_json.h"
+#include "tick_scheduler.h"
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
 
 int main()
 {
-    GNSSSimulator gnss_simulator;
-    EngineSimulator engine_simulator;
-    Logger logger;
-    Aggregator aggregator;
+    constexpr std::size_t VEHICLES = 10000;
+    constexpr std::uint64_t TICKS = 100; // 10 s of 100 ms ticks
+    constexpr std::uint64_t SEED = 2024;
+    constexpr std::size_t PARTITIONS = 16;
 
-    gnss_simulator.sayHello();
-    engine_simulator.sayHello();
-    logger.sayHello();
-    aggregator.sayHello();
+    std::vector<double> latitude(VEHICLES, 1.3521);
+    std::vector<double> longitude(VEHICLES, 103.8198);
+    EngineFleet engines(VEHICLES, SEED);
+
+    std::vector<WindowResult> windows; // closed during the current tick
+    Aggregator aggregator(WindowSpec::tumbling(1000), [&windows](const WindowResult &result)
+                          { windows.push_back(result); });
+
+    AsyncLogger::Options logOptions;
+    logOptions.path = "teletrack_sim.log";
+    logOptions.overflow = OverflowPolicy::Block; // every window gets its line
+    AsyncLogger logger(logOptions);
+
+    LoopbackBroker broker;
+    MqttPublisher publisher(broker.takeClientFd());
+    publisher.connect();
+
+    // Same seed, same output, whatever the core count
+    TickScheduler scheduler(std::thread::hardware_concurrency(), SEED);
+
+    scheduler.addStage({"gnss", {}, {"positions"}, [&](const TickScheduler::TickContext &context)
+                        {
+                            std::mt19937_64 rng(context.seed);
+                            std::uniform_real_distribution<double> step(-1e-4, 1e-4);
+                            const auto [begin, end] = context.range(VEHICLES);
+                            for (std::size_t i = begin; i < end; ++i)
+                            {
+                                latitude[i] += step(rng);
+                                longitude[i] += step(rng);
+                            }
+                        },
+                        PARTITIONS});
+
+    scheduler.addStage({"engine", {}, {"engine"}, [&](const TickScheduler::TickContext &context)
+                        {
+                            const auto [begin, end] = context.range(VEHICLES);
+                            engines.simulate(begin, end);
+                        },
+                        PARTITIONS});
+
+    // After every engine partition, before anyone reads the engines
+    scheduler.addStage({"engine tick", {}, {"engine"}, [&](const TickScheduler::TickContext &)
+                        { engines.endTick(); }});
+
+    scheduler.addStage({"aggregator", {"positions", "engine"}, {"windows"}, [&](const TickScheduler::TickContext &context)
+                        {
+                            windows.clear();
+                            const std::uint64_t t = context.tick * 100;
+                            for (std::uint32_t v = 0; v < VEHICLES; ++v)
+                            {
+                                aggregator.addGnss(GnssSample{v, t, latitude[v], longitude[v]});
+                                aggregator.addEngine(EngineSample{v, t, engines.rpm(v), engines.coolantTemp(v), engines.fuelRate(v)});
+                            }
+                        }});
+
+    scheduler.addStage({"logger", {"windows"}, {"log"}, [&](const TickScheduler::TickContext &)
+                        {
+                            for (const WindowResult &w : windows)
+                            {
+                                logger.info("vehicle {} window {} distance {} m rpm {}", w.vehicle, w.startMs,
+                                            w.stats.distanceM, w.stats.rpm.mean());
+                            }
+                        }});
+
+    scheduler.addStage({"publisher", {"windows"}, {"mqtt"}, [&](const TickScheduler::TickContext &)
+                        {
+                            // Room for the longest numbers, so nothing is ever cut off
+                            constexpr char PREFIX[] = "{\"vehicle\":%u,\"start\":%llu,\"distance\":";
+                            char payload[sizeof(PREFIX) + json::MAX_U32_CHARS + json::MAX_U64_CHARS + json::MAX_DOUBLE_CHARS + 1];
+                            for (const WindowResult &w : windows)
+                            {
+                                const int prefix = std::snprintf(payload, sizeof(payload), PREFIX, w.vehicle,
+                                                                 static_cast<unsigned long long>(w.startMs));
+                                char *end = json::writeNumber(payload + prefix, w.stats.distanceM);
+                                *end++ = '}';
+                                publisher.publish("teletrack/windows", payload, static_cast<std::size_t>(end - payload));
+                            }
+                            publisher.flush();
+                        }});
+
+    scheduler.run(TICKS);
+    publisher.disconnect();
+    logger.flush();
+
+    std::printf("%llu ticks of %zu vehicles on %u threads: %llu windows published, %llu log lines\n",
+                static_cast<unsigned long long>(scheduler.tick()), VEHICLES, scheduler.threadCount(),
+                static_cast<unsigned long long>(publisher.stats().published),
+                static_cast<unsigned long long>(logger.written()));
 
     return 0;
-};
\ No newline at end of file
+}
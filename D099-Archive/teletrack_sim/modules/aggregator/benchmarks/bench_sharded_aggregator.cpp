@@ -0,0 +1,66 @@
+// Samples per second through ShardedAggregator at 1, 2, 4, 8 and 16 workers.
+//
+// Usage: bench_sharded_aggregator [vehicles] [ticks]
+// Every tick (100 ms) each vehicle sends one GNSS fix and one engine sample;
+// windows are 10 s sliding by 1 s and the watermark advances every second.
+
+#include "sharded_aggregator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    double run(unsigned threads, std::uint32_t vehicles, std::uint64_t ticks, std::uint64_t &windows)
+    {
+        ShardedAggregator::Options options;
+        options.spec = WindowSpec::sliding(10000, 1000);
+        options.threads = threads;
+
+        windows = 0;
+        ShardedAggregator aggregator(options, [&](const WindowResult &)
+                                     { ++windows; });
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t tick = 0; tick < ticks; ++tick)
+        {
+            const std::uint64_t t = tick * 100;
+            for (std::uint32_t v = 0; v < vehicles; ++v)
+            {
+                aggregator.submit(GnssSample{v, t, 1.30 + 1e-5 * static_cast<double>(tick + v % 13), 103.8 + 1e-5 * static_cast<double>(tick)});
+                aggregator.submit(EngineSample{v, t, 800.0f + static_cast<float>((tick + v) % 4000), 90.0f, 2.0f});
+            }
+            if (tick % 10 == 9)
+            {
+                aggregator.advanceTo(t + 100);
+            }
+        }
+        aggregator.flush();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        return static_cast<double>(aggregator.processed()) / elapsed.count();
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const std::uint32_t vehicles = argc > 1 ? static_cast<std::uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 100000;
+    const std::uint64_t ticks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 50;
+
+    std::printf("%u vehicles, %llu ticks, %u hardware threads\n", vehicles, static_cast<unsigned long long>(ticks),
+                std::thread::hardware_concurrency());
+    std::printf("%8s %16s %10s %10s\n", "threads", "samples/s", "speedup", "windows");
+
+    double baseline = 0.0;
+    for (unsigned threads : {1u, 2u, 4u, 8u, 16u})
+    {
+        std::uint64_t windows = 0;
+        const double rate = run(threads, vehicles, ticks, windows);
+        if (threads == 1)
+        {
+            baseline = rate;
+        }
+        std::printf("%8u %16.0f %9.2fx %10llu\n", threads, rate, rate / baseline, static_cast<unsigned long long>(windows));
+    }
+    return 0;
+}
@@ -1,10 +1,105 @@
 #ifndef AGGREGATOR_H
 #define AGGREGATOR_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "telemetry_sample.h"
+#include "window_stats.h"
+
+/**
+ * Window shape: windows of lengthMs starting every slideMs.
+ * slideMs == lengthMs gives tumbling windows; a smaller slide (that divides
+ * the length) gives overlapping sliding windows.
+ */
+struct WindowSpec
+{
+    std::uint64_t lengthMs;
+    std::uint64_t slideMs;
+
+    static WindowSpec tumbling(std::uint64_t lengthMs) { return WindowSpec{lengthMs, lengthMs}; }
+    static WindowSpec sliding(std::uint64_t lengthMs, std::uint64_t slideMs) { return WindowSpec{lengthMs, slideMs}; }
+};
+
+/**
+ * Incremental per-vehicle window aggregator.
+ *
+ * Time is cut into panes of slideMs. Every sample is folded into its
+ * vehicle's current pane in O(1) and never stored; a window is the merge of
+ * the lengthMs / slideMs panes it covers, computed once when it closes.
+ * Each vehicle keeps a fixed ring of panes, so memory does not grow with
+ * the sample rate.
+ *
+ * Samples must arrive in time order per vehicle (vehicles may interleave
+ * freely); a sample older than its vehicle's open pane is counted in late()
+ * and ignored. A window closes when a later sample of the same vehicle
+ * arrives, or when advanceTo() moves the watermark past its end.
+ */
 class Aggregator
 {
 public:
+    using WindowCallback = std::function<void(const WindowResult &)>;
+
+    Aggregator() : Aggregator(WindowSpec::tumbling(1000), nullptr) {}
+    Aggregator(WindowSpec spec, WindowCallback onWindow);
+
     void sayHello();
+
+    void addGnss(const GnssSample &sample);
+    void addEngine(const EngineSample &sample);
+
+    // Close every window that ends at or before watermarkMs
+    void advanceTo(std::uint64_t watermarkMs);
+
+    // Close every window that holds data
+    void flush();
+
+    // The still open window of a vehicle, for dashboards; false if the vehicle is unknown
+    bool current(std::uint32_t vehicle, WindowResult &out) const;
+
+    const WindowSpec &spec() const { return spec_; }
+    std::size_t vehicleCount() const { return vehicles_.size(); }
+    std::uint64_t late() const { return late_; }
+
+private:
+    static constexpr std::uint64_t NO_PANE = ~std::uint64_t{0};
+
+    struct Vehicle
+    {
+        std::uint32_t id;
+        std::uint64_t openPane;     // pane new samples go to
+        std::uint64_t lastDataPane; // newest pane that received a sample
+        bool hasFix = false;
+        std::uint64_t lastFixMs = 0;
+        double lastLatitude = 0.0;
+        double lastLongitude = 0.0;
+    };
+
+    // Vehicle state for a sample at timestampMs, after closing the windows it
+    // leaves behind; nullptr when the sample is late
+    Vehicle *prepare(std::uint32_t vehicle, std::uint64_t timestampMs);
+
+    void roll(std::size_t index, std::uint64_t target);
+    void emit(std::size_t index, std::uint64_t lastPane);
+    void mergeWindow(std::size_t index, std::uint64_t lastPane, WindowStats &out) const;
+    WindowStats &pane(std::size_t index, std::uint64_t number) { return panes_[index * panesPerWindow_ + number % panesPerWindow_]; }
+
+    // Windows overlapping time 0 are reported as starting at 0
+    std::uint64_t windowStart(std::uint64_t endMs) const { return endMs > spec_.lengthMs ? endMs - spec_.lengthMs : 0; }
+
+    WindowSpec spec_;
+    std::uint64_t panesPerWindow_;
+    WindowCallback onWindow_;
+
+    std::unordered_map<std::uint32_t, std::size_t> index_; // vehicle id -> vehicles_ slot
+    std::vector<Vehicle> vehicles_;
+    std::vector<WindowStats> panes_; // panesPerWindow_ per vehicle, ring indexed by pane number
+    std::uint64_t late_ = 0;
 };
 
-#endif // AGGREGATOR_H
\ No newline at end of file
+// Great circle distance in metres between two WGS84 positions (degrees)
+double haversineMeters(double lat1, double lon1, double lat2, double lon2);
+
+#endif // AGGREGATOR_H
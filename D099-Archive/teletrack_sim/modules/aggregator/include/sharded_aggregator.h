@@ -0,0 +1,134 @@
+#ifndef SHARDED_AGGREGATOR_H
+#define SHARDED_AGGREGATOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "aggregator.h"
+
+/**
+ * Multi-core front end for Aggregator.
+ *
+ * Vehicles are hashed onto shards (several per worker thread). Each shard
+ * owns a plain single-threaded Aggregator and is processed by one worker at
+ * a time, guarded by an atomic claim flag, so aggregation itself takes no
+ * locks. The feeding thread stages samples per shard and hands them over in
+ * batches; only that hand-over queue has a mutex.
+ *
+ * Workers serve their own shards first and, when those are idle, steal
+ * pending batches from other shards, so a hot shard does not leave the rest
+ * of the machine waiting.
+ *
+ * Windows closed inside the shards are collected per shard and merged at
+ * each advanceTo()/flush(): the callback then runs on the calling thread,
+ * in (endMs, vehicle) order.
+ *
+ * submit(), advanceTo() and flush() must all be called from one thread.
+ */
+class ShardedAggregator
+{
+public:
+    struct Options
+    {
+        WindowSpec spec = WindowSpec::tumbling(1000);
+        unsigned threads = std::thread::hardware_concurrency();
+        unsigned shardsPerThread = 4; // more shards than workers leaves room to steal
+        std::size_t batchSize = 1024; // samples staged per shard before hand-over
+    };
+
+    ShardedAggregator(Options options, Aggregator::WindowCallback onWindow);
+    ~ShardedAggregator();
+
+    ShardedAggregator(const ShardedAggregator &) = delete;
+    ShardedAggregator &operator=(const ShardedAggregator &) = delete;
+
+    void submit(const GnssSample &sample) { stage(sample.vehicle, Record{sample}); }
+    void submit(const EngineSample &sample) { stage(sample.vehicle, Record{sample}); }
+
+    // Close every window ending at or before watermarkMs and deliver them
+    void advanceTo(std::uint64_t watermarkMs);
+
+    // Close every window holding data and deliver them
+    void flush();
+
+    unsigned threadCount() const { return workers_; }
+    std::size_t shardCount() const { return shards_.size(); }
+
+    // Samples aggregated so far, and batches run by a worker that does not own the shard
+    std::uint64_t processed() const { return processed_.load(std::memory_order_relaxed); }
+    std::uint64_t steals() const { return steals_.load(std::memory_order_relaxed); }
+    std::uint64_t late() const;
+
+private:
+    // One GNSS or engine sample, kept in arrival order
+    struct Record
+    {
+        explicit Record(const GnssSample &sample) : isGnss(true), gnss(sample) {}
+        explicit Record(const EngineSample &sample) : isGnss(false), engine(sample) {}
+
+        bool isGnss;
+        union
+        {
+            GnssSample gnss;
+            EngineSample engine;
+        };
+    };
+
+    static constexpr std::uint64_t NO_WATERMARK = ~std::uint64_t{0};
+    static constexpr std::uint64_t FLUSH = NO_WATERMARK - 1;
+
+    struct Batch
+    {
+        std::vector<Record> records;
+        std::uint64_t watermark = NO_WATERMARK; // applied after the records
+    };
+
+    struct alignas(64) Shard
+    {
+        explicit Shard(const WindowSpec &spec);
+
+        std::atomic<bool> claimed{false};
+        std::mutex queueMutex; // hand-over only
+        std::vector<Batch> queue;
+
+        // Touched only by the worker holding the claim
+        Aggregator aggregator;
+        std::vector<WindowResult> closed;
+        std::vector<Batch> running;
+    };
+
+    std::size_t shardOf(std::uint32_t vehicle) const;
+    void stage(std::uint32_t vehicle, const Record &record);
+
+    void handOver(std::size_t shard, Batch batch);
+    void broadcast(std::uint64_t watermark);
+    void waitIdle();
+    void deliver();
+
+    void workerLoop(unsigned worker);
+    bool tryRun(unsigned worker, std::size_t shard);
+
+    const Options options_;
+    const unsigned workers_;
+    Aggregator::WindowCallback onWindow_;
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<std::vector<Record>> staged_; // feeding thread only
+    std::vector<std::thread> threads_;
+
+    std::atomic<std::size_t> pending_{0}; // batches handed over but not yet run
+    std::mutex wakeMutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    bool stopping_ = false;
+
+    std::atomic<std::uint64_t> processed_{0};
+    std::atomic<std::uint64_t> steals_{0};
+};
+
+#endif // SHARDED_AGGREGATOR_H
@@ -0,0 +1,72 @@
+#ifndef WINDOW_STATS_H
+#define WINDOW_STATS_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * Running min / max / mean of one metric. Constant size, mergeable, so
+ * windows are built from partial results instead of raw samples.
+ */
+struct RunningStats
+{
+    std::uint64_t count = 0;
+    double min = std::numeric_limits<double>::infinity();
+    double max = -std::numeric_limits<double>::infinity();
+    double sum = 0.0;
+
+    void add(double value)
+    {
+        ++count;
+        sum += value;
+        min = value < min ? value : min;
+        max = value > max ? value : max;
+    }
+
+    void merge(const RunningStats &other)
+    {
+        count += other.count;
+        sum += other.sum;
+        min = other.min < min ? other.min : min;
+        max = other.max > max ? other.max : max;
+    }
+
+    double mean() const { return count ? sum / static_cast<double>(count) : 0.0; }
+};
+
+// Partial aggregate of one vehicle over one pane (or a whole window)
+struct WindowStats
+{
+    double distanceM = 0.0;       // along successive GNSS fixes
+    std::uint64_t movingMs = 0;   // time covered by those fix-to-fix segments
+    std::uint32_t fixes = 0;
+    RunningStats rpm;
+    RunningStats coolantTemp;
+    RunningStats fuelRate;
+
+    void merge(const WindowStats &other)
+    {
+        distanceM += other.distanceM;
+        movingMs += other.movingMs;
+        fixes += other.fixes;
+        rpm.merge(other.rpm);
+        coolantTemp.merge(other.coolantTemp);
+        fuelRate.merge(other.fuelRate);
+    }
+
+    // Metres per second over the fix-to-fix segments, 0 without any
+    double averageSpeed() const { return movingMs ? distanceM * 1000.0 / static_cast<double>(movingMs) : 0.0; }
+
+    bool empty() const { return fixes == 0 && rpm.count == 0; }
+};
+
+// One closed window of one vehicle, covering [startMs, endMs)
+struct WindowResult
+{
+    std::uint32_t vehicle;
+    std::uint64_t startMs;
+    std::uint64_t endMs;
+    WindowStats stats;
+};
+
+#endif // WINDOW_STATS_H
@@ -1,7 +1,185 @@
 #include "aggregator.h"
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    constexpr double EARTH_RADIUS_M = 6371008.8; // mean radius
+    constexpr double DEG_TO_RAD = 3.14159265358979323846 / 180.0;
+}
+
+double haversineMeters(double lat1, double lon1, double lat2, double lon2)
+{
+    const double dLat = (lat2 - lat1) * DEG_TO_RAD;
+    const double dLon = (lon2 - lon1) * DEG_TO_RAD;
+    const double sinLat = std::sin(dLat / 2.0);
+    const double sinLon = std::sin(dLon / 2.0);
+    const double a = sinLat * sinLat + std::cos(lat1 * DEG_TO_RAD) * std::cos(lat2 * DEG_TO_RAD) * sinLon * sinLon;
+    return 2.0 * EARTH_RADIUS_M * std::asin(std::sqrt(std::fmin(a, 1.0)));
+}
+
+Aggregator::Aggregator(WindowSpec spec, WindowCallback onWindow)
+    : spec_(spec), panesPerWindow_(0), onWindow_(std::move(onWindow))
+{
+    if (spec_.slideMs == 0 || spec_.lengthMs == 0 || spec_.lengthMs % spec_.slideMs != 0)
+    {
+        throw std::invalid_argument("Aggregator: window length must be a non-zero multiple of the slide");
+    }
+    panesPerWindow_ = spec_.lengthMs / spec_.slideMs;
+}
 
 void Aggregator::sayHello()
 {
     std::cout << "[AGGREGATOR]: Hello from Aggregator!" << std::endl;
-};
\ No newline at end of file
+};
+
+void Aggregator::addGnss(const GnssSample &sample)
+{
+    Vehicle *vehicle = prepare(sample.vehicle, sample.timestampMs);
+    if (!vehicle)
+    {
+        return;
+    }
+
+    WindowStats &stats = pane(static_cast<std::size_t>(vehicle - vehicles_.data()), vehicle->openPane);
+    ++stats.fixes;
+
+    // The segment from the previous fix counts towards the pane of the later fix
+    if (vehicle->hasFix)
+    {
+        stats.distanceM += haversineMeters(vehicle->lastLatitude, vehicle->lastLongitude, sample.latitude, sample.longitude);
+        stats.movingMs += sample.timestampMs - vehicle->lastFixMs;
+    }
+
+    vehicle->hasFix = true;
+    vehicle->lastFixMs = sample.timestampMs;
+    vehicle->lastLatitude = sample.latitude;
+    vehicle->lastLongitude = sample.longitude;
+}
+
+void Aggregator::addEngine(const EngineSample &sample)
+{
+    Vehicle *vehicle = prepare(sample.vehicle, sample.timestampMs);
+    if (!vehicle)
+    {
+        return;
+    }
+
+    WindowStats &stats = pane(static_cast<std::size_t>(vehicle - vehicles_.data()), vehicle->openPane);
+    stats.rpm.add(sample.rpm);
+    stats.coolantTemp.add(sample.coolantTemp);
+    stats.fuelRate.add(sample.fuelRate);
+}
+
+void Aggregator::advanceTo(std::uint64_t watermarkMs)
+{
+    // Pane k ends at (k + 1) * slide, so everything before this pane is complete
+    const std::uint64_t target = watermarkMs / spec_.slideMs;
+    for (std::size_t i = 0; i < vehicles_.size(); ++i)
+    {
+        roll(i, target);
+    }
+}
+
+void Aggregator::flush()
+{
+    for (std::size_t i = 0; i < vehicles_.size(); ++i)
+    {
+        roll(i, vehicles_[i].lastDataPane + panesPerWindow_);
+    }
+}
+
+bool Aggregator::current(std::uint32_t vehicle, WindowResult &out) const
+{
+    auto found = index_.find(vehicle);
+    if (found == index_.end())
+    {
+        return false;
+    }
+
+    const std::uint64_t open = vehicles_[found->second].openPane;
+    out.vehicle = vehicle;
+    out.endMs = (open + 1) * spec_.slideMs;
+    out.startMs = windowStart(out.endMs);
+    out.stats = WindowStats{};
+    mergeWindow(found->second, open, out.stats);
+    return true;
+}
+
+Aggregator::Vehicle *Aggregator::prepare(std::uint32_t vehicle, std::uint64_t timestampMs)
+{
+    const std::uint64_t target = timestampMs / spec_.slideMs;
+
+    auto inserted = index_.emplace(vehicle, vehicles_.size());
+    if (inserted.second)
+    {
+        vehicles_.push_back(Vehicle{vehicle, target, NO_PANE});
+        panes_.resize(panes_.size() + panesPerWindow_);
+    }
+
+    const std::size_t index = inserted.first->second;
+    if (target < vehicles_[index].openPane)
+    {
+        ++late_;
+        return nullptr;
+    }
+
+    roll(index, target);
+    vehicles_[index].lastDataPane = target;
+    return &vehicles_[index];
+}
+
+// Move a vehicle's open pane forward to target, emitting each window that ends
+// on the way and clearing the ring slots being reused
+void Aggregator::roll(std::size_t index, std::uint64_t target)
+{
+    Vehicle &vehicle = vehicles_[index];
+    while (vehicle.openPane < target)
+    {
+        // No data in the last panesPerWindow_ panes: the rest would be empty
+        if (vehicle.lastDataPane == NO_PANE || vehicle.openPane >= vehicle.lastDataPane + panesPerWindow_)
+        {
+            for (std::uint64_t k = 0; k < panesPerWindow_; ++k)
+            {
+                panes_[index * panesPerWindow_ + k] = WindowStats{};
+            }
+            vehicle.openPane = target;
+            return;
+        }
+
+        emit(index, vehicle.openPane);
+        ++vehicle.openPane;
+        pane(index, vehicle.openPane) = WindowStats{};
+    }
+}
+
+void Aggregator::emit(std::size_t index, std::uint64_t lastPane)
+{
+    if (!onWindow_)
+    {
+        return;
+    }
+
+    WindowResult result;
+    result.vehicle = vehicles_[index].id;
+    result.endMs = (lastPane + 1) * spec_.slideMs;
+    result.startMs = windowStart(result.endMs);
+    mergeWindow(index, lastPane, result.stats);
+    onWindow_(result);
+}
+
+// Merge the panes of the window ending with lastPane; panes before the
+// vehicle's first sample are still empty
+void Aggregator::mergeWindow(std::size_t index, std::uint64_t lastPane, WindowStats &out) const
+{
+    for (std::uint64_t k = 0; k < panesPerWindow_; ++k)
+    {
+        if (k > lastPane)
+        {
+            break;
+        }
+        out.merge(panes_[index * panesPerWindow_ + (lastPane - k) % panesPerWindow_]);
+    }
+}
@@ -0,0 +1,254 @@
+#include "sharded_aggregator.h"
+#include <algorithm>
+#include <utility>
+
+ShardedAggregator::Shard::Shard(const WindowSpec &spec)
+    : aggregator(spec, [this](const WindowResult &result)
+                 { closed.push_back(result); })
+{
+}
+
+ShardedAggregator::ShardedAggregator(Options options, Aggregator::WindowCallback onWindow)
+    : options_(options), workers_(std::max(1u, options.threads)), onWindow_(std::move(onWindow))
+{
+    const std::size_t shards = static_cast<std::size_t>(workers_) * std::max(1u, options_.shardsPerThread);
+
+    for (std::size_t i = 0; i < shards; ++i)
+    {
+        shards_.push_back(std::make_unique<Shard>(options_.spec));
+    }
+    staged_.resize(shards);
+
+    for (unsigned worker = 0; worker < workers_; ++worker)
+    {
+        threads_.emplace_back([this, worker]
+                              { workerLoop(worker); });
+    }
+}
+
+ShardedAggregator::~ShardedAggregator()
+{
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+void ShardedAggregator::advanceTo(std::uint64_t watermarkMs)
+{
+    broadcast(watermarkMs);
+    waitIdle();
+    deliver();
+}
+
+void ShardedAggregator::flush()
+{
+    broadcast(FLUSH);
+    waitIdle();
+    deliver();
+}
+
+// Only meaningful between advanceTo()/flush() calls, when no shard is running
+std::uint64_t ShardedAggregator::late() const
+{
+    std::uint64_t total = 0;
+    for (const auto &shard : shards_)
+    {
+        total += shard->aggregator.late();
+    }
+    return total;
+}
+
+// Multiplicative hash mapped onto [0, shards) without a division
+std::size_t ShardedAggregator::shardOf(std::uint32_t vehicle) const
+{
+    const std::uint64_t hash = static_cast<std::uint32_t>(vehicle * 0x9E3779B1u);
+    return static_cast<std::size_t>((hash * shards_.size()) >> 32);
+}
+
+void ShardedAggregator::stage(std::uint32_t vehicle, const Record &record)
+{
+    const std::size_t shard = shardOf(vehicle);
+    std::vector<Record> &records = staged_[shard];
+    records.push_back(record);
+    if (records.size() >= options_.batchSize)
+    {
+        Batch batch;
+        batch.records.swap(records);
+        records.reserve(options_.batchSize);
+        handOver(shard, std::move(batch));
+    }
+}
+
+void ShardedAggregator::handOver(std::size_t shard, Batch batch)
+{
+    {
+        std::lock_guard<std::mutex> lock(shards_[shard]->queueMutex);
+        shards_[shard]->queue.push_back(std::move(batch));
+    }
+    pending_.fetch_add(1, std::memory_order_release);
+
+    // Taking the lock orders this wake-up after a sleeping worker's check
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    wake_.notify_one();
+}
+
+// Send the staged samples plus a watermark to every shard
+void ShardedAggregator::broadcast(std::uint64_t watermark)
+{
+    for (std::size_t shard = 0; shard < shards_.size(); ++shard)
+    {
+        Batch batch;
+        batch.records.swap(staged_[shard]);
+        batch.watermark = watermark;
+        handOver(shard, std::move(batch));
+    }
+}
+
+void ShardedAggregator::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    idle_.wait(lock, [this]
+               { return pending_.load(std::memory_order_acquire) == 0; });
+}
+
+// Merge the windows every shard closed and hand them out in time order
+void ShardedAggregator::deliver()
+{
+    std::vector<WindowResult> merged;
+    for (const auto &shard : shards_)
+    {
+        merged.insert(merged.end(), shard->closed.begin(), shard->closed.end());
+        shard->closed.clear();
+    }
+
+    std::sort(merged.begin(), merged.end(), [](const WindowResult &a, const WindowResult &b)
+              { return a.endMs != b.endMs ? a.endMs < b.endMs : a.vehicle < b.vehicle; });
+
+    if (onWindow_)
+    {
+        for (const WindowResult &result : merged)
+        {
+            onWindow_(result);
+        }
+    }
+}
+
+void ShardedAggregator::workerLoop(unsigned worker)
+{
+    const std::size_t shards = shards_.size();
+    std::size_t victim = worker;
+
+    for (;;)
+    {
+        bool ran = false;
+
+        // Own shards first
+        for (std::size_t shard = worker; shard < shards; shard += workers_)
+        {
+            ran = tryRun(worker, shard) || ran;
+        }
+
+        // Then steal from the others, rotating the starting point
+        if (!ran)
+        {
+            for (std::size_t k = 0; k < shards && !ran; ++k)
+            {
+                victim = (victim + 1) % shards;
+                if (victim % workers_ != worker)
+                {
+                    ran = tryRun(worker, victim);
+                }
+            }
+        }
+
+        if (ran)
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        if (pending_.load(std::memory_order_acquire) > 0)
+        {
+            // Work exists but its shards are claimed right now
+            lock.unlock();
+            std::this_thread::yield();
+            continue;
+        }
+        if (stopping_)
+        {
+            return;
+        }
+        wake_.wait(lock, [this]
+                   { return stopping_ || pending_.load(std::memory_order_acquire) > 0; });
+    }
+}
+
+// Claim a shard and run everything queued on it; false if it was busy or empty
+bool ShardedAggregator::tryRun(unsigned worker, std::size_t index)
+{
+    Shard &shard = *shards_[index];
+    if (shard.claimed.load(std::memory_order_relaxed) || shard.claimed.exchange(true, std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(shard.queueMutex);
+        shard.running.swap(shard.queue);
+    }
+
+    const std::size_t batches = shard.running.size();
+    std::uint64_t samples = 0;
+    for (const Batch &batch : shard.running)
+    {
+        for (const Record &record : batch.records)
+        {
+            if (record.isGnss)
+            {
+                shard.aggregator.addGnss(record.gnss);
+            }
+            else
+            {
+                shard.aggregator.addEngine(record.engine);
+            }
+        }
+        samples += batch.records.size();
+
+        if (batch.watermark == FLUSH)
+        {
+            shard.aggregator.flush();
+        }
+        else if (batch.watermark != NO_WATERMARK)
+        {
+            shard.aggregator.advanceTo(batch.watermark);
+        }
+    }
+    shard.running.clear();
+    shard.claimed.store(false, std::memory_order_release);
+
+    if (batches == 0)
+    {
+        return false;
+    }
+
+    processed_.fetch_add(samples, std::memory_order_relaxed);
+    if (index % workers_ != worker)
+    {
+        steals_.fetch_add(batches, std::memory_order_relaxed);
+    }
+
+    if (pending_.fetch_sub(batches, std::memory_order_acq_rel) == batches)
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        idle_.notify_all();
+    }
+    return true;
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "aggregator.h"
+#include <vector>
+
+namespace
+{
+    // Collects every emitted window
+    struct Sink
+    {
+        std::vector<WindowResult> windows;
+
+        Aggregator::WindowCallback callback()
+        {
+            return [this](const WindowResult &result)
+            { windows.push_back(result); };
+        }
+    };
+
+    // 0.001 degrees of latitude
+    const double LAT_STEP_M = haversineMeters(0.0, 0.0, 0.001, 0.0);
+}
+
+TEST(HaversineTest, KnownDistances)
+{
+    EXPECT_NEAR(haversineMeters(0.0, 0.0, 1.0, 0.0), 111195.0, 1.0);
+    EXPECT_NEAR(haversineMeters(0.0, 0.0, 0.0, 1.0), 111195.0, 1.0);
+    EXPECT_NEAR(haversineMeters(60.0, 0.0, 60.0, 1.0), 55597.0, 1.0);
+    EXPECT_DOUBLE_EQ(haversineMeters(1.3521, 103.8198, 1.3521, 103.8198), 0.0);
+}
+
+TEST(AggregatorTest, RejectsLengthThatIsNotAMultipleOfSlide)
+{
+    EXPECT_THROW(Aggregator(WindowSpec::sliding(1000, 300), nullptr), std::invalid_argument);
+    EXPECT_THROW(Aggregator(WindowSpec::tumbling(0), nullptr), std::invalid_argument);
+}
+
+TEST(AggregatorTest, TumblingWindowDistanceSpeedAndEngineStats)
+{
+    Sink sink;
+    Aggregator aggregator(WindowSpec::tumbling(1000), sink.callback());
+
+    // Vehicle 7 moves 0.001 deg north every 100 ms
+    for (int i = 0; i < 10; ++i)
+    {
+        aggregator.addGnss(GnssSample{7, static_cast<std::uint64_t>(i * 100), 0.001 * i, 0.0});
+        aggregator.addEngine(EngineSample{7, static_cast<std::uint64_t>(i * 100), 1000.0f + 100.0f * i, 80.0f, 2.0f});
+    }
+    EXPECT_TRUE(sink.windows.empty());
+
+    // First sample of the next window closes [0, 1000)
+    aggregator.addGnss(GnssSample{7, 1000, 0.010, 0.0});
+    ASSERT_EQ(sink.windows.size(), 1u);
+
+    const WindowResult &w = sink.windows[0];
+    EXPECT_EQ(w.vehicle, 7u);
+    EXPECT_EQ(w.startMs, 0u);
+    EXPECT_EQ(w.endMs, 1000u);
+    EXPECT_EQ(w.stats.fixes, 10u);
+    EXPECT_NEAR(w.stats.distanceM, 9 * LAT_STEP_M, 1e-6);
+    EXPECT_EQ(w.stats.movingMs, 900u);
+    EXPECT_NEAR(w.stats.averageSpeed(), LAT_STEP_M / 0.1, 1e-6);
+    EXPECT_EQ(w.stats.rpm.count, 10u);
+    EXPECT_DOUBLE_EQ(w.stats.rpm.min, 1000.0);
+    EXPECT_DOUBLE_EQ(w.stats.rpm.max, 1900.0);
+    EXPECT_DOUBLE_EQ(w.stats.rpm.mean(), 1450.0);
+    EXPECT_DOUBLE_EQ(w.stats.coolantTemp.mean(), 80.0);
+
+    // The 900 -> 1000 segment belongs to the second window
+    aggregator.flush();
+    ASSERT_EQ(sink.windows.size(), 2u);
+    EXPECT_EQ(sink.windows[1].startMs, 1000u);
+    EXPECT_EQ(sink.windows[1].stats.fixes, 1u);
+    EXPECT_NEAR(sink.windows[1].stats.distanceM, LAT_STEP_M, 1e-6);
+}
+
+TEST(AggregatorTest, SlidingWindowsMergePanes)
+{
+    Sink sink;
+    Aggregator aggregator(WindowSpec::sliding(3000, 1000), sink.callback());
+
+    // One engine sample per second with rpm = 1000 * (second + 1)
+    for (std::uint64_t second = 0; second < 5; ++second)
+    {
+        aggregator.addEngine(EngineSample{1, second * 1000 + 500, 1000.0f * (second + 1), 90.0f, 1.0f});
+    }
+    aggregator.flush();
+
+    // Windows end at 1s, 2s, ... 7s; the last two only see the tail
+    ASSERT_EQ(sink.windows.size(), 7u);
+    const double expectedMin[] = {1000, 1000, 1000, 2000, 3000, 4000, 5000};
+    const double expectedMax[] = {1000, 2000, 3000, 4000, 5000, 5000, 5000};
+    for (std::size_t i = 0; i < sink.windows.size(); ++i)
+    {
+        const WindowResult &w = sink.windows[i];
+        EXPECT_EQ(w.endMs, (i + 1) * 1000);
+        EXPECT_EQ(w.endMs - w.startMs, i < 2 ? w.endMs : 3000u);
+        EXPECT_DOUBLE_EQ(w.stats.rpm.min, expectedMin[i]) << "window " << i;
+        EXPECT_DOUBLE_EQ(w.stats.rpm.max, expectedMax[i]) << "window " << i;
+    }
+    EXPECT_EQ(sink.windows[2].stats.rpm.count, 3u);
+    EXPECT_DOUBLE_EQ(sink.windows[2].stats.rpm.mean(), 2000.0);
+}
+
+TEST(AggregatorTest, SilentStretchesEmitNoEmptyWindows)
+{
+    Sink sink;
+    Aggregator aggregator(WindowSpec::tumbling(1000), sink.callback());
+
+    aggregator.addEngine(EngineSample{1, 100, 900.0f, 20.0f, 0.8f});
+    aggregator.addEngine(EngineSample{1, 1000000, 950.0f, 20.0f, 0.8f});
+
+    ASSERT_EQ(sink.windows.size(), 1u);
+    EXPECT_EQ(sink.windows[0].endMs, 1000u);
+}
+
+TEST(AggregatorTest, WatermarkClosesQuietVehicles)
+{
+    Sink sink;
+    Aggregator aggregator(WindowSpec::tumbling(1000), sink.callback());
+
+    aggregator.addEngine(EngineSample{1, 100, 900.0f, 20.0f, 0.8f});
+    aggregator.addEngine(EngineSample{2, 1500, 900.0f, 20.0f, 0.8f});
+    EXPECT_EQ(aggregator.vehicleCount(), 2u);
+
+    aggregator.advanceTo(999);
+    EXPECT_TRUE(sink.windows.empty());
+
+    aggregator.advanceTo(1000);
+    ASSERT_EQ(sink.windows.size(), 1u);
+    EXPECT_EQ(sink.windows[0].vehicle, 1u);
+
+    aggregator.advanceTo(2000);
+    ASSERT_EQ(sink.windows.size(), 2u);
+    EXPECT_EQ(sink.windows[1].vehicle, 2u);
+    EXPECT_EQ(sink.windows[1].startMs, 1000u);
+}
+
+TEST(AggregatorTest, LateSamplesAreCountedAndIgnored)
+{
+    Sink sink;
+    Aggregator aggregator(WindowSpec::tumbling(1000), sink.callback());
+
+    aggregator.addEngine(EngineSample{1, 2500, 1000.0f, 20.0f, 1.0f});
+    aggregator.addEngine(EngineSample{1, 1500, 9999.0f, 20.0f, 1.0f});
+    EXPECT_EQ(aggregator.late(), 1u);
+
+    aggregator.flush();
+    ASSERT_EQ(sink.windows.size(), 1u);
+    EXPECT_DOUBLE_EQ(sink.windows[0].stats.rpm.max, 1000.0);
+}
+
+TEST(AggregatorTest, CurrentShowsTheOpenWindow)
+{
+    Aggregator aggregator(WindowSpec::sliding(2000, 1000), nullptr);
+
+    WindowResult open;
+    EXPECT_FALSE(aggregator.current(3, open));
+
+    aggregator.addEngine(EngineSample{3, 200, 1000.0f, 20.0f, 1.0f});
+    aggregator.addEngine(EngineSample{3, 1200, 3000.0f, 20.0f, 1.0f});
+
+    ASSERT_TRUE(aggregator.current(3, open));
+    EXPECT_EQ(open.startMs, 0u);
+    EXPECT_EQ(open.endMs, 2000u);
+    EXPECT_EQ(open.stats.rpm.count, 2u);
+    EXPECT_DOUBLE_EQ(open.stats.rpm.mean(), 2000.0);
+}
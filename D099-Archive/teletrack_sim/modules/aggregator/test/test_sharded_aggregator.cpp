@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include "sharded_aggregator.h"
+#include <algorithm>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    // Deterministic mixed GNSS / engine stream, in time order
+    template <typename Fn>
+    void generate(std::uint32_t vehicles, std::uint64_t ticks, Fn &&emit)
+    {
+        for (std::uint64_t tick = 0; tick < ticks; ++tick)
+        {
+            const std::uint64_t t = tick * 100;
+            for (std::uint32_t v = 0; v < vehicles; ++v)
+            {
+                emit(GnssSample{v, t, 1.0 + 0.0001 * tick * (v % 7 + 1), 103.0 + 0.00005 * tick});
+                emit(EngineSample{v, t + 50, 800.0f + static_cast<float>((tick * 37 + v * 11) % 5000), 80.0f + v % 10, 1.5f});
+            }
+        }
+    }
+
+    bool sameWindow(const WindowResult &a, const WindowResult &b)
+    {
+        return a.vehicle == b.vehicle && a.startMs == b.startMs && a.endMs == b.endMs &&
+               a.stats.fixes == b.stats.fixes && a.stats.movingMs == b.stats.movingMs &&
+               a.stats.distanceM == b.stats.distanceM && a.stats.rpm.count == b.stats.rpm.count &&
+               a.stats.rpm.min == b.stats.rpm.min && a.stats.rpm.max == b.stats.rpm.max &&
+               a.stats.rpm.sum == b.stats.rpm.sum;
+    }
+}
+
+TEST(ShardedAggregatorTest, MatchesSingleThreadedAggregator)
+{
+    const WindowSpec spec = WindowSpec::sliding(2000, 500);
+
+    std::vector<WindowResult> expected;
+    Aggregator single(spec, [&](const WindowResult &result)
+                      { expected.push_back(result); });
+
+    std::vector<WindowResult> actual;
+    ShardedAggregator::Options options;
+    options.spec = spec;
+    options.threads = 3;
+    options.batchSize = 64;
+    ShardedAggregator sharded(options, [&](const WindowResult &result)
+                              { actual.push_back(result); });
+    EXPECT_EQ(sharded.threadCount(), 3u);
+    EXPECT_EQ(sharded.shardCount(), 12u);
+
+    std::uint64_t samples = 0;
+    auto feed = [&](const auto &sample)
+    {
+        using T = std::decay_t<decltype(sample)>;
+        if constexpr (std::is_same<T, GnssSample>::value)
+        {
+            single.addGnss(sample);
+        }
+        else
+        {
+            single.addEngine(sample);
+        }
+        sharded.submit(sample);
+        ++samples;
+    };
+    generate(200, 100, feed);
+    single.flush();
+    sharded.flush();
+
+    EXPECT_EQ(sharded.processed(), samples);
+    EXPECT_EQ(sharded.late(), 0u);
+
+    // Sharded output comes in (endMs, vehicle) order
+    EXPECT_TRUE(std::is_sorted(actual.begin(), actual.end(), [](const WindowResult &a, const WindowResult &b)
+                               { return std::tie(a.endMs, a.vehicle) < std::tie(b.endMs, b.vehicle); }));
+    std::sort(expected.begin(), expected.end(), [](const WindowResult &a, const WindowResult &b)
+              { return std::tie(a.endMs, a.vehicle) < std::tie(b.endMs, b.vehicle); });
+
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); ++i)
+    {
+        ASSERT_TRUE(sameWindow(actual[i], expected[i])) << "window " << i;
+    }
+}
+
+TEST(ShardedAggregatorTest, WatermarkDeliversClosedWindowsOnly)
+{
+    std::vector<WindowResult> windows;
+    ShardedAggregator::Options options;
+    options.threads = 2;
+    ShardedAggregator sharded(options, [&](const WindowResult &result)
+                              { windows.push_back(result); });
+
+    for (std::uint32_t v = 0; v < 50; ++v)
+    {
+        sharded.submit(EngineSample{v, 200, 1000.0f, 80.0f, 1.0f});
+        sharded.submit(EngineSample{v, 1200, 2000.0f, 80.0f, 1.0f});
+    }
+
+    sharded.advanceTo(1000);
+    ASSERT_EQ(windows.size(), 50u);
+    for (std::uint32_t v = 0; v < 50; ++v)
+    {
+        EXPECT_EQ(windows[v].vehicle, v);
+        EXPECT_EQ(windows[v].endMs, 1000u);
+        EXPECT_DOUBLE_EQ(windows[v].stats.rpm.max, 1000.0);
+    }
+
+    sharded.advanceTo(2000);
+    ASSERT_EQ(windows.size(), 100u);
+    EXPECT_EQ(windows[50].endMs, 2000u);
+    EXPECT_DOUBLE_EQ(windows[50].stats.rpm.max, 2000.0);
+}
+
+TEST(ShardedAggregatorTest, SingleHotVehicleStillCompletes)
+{
+    std::uint64_t windows = 0;
+    ShardedAggregator::Options options;
+    options.threads = 4;
+    options.batchSize = 16;
+    ShardedAggregator sharded(options, [&](const WindowResult &)
+                              { ++windows; });
+
+    for (std::uint64_t t = 0; t < 10000; ++t)
+    {
+        sharded.submit(EngineSample{42, t, 900.0f, 85.0f, 1.0f});
+    }
+    sharded.flush();
+
+    EXPECT_EQ(sharded.processed(), 10000u);
+    EXPECT_EQ(windows, 10u);
+}
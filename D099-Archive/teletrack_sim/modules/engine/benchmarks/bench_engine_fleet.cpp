@@ -0,0 +1,73 @@
+// Time per tick of EngineFleet against the 100 ms budget of a 10 Hz simulation.
+//
+// Usage: bench_engine_fleet [vehicles] [ticks]
+// The fleet is stepped whole on one thread, then sharded with
+// simulate(begin, end) over 2, 4 and 8 threads (started once per tick, as
+// the cost of a pool is not what is measured here).
+
+#include "engine_fleet.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Seconds per tick, stepping the fleet on `threads` threads
+    double run(unsigned threads, std::size_t vehicles, std::uint64_t ticks, float &checksum)
+    {
+        EngineFleet fleet(vehicles, 1);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t tick = 0; tick < ticks; ++tick)
+        {
+            if (threads == 1)
+            {
+                fleet.simulate();
+                continue;
+            }
+            std::vector<std::thread> shards;
+            for (unsigned shard = 0; shard < threads; ++shard)
+            {
+                shards.emplace_back([&fleet, shard, threads, vehicles]
+                                    { fleet.simulate(vehicles * shard / threads, vehicles * (shard + 1) / threads); });
+            }
+            for (std::thread &thread : shards)
+            {
+                thread.join();
+            }
+            fleet.endTick();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        checksum = fleet.rpm(vehicles / 2) + fleet.coolantTemp(vehicles - 1);
+        return elapsed.count() / static_cast<double>(fleet.ticks());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const std::size_t vehicles = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const std::uint64_t ticks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+    if (vehicles == 0 || ticks == 0)
+    {
+        std::fprintf(stderr, "usage: bench_engine_fleet [vehicles > 0] [ticks > 0]\n");
+        return 1;
+    }
+
+    std::printf("%zu vehicles, %llu ticks, %u hardware threads\n", vehicles, static_cast<unsigned long long>(ticks),
+                std::thread::hardware_concurrency());
+    std::printf("%8s %12s %16s %12s %10s\n", "threads", "ms/tick", "vehicles/s", "of 100 ms", "checksum");
+
+    const double budget = static_cast<double>(EngineFleet::TICK_SECONDS);
+    for (unsigned threads : {1u, 2u, 4u, 8u})
+    {
+        float checksum = 0.0f;
+        const double perTick = run(threads, vehicles, ticks, checksum);
+        std::printf("%8u %12.3f %16.0f %11.1f%% %10.1f\n", threads, perTick * 1e3, static_cast<double>(vehicles) / perTick,
+                    100.0 * perTick / budget, static_cast<double>(checksum));
+    }
+    return 0;
+}
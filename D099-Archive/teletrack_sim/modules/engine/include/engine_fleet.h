@@ -0,0 +1,65 @@
+#ifndef ENGINE_FLEET_H
+#define ENGINE_FLEET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Engine telemetry for a large batch of vehicles.
+ *
+ * State is kept as structure of arrays (one float column per quantity) and
+ * advanced by a branch-free per-tick step that the compiler vectorizes.
+ * Like gnss::GNSS::simulate(), one simulate() call is one tick; ticks are
+ * TICK_SECONDS long, i.e. 10 Hz.
+ *
+ * Each vehicle's driver demand follows a random walk from its own xorshift
+ * state, so a fleet is fully reproducible from its seed and independent of
+ * how the vehicles are split across threads.
+ */
+class EngineFleet
+{
+public:
+    static constexpr float TICK_SECONDS = 0.1f;
+
+    static constexpr float IDLE_RPM = 800.0f;
+    static constexpr float MAX_RPM = 6000.0f;
+    static constexpr float AMBIENT_C = 20.0f;
+    static constexpr float IDLE_FUEL_LPH = 0.8f; // litres per hour at idle
+
+    explicit EngineFleet(std::size_t vehicles, std::uint32_t seed = 1);
+
+    // Advance every vehicle by one tick
+    void simulate();
+
+    // Advance vehicles [begin, end) by one tick, for callers that shard the
+    // fleet across threads. Every vehicle must be stepped once per tick, and
+    // the caller ends the tick with endTick() once all shards are done.
+    void simulate(std::size_t begin, std::size_t end);
+    void endTick() { ++ticks_; }
+
+    std::size_t size() const { return rpm_.size(); }
+    std::uint64_t ticks() const { return ticks_; }
+
+    float rpm(std::size_t i) const { return rpm_[i]; }
+    float coolantTemp(std::size_t i) const { return coolant_[i]; } // deg C
+    float fuelRate(std::size_t i) const { return fuel_[i]; }       // litres per hour
+    float load(std::size_t i) const { return load_[i]; }           // 0..1
+
+    // Whole columns, for exporters and aggregators
+    const float *rpms() const { return rpm_.data(); }
+    const float *coolantTemps() const { return coolant_.data(); }
+    const float *fuelRates() const { return fuel_.data(); }
+    const float *loads() const { return load_.data(); }
+
+private:
+    std::vector<float> demand_;  // driver throttle demand, 0..1
+    std::vector<float> load_;    // engine load, lags demand
+    std::vector<float> rpm_;
+    std::vector<float> coolant_;
+    std::vector<float> fuel_;
+    std::vector<std::uint32_t> rng_; // xorshift32 state per vehicle
+    std::uint64_t ticks_ = 0;
+};
+
+#endif // ENGINE_FLEET_H
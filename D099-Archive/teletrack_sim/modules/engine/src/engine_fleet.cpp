@@ -0,0 +1,92 @@
+#include "engine_fleet.h"
+#include <algorithm>
+
+namespace
+{
+    // Per tick smoothing factors (fraction of the gap closed each tick)
+    constexpr float LOAD_RESPONSE = 0.3f;
+    constexpr float RPM_RESPONSE = 0.2f;
+
+    constexpr float DEMAND_STEP = 0.1f;         // max demand change per tick
+    constexpr float FUEL_PER_RPM_LOAD = 0.004f; // L/h per rpm at full load
+
+    // Coolant: heat from burnt fuel, loss to ambient, extra loss once the
+    // thermostat opens above THERMOSTAT_C
+    constexpr float HEAT_PER_FUEL = 0.9f;   // deg C per second per L/h
+    constexpr float AMBIENT_LOSS = 0.01f;   // per second per deg C above ambient
+    constexpr float THERMOSTAT_C = 88.0f;
+    constexpr float RADIATOR_LOSS = 2.0f;   // per second per deg C above THERMOSTAT_C
+
+    constexpr float RANDOM_SCALE = 1.0f / 16777216.0f; // 2^-24
+
+    std::uint32_t mix(std::uint32_t x)
+    {
+        x ^= x >> 16;
+        x *= 0x7feb352du;
+        x ^= x >> 15;
+        x *= 0x846ca68bu;
+        x ^= x >> 16;
+        return x != 0 ? x : 0x9e3779b9u; // xorshift must not start at zero
+    }
+
+    // One tick for count vehicles. Branch free with restrict-qualified columns
+    // so it vectorizes; the min/max clamps need -fno-trapping-math (CMakeLists).
+    void stepEngines(float *__restrict demand, float *__restrict load, float *__restrict rpm,
+                     float *__restrict coolant, float *__restrict fuel, std::uint32_t *__restrict rng,
+                     std::size_t count)
+    {
+        constexpr float dt = EngineFleet::TICK_SECONDS;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::uint32_t x = rng[i];
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            rng[i] = x;
+
+            // Top 24 bits as a signed int: converts to float with one SIMD instruction
+            const float noise = static_cast<float>(static_cast<std::int32_t>(x >> 8)) * RANDOM_SCALE - 0.5f;
+            const float d = std::min(std::max(demand[i] + noise * (2.0f * DEMAND_STEP), 0.0f), 1.0f);
+            demand[i] = d;
+
+            const float l = load[i] + (d - load[i]) * LOAD_RESPONSE;
+            load[i] = l;
+
+            const float targetRpm = EngineFleet::IDLE_RPM + l * (EngineFleet::MAX_RPM - EngineFleet::IDLE_RPM);
+            const float r = rpm[i] + (targetRpm - rpm[i]) * RPM_RESPONSE;
+            rpm[i] = r;
+
+            const float f = EngineFleet::IDLE_FUEL_LPH + FUEL_PER_RPM_LOAD * r * l;
+            fuel[i] = f;
+
+            const float t = coolant[i];
+            const float opened = std::max(t - THERMOSTAT_C, 0.0f);
+            const float dTemp = HEAT_PER_FUEL * f - AMBIENT_LOSS * (t - EngineFleet::AMBIENT_C) - RADIATOR_LOSS * opened;
+            coolant[i] = t + dTemp * dt;
+        }
+    }
+}
+
+EngineFleet::EngineFleet(std::size_t vehicles, std::uint32_t seed)
+    : demand_(vehicles), load_(vehicles, 0.0f), rpm_(vehicles, IDLE_RPM), coolant_(vehicles, AMBIENT_C),
+      fuel_(vehicles, IDLE_FUEL_LPH), rng_(vehicles)
+{
+    for (std::size_t i = 0; i < vehicles; ++i)
+    {
+        rng_[i] = mix(seed * 0x9e3779b9u + static_cast<std::uint32_t>(i));
+        demand_[i] = static_cast<float>(rng_[i] >> 8) * RANDOM_SCALE;
+    }
+}
+
+void EngineFleet::simulate()
+{
+    simulate(0, size());
+    endTick();
+}
+
+void EngineFleet::simulate(std::size_t begin, std::size_t end)
+{
+    stepEngines(demand_.data() + begin, load_.data() + begin, rpm_.data() + begin, coolant_.data() + begin,
+                fuel_.data() + begin, rng_.data() + begin, end - begin);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "engine_fleet.h"
+
+TEST(EngineFleetTest, StartsColdAtIdle)
+{
+    EngineFleet fleet(16);
+    ASSERT_EQ(fleet.size(), 16u);
+    for (std::size_t i = 0; i < fleet.size(); ++i)
+    {
+        EXPECT_FLOAT_EQ(fleet.rpm(i), EngineFleet::IDLE_RPM);
+        EXPECT_FLOAT_EQ(fleet.coolantTemp(i), EngineFleet::AMBIENT_C);
+        EXPECT_FLOAT_EQ(fleet.fuelRate(i), EngineFleet::IDLE_FUEL_LPH);
+        EXPECT_FLOAT_EQ(fleet.load(i), 0.0f);
+    }
+}
+
+TEST(EngineFleetTest, StaysWithinPhysicalLimits)
+{
+    EngineFleet fleet(1000, 7);
+    for (int tick = 0; tick < 3000; ++tick)
+    {
+        fleet.simulate();
+    }
+    EXPECT_EQ(fleet.ticks(), 3000u);
+
+    for (std::size_t i = 0; i < fleet.size(); ++i)
+    {
+        ASSERT_GE(fleet.load(i), 0.0f);
+        ASSERT_LE(fleet.load(i), 1.0f);
+        ASSERT_GE(fleet.rpm(i), EngineFleet::IDLE_RPM);
+        ASSERT_LE(fleet.rpm(i), EngineFleet::MAX_RPM);
+        ASSERT_GE(fleet.fuelRate(i), EngineFleet::IDLE_FUEL_LPH);
+        ASSERT_LT(fleet.fuelRate(i), 30.0f);
+        ASSERT_GT(fleet.coolantTemp(i), EngineFleet::AMBIENT_C);
+        ASSERT_LT(fleet.coolantTemp(i), 110.0f);
+    }
+}
+
+TEST(EngineFleetTest, WarmsUpToOperatingTemperature)
+{
+    EngineFleet fleet(100, 3);
+    for (int tick = 0; tick < 15 * 60 * 10; ++tick) // 15 simulated minutes
+    {
+        fleet.simulate();
+    }
+    for (std::size_t i = 0; i < fleet.size(); ++i)
+    {
+        EXPECT_GT(fleet.coolantTemp(i), 80.0f);
+    }
+}
+
+TEST(EngineFleetTest, VehiclesDiverge)
+{
+    EngineFleet fleet(2, 11);
+    for (int tick = 0; tick < 50; ++tick)
+    {
+        fleet.simulate();
+    }
+    EXPECT_NE(fleet.rpm(0), fleet.rpm(1));
+}
+
+TEST(EngineFleetTest, SameSeedIsReproducible)
+{
+    EngineFleet a(257, 42);
+    EngineFleet b(257, 42);
+    for (int tick = 0; tick < 100; ++tick)
+    {
+        a.simulate();
+        b.simulate();
+    }
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        ASSERT_EQ(a.rpm(i), b.rpm(i));
+        ASSERT_EQ(a.coolantTemp(i), b.coolantTemp(i));
+    }
+}
+
+TEST(EngineFleetTest, ShardedStepMatchesWholeFleet)
+{
+    EngineFleet whole(1001, 5);
+    EngineFleet sharded(1001, 5);
+    for (int tick = 0; tick < 100; ++tick)
+    {
+        whole.simulate();
+        sharded.simulate(0, 333);
+        sharded.simulate(333, 700);
+        sharded.simulate(700, 1001);
+        sharded.endTick();
+    }
+    EXPECT_EQ(sharded.ticks(), whole.ticks());
+    for (std::size_t i = 0; i < whole.size(); ++i)
+    {
+        ASSERT_EQ(whole.rpm(i), sharded.rpm(i));
+        ASSERT_EQ(whole.fuelRate(i), sharded.fuelRate(i));
+        ASSERT_EQ(whole.coolantTemp(i), sharded.coolantTemp(i));
+        ASSERT_EQ(whole.load(i), sharded.load(i));
+    }
+}
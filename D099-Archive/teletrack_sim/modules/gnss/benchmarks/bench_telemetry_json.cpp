@@ -0,0 +1,147 @@
+// JSON formatting throughput for a fleet tick.
+//
+// Usage: bench_telemetry_json [vehicles] [ticks]
+// Every tick formats one GNSS and one engine line per vehicle as NDJSON,
+// once with json::write*Lines into a reused buffer and once each with
+// snprintf("%.17g") and std::ostringstream, the usual ways to do it.
+
+#include "telemetry_json.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Fleet
+    {
+        std::vector<double> latitude;
+        std::vector<double> longitude;
+        std::vector<float> rpm;
+        std::vector<float> coolant;
+        std::vector<float> fuel;
+
+        explicit Fleet(std::size_t vehicles)
+        {
+            for (std::size_t v = 0; v < vehicles; ++v)
+            {
+                latitude.push_back(1.3521 + static_cast<double>(v % 1000) * 1.37e-4);
+                longitude.push_back(103.8198 - static_cast<double>(v / 1000) * 2.11e-4);
+                rpm.push_back(800.0f + static_cast<float>(v % 3000) * 1.37f);
+                coolant.push_back(70.0f + static_cast<float>(v % 25) * 0.83f);
+                fuel.push_back(1.1f + static_cast<float>(v % 90) * 0.157f);
+            }
+        }
+
+        std::size_t size() const { return latitude.size(); }
+
+        // Drift so every tick formats new numbers
+        void step()
+        {
+            for (std::size_t v = 0; v < size(); ++v)
+            {
+                latitude[v] += 1e-5;
+                longitude[v] -= 1e-5;
+                rpm[v] += 0.5f;
+            }
+        }
+    };
+
+    double seconds(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const char *what, std::uint64_t lines, std::uint64_t bytes, double elapsed)
+    {
+        std::printf("%-14s %12.0f lines/s %8.1f MB/s\n", what, static_cast<double>(lines) / elapsed,
+                    static_cast<double>(bytes) / elapsed / 1e6);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const std::size_t vehicles = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000;
+    const std::uint64_t ticks = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100;
+    std::printf("%zu vehicles, %llu ticks, 2 lines per vehicle per tick\n", vehicles, static_cast<unsigned long long>(ticks));
+
+    const std::uint64_t lines = 2 * vehicles * ticks;
+    std::uint64_t bytes = 0;
+
+    // json: one buffer sized for the worst case, reused every tick
+    {
+        Fleet fleet(vehicles);
+        std::vector<char> buffer(vehicles * (json::MAX_GNSS_BYTES + json::MAX_ENGINE_BYTES + 2));
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t t = 0; t < ticks; ++t)
+        {
+            fleet.step();
+            const json::BatchResult gnss = json::writeGnssLines(buffer.data(), buffer.size(), t * 100, 0,
+                                                                fleet.latitude.data(), fleet.longitude.data(), vehicles);
+            const json::BatchResult engine = json::writeEngineLines(buffer.data() + gnss.bytes, buffer.size() - gnss.bytes,
+                                                                    t * 100, 0, fleet.rpm.data(), fleet.coolant.data(),
+                                                                    fleet.fuel.data(), vehicles);
+            bytes += gnss.bytes + engine.bytes;
+        }
+        report("json::write", lines, bytes, seconds(start));
+    }
+
+    // snprintf with enough digits to round-trip
+    {
+        Fleet fleet(vehicles);
+        std::vector<char> buffer(vehicles * 512);
+        bytes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t t = 0; t < ticks; ++t)
+        {
+            fleet.step();
+            char *cursor = buffer.data();
+            for (std::size_t v = 0; v < vehicles; ++v)
+            {
+                cursor += std::snprintf(cursor, 256, "{\"vehicle\":%zu,\"timestamp\":%llu,\"latitude\":%.17g,\"longitude\":%.17g}\n",
+                                        v, static_cast<unsigned long long>(t * 100), fleet.latitude[v], fleet.longitude[v]);
+            }
+            for (std::size_t v = 0; v < vehicles; ++v)
+            {
+                cursor += std::snprintf(cursor, 256, "{\"vehicle\":%zu,\"timestamp\":%llu,\"rpm\":%.9g,\"coolantTemp\":%.9g,\"fuelRate\":%.9g}\n",
+                                        v, static_cast<unsigned long long>(t * 100), fleet.rpm[v], fleet.coolant[v], fleet.fuel[v]);
+            }
+            bytes += static_cast<std::uint64_t>(cursor - buffer.data());
+        }
+        report("snprintf", lines, bytes, seconds(start));
+    }
+
+    // ostringstream per line, the std::string way
+    {
+        Fleet fleet(vehicles);
+        bytes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t t = 0; t < ticks; ++t)
+        {
+            fleet.step();
+            std::string out;
+            for (std::size_t v = 0; v < vehicles; ++v)
+            {
+                std::ostringstream line;
+                line.precision(17);
+                line << "{\"vehicle\":" << v << ",\"timestamp\":" << t * 100 << ",\"latitude\":" << fleet.latitude[v]
+                     << ",\"longitude\":" << fleet.longitude[v] << "}\n";
+                out += line.str();
+            }
+            for (std::size_t v = 0; v < vehicles; ++v)
+            {
+                std::ostringstream line;
+                line.precision(9);
+                line << "{\"vehicle\":" << v << ",\"timestamp\":" << t * 100 << ",\"rpm\":" << fleet.rpm[v]
+                     << ",\"coolantTemp\":" << fleet.coolant[v] << ",\"fuelRate\":" << fleet.fuel[v] << "}\n";
+                out += line.str();
+            }
+            bytes += out.size();
+        }
+        report("ostringstream", lines, bytes, seconds(start));
+    }
+
+    return 0;
+}
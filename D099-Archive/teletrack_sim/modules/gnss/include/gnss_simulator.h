@@ -6,7 +6,10 @@ class GNSSSimulator
 {
 public:
     void sayHello();
-    std::string generateMockLocation();
+    std::string generateMockLocation(); // json::writeLocation() of the mock fix; write into your own buffer on hot paths
+
+    static constexpr double MOCK_LATITUDE = 1.3521;
+    static constexpr double MOCK_LONGITUDE = 103.8198;
 };
 
 #endif // GNSS_SIMULATOR_H
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef TELEMETRY_JSON_H
+#define TELEMETRY_JSON_H
+
+#include "telemetry_sample.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * JSON output for GNSS and engine samples, written straight into caller
+ * buffers: no std::string, no streams, no allocation.
+ *
+ * Numbers use the shortest text that parses back to the same double/float
+ * (std::to_chars, a Ryu implementation in libstdc++), so 1.3521 prints as
+ * 1.3521 and not 1.35210000000000008. JSON has no NaN or infinity; those
+ * are written as null.
+ *
+ *   {"vehicle":7,"timestamp":1000,"latitude":1.3521,"longitude":103.8198}
+ *   {"vehicle":7,"timestamp":1000,"rpm":812.5,"coolantTemp":88.25,"fuelRate":3.1}
+ *
+ * Single writers need MAX_*_BYTES of room and return 0 otherwise, so the hot
+ * path checks capacity once per record instead of once per field.
+ */
+namespace json
+{
+    constexpr std::size_t MAX_DOUBLE_CHARS = 24; // -2.2250738585072014e-308
+    constexpr std::size_t MAX_FLOAT_CHARS = 15;  // -1.17549435e-38
+    constexpr std::size_t MAX_U32_CHARS = 10;
+    constexpr std::size_t MAX_U64_CHARS = 20;
+
+    // Worst case for one record, without the NDJSON newline
+    constexpr std::size_t MAX_LOCATION_BYTES = sizeof("{\"latitude\":,\"longitude\":}") - 1 + 2 * MAX_DOUBLE_CHARS;
+    constexpr std::size_t MAX_GNSS_BYTES = sizeof("{\"vehicle\":,\"timestamp\":,\"latitude\":,\"longitude\":}") - 1 +
+                                           MAX_U32_CHARS + MAX_U64_CHARS + 2 * MAX_DOUBLE_CHARS;
+    constexpr std::size_t MAX_ENGINE_BYTES = sizeof("{\"vehicle\":,\"timestamp\":,\"rpm\":,\"coolantTemp\":,\"fuelRate\":}") - 1 +
+                                             MAX_U32_CHARS + MAX_U64_CHARS + 3 * MAX_FLOAT_CHARS;
+
+    // Shortest round-trip number, or null when not finite; out needs MAX_*_CHARS. Returns the end.
+    char *writeNumber(char *out, double value);
+    char *writeNumber(char *out, float value);
+
+    // One object, no newline. Return bytes written, 0 if capacity is below the matching MAX_*_BYTES.
+    std::size_t writeLocation(char *out, std::size_t capacity, double latitude, double longitude);
+    std::size_t writeGnss(char *out, std::size_t capacity, const GnssSample &sample);
+    std::size_t writeEngine(char *out, std::size_t capacity, const EngineSample &sample);
+
+    // How far a batch got before the buffer ran out; resume from samples
+    struct BatchResult
+    {
+        std::size_t samples = 0; // lines written
+        std::size_t bytes = 0;
+    };
+
+    // NDJSON, one line per sample
+    BatchResult writeGnssLines(char *out, std::size_t capacity, const GnssSample *samples, std::size_t count);
+    BatchResult writeEngineLines(char *out, std::size_t capacity, const EngineSample *samples, std::size_t count);
+
+    // NDJSON straight from fleet columns (vehicles firstVehicle.. firstVehicle + count - 1, one timestamp)
+    BatchResult writeGnssLines(char *out, std::size_t capacity, std::uint64_t timestampMs, std::uint32_t firstVehicle,
+                               const double *latitude, const double *longitude, std::size_t count);
+    BatchResult writeEngineLines(char *out, std::size_t capacity, std::uint64_t timestampMs, std::uint32_t firstVehicle,
+                                 const float *rpm, const float *coolantTemp, const float *fuelRate, std::size_t count);
+}
+
+#endif // TELEMETRY_JSON_H
@@ -1,4 +1,5 @@
 #include "gnss_simulator.h"
+#include "telemetry_json.h"
 #include <iostream>
 
 void GNSSSimulator::sayHello()
@@ -8,5 +9,7 @@ void GNSSSimulator::sayHello()
 
 std::string GNSSSimulator::generateMockLocation()
 {
-    return R"({"latitude":1.3521,"longitude":103.8198})";
+    char buffer[json::MAX_LOCATION_BYTES];
+    const std::size_t size = json::writeLocation(buffer, sizeof(buffer), MOCK_LATITUDE, MOCK_LONGITUDE);
+    return std::string(buffer, size);
 }
\ No newline at end of file
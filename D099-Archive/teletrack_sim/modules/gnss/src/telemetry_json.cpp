@@ -0,0 +1,156 @@
+#include "telemetry_json.h"
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    // Copy a key literal without its terminator; the size is a constant so this becomes a few stores
+    template <std::size_t N>
+    char *put(char *out, const char (&text)[N])
+    {
+        std::memcpy(out, text, N - 1);
+        return out + N - 1;
+    }
+
+    template <typename Int>
+    char *putInt(char *out, Int value)
+    {
+        return std::to_chars(out, out + json::MAX_U64_CHARS, value).ptr;
+    }
+
+    template <typename Float>
+    char *putFloat(char *out, Float value)
+    {
+        if (!std::isfinite(value))
+        {
+            return put(out, "null");
+        }
+        return std::to_chars(out, out + json::MAX_DOUBLE_CHARS, value).ptr;
+    }
+
+    // Unchecked: the caller made sure MAX_GNSS_BYTES fit
+    char *putGnss(char *out, std::uint32_t vehicle, std::uint64_t timestampMs, double latitude, double longitude)
+    {
+        out = put(out, "{\"vehicle\":");
+        out = putInt(out, vehicle);
+        out = put(out, ",\"timestamp\":");
+        out = putInt(out, timestampMs);
+        out = put(out, ",\"latitude\":");
+        out = putFloat(out, latitude);
+        out = put(out, ",\"longitude\":");
+        out = putFloat(out, longitude);
+        return put(out, "}");
+    }
+
+    // Unchecked: the caller made sure MAX_ENGINE_BYTES fit
+    char *putEngine(char *out, std::uint32_t vehicle, std::uint64_t timestampMs, float rpm, float coolantTemp,
+                    float fuelRate)
+    {
+        out = put(out, "{\"vehicle\":");
+        out = putInt(out, vehicle);
+        out = put(out, ",\"timestamp\":");
+        out = putInt(out, timestampMs);
+        out = put(out, ",\"rpm\":");
+        out = putFloat(out, rpm);
+        out = put(out, ",\"coolantTemp\":");
+        out = putFloat(out, coolantTemp);
+        out = put(out, ",\"fuelRate\":");
+        out = putFloat(out, fuelRate);
+        return put(out, "}");
+    }
+
+    // Shared NDJSON loop: line(cursor, i) writes record i unchecked
+    template <std::size_t MaxLine, typename Line>
+    json::BatchResult writeLines(char *out, std::size_t capacity, std::size_t count, Line line)
+    {
+        char *cursor = out;
+        char *const end = out + capacity;
+        std::size_t i = 0;
+        for (; i < count && static_cast<std::size_t>(end - cursor) >= MaxLine + 1; ++i)
+        {
+            cursor = line(cursor, i);
+            *cursor++ = '\n';
+        }
+        return json::BatchResult{i, static_cast<std::size_t>(cursor - out)};
+    }
+}
+
+namespace json
+{
+    char *writeNumber(char *out, double value)
+    {
+        return putFloat(out, value);
+    }
+
+    char *writeNumber(char *out, float value)
+    {
+        return putFloat(out, value);
+    }
+
+    std::size_t writeLocation(char *out, std::size_t capacity, double latitude, double longitude)
+    {
+        if (capacity < MAX_LOCATION_BYTES)
+        {
+            return 0;
+        }
+        char *cursor = put(out, "{\"latitude\":");
+        cursor = putFloat(cursor, latitude);
+        cursor = put(cursor, ",\"longitude\":");
+        cursor = putFloat(cursor, longitude);
+        cursor = put(cursor, "}");
+        return static_cast<std::size_t>(cursor - out);
+    }
+
+    std::size_t writeGnss(char *out, std::size_t capacity, const GnssSample &sample)
+    {
+        if (capacity < MAX_GNSS_BYTES)
+        {
+            return 0;
+        }
+        return static_cast<std::size_t>(
+            putGnss(out, sample.vehicle, sample.timestampMs, sample.latitude, sample.longitude) - out);
+    }
+
+    std::size_t writeEngine(char *out, std::size_t capacity, const EngineSample &sample)
+    {
+        if (capacity < MAX_ENGINE_BYTES)
+        {
+            return 0;
+        }
+        return static_cast<std::size_t>(
+            putEngine(out, sample.vehicle, sample.timestampMs, sample.rpm, sample.coolantTemp, sample.fuelRate) - out);
+    }
+
+    BatchResult writeGnssLines(char *out, std::size_t capacity, const GnssSample *samples, std::size_t count)
+    {
+        return writeLines<MAX_GNSS_BYTES>(out, capacity, count, [samples](char *cursor, std::size_t i)
+                                          {
+                                              const GnssSample &s = samples[i];
+                                              return putGnss(cursor, s.vehicle, s.timestampMs, s.latitude, s.longitude); });
+    }
+
+    BatchResult writeEngineLines(char *out, std::size_t capacity, const EngineSample *samples, std::size_t count)
+    {
+        return writeLines<MAX_ENGINE_BYTES>(out, capacity, count, [samples](char *cursor, std::size_t i)
+                                            {
+                                                const EngineSample &s = samples[i];
+                                                return putEngine(cursor, s.vehicle, s.timestampMs, s.rpm, s.coolantTemp, s.fuelRate); });
+    }
+
+    BatchResult writeGnssLines(char *out, std::size_t capacity, std::uint64_t timestampMs, std::uint32_t firstVehicle,
+                               const double *latitude, const double *longitude, std::size_t count)
+    {
+        return writeLines<MAX_GNSS_BYTES>(out, capacity, count, [&](char *cursor, std::size_t i)
+                                          { return putGnss(cursor, firstVehicle + static_cast<std::uint32_t>(i), timestampMs,
+                                                           latitude[i], longitude[i]); });
+    }
+
+    BatchResult writeEngineLines(char *out, std::size_t capacity, std::uint64_t timestampMs, std::uint32_t firstVehicle,
+                                 const float *rpm, const float *coolantTemp, const float *fuelRate, std::size_t count)
+    {
+        return writeLines<MAX_ENGINE_BYTES>(out, capacity, count, [&](char *cursor, std::size_t i)
+                                            { return putEngine(cursor, firstVehicle + static_cast<std::uint32_t>(i), timestampMs,
+                                                               rpm[i], coolantTemp[i], fuelRate[i]); });
+    }
+}
@@ -9,3 +9,9 @@ TEST(GnssSimulatorTest, GeneratesNonEmptyLocation)
     ASSERT_NE(loc.find("latitude"), std::string::npos);
     ASSERT_NE(loc.find("longitude"), std::string::npos);
 }
+
+TEST(GnssSimulatorTest, MockLocationIsShortestJson)
+{
+    GNSSSimulator sim;
+    EXPECT_EQ(sim.generateMockLocation(), R"({"latitude":1.3521,"longitude":103.8198})");
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "telemetry_json.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string number(double value)
+    {
+        char buffer[json::MAX_DOUBLE_CHARS];
+        return std::string(buffer, json::writeNumber(buffer, value));
+    }
+
+    std::string number(float value)
+    {
+        char buffer[json::MAX_FLOAT_CHARS];
+        return std::string(buffer, json::writeNumber(buffer, value));
+    }
+
+    std::vector<std::string> lines(const char *text, std::size_t size)
+    {
+        std::vector<std::string> out;
+        std::size_t begin = 0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (text[i] == '\n')
+            {
+                out.emplace_back(text + begin, i - begin);
+                begin = i + 1;
+            }
+        }
+        EXPECT_EQ(begin, size) << "last line not terminated";
+        return out;
+    }
+}
+
+TEST(TelemetryJsonTest, ShortestNumbers)
+{
+    EXPECT_EQ(number(1.3521), "1.3521");
+    EXPECT_EQ(number(103.8198), "103.8198");
+    EXPECT_EQ(number(0.1), "0.1");
+    EXPECT_EQ(number(-0.5), "-0.5");
+    EXPECT_EQ(number(100.0), "100");
+    EXPECT_EQ(number(812.5f), "812.5");
+    EXPECT_EQ(number(0.1f), "0.1"); // not 0.100000001
+    EXPECT_EQ(number(1e21), "1e+21");
+}
+
+TEST(TelemetryJsonTest, NonFiniteIsNull)
+{
+    EXPECT_EQ(number(std::numeric_limits<double>::quiet_NaN()), "null");
+    EXPECT_EQ(number(std::numeric_limits<double>::infinity()), "null");
+    EXPECT_EQ(number(-std::numeric_limits<float>::infinity()), "null");
+}
+
+TEST(TelemetryJsonTest, WorstCaseFitsTheBounds)
+{
+    EXPECT_EQ(number(-2.2250738585072014e-308).size(), json::MAX_DOUBLE_CHARS);
+    EXPECT_LE(number(-1.17549435e-38f).size(), json::MAX_FLOAT_CHARS); // 8 digits suffice for FLT_MIN
+
+    const double lowest = -std::numeric_limits<double>::denorm_min() * 3; // long mantissa, long exponent
+    const GnssSample gnss{0xFFFFFFFFu, 0xFFFFFFFFFFFFFFFFull, -2.2250738585072014e-308, lowest};
+    char buffer[json::MAX_GNSS_BYTES];
+    const std::size_t size = json::writeGnss(buffer, sizeof(buffer), gnss);
+    EXPECT_GT(size, 0u);
+    EXPECT_LE(size, json::MAX_GNSS_BYTES);
+}
+
+TEST(TelemetryJsonTest, RoundTripsRandomValues)
+{
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<std::uint64_t> bits;
+    for (int i = 0; i < 100000; ++i)
+    {
+        double value;
+        const std::uint64_t raw = bits(rng);
+        std::memcpy(&value, &raw, sizeof(value));
+        if (!std::isfinite(value))
+        {
+            continue;
+        }
+        const std::string text = number(value);
+        ASSERT_LE(text.size(), json::MAX_DOUBLE_CHARS);
+        ASSERT_EQ(std::strtod(text.c_str(), nullptr), value) << text;
+
+        const float single = static_cast<float>(value);
+        if (std::isfinite(single))
+        {
+            const std::string shortText = number(single);
+            ASSERT_LE(shortText.size(), json::MAX_FLOAT_CHARS);
+            ASSERT_EQ(std::strtof(shortText.c_str(), nullptr), single) << shortText;
+        }
+    }
+}
+
+TEST(TelemetryJsonTest, RecordLayout)
+{
+    char buffer[256];
+    std::size_t size = json::writeGnss(buffer, sizeof(buffer), GnssSample{7, 1000, 1.3521, 103.8198});
+    EXPECT_EQ(std::string(buffer, size), R"({"vehicle":7,"timestamp":1000,"latitude":1.3521,"longitude":103.8198})");
+
+    size = json::writeEngine(buffer, sizeof(buffer), EngineSample{7, 1000, 812.5f, 88.25f, 3.1f});
+    EXPECT_EQ(std::string(buffer, size), R"({"vehicle":7,"timestamp":1000,"rpm":812.5,"coolantTemp":88.25,"fuelRate":3.1})");
+}
+
+TEST(TelemetryJsonTest, RefusesSmallBuffers)
+{
+    char buffer[json::MAX_GNSS_BYTES];
+    EXPECT_EQ(json::writeGnss(buffer, json::MAX_GNSS_BYTES - 1, GnssSample{1, 2, 3.0, 4.0}), 0u);
+    EXPECT_EQ(json::writeEngine(buffer, json::MAX_ENGINE_BYTES - 1, EngineSample{1, 2, 3.0f, 4.0f, 5.0f}), 0u);
+    EXPECT_EQ(json::writeLocation(buffer, json::MAX_LOCATION_BYTES - 1, 1.0, 2.0), 0u);
+}
+
+TEST(TelemetryJsonTest, NdjsonFromSamplesResumesWhenFull)
+{
+    std::vector<GnssSample> samples;
+    for (std::uint32_t v = 0; v < 1000; ++v)
+    {
+        samples.push_back(GnssSample{v, 5000, 1.3521 + v * 1e-4, 103.8198 - v * 1e-4});
+    }
+
+    // Room for a few lines at a time: every call must stop cleanly and resume
+    std::vector<char> buffer(json::MAX_GNSS_BYTES * 4);
+    std::string all;
+    std::size_t done = 0;
+    while (done < samples.size())
+    {
+        const json::BatchResult result = json::writeGnssLines(buffer.data(), buffer.size(), samples.data() + done,
+                                                              samples.size() - done);
+        ASSERT_GT(result.samples, 0u);
+        all.append(buffer.data(), result.bytes);
+        done += result.samples;
+    }
+
+    const std::vector<std::string> out = lines(all.data(), all.size());
+    ASSERT_EQ(out.size(), samples.size());
+    for (std::uint32_t v = 0; v < samples.size(); v += 97)
+    {
+        char expected[json::MAX_GNSS_BYTES];
+        const std::size_t size = json::writeGnss(expected, sizeof(expected), samples[v]);
+        EXPECT_EQ(out[v], std::string(expected, size));
+    }
+
+    EXPECT_EQ(json::writeGnssLines(buffer.data(), json::MAX_GNSS_BYTES, samples.data(), samples.size()).samples, 0u);
+}
+
+TEST(TelemetryJsonTest, NdjsonFromFleetColumns)
+{
+    const std::size_t vehicles = 5000;
+    std::vector<double> latitude(vehicles, 1.3521);
+    std::vector<double> longitude(vehicles, 103.8198);
+    std::vector<float> rpm(vehicles, 812.5f);
+    std::vector<float> coolant(vehicles, 88.25f);
+    std::vector<float> fuel(vehicles, 3.1f);
+
+    std::vector<char> buffer(vehicles * (json::MAX_ENGINE_BYTES + 1));
+    json::BatchResult result = json::writeGnssLines(buffer.data(), buffer.size(), 100, 10, latitude.data(),
+                                                    longitude.data(), vehicles);
+    ASSERT_EQ(result.samples, vehicles);
+    std::vector<std::string> out = lines(buffer.data(), result.bytes);
+    ASSERT_EQ(out.size(), vehicles);
+    EXPECT_EQ(out[0], R"({"vehicle":10,"timestamp":100,"latitude":1.3521,"longitude":103.8198})");
+    EXPECT_EQ(out[vehicles - 1], R"({"vehicle":5009,"timestamp":100,"latitude":1.3521,"longitude":103.8198})");
+
+    result = json::writeEngineLines(buffer.data(), buffer.size(), 100, 0, rpm.data(), coolant.data(), fuel.data(), vehicles);
+    ASSERT_EQ(result.samples, vehicles);
+    out = lines(buffer.data(), result.bytes);
+    EXPECT_EQ(out[42], R"({"vehicle":42,"timestamp":100,"rpm":812.5,"coolantTemp":88.25,"fuelRate":3.1})");
+}
@@ -0,0 +1,125 @@
+// Messages per second through AsyncMqttClient on one I/O thread.
+//
+// Usage: bench_io_runtime [connections] [messages per connection]
+// Every connection is a socketpair with a coroutine broker on the same loop,
+// so the single thread does both sides of every connection.
+
+#include "async_mqtt_client.h"
+#include "event_loop.h"
+#include "mqtt_packet.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    // Count PUBLISH packets until DISCONNECT or EOF; CONNACK the CONNECT
+    io::Task<void> broker(io::EventLoop &loop, int fd, std::uint64_t &messages, int &closed, int total)
+    {
+        std::vector<std::uint8_t> rx;
+        std::vector<std::uint8_t> chunk(64 * 1024);
+        bool open = true;
+        while (open)
+        {
+            const int n = co_await loop.read(fd, chunk.data(), chunk.size());
+            if (n <= 0)
+            {
+                break;
+            }
+            rx.insert(rx.end(), chunk.data(), chunk.data() + n);
+
+            std::size_t used = 0;
+            mqtt::FixedHeader header;
+            while (open && mqtt::decodeFixedHeader(rx.data() + used, rx.size() - used, header) == mqtt::DecodeStatus::Ok &&
+                   rx.size() - used >= header.headerSize + header.remainingLength)
+            {
+                if (header.type == mqtt::CONNECT)
+                {
+                    std::vector<std::uint8_t> connack;
+                    mqtt::appendConnack(connack, 0);
+                    co_await io::writeAll(loop, fd, connack.data(), connack.size());
+                }
+                messages += header.type == mqtt::PUBLISH;
+                open = header.type != mqtt::DISCONNECT;
+                used += header.headerSize + header.remainingLength;
+            }
+            rx.erase(rx.begin(), rx.begin() + static_cast<std::ptrdiff_t>(used));
+        }
+        ::close(fd);
+
+        if (++closed == total)
+        {
+            loop.stop();
+        }
+    }
+
+    io::Task<void> client(io::EventLoop &loop, int fd, int messages)
+    {
+        io::AsyncMqttClient mqttClient(loop, fd);
+        co_await mqttClient.connect("vehicle");
+
+        char payload[64];
+        for (int i = 0; i < messages; ++i)
+        {
+            const int size = std::snprintf(payload, sizeof(payload), "{\"seq\":%d,\"rpm\":%d}", i, 800 + i % 4000);
+            co_await mqttClient.publish("teletrack/telemetry", payload, static_cast<std::size_t>(size));
+            if (i % 64 == 63)
+            {
+                co_await mqttClient.flush();
+            }
+        }
+        co_await mqttClient.disconnect();
+    }
+
+    void run(io::Backend backend, int connections, int messages)
+    {
+        std::unique_ptr<io::EventLoop> loop;
+        try
+        {
+            loop = io::EventLoop::create(backend);
+        }
+        catch (const std::exception &error)
+        {
+            std::printf("%-9s unavailable: %s\n", io::backendName(backend), error.what());
+            return;
+        }
+        std::uint64_t received = 0;
+        int closed = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < connections; ++i)
+        {
+            int fds[2];
+            if (::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) != 0)
+            {
+                std::perror("socketpair");
+                std::exit(1);
+            }
+            loop->spawn(broker(*loop, fds[0], received, closed, connections));
+            loop->spawn(client(*loop, fds[1], messages));
+        }
+        loop->run();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::printf("%-9s %6d connections %12.0f msg/s %10llu received\n", io::backendName(loop->backend()), connections,
+                    static_cast<double>(received) / elapsed.count(), static_cast<unsigned long long>(received));
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const int connections = argc > 1 ? std::atoi(argv[1]) : 4000;
+    const int messages = argc > 2 ? std::atoi(argv[2]) : 500;
+
+    for (io::Backend backend : {io::Backend::IoUring, io::Backend::Epoll})
+    {
+        run(backend, connections, messages);
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+#ifndef IO_ASYNC_MQTT_CLIENT_H
+#define IO_ASYNC_MQTT_CLIENT_H
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <string_view>
+#include <vector>
+#include "event_loop.h"
+
+namespace io
+{
+    /**
+     * MQTT 3.1.1 QoS 0 publisher running as coroutines on an EventLoop, so
+     * one I/O thread can drive thousands of broker connections. Packets come
+     * from the mqtt_publisher codec.
+     *
+     * publish() only appends to a buffer when a write is already in flight;
+     * the coroutine doing that write sends everything queued behind it in
+     * one go. flush() waits until the buffer is on the socket.
+     */
+    class AsyncMqttClient
+    {
+    public:
+        // Takes ownership of fd (made non-blocking)
+        AsyncMqttClient(EventLoop &loop, int fd);
+        ~AsyncMqttClient();
+
+        AsyncMqttClient(const AsyncMqttClient &) = delete;
+        AsyncMqttClient &operator=(const AsyncMqttClient &) = delete;
+
+        // CONNECT, then wait for CONNACK; throws std::runtime_error if refused or closed.
+        // Arguments must stay valid until the task is awaited.
+        Task<void> connect(std::string_view clientId, std::uint16_t keepAliveSeconds = 60);
+
+        // Queue one QoS 0 message (copied) and write it unless another publish is writing
+        Task<void> publish(std::string_view topic, const void *payload, std::size_t size);
+        Task<void> publish(std::string_view topic, std::string_view payload) { return publish(topic, payload.data(), payload.size()); }
+
+        // Wait until everything queued is written. Throws the write error if a
+        // write failed, now or earlier: the connection is unusable after that.
+        Task<void> flush();
+
+        // Flush, send DISCONNECT and close the write side
+        Task<void> disconnect();
+
+        std::uint64_t published() const noexcept { return published_; }
+        std::uint64_t bytesWritten() const noexcept { return bytesWritten_; }
+        std::uint64_t writes() const noexcept { return writes_; }
+
+    private:
+        Task<void> drain();
+
+        struct Drained
+        {
+            AsyncMqttClient &client;
+            bool await_ready() const noexcept { return !client.writing_; }
+            void await_suspend(std::coroutine_handle<> waiter) { client.drainWaiters_.push_back(waiter); }
+            void await_resume() const
+            {
+                if (client.error_)
+                {
+                    std::rethrow_exception(client.error_);
+                }
+            }
+        };
+
+        EventLoop &loop_;
+        int fd_;
+        std::vector<std::uint8_t> queued_;
+        std::vector<std::uint8_t> sending_;
+        bool writing_ = false;
+        std::vector<std::coroutine_handle<>> drainWaiters_;
+        std::exception_ptr error_; // first failed write, rethrown to flush() callers
+        std::uint64_t published_ = 0;
+        std::uint64_t bytesWritten_ = 0;
+        std::uint64_t writes_ = 0;
+    };
+}
+
+#endif // IO_ASYNC_MQTT_CLIENT_H
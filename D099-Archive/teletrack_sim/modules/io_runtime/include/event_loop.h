@@ -0,0 +1,176 @@
+#ifndef IO_EVENT_LOOP_H
+#define IO_EVENT_LOOP_H
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "task.h"
+
+/**
+ * Single threaded coroutine I/O runtime.
+ *
+ * One EventLoop runs on one I/O thread. Coroutines running on it co_await
+ * read(), write(), fsync() and sleepFor(), which suspend until the kernel
+ * completes the operation, so thousands of connections and file sinks share
+ * that thread. Simulation threads hand work over with spawn() and post().
+ *
+ * Two backends: io_uring, driven through raw syscalls (no liburing), is used
+ * when the kernel supports every opcode the runtime needs; otherwise epoll
+ * readiness plus non-blocking syscalls. With epoll, regular file I/O and
+ * fsync cannot be polled and run inline on the I/O thread.
+ */
+namespace io
+{
+    enum class Backend
+    {
+        Auto,    // io_uring if available, else epoll
+        IoUring,
+        Epoll
+    };
+
+    const char *backendName(Backend backend) noexcept;
+
+    // One pending operation. It lives in the awaiting coroutine's frame until completion.
+    struct Operation
+    {
+        enum class Kind : std::uint8_t
+        {
+            Read,
+            Write,
+            Fsync,
+            Timer
+        };
+
+        Kind kind = Kind::Read;
+        int fd = -1;
+        void *buffer = nullptr;
+        std::size_t size = 0;
+        std::int64_t offset = -1; // -1: stream position (sockets, pipes)
+        std::chrono::steady_clock::time_point deadline; // Timer
+        std::coroutine_handle<> waiter;
+        int result = 0; // bytes transferred, 0 for fsync / expired timers, or -errno
+
+        // Backend scratch
+        std::int64_t timespec[2] = {0, 0}; // io_uring timeout, layout of __kernel_timespec
+        bool polling = false;              // io_uring: waiting for readiness after -EAGAIN
+        bool notSocket = false;            // stream write: use write() instead of send()
+    };
+
+    class EventLoop;
+
+    // co_await result: bytes transferred (or 0), negative errno on failure
+    class OpAwaiter
+    {
+    public:
+        OpAwaiter(EventLoop &loop, const Operation &op) : loop_(loop), op_(op) {}
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> waiter);
+        int await_resume() const noexcept { return op_.result; }
+
+    private:
+        EventLoop &loop_;
+        Operation op_;
+    };
+
+    class EventLoop
+    {
+    public:
+        // Auto falls back to epoll when io_uring is missing or blocked; throws if the backend cannot start
+        static std::unique_ptr<EventLoop> create(Backend backend = Backend::Auto);
+
+        virtual ~EventLoop();
+
+        EventLoop(const EventLoop &) = delete;
+        EventLoop &operator=(const EventLoop &) = delete;
+
+        virtual Backend backend() const noexcept = 0;
+
+        // Process events on the calling thread until stop()
+        void run();
+
+        // Any thread: make run() return after the current iteration
+        void stop();
+
+        // Any thread: run fn on the loop thread
+        void post(std::function<void()> fn);
+
+        // Any thread: start task on the loop thread. The loop owns it until it
+        // finishes; an escaping exception is counted in failedTasks().
+        void spawn(Task<void> task);
+
+        // Run the loop on the calling thread until task finishes, then return its result
+        template <typename T>
+        T block(Task<T> task);
+
+        std::size_t activeTasks() const noexcept { return active_.load(std::memory_order_acquire); }
+        std::uint64_t failedTasks() const noexcept { return failed_.load(std::memory_order_relaxed); }
+
+        // Awaitables, loop thread only. With epoll, sockets and pipes must be non-blocking.
+        // At most one read and one write may be pending on an fd at a time: serialize
+        // them in one coroutine (as AsyncMqttClient does for writes). Both backends
+        // throw std::logic_error from the co_await of a second one. Positional
+        // (offset >= 0) file I/O is exempt.
+        OpAwaiter read(int fd, void *buffer, std::size_t size, std::int64_t offset = -1);
+        OpAwaiter write(int fd, const void *buffer, std::size_t size, std::int64_t offset = -1);
+        OpAwaiter fsync(int fd);
+        OpAwaiter sleepUntil(std::chrono::steady_clock::time_point deadline);
+        OpAwaiter sleepFor(std::chrono::nanoseconds duration) { return sleepUntil(std::chrono::steady_clock::now() + duration); }
+
+    protected:
+        EventLoop() = default;
+
+        // Start op. Returns true if it already completed (op.result set, waiter not resumed);
+        // otherwise the backend resumes op.waiter from poll() once it completes.
+        virtual bool submit(Operation &op) = 0;
+
+        // Wait for completions (block) or just collect ready ones, resuming their waiters
+        virtual void poll(bool block) = 0;
+
+        // Any thread: wake a blocked poll()
+        virtual void wake() = 0;
+
+    private:
+        friend class OpAwaiter;
+
+        // Runs posted functions and starts spawned tasks; false if nothing was queued
+        bool runQueued();
+        void start(Task<void> task);
+
+        std::mutex mutex_;
+        std::vector<std::function<void()>> posted_;
+        std::vector<Task<void>> spawned_;
+        std::atomic<bool> stopping_{false};
+        std::atomic<std::size_t> active_{0};
+        std::atomic<std::uint64_t> failed_{0};
+    };
+
+    template <typename T>
+    T EventLoop::block(Task<T> task)
+    {
+        task.handle().resume();
+        while (!task.done())
+        {
+            const bool ranQueued = runQueued();
+            if (!task.done())
+            {
+                poll(!ranQueued);
+            }
+        }
+        return task.result();
+    }
+
+    // Write all of buffer (at offset, advancing, unless -1); throws std::system_error
+    Task<std::size_t> writeAll(EventLoop &loop, int fd, const void *buffer, std::size_t size, std::int64_t offset = -1);
+
+    // Read exactly size bytes unless end of file comes first; returns the bytes read, throws std::system_error
+    Task<std::size_t> readExact(EventLoop &loop, int fd, void *buffer, std::size_t size, std::int64_t offset = -1);
+}
+
+#endif // IO_EVENT_LOOP_H
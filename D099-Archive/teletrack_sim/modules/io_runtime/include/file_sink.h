@@ -0,0 +1,45 @@
+#ifndef IO_FILE_SINK_H
+#define IO_FILE_SINK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "event_loop.h"
+
+namespace io
+{
+    /**
+     * Append-only file written from coroutines on one EventLoop, e.g. for
+     * logger or journal output that must not block a simulation thread.
+     *
+     * append() reserves the byte range when it is called, so concurrent
+     * appends land in call order whichever write the kernel finishes first.
+     * The data must stay valid until the returned task completes.
+     */
+    class FileSink
+    {
+    public:
+        FileSink(EventLoop &loop, const std::string &path); // truncates; throws std::system_error
+        ~FileSink();
+
+        FileSink(const FileSink &) = delete;
+        FileSink &operator=(const FileSink &) = delete;
+
+        Task<std::size_t> append(const void *data, std::size_t size);
+        Task<std::size_t> append(std::string_view text) { return append(text.data(), text.size()); }
+
+        // fsync; covers the appends that completed before it is awaited
+        Task<void> sync();
+
+        std::uint64_t size() const noexcept { return end_; } // bytes reserved so far
+        int fd() const noexcept { return fd_; }
+
+    private:
+        EventLoop &loop_;
+        int fd_ = -1;
+        std::uint64_t end_ = 0;
+    };
+}
+
+#endif // IO_FILE_SINK_H
@@ -0,0 +1,161 @@
+#ifndef IO_TASK_H
+#define IO_TASK_H
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace io
+{
+    /**
+     * Lazily started coroutine returning T.
+     *
+     * Nothing runs until the task is co_awaited (or handed to
+     * EventLoop::spawn / EventLoop::block). Completion resumes the awaiting
+     * coroutine directly (symmetric transfer), so long chains of tasks do
+     * not grow the stack. Exceptions propagate to the awaiter.
+     */
+    template <typename T = void>
+    class Task;
+
+    namespace detail
+    {
+        struct PromiseBase
+        {
+            std::coroutine_handle<> continuation = std::noop_coroutine();
+            std::exception_ptr error;
+
+            struct FinalAwaiter
+            {
+                bool await_ready() const noexcept { return false; }
+
+                template <typename Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+                {
+                    return handle.promise().continuation;
+                }
+
+                void await_resume() const noexcept {}
+            };
+
+            std::suspend_always initial_suspend() const noexcept { return {}; }
+            FinalAwaiter final_suspend() const noexcept { return {}; }
+            void unhandled_exception() noexcept { error = std::current_exception(); }
+        };
+
+        template <typename T>
+        struct Promise : PromiseBase
+        {
+            std::optional<T> value;
+
+            Task<T> get_return_object() noexcept;
+
+            template <typename U>
+            void return_value(U &&result) { value.emplace(std::forward<U>(result)); }
+
+            T take()
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+                return std::move(*value);
+            }
+        };
+
+        template <>
+        struct Promise<void> : PromiseBase
+        {
+            Task<void> get_return_object() noexcept;
+
+            void return_void() noexcept {}
+
+            void take()
+            {
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+            }
+        };
+    }
+
+    template <typename T>
+    class [[nodiscard]] Task
+    {
+    public:
+        using promise_type = detail::Promise<T>;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        Task() = default;
+        explicit Task(Handle handle) : handle_(handle) {}
+        Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+        Task &operator=(Task &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                handle_ = std::exchange(other.handle_, {});
+            }
+            return *this;
+        }
+
+        ~Task() { reset(); }
+
+        bool valid() const noexcept { return static_cast<bool>(handle_); }
+        bool done() const noexcept { return !handle_ || handle_.done(); }
+
+        auto operator co_await() && noexcept
+        {
+            struct Awaiter
+            {
+                Handle handle;
+
+                bool await_ready() const noexcept { return !handle || handle.done(); }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept
+                {
+                    handle.promise().continuation = awaiting;
+                    return handle;
+                }
+
+                T await_resume() { return handle.promise().take(); }
+            };
+            return Awaiter{handle_};
+        }
+
+        // For runners: start or resume the coroutine, and read the result once done()
+        Handle handle() const noexcept { return handle_; }
+        T result() { return handle_.promise().take(); }
+
+    private:
+        void reset()
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+                handle_ = {};
+            }
+        }
+
+        Handle handle_;
+    };
+
+    namespace detail
+    {
+        template <typename T>
+        Task<T> Promise<T>::get_return_object() noexcept
+        {
+            return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+        }
+
+        inline Task<void> Promise<void>::get_return_object() noexcept
+        {
+            return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+        }
+    }
+}
+
+#endif // IO_TASK_H
@@ -0,0 +1,106 @@
+#include "async_mqtt_client.h"
+#include "mqtt_packet.h"
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace io
+{
+    AsyncMqttClient::AsyncMqttClient(EventLoop &loop, int fd) : loop_(loop), fd_(fd)
+    {
+        ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) | O_NONBLOCK);
+    }
+
+    AsyncMqttClient::~AsyncMqttClient()
+    {
+        ::close(fd_);
+    }
+
+    Task<void> AsyncMqttClient::connect(std::string_view clientId, std::uint16_t keepAliveSeconds)
+    {
+        std::vector<std::uint8_t> packet;
+        mqtt::appendConnect(packet, clientId, keepAliveSeconds);
+        co_await writeAll(loop_, fd_, packet.data(), packet.size());
+        bytesWritten_ += packet.size();
+        ++writes_;
+
+        // CONNACK is always 4 bytes: type, length 2, session present, return code
+        std::uint8_t connack[4];
+        if (co_await readExact(loop_, fd_, connack, sizeof(connack)) != sizeof(connack))
+        {
+            throw std::runtime_error("io::AsyncMqttClient: broker closed the connection");
+        }
+        if (connack[0] >> 4 != mqtt::CONNACK || connack[1] != 2)
+        {
+            throw std::runtime_error("io::AsyncMqttClient: expected CONNACK");
+        }
+        if (connack[3] != 0)
+        {
+            throw std::runtime_error("io::AsyncMqttClient: connection refused");
+        }
+    }
+
+    Task<void> AsyncMqttClient::publish(std::string_view topic, const void *payload, std::size_t size)
+    {
+        mqtt::appendPublish(queued_, topic, payload, size, mqtt::QoS::AtMostOnce, 0);
+        ++published_;
+        if (!writing_)
+        {
+            co_await drain();
+        }
+    }
+
+    Task<void> AsyncMqttClient::flush()
+    {
+        if (writing_ || error_)
+        {
+            co_await Drained{*this};
+        }
+        else if (!queued_.empty())
+        {
+            co_await drain();
+        }
+    }
+
+    Task<void> AsyncMqttClient::disconnect()
+    {
+        mqtt::appendDisconnect(queued_);
+        co_await flush();
+        ::shutdown(fd_, SHUT_WR);
+    }
+
+    // The single writer: send batches until nothing is queued, then wake flush() waiters
+    Task<void> AsyncMqttClient::drain()
+    {
+        writing_ = true;
+        try
+        {
+            while (!queued_.empty())
+            {
+                sending_.swap(queued_);
+                co_await writeAll(loop_, fd_, sending_.data(), sending_.size());
+                bytesWritten_ += sending_.size();
+                ++writes_;
+                sending_.clear();
+            }
+        }
+        catch (...)
+        {
+            error_ = std::current_exception();
+            writing_ = false;
+            for (std::coroutine_handle<> waiter : std::exchange(drainWaiters_, {}))
+            {
+                waiter.resume();
+            }
+            throw;
+        }
+
+        writing_ = false;
+        for (std::coroutine_handle<> waiter : std::exchange(drainWaiters_, {}))
+        {
+            waiter.resume();
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#ifndef IO_BACKENDS_H
+#define IO_BACKENDS_H
+
+#include <cstdint>
+#include <vector>
+#include "event_loop.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace io
+{
+    /**
+     * epoll backend: try the syscall first, wait for readiness on -EAGAIN.
+     * Timers are a min-heap that bounds the epoll_wait timeout.
+     */
+    class EpollLoop final : public EventLoop
+    {
+    public:
+        EpollLoop();
+        ~EpollLoop() override;
+
+        Backend backend() const noexcept override { return Backend::Epoll; }
+
+    protected:
+        bool submit(Operation &op) override;
+        void poll(bool block) override;
+        void wake() override;
+
+    private:
+        struct Waiters
+        {
+            Operation *reader = nullptr;
+            Operation *writer = nullptr;
+            std::uint32_t events = 0; // currently registered interest
+            bool registered = false;
+        };
+
+        void updateInterest(int fd);
+        void expireTimers(std::vector<Operation *> &completed);
+
+        int epoll_ = -1;
+        int event_ = -1;
+        std::vector<Waiters> waiters_; // by fd
+        std::vector<Operation *> timers_; // min-heap on deadline
+    };
+
+    /**
+     * io_uring backend over the raw io_uring_setup / io_uring_enter syscalls.
+     * Every operation is one SQE whose user_data is the Operation. An eventfd
+     * read stays armed so wake() can interrupt a blocking wait.
+     */
+    class UringLoop final : public EventLoop
+    {
+    public:
+        explicit UringLoop(unsigned entries = 4096);
+        ~UringLoop() override;
+
+        Backend backend() const noexcept override { return Backend::IoUring; }
+
+        // The kernel lets us create a ring and supports every opcode used here
+        static bool supported();
+
+    protected:
+        bool submit(Operation &op) override;
+        void poll(bool block) override;
+        void wake() override;
+
+    private:
+        io_uring_sqe *nextSqe();
+        void prepare(Operation &op);
+        void armWake();
+        int enter(unsigned submit, unsigned waitFor);
+        void release() noexcept;
+        bool *inFlight(const Operation &op); // the fd's flag for a stream read or write, else nullptr
+
+        struct Streams
+        {
+            bool reading = false;
+            bool writing = false;
+        };
+
+        int ring_ = -1;
+        int event_ = -1;
+        std::uint64_t wakeValue_ = 0;
+        unsigned pending_ = 0; // SQEs queued but not yet submitted
+        std::vector<Streams> streams_; // by fd
+
+        void *sqMap_ = nullptr;
+        std::size_t sqMapSize_ = 0;
+        void *cqMap_ = nullptr;
+        std::size_t cqMapSize_ = 0;
+        io_uring_sqe *sqes_ = nullptr;
+        std::size_t sqesSize_ = 0;
+
+        unsigned *sqHead_ = nullptr;
+        unsigned *sqTail_ = nullptr;
+        unsigned sqMask_ = 0;
+        unsigned sqEntries_ = 0;
+        unsigned *sqArray_ = nullptr;
+        unsigned *cqHead_ = nullptr;
+        unsigned *cqTail_ = nullptr;
+        unsigned cqMask_ = 0;
+        io_uring_cqe *cqes_ = nullptr;
+    };
+}
+
+#endif // IO_BACKENDS_H
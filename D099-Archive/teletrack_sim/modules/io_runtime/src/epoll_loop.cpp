@@ -0,0 +1,238 @@
+#include "backends.h"
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace io
+{
+    namespace
+    {
+        bool laterDeadline(const Operation *a, const Operation *b) { return a->deadline > b->deadline; }
+
+        // One non-blocking attempt: bytes, or -errno
+        int attempt(Operation &op)
+        {
+            ssize_t result = 0;
+            if (op.kind == Operation::Kind::Read)
+            {
+                result = op.offset < 0 ? ::read(op.fd, op.buffer, op.size) : ::pread(op.fd, op.buffer, op.size, op.offset);
+            }
+            else if (op.offset >= 0)
+            {
+                result = ::pwrite(op.fd, op.buffer, op.size, op.offset);
+            }
+            else
+            {
+                // send() so a closed peer gives EPIPE instead of SIGPIPE
+                if (!op.notSocket)
+                {
+                    result = ::send(op.fd, op.buffer, op.size, MSG_NOSIGNAL);
+                    if (result < 0 && errno == ENOTSOCK)
+                    {
+                        op.notSocket = true;
+                    }
+                }
+                if (op.notSocket)
+                {
+                    result = ::write(op.fd, op.buffer, op.size);
+                }
+            }
+            return result < 0 ? -errno : static_cast<int>(result);
+        }
+    }
+
+    EpollLoop::EpollLoop()
+    {
+        epoll_ = ::epoll_create1(EPOLL_CLOEXEC);
+        event_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (epoll_ < 0 || event_ < 0)
+        {
+            const int error = errno;
+            if (epoll_ >= 0)
+            {
+                ::close(epoll_);
+            }
+            throw std::system_error(error, std::generic_category(), "io::EpollLoop");
+        }
+
+        epoll_event wakeEvent{};
+        wakeEvent.events = EPOLLIN;
+        wakeEvent.data.fd = event_;
+        ::epoll_ctl(epoll_, EPOLL_CTL_ADD, event_, &wakeEvent);
+    }
+
+    EpollLoop::~EpollLoop()
+    {
+        ::close(event_);
+        ::close(epoll_);
+    }
+
+    bool EpollLoop::submit(Operation &op)
+    {
+        switch (op.kind)
+        {
+        case Operation::Kind::Timer:
+            if (op.deadline <= std::chrono::steady_clock::now())
+            {
+                op.result = 0;
+                return true;
+            }
+            timers_.push_back(&op);
+            std::push_heap(timers_.begin(), timers_.end(), laterDeadline);
+            return false;
+
+        case Operation::Kind::Fsync:
+            op.result = ::fsync(op.fd) == 0 ? 0 : -errno;
+            return true;
+
+        case Operation::Kind::Read:
+        case Operation::Kind::Write:
+            break;
+        }
+
+        // One parked reader and one parked writer per fd: a second would overwrite the first
+        const bool reading = op.kind == Operation::Kind::Read;
+        if (static_cast<std::size_t>(op.fd) < waiters_.size())
+        {
+            const Waiters &parked = waiters_[static_cast<std::size_t>(op.fd)];
+            if ((reading ? parked.reader : parked.writer) != nullptr)
+            {
+                throw std::logic_error(reading ? "io::EpollLoop: fd already has a pending read"
+                                               : "io::EpollLoop: fd already has a pending write");
+            }
+        }
+
+        const int result = attempt(op);
+        if (result != -EAGAIN)
+        {
+            op.result = result;
+            return true;
+        }
+
+        if (static_cast<std::size_t>(op.fd) >= waiters_.size())
+        {
+            waiters_.resize(static_cast<std::size_t>(op.fd) + 1);
+        }
+        Waiters &waiters = waiters_[static_cast<std::size_t>(op.fd)];
+        (reading ? waiters.reader : waiters.writer) = &op;
+        updateInterest(op.fd);
+        return false;
+    }
+
+    void EpollLoop::poll(bool block)
+    {
+        int timeoutMs = block ? -1 : 0;
+        if (block && !timers_.empty())
+        {
+            const auto wait = timers_.front()->deadline - std::chrono::steady_clock::now();
+            const auto ms = std::chrono::ceil<std::chrono::milliseconds>(wait).count();
+            timeoutMs = static_cast<int>(std::clamp<long long>(ms, 0, 60000));
+        }
+
+        epoll_event events[256];
+        const int count = ::epoll_wait(epoll_, events, 256, timeoutMs);
+
+        std::vector<Operation *> completed;
+        for (int i = 0; i < count; ++i)
+        {
+            const int fd = events[i].data.fd;
+            if (fd == event_)
+            {
+                std::uint64_t value;
+                while (::read(event_, &value, sizeof(value)) > 0)
+                {
+                }
+                continue;
+            }
+
+            Waiters &waiters = waiters_[static_cast<std::size_t>(fd)];
+            const std::uint32_t ready = events[i].events;
+            const bool failed = (ready & (EPOLLERR | EPOLLHUP)) != 0;
+
+            for (Operation **slot : {&waiters.reader, &waiters.writer})
+            {
+                Operation *op = *slot;
+                const std::uint32_t wanted = slot == &waiters.reader ? EPOLLIN : EPOLLOUT;
+                if (op == nullptr || ((ready & wanted) == 0 && !failed))
+                {
+                    continue;
+                }
+                const int result = attempt(*op);
+                if (result == -EAGAIN)
+                {
+                    continue; // spurious, keep waiting
+                }
+                op->result = result;
+                *slot = nullptr;
+                completed.push_back(op);
+            }
+            updateInterest(fd);
+        }
+
+        expireTimers(completed);
+
+        // Resume last: a resumed coroutine may submit on the same fd again
+        for (Operation *op : completed)
+        {
+            op->waiter.resume();
+        }
+    }
+
+    void EpollLoop::wake()
+    {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const ssize_t written = ::write(event_, &one, sizeof(one));
+    }
+
+    // Level triggered interest matching the parked operations of fd. An fd
+    // with nothing parked is removed, or hang-ups would wake every poll.
+    void EpollLoop::updateInterest(int fd)
+    {
+        Waiters &waiters = waiters_[static_cast<std::size_t>(fd)];
+        const std::uint32_t events = (waiters.reader ? EPOLLIN : 0u) | (waiters.writer ? EPOLLOUT : 0u);
+
+        if (events == 0)
+        {
+            if (waiters.registered)
+            {
+                ::epoll_ctl(epoll_, EPOLL_CTL_DEL, fd, nullptr);
+                waiters.registered = false;
+            }
+            waiters.events = 0;
+            return;
+        }
+        if (waiters.registered && events == waiters.events)
+        {
+            return;
+        }
+
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+        if (::epoll_ctl(epoll_, waiters.registered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event) != 0)
+        {
+            // Closed and reused since the last registration, or registered behind our back
+            ::epoll_ctl(epoll_, errno == ENOENT ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event);
+        }
+        waiters.registered = true;
+        waiters.events = events;
+    }
+
+    void EpollLoop::expireTimers(std::vector<Operation *> &completed)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        while (!timers_.empty() && timers_.front()->deadline <= now)
+        {
+            std::pop_heap(timers_.begin(), timers_.end(), laterDeadline);
+            Operation *op = timers_.back();
+            timers_.pop_back();
+            op->result = 0;
+            completed.push_back(op);
+        }
+    }
+}
@@ -0,0 +1,206 @@
+#include "event_loop.h"
+#include "backends.h"
+#include <stdexcept>
+#include <system_error>
+
+namespace io
+{
+    namespace
+    {
+        // Fire and forget coroutine that owns one spawned task
+        struct Detached
+        {
+            struct promise_type
+            {
+                Detached get_return_object() noexcept { return {}; }
+                std::suspend_never initial_suspend() const noexcept { return {}; }
+                std::suspend_never final_suspend() const noexcept { return {}; }
+                void return_void() noexcept {}
+                void unhandled_exception() noexcept { std::terminate(); }
+            };
+        };
+
+        Detached drive(Task<void> task, std::atomic<std::size_t> &active, std::atomic<std::uint64_t> &failed)
+        {
+            try
+            {
+                co_await std::move(task);
+            }
+            catch (...)
+            {
+                failed.fetch_add(1, std::memory_order_relaxed);
+            }
+            active.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    const char *backendName(Backend backend) noexcept
+    {
+        switch (backend)
+        {
+        case Backend::Auto:
+            return "auto";
+        case Backend::IoUring:
+            return "io_uring";
+        case Backend::Epoll:
+            return "epoll";
+        }
+        return "?";
+    }
+
+    bool OpAwaiter::await_suspend(std::coroutine_handle<> waiter)
+    {
+        op_.waiter = waiter;
+        return !loop_.submit(op_);
+    }
+
+    std::unique_ptr<EventLoop> EventLoop::create(Backend backend)
+    {
+        if (backend == Backend::IoUring || (backend == Backend::Auto && UringLoop::supported()))
+        {
+            return std::make_unique<UringLoop>();
+        }
+        return std::make_unique<EpollLoop>();
+    }
+
+    EventLoop::~EventLoop() = default;
+
+    void EventLoop::run()
+    {
+        while (!stopping_.load(std::memory_order_acquire))
+        {
+            const bool ranQueued = runQueued();
+            if (stopping_.load(std::memory_order_acquire))
+            {
+                break;
+            }
+            poll(!ranQueued);
+        }
+        stopping_.store(false, std::memory_order_release);
+    }
+
+    void EventLoop::stop()
+    {
+        stopping_.store(true, std::memory_order_release);
+        wake();
+    }
+
+    void EventLoop::post(std::function<void()> fn)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            posted_.push_back(std::move(fn));
+        }
+        wake();
+    }
+
+    void EventLoop::spawn(Task<void> task)
+    {
+        active_.fetch_add(1, std::memory_order_acq_rel);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            spawned_.push_back(std::move(task));
+        }
+        wake();
+    }
+
+    bool EventLoop::runQueued()
+    {
+        std::vector<std::function<void()>> posted;
+        std::vector<Task<void>> spawned;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            posted.swap(posted_);
+            spawned.swap(spawned_);
+        }
+
+        for (std::function<void()> &fn : posted)
+        {
+            fn();
+        }
+        for (Task<void> &task : spawned)
+        {
+            start(std::move(task));
+        }
+        return !posted.empty() || !spawned.empty();
+    }
+
+    void EventLoop::start(Task<void> task)
+    {
+        drive(std::move(task), active_, failed_);
+    }
+
+    OpAwaiter EventLoop::read(int fd, void *buffer, std::size_t size, std::int64_t offset)
+    {
+        Operation op;
+        op.kind = Operation::Kind::Read;
+        op.fd = fd;
+        op.buffer = buffer;
+        op.size = size;
+        op.offset = offset;
+        return OpAwaiter(*this, op);
+    }
+
+    OpAwaiter EventLoop::write(int fd, const void *buffer, std::size_t size, std::int64_t offset)
+    {
+        Operation op;
+        op.kind = Operation::Kind::Write;
+        op.fd = fd;
+        op.buffer = const_cast<void *>(buffer); // only read from
+        op.size = size;
+        op.offset = offset;
+        return OpAwaiter(*this, op);
+    }
+
+    OpAwaiter EventLoop::fsync(int fd)
+    {
+        Operation op;
+        op.kind = Operation::Kind::Fsync;
+        op.fd = fd;
+        return OpAwaiter(*this, op);
+    }
+
+    OpAwaiter EventLoop::sleepUntil(std::chrono::steady_clock::time_point deadline)
+    {
+        Operation op;
+        op.kind = Operation::Kind::Timer;
+        op.deadline = deadline;
+        return OpAwaiter(*this, op);
+    }
+
+    Task<std::size_t> writeAll(EventLoop &loop, int fd, const void *buffer, std::size_t size, std::int64_t offset)
+    {
+        const auto *bytes = static_cast<const std::uint8_t *>(buffer);
+        std::size_t done = 0;
+        while (done < size)
+        {
+            const int result = co_await loop.write(fd, bytes + done, size - done, offset < 0 ? -1 : offset + static_cast<std::int64_t>(done));
+            if (result < 0)
+            {
+                throw std::system_error(-result, std::generic_category(), "io::writeAll");
+            }
+            done += static_cast<std::size_t>(result);
+        }
+        co_return done;
+    }
+
+    Task<std::size_t> readExact(EventLoop &loop, int fd, void *buffer, std::size_t size, std::int64_t offset)
+    {
+        auto *bytes = static_cast<std::uint8_t *>(buffer);
+        std::size_t done = 0;
+        while (done < size)
+        {
+            const int result = co_await loop.read(fd, bytes + done, size - done, offset < 0 ? -1 : offset + static_cast<std::int64_t>(done));
+            if (result < 0)
+            {
+                throw std::system_error(-result, std::generic_category(), "io::readExact");
+            }
+            if (result == 0)
+            {
+                break; // end of file
+            }
+            done += static_cast<std::size_t>(result);
+        }
+        co_return done;
+    }
+}
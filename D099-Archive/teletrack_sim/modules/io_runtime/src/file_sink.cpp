@@ -0,0 +1,38 @@
+#include "file_sink.h"
+#include <cerrno>
+#include <system_error>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace io
+{
+    FileSink::FileSink(EventLoop &loop, const std::string &path) : loop_(loop)
+    {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "io::FileSink: open " + path);
+        }
+    }
+
+    FileSink::~FileSink()
+    {
+        ::close(fd_);
+    }
+
+    Task<std::size_t> FileSink::append(const void *data, std::size_t size)
+    {
+        const auto offset = static_cast<std::int64_t>(end_);
+        end_ += size;
+        return writeAll(loop_, fd_, data, size, offset);
+    }
+
+    Task<void> FileSink::sync()
+    {
+        const int result = co_await loop_.fsync(fd_);
+        if (result < 0)
+        {
+            throw std::system_error(-result, std::generic_category(), "io::FileSink: fsync");
+        }
+    }
+}
@@ -0,0 +1,356 @@
+#include "backends.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace io
+{
+    namespace
+    {
+        constexpr std::uint64_t WAKE_TAG = 1; // user_data of the eventfd read; Operations are aligned
+
+        int setup(unsigned entries, io_uring_params &params)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        }
+
+        int registerProbe(int ring, io_uring_probe *probe, unsigned ops)
+        {
+            return static_cast<int>(::syscall(__NR_io_uring_register, ring, IORING_REGISTER_PROBE, probe, ops));
+        }
+
+        unsigned load(const unsigned *p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+        void store(unsigned *p, unsigned value) { __atomic_store_n(p, value, __ATOMIC_RELEASE); }
+    }
+
+    bool UringLoop::supported()
+    {
+        static const bool result = []
+        {
+            io_uring_params params{};
+            const int ring = setup(8, params);
+            if (ring < 0)
+            {
+                return false; // ENOSYS, or blocked by seccomp / io_uring_disabled
+            }
+
+            constexpr unsigned OPS = 256;
+            auto *probe = static_cast<io_uring_probe *>(std::calloc(1, sizeof(io_uring_probe) + OPS * sizeof(io_uring_probe_op)));
+            bool ok = probe != nullptr && registerProbe(ring, probe, OPS) == 0;
+            for (const unsigned op : {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_SEND, IORING_OP_FSYNC, IORING_OP_TIMEOUT,
+                                      IORING_OP_POLL_ADD})
+            {
+                ok = ok && op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+            }
+            std::free(probe);
+            ::close(ring);
+            return ok;
+        }();
+        return result;
+    }
+
+    UringLoop::UringLoop(unsigned entries)
+    {
+        io_uring_params params{};
+        ring_ = setup(entries, params);
+        if (ring_ < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "io::UringLoop: io_uring_setup");
+        }
+
+        sqMapSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqMapSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single)
+        {
+            sqMapSize_ = cqMapSize_ = std::max(sqMapSize_, cqMapSize_);
+        }
+
+        sqMap_ = ::mmap(nullptr, sqMapSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_SQ_RING);
+        cqMap_ = single ? sqMap_ : ::mmap(nullptr, cqMapSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_CQ_RING);
+        sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+        void *sqes = ::mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_, IORING_OFF_SQES);
+        event_ = ::eventfd(0, EFD_CLOEXEC);
+
+        if (sqMap_ == MAP_FAILED || cqMap_ == MAP_FAILED || sqes == MAP_FAILED || event_ < 0)
+        {
+            const int error = errno;
+            sqes_ = sqes != MAP_FAILED ? static_cast<io_uring_sqe *>(sqes) : nullptr;
+            release();
+            throw std::system_error(error, std::generic_category(), "io::UringLoop: mmap");
+        }
+        sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+        auto *sq = static_cast<std::uint8_t *>(sqMap_);
+        sqHead_ = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+        sqTail_ = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+        sqMask_ = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+        sqEntries_ = params.sq_entries;
+        sqArray_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+
+        auto *cq = static_cast<std::uint8_t *>(cqMap_);
+        cqHead_ = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+        cqTail_ = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+        cqMask_ = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+
+        armWake();
+    }
+
+    UringLoop::~UringLoop()
+    {
+        release();
+    }
+
+    void UringLoop::release() noexcept
+    {
+        if (sqes_ != nullptr)
+        {
+            ::munmap(sqes_, sqesSize_);
+        }
+        if (cqMap_ != nullptr && cqMap_ != MAP_FAILED && cqMap_ != sqMap_)
+        {
+            ::munmap(cqMap_, cqMapSize_);
+        }
+        if (sqMap_ != nullptr && sqMap_ != MAP_FAILED)
+        {
+            ::munmap(sqMap_, sqMapSize_);
+        }
+        if (event_ >= 0)
+        {
+            ::close(event_);
+        }
+        ::close(ring_);
+    }
+
+    bool UringLoop::submit(Operation &op)
+    {
+        // The rule EpollLoop needs, kept here too so code behaves the same on
+        // both backends: one stream read and one stream write in flight per fd
+        if (bool *busy = inFlight(op))
+        {
+            if (*busy)
+            {
+                throw std::logic_error(op.kind == Operation::Kind::Read ? "io::UringLoop: fd already has a pending read"
+                                                                        : "io::UringLoop: fd already has a pending write");
+            }
+            *busy = true;
+        }
+        prepare(op);
+        return false;
+    }
+
+    bool *UringLoop::inFlight(const Operation &op)
+    {
+        // Positional file I/O never waits for readiness, under epoll either
+        if ((op.kind != Operation::Kind::Read && op.kind != Operation::Kind::Write) || op.offset >= 0 || op.fd < 0)
+        {
+            return nullptr;
+        }
+        if (static_cast<std::size_t>(op.fd) >= streams_.size())
+        {
+            streams_.resize(static_cast<std::size_t>(op.fd) + 1);
+        }
+        Streams &streams = streams_[static_cast<std::size_t>(op.fd)];
+        return op.kind == Operation::Kind::Read ? &streams.reading : &streams.writing;
+    }
+
+    void UringLoop::poll(bool block)
+    {
+        const bool ready = load(cqTail_) != *cqHead_;
+        const unsigned submit = pending_;
+        pending_ = 0;
+        if (submit > 0 || (block && !ready))
+        {
+            enter(submit, block && !ready ? 1 : 0);
+        }
+
+        std::vector<Operation *> completed;
+        unsigned head = *cqHead_;
+        const unsigned tail = load(cqTail_);
+        for (; head != tail; ++head)
+        {
+            const io_uring_cqe &cqe = cqes_[head & cqMask_];
+            const int result = cqe.res;
+            if (cqe.user_data == WAKE_TAG)
+            {
+                armWake();
+                continue;
+            }
+
+            Operation &op = *reinterpret_cast<Operation *>(static_cast<std::uintptr_t>(cqe.user_data));
+            if (op.polling)
+            {
+                // Readiness (or an error) arrived: retry the real operation
+                op.polling = false;
+                if (result < 0)
+                {
+                    op.result = result;
+                    completed.push_back(&op);
+                }
+                else
+                {
+                    prepare(op);
+                }
+                continue;
+            }
+
+            if (op.kind == Operation::Kind::Timer)
+            {
+                op.result = result == -ETIME ? 0 : result;
+            }
+            else if (op.kind == Operation::Kind::Write && result == -ENOTSOCK && !op.notSocket)
+            {
+                op.notSocket = true;
+                prepare(op);
+                continue;
+            }
+            else if (result == -EAGAIN && (op.kind == Operation::Kind::Read || op.kind == Operation::Kind::Write))
+            {
+                // Non-blocking fd with nothing to do: wait for readiness first
+                op.polling = true;
+                prepare(op);
+                continue;
+            }
+            else
+            {
+                op.result = result;
+            }
+            completed.push_back(&op);
+        }
+        store(cqHead_, head);
+
+        for (Operation *op : completed)
+        {
+            if (bool *busy = inFlight(*op))
+            {
+                *busy = false; // before resuming, so the waiter can issue the next one
+            }
+            op->waiter.resume();
+        }
+    }
+
+    void UringLoop::wake()
+    {
+        const std::uint64_t one = 1;
+        [[maybe_unused]] const ssize_t written = ::write(event_, &one, sizeof(one));
+    }
+
+    io_uring_sqe *UringLoop::nextSqe()
+    {
+        if (*sqTail_ - load(sqHead_) >= sqEntries_)
+        {
+            // Ring full: hand what we have to the kernel, which consumes it during the call
+            enter(pending_, 0);
+            pending_ = 0;
+        }
+        io_uring_sqe *sqe = &sqes_[*sqTail_ & sqMask_];
+        std::memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    void UringLoop::prepare(Operation &op)
+    {
+        io_uring_sqe *sqe = nextSqe();
+        sqe->fd = op.fd;
+        sqe->user_data = reinterpret_cast<std::uintptr_t>(&op);
+        const auto length = static_cast<unsigned>(std::min<std::size_t>(op.size, INT_MAX));
+
+        if (op.polling)
+        {
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->poll32_events = op.kind == Operation::Kind::Read ? POLLIN : POLLOUT;
+        }
+        else
+        {
+            switch (op.kind)
+            {
+            case Operation::Kind::Read:
+                sqe->opcode = IORING_OP_READ;
+                sqe->addr = reinterpret_cast<std::uintptr_t>(op.buffer);
+                sqe->len = length;
+                sqe->off = op.offset < 0 ? ~std::uint64_t{0} : static_cast<std::uint64_t>(op.offset);
+                break;
+
+            case Operation::Kind::Write:
+                if (op.offset < 0 && !op.notSocket)
+                {
+                    sqe->opcode = IORING_OP_SEND; // MSG_NOSIGNAL: EPIPE instead of SIGPIPE
+                    sqe->msg_flags = MSG_NOSIGNAL;
+                }
+                else
+                {
+                    sqe->opcode = IORING_OP_WRITE;
+                    sqe->off = op.offset < 0 ? ~std::uint64_t{0} : static_cast<std::uint64_t>(op.offset);
+                }
+                sqe->addr = reinterpret_cast<std::uintptr_t>(op.buffer);
+                sqe->len = length;
+                break;
+
+            case Operation::Kind::Fsync:
+                sqe->opcode = IORING_OP_FSYNC;
+                break;
+
+            case Operation::Kind::Timer:
+            {
+                // Absolute CLOCK_MONOTONIC deadline, the clock behind steady_clock
+                const auto since = op.deadline.time_since_epoch();
+                const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(since);
+                op.timespec[0] = seconds.count();
+                op.timespec[1] = std::chrono::duration_cast<std::chrono::nanoseconds>(since - seconds).count();
+                sqe->opcode = IORING_OP_TIMEOUT;
+                sqe->fd = -1;
+                sqe->addr = reinterpret_cast<std::uintptr_t>(op.timespec);
+                sqe->len = 1;
+                sqe->timeout_flags = IORING_TIMEOUT_ABS;
+                break;
+            }
+            }
+        }
+
+        const unsigned tail = *sqTail_;
+        sqArray_[tail & sqMask_] = tail & sqMask_;
+        store(sqTail_, tail + 1);
+        ++pending_;
+    }
+
+    void UringLoop::armWake()
+    {
+        io_uring_sqe *sqe = nextSqe();
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = event_;
+        sqe->addr = reinterpret_cast<std::uintptr_t>(&wakeValue_);
+        sqe->len = sizeof(wakeValue_);
+        sqe->off = ~std::uint64_t{0};
+        sqe->user_data = WAKE_TAG;
+
+        const unsigned tail = *sqTail_;
+        sqArray_[tail & sqMask_] = tail & sqMask_;
+        store(sqTail_, tail + 1);
+        ++pending_;
+    }
+
+    int UringLoop::enter(unsigned submit, unsigned waitFor)
+    {
+        const unsigned flags = waitFor > 0 ? IORING_ENTER_GETEVENTS : 0;
+        while (true)
+        {
+            const long result = ::syscall(__NR_io_uring_enter, ring_, submit, waitFor, flags, nullptr, 0);
+            if (result >= 0 || errno != EINTR)
+            {
+                return static_cast<int>(result);
+            }
+        }
+    }
+}
@@ -0,0 +1,416 @@
+#include <gtest/gtest.h>
+#include "async_mqtt_client.h"
+#include "event_loop.h"
+#include "file_sink.h"
+#include "mqtt_packet.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <system_error>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    io::Task<int> answer()
+    {
+        co_return 42;
+    }
+
+    io::Task<int> addOne(io::Task<int> inner)
+    {
+        co_return co_await std::move(inner) + 1;
+    }
+
+    io::Task<void> fail()
+    {
+        throw std::runtime_error("boom");
+        co_return;
+    }
+
+    void makeNonBlocking(int fd)
+    {
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+
+    // Server side of one connection: CONNACK the CONNECT, count PUBLISH until DISCONNECT or EOF
+    io::Task<void> miniBroker(io::EventLoop &loop, int fd, std::atomic<std::uint64_t> &messages)
+    {
+        std::vector<std::uint8_t> rx;
+        std::uint8_t chunk[4096];
+        bool open = true;
+        while (open)
+        {
+            const int n = co_await loop.read(fd, chunk, sizeof(chunk));
+            if (n <= 0)
+            {
+                break;
+            }
+            rx.insert(rx.end(), chunk, chunk + n);
+
+            std::size_t used = 0;
+            mqtt::FixedHeader header;
+            while (open && mqtt::decodeFixedHeader(rx.data() + used, rx.size() - used, header) == mqtt::DecodeStatus::Ok &&
+                   rx.size() - used >= header.headerSize + header.remainingLength)
+            {
+                if (header.type == mqtt::CONNECT)
+                {
+                    std::vector<std::uint8_t> connack;
+                    mqtt::appendConnack(connack, 0);
+                    co_await io::writeAll(loop, fd, connack.data(), connack.size());
+                }
+                else if (header.type == mqtt::PUBLISH)
+                {
+                    messages.fetch_add(1, std::memory_order_relaxed);
+                }
+                else if (header.type == mqtt::DISCONNECT)
+                {
+                    open = false;
+                }
+                used += header.headerSize + header.remainingLength;
+            }
+            rx.erase(rx.begin(), rx.begin() + static_cast<std::ptrdiff_t>(used));
+        }
+        ::close(fd);
+    }
+
+    io::Task<void> telemetryClient(io::EventLoop &loop, int fd, int messages, std::atomic<int> &finished, int total)
+    {
+        io::AsyncMqttClient client(loop, fd);
+        co_await client.connect("vehicle");
+        for (int i = 0; i < messages; ++i)
+        {
+            const std::string payload = "{\"seq\":" + std::to_string(i) + "}";
+            co_await client.publish("teletrack/telemetry", payload);
+        }
+        co_await client.disconnect();
+
+        if (finished.fetch_add(1) + 1 == total)
+        {
+            loop.stop();
+        }
+    }
+
+    class IoRuntimeTest : public ::testing::TestWithParam<io::Backend>
+    {
+    protected:
+        void SetUp() override
+        {
+            try
+            {
+                loop = io::EventLoop::create(GetParam());
+            }
+            catch (const std::exception &error)
+            {
+                GTEST_SKIP() << io::backendName(GetParam()) << " unavailable: " << error.what();
+            }
+        }
+
+        std::unique_ptr<io::EventLoop> loop;
+    };
+}
+
+TEST(TaskTest, BlockReturnsValueAndPropagatesExceptions)
+{
+    auto loop = io::EventLoop::create(io::Backend::Epoll);
+    EXPECT_EQ(loop->block(addOne(answer())), 43);
+    EXPECT_THROW(loop->block(fail()), std::runtime_error);
+}
+
+TEST(EventLoopTest, AutoPicksAnAvailableBackend)
+{
+    auto loop = io::EventLoop::create();
+    EXPECT_NE(loop->backend(), io::Backend::Auto);
+    std::printf("auto backend: %s\n", io::backendName(loop->backend()));
+}
+
+TEST_P(IoRuntimeTest, TimersFireInDeadlineOrder)
+{
+    std::vector<int> order;
+    auto sleeper = [&](int id, std::chrono::milliseconds delay) -> io::Task<void>
+    {
+        co_await loop->sleepFor(delay);
+        order.push_back(id);
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    loop->spawn(sleeper(3, 30ms));
+    loop->spawn(sleeper(1, 10ms));
+    loop->spawn(sleeper(2, 20ms));
+    loop->block([&]() -> io::Task<void>
+                { co_await loop->sleepFor(40ms); }());
+
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 40ms);
+    EXPECT_EQ(loop->activeTasks(), 0u);
+}
+
+TEST_P(IoRuntimeTest, RejectsASecondReaderOnOneFd)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    makeNonBlocking(fds[0]);
+    makeNonBlocking(fds[1]);
+
+    auto reader = [](io::EventLoop &loop, int fd, std::string &out) -> io::Task<void>
+    {
+        char buffer[64];
+        const int n = co_await loop.read(fd, buffer, sizeof(buffer));
+        out.assign(buffer, static_cast<std::size_t>(std::max(n, 0)));
+    };
+
+    std::string first;
+    std::string next;
+    loop->spawn(reader(*loop, fds[0], first));
+
+    bool rejected = false;
+    loop->block([&]() -> io::Task<void>
+                {
+                    co_await loop->sleepFor(5ms); // the first reader is parked by now
+                    char buffer[64];
+                    try
+                    {
+                        co_await loop->read(fds[0], buffer, sizeof(buffer));
+                    }
+                    catch (const std::logic_error &)
+                    {
+                        rejected = true;
+                    }
+                    co_await io::writeAll(*loop, fds[1], "hello", 5);
+                    while (loop->activeTasks() > 0)
+                    {
+                        co_await loop->sleepFor(1ms);
+                    }
+
+                    // Once it completed, the fd takes a new reader
+                    loop->spawn(reader(*loop, fds[0], next));
+                    co_await io::writeAll(*loop, fds[1], "again", 5);
+                    while (loop->activeTasks() > 0)
+                    {
+                        co_await loop->sleepFor(1ms);
+                    }
+                }());
+
+    EXPECT_TRUE(rejected);
+    EXPECT_EQ(first, "hello"); // the first reader still gets its data
+    EXPECT_EQ(next, "again");
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_P(IoRuntimeTest, ReaderSuspendsUntilWriterSends)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    makeNonBlocking(fds[0]);
+    makeNonBlocking(fds[1]);
+
+    // Coroutine lambdas get their state as parameters: the frame outlives the closure
+    std::string received;
+    loop->spawn([](io::EventLoop &loop, int fd, std::string &out) -> io::Task<void>
+                {
+                    char buffer[64];
+                    const int n = co_await loop.read(fd, buffer, sizeof(buffer));
+                    out.assign(buffer, static_cast<std::size_t>(std::max(n, 0)));
+                }(*loop, fds[0], received));
+
+    loop->block([&]() -> io::Task<void>
+                {
+                    co_await loop->sleepFor(5ms); // the reader is parked by now
+                    co_await io::writeAll(*loop, fds[1], "hello", 5);
+                    while (loop->activeTasks() > 0)
+                    {
+                        co_await loop->sleepFor(1ms);
+                    }
+                }());
+
+    EXPECT_EQ(received, "hello");
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST_P(IoRuntimeTest, WriteToClosedPeerReturnsEpipe)
+{
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    makeNonBlocking(fds[0]);
+    ::close(fds[1]);
+
+    const int result = loop->block([&]() -> io::Task<int>
+                                   { co_return co_await loop->write(fds[0], "x", 1); }());
+    EXPECT_EQ(result, -EPIPE);
+    ::close(fds[0]);
+}
+
+TEST_P(IoRuntimeTest, FlushReportsAFailedWrite)
+{
+    int fds[2];
+    ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+    io::AsyncMqttClient client(*loop, fds[1]);
+
+    // Far more than the socket buffer holds, so the write parks until the peer reads
+    loop->spawn([](io::AsyncMqttClient &client) -> io::Task<void>
+                {
+                    const std::string payload(4 << 20, 'x');
+                    co_await client.publish("teletrack/telemetry", payload);
+                }(client));
+
+    int failures = 0;
+    loop->block([&]() -> io::Task<void>
+                {
+                    co_await loop->sleepFor(5ms); // the writer is parked by now
+                    ::close(fds[0]);
+                    for (int attempt = 0; attempt < 2; ++attempt)
+                    {
+                        try
+                        {
+                            co_await client.flush();
+                        }
+                        catch (const std::system_error &)
+                        {
+                            ++failures;
+                        }
+                    }
+                    while (loop->activeTasks() > 0)
+                    {
+                        co_await loop->sleepFor(1ms);
+                    }
+                }());
+
+    EXPECT_EQ(failures, 2); // the waiting flush and any later one
+    EXPECT_EQ(loop->failedTasks(), 1u);
+}
+
+TEST_P(IoRuntimeTest, FileSinkKeepsAppendOrder)
+{
+    const std::string path = (std::filesystem::temp_directory_path() /
+                              ("io_sink_" + std::to_string(::getpid()) + io::backendName(GetParam())))
+                                 .string();
+    std::vector<std::string> lines;
+    for (int i = 0; i < 200; ++i)
+    {
+        lines.push_back("line " + std::to_string(i) + "\n");
+    }
+
+    {
+        io::FileSink sink(*loop, path);
+        loop->block([&]() -> io::Task<void>
+                    {
+                        // All appends in flight at once, then wait for them
+                        std::vector<io::Task<std::size_t>> writes;
+                        for (const std::string &line : lines)
+                        {
+                            writes.push_back(sink.append(line));
+                        }
+                        for (io::Task<std::size_t> &write : writes)
+                        {
+                            co_await std::move(write);
+                        }
+                        co_await sink.sync();
+                    }());
+        EXPECT_EQ(sink.size(), std::filesystem::file_size(path));
+    }
+
+    std::ifstream in(path);
+    std::stringstream content;
+    content << in.rdbuf();
+    std::string expected;
+    for (const std::string &line : lines)
+    {
+        expected += line;
+    }
+    EXPECT_EQ(content.str(), expected);
+    std::filesystem::remove(path);
+}
+
+TEST_P(IoRuntimeTest, OneThreadDrivesThousandsOfBrokerConnections)
+{
+    constexpr int CONNECTIONS = 2000;
+    constexpr int MESSAGES = 20;
+
+    std::atomic<std::uint64_t> brokerMessages{0};
+    std::atomic<int> finished{0};
+    for (int i = 0; i < CONNECTIONS; ++i)
+    {
+        int fds[2];
+        ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds), 0);
+        loop->spawn(miniBroker(*loop, fds[0], brokerMessages));
+        loop->spawn(telemetryClient(*loop, fds[1], MESSAGES, finished, CONNECTIONS));
+    }
+
+    loop->run(); // the last client stops it
+    EXPECT_EQ(finished.load(), CONNECTIONS);
+
+    // Brokers see the DISCONNECT right after the last publish
+    loop->block([&]() -> io::Task<void>
+                {
+                    while (loop->activeTasks() > 0)
+                    {
+                        co_await loop->sleepFor(1ms);
+                    }
+                }());
+    EXPECT_EQ(brokerMessages.load(), static_cast<std::uint64_t>(CONNECTIONS) * MESSAGES);
+    EXPECT_EQ(loop->failedTasks(), 0u);
+}
+
+TEST_P(IoRuntimeTest, SimulationThreadsHandWorkToTheLoopThread)
+{
+    std::thread ioThread([&]
+                         { loop->run(); });
+
+    std::atomic<int> ran{0};
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t)
+    {
+        producers.emplace_back([&]
+                               {
+                                   for (int i = 0; i < 50; ++i)
+                                   {
+                                       loop->spawn([](io::EventLoop &loop, std::atomic<int> &counter) -> io::Task<void>
+                                                   {
+                                                       co_await loop.sleepFor(1ms);
+                                                       counter.fetch_add(1);
+                                                   }(*loop, ran));
+                                       loop->post([&]
+                                                  { ran.fetch_add(1); });
+                                   }
+                               });
+    }
+    for (std::thread &producer : producers)
+    {
+        producer.join();
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + 5s;
+    while (ran.load() < 400 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(1ms);
+    }
+    loop->stop();
+    ioThread.join();
+    EXPECT_EQ(ran.load(), 400);
+}
+
+TEST_P(IoRuntimeTest, FailedSpawnedTasksAreCounted)
+{
+    loop->spawn(fail());
+    loop->block([&]() -> io::Task<void>
+                { co_await loop->sleepFor(1ms); }());
+    EXPECT_EQ(loop->failedTasks(), 1u);
+    EXPECT_EQ(loop->activeTasks(), 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, IoRuntimeTest, ::testing::Values(io::Backend::IoUring, io::Backend::Epoll),
+                         [](const ::testing::TestParamInfo<io::Backend> &info)
+                         { return std::string(info.param == io::Backend::IoUring ? "IoUring" : "Epoll"); });
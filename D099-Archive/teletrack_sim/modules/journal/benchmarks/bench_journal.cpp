@@ -0,0 +1,94 @@
+// Journal append and replay throughput.
+//
+// Usage: bench_journal [directory] [vehicles] [ticks]
+// Every tick (100 ms) each vehicle appends one GNSS fix and one engine
+// sample. Replay is timed twice: cold after the writer closed, then warm
+// (page cache), plus a single vehicle query that leans on the sparse index.
+
+#include "journal.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+namespace
+{
+    struct Counter
+    {
+        std::uint64_t samples = 0;
+        double checksum = 0.0; // keeps the replay from being optimized away
+
+        void operator()(const GnssSample &sample)
+        {
+            ++samples;
+            checksum += sample.latitude;
+        }
+
+        void operator()(const EngineSample &sample)
+        {
+            ++samples;
+            checksum += sample.rpm;
+        }
+    };
+
+    double seconds(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const char *what, std::uint64_t records, double elapsed)
+    {
+        const double bytes = static_cast<double>(records * sizeof(journal::Record));
+        std::printf("%-22s %12.0f records/s %8.2f GB/s\n", what, static_cast<double>(records) / elapsed,
+                    bytes / elapsed / 1e9);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const std::string directory = argc > 1 ? argv[1] : (std::filesystem::temp_directory_path() / "bench_journal").string();
+    const std::uint32_t vehicles = argc > 2 ? static_cast<std::uint32_t>(std::strtoul(argv[2], nullptr, 10)) : 100000;
+    const std::uint64_t ticks = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 50;
+
+    std::filesystem::remove_all(directory);
+    std::printf("%u vehicles, %llu ticks, journal in %s\n", vehicles, static_cast<unsigned long long>(ticks),
+                directory.c_str());
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t written = 0;
+    {
+        JournalWriter::Options options;
+        options.directory = directory;
+        JournalWriter writer(options);
+        for (std::uint64_t tick = 0; tick < ticks; ++tick)
+        {
+            for (std::uint32_t v = 0; v < vehicles; ++v)
+            {
+                writer.append(GnssSample{v, tick * 100, 1.3 + 1e-5 * static_cast<double>(tick), 103.8});
+                writer.append(EngineSample{v, tick * 100, 800.0f + static_cast<float>(tick), 90.0f, 2.0f});
+            }
+        }
+        written = writer.records();
+    }
+    report("append", written, seconds(start));
+
+    JournalReader reader(directory);
+    for (const char *pass : {"replay (first)", "replay (warm)"})
+    {
+        Counter counter;
+        start = std::chrono::steady_clock::now();
+        reader.replay(counter);
+        report(pass, counter.samples, seconds(start));
+    }
+
+    Counter counter;
+    JournalReader::Query query;
+    query.vehicle = vehicles / 2;
+    start = std::chrono::steady_clock::now();
+    reader.replay(counter, query);
+    std::printf("%-22s %12.3f ms, %llu samples, %llu blocks skipped\n", "one vehicle", seconds(start) * 1e3,
+                static_cast<unsigned long long>(counter.samples), static_cast<unsigned long long>(reader.blocksSkipped()));
+
+    std::filesystem::remove_all(directory);
+    return 0;
+}
@@ -0,0 +1,181 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "journal_format.h"
+#include "telemetry_sample.h"
+
+class Aggregator;
+
+namespace journal
+{
+    // "segment-000042.tj" -> 42, 0 for any other file name
+    std::uint64_t segmentSequence(const std::string &fileName);
+
+    // directory/segment-NNNNNN<extension>
+    std::string segmentPath(const std::string &directory, std::uint64_t sequence, const char *extension);
+}
+
+/**
+ * Append-only writer of a segmented telemetry journal.
+ *
+ * Segments are preallocated files mapped with mmap; append() is a 32 byte
+ * store into the mapping, with no syscall. A full segment is sealed (its
+ * sparse index written, the file trimmed to its used size) and the next one
+ * is created. The destructor seals the current segment.
+ *
+ * Opening an existing journal directory continues after its last segment.
+ */
+class JournalWriter
+{
+public:
+    struct Options
+    {
+        std::string directory;
+        std::size_t segmentBytes = 64 * 1024 * 1024;                // preallocated size of each segment
+        std::size_t blockRecords = journal::DEFAULT_BLOCK_RECORDS; // records per sparse index entry
+    };
+
+    explicit JournalWriter(Options options);
+    ~JournalWriter();
+
+    JournalWriter(const JournalWriter &) = delete;
+    JournalWriter &operator=(const JournalWriter &) = delete;
+
+    void append(const GnssSample &sample);
+    void append(const EngineSample &sample);
+
+    // msync the current segment (appends are already visible to readers in this process)
+    void sync();
+
+    std::uint64_t records() const { return records_; }
+    std::uint64_t segments() const { return sequence_; }
+
+private:
+    void write(const journal::Record &record);
+    void openSegment();
+    void sealSegment();
+
+    Options options_;
+    std::uint64_t sequence_ = 0;
+    int fd_ = -1;
+    std::uint8_t *base_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t used_ = 0;
+    std::size_t blockFill_ = 0;
+    std::vector<journal::IndexEntry> index_;
+    std::uint64_t records_ = 0;
+};
+
+/**
+ * Read-only view of every segment of a journal, mapped at once.
+ *
+ * replay() walks the records in append order and hands each one to a
+ * visitor as the GnssSample / EngineSample the live pipeline produced, so
+ * the same Aggregator (or observer) code runs on recorded traffic. A Query
+ * limits replay to a time range and optionally one vehicle; whole blocks
+ * are skipped with the sparse index.
+ */
+class JournalReader
+{
+public:
+    static constexpr std::uint32_t ALL_VEHICLES = std::numeric_limits<std::uint32_t>::max();
+
+    struct Query
+    {
+        std::uint64_t fromMs = 0;
+        std::uint64_t toMs = std::numeric_limits<std::uint64_t>::max(); // inclusive
+        std::uint32_t vehicle = ALL_VEHICLES;
+    };
+
+    explicit JournalReader(const std::string &directory);
+    ~JournalReader();
+
+    JournalReader(const JournalReader &) = delete;
+    JournalReader &operator=(const JournalReader &) = delete;
+
+    // visitor(const GnssSample &) and visitor(const EngineSample &); returns the samples visited
+    template <typename Visitor>
+    std::uint64_t replay(Visitor &&visitor, const Query &query) const;
+
+    template <typename Visitor>
+    std::uint64_t replay(Visitor &&visitor) const { return replay(visitor, Query{}); }
+
+    // Feed matching samples to aggregator.addGnss() / addEngine()
+    std::uint64_t replayInto(Aggregator &aggregator, const Query &query) const;
+    std::uint64_t replayInto(Aggregator &aggregator) const { return replayInto(aggregator, Query{}); }
+
+    std::size_t segments() const { return segments_.size(); }
+    std::uint64_t records() const;
+    std::uint64_t blocksSkipped() const { return skipped_; } // by the last replay()
+
+private:
+    struct Segment
+    {
+        const std::uint8_t *base = nullptr;
+        std::size_t mappedBytes = 0;
+        std::size_t usedBytes = 0;
+        std::vector<journal::IndexEntry> index;
+    };
+
+    static void rebuildIndex(Segment &segment);
+
+    std::vector<Segment> segments_;
+    mutable std::uint64_t skipped_ = 0;
+};
+
+template <typename Visitor>
+std::uint64_t JournalReader::replay(Visitor &&visitor, const Query &query) const
+{
+    std::uint64_t visited = 0;
+    skipped_ = 0;
+
+    for (const Segment &segment : segments_)
+    {
+        for (std::size_t b = 0; b < segment.index.size(); ++b)
+        {
+            const journal::IndexEntry &entry = segment.index[b];
+            if (entry.maxTimestampMs < query.fromMs || entry.minTimestampMs > query.toMs ||
+                (query.vehicle != ALL_VEHICLES && !journal::mayContain(entry, query.vehicle)))
+            {
+                ++skipped_;
+                continue;
+            }
+
+            const std::size_t end = b + 1 < segment.index.size() ? segment.index[b + 1].offset : segment.usedBytes;
+            const auto *record = reinterpret_cast<const journal::Record *>(segment.base + entry.offset);
+            const auto *last = reinterpret_cast<const journal::Record *>(segment.base + end);
+
+            for (; record < last; ++record)
+            {
+                if (record->timestampMs < query.fromMs || record->timestampMs > query.toMs ||
+                    (query.vehicle != ALL_VEHICLES && record->vehicle != query.vehicle))
+                {
+                    continue;
+                }
+
+                if (record->type == journal::RECORD_GNSS)
+                {
+                    visitor(GnssSample{record->vehicle, record->timestampMs, record->gnss.latitude, record->gnss.longitude});
+                }
+                else if (record->type == journal::RECORD_ENGINE)
+                {
+                    visitor(EngineSample{record->vehicle, record->timestampMs, record->engine.rpm,
+                                         record->engine.coolantTemp, record->engine.fuelRate});
+                }
+                else
+                {
+                    continue;
+                }
+                ++visited;
+            }
+        }
+    }
+    return visited;
+}
+
+#endif // JOURNAL_H
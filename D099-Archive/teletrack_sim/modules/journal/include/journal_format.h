@@ -0,0 +1,91 @@
+#ifndef JOURNAL_FORMAT_H
+#define JOURNAL_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * On-disk layout of the telemetry journal (host byte order).
+ *
+ * A journal is a directory of segment files "segment-NNNNNN.tj", each a
+ * SegmentHeader followed by fixed size records, plus one sparse index file
+ * "segment-NNNNNN.idx" per sealed segment. The index has one IndexEntry per
+ * block of records, so replay can skip blocks by time range and vehicle.
+ */
+namespace journal
+{
+    constexpr char SEGMENT_MAGIC[8] = {'T', 'T', 'J', 'O', 'U', 'R', 'N', '1'};
+
+    enum RecordType : std::uint16_t
+    {
+        RECORD_GNSS = 1,
+        RECORD_ENGINE = 2
+    };
+
+    struct SegmentHeader
+    {
+        char magic[8];
+        std::uint32_t headerBytes;
+        std::uint32_t recordBytes;
+        std::uint64_t sequence;  // segment number, from 1
+        std::uint64_t usedBytes; // header + records written, updated on every append
+        std::uint8_t reserved[32];
+    };
+    static_assert(sizeof(SegmentHeader) == 64, "segment header is one cache line");
+
+    struct GnssPayload
+    {
+        double latitude;
+        double longitude;
+    };
+
+    struct EnginePayload
+    {
+        float rpm;
+        float coolantTemp;
+        float fuelRate;
+        float unused;
+    };
+
+    // Every record is 32 bytes so the segment is a plain array
+    struct Record
+    {
+        std::uint16_t type;
+        std::uint16_t reserved;
+        std::uint32_t vehicle;
+        std::uint64_t timestampMs;
+        union
+        {
+            GnssPayload gnss;
+            EnginePayload engine;
+        };
+    };
+    static_assert(sizeof(Record) == 32, "records are 32 bytes");
+
+    constexpr unsigned VEHICLE_FILTER_BITS = 1024;
+    constexpr std::size_t DEFAULT_BLOCK_RECORDS = 512;
+
+    // Summary of one block of records. With a few hundred vehicles per block
+    // the filter rejects most blocks that do not hold a given vehicle.
+    struct IndexEntry
+    {
+        std::uint64_t offset; // of the block's first record in the segment
+        std::uint64_t minTimestampMs;
+        std::uint64_t maxTimestampMs;
+        std::uint64_t vehicleBits[VEHICLE_FILTER_BITS / 64]; // filter over vehicleBit()
+    };
+
+    // Which bit of IndexEntry::vehicleBits a vehicle sets
+    inline unsigned vehicleBit(std::uint32_t vehicle)
+    {
+        return static_cast<std::uint32_t>(vehicle * 0x9E3779B1u) >> 22;
+    }
+
+    inline bool mayContain(const IndexEntry &entry, std::uint32_t vehicle)
+    {
+        const unsigned bit = vehicleBit(vehicle);
+        return (entry.vehicleBits[bit / 64] >> (bit % 64)) & 1u;
+    }
+}
+
+#endif // JOURNAL_FORMAT_H
@@ -0,0 +1,178 @@
+#include "journal.h"
+#include "aggregator.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr std::size_t HEADER_BYTES = sizeof(journal::SegmentHeader);
+    constexpr std::size_t RECORD_BYTES = sizeof(journal::Record);
+
+    // The sealed index, or an empty vector if it is missing or does not match the segment
+    std::vector<journal::IndexEntry> loadIndex(const std::string &path, std::size_t usedBytes)
+    {
+        std::vector<journal::IndexEntry> index;
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (file == nullptr)
+        {
+            return index;
+        }
+
+        journal::IndexEntry entry;
+        while (std::fread(&entry, sizeof(entry), 1, file) == 1)
+        {
+            index.push_back(entry);
+        }
+        std::fclose(file);
+
+        // Every block must start on a record inside the used part, in increasing order
+        bool valid = !index.empty() && index.front().offset == HEADER_BYTES;
+        for (std::size_t i = 0; valid && i < index.size(); ++i)
+        {
+            const std::uint64_t offset = index[i].offset;
+            valid = offset < usedBytes && (offset - HEADER_BYTES) % RECORD_BYTES == 0 &&
+                    (i == 0 || offset > index[i - 1].offset);
+        }
+        if (!valid)
+        {
+            index.clear();
+        }
+        return index;
+    }
+}
+
+JournalReader::JournalReader(const std::string &directory)
+{
+    std::vector<std::uint64_t> sequences;
+    for (const auto &entry : std::filesystem::directory_iterator(directory))
+    {
+        if (const std::uint64_t sequence = journal::segmentSequence(entry.path().filename().string()))
+        {
+            sequences.push_back(sequence);
+        }
+    }
+    std::sort(sequences.begin(), sequences.end());
+
+    // The destructor does not run if this throws: unmap what was mapped so far
+    try
+    {
+        for (std::uint64_t sequence : sequences)
+        {
+            const std::string path = journal::segmentPath(directory, sequence, ".tj");
+            const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            struct stat info{};
+            if (fd < 0 || ::fstat(fd, &info) != 0)
+            {
+                if (fd >= 0)
+                {
+                    ::close(fd);
+                }
+                throw std::runtime_error("JournalReader: cannot open " + path);
+            }
+
+            const auto size = static_cast<std::size_t>(info.st_size);
+            void *mapping = size >= HEADER_BYTES ? ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+            ::close(fd);
+            if (mapping == MAP_FAILED)
+            {
+                throw std::runtime_error("JournalReader: cannot map " + path);
+            }
+
+            journal::SegmentHeader header;
+            std::memcpy(&header, mapping, HEADER_BYTES);
+            if (std::memcmp(header.magic, journal::SEGMENT_MAGIC, sizeof(header.magic)) != 0 ||
+                header.headerBytes != HEADER_BYTES || header.recordBytes != RECORD_BYTES)
+            {
+                ::munmap(mapping, size);
+                throw std::runtime_error("JournalReader: not a journal segment " + path);
+            }
+
+            segments_.push_back(Segment{static_cast<const std::uint8_t *>(mapping), size, 0, {}});
+            Segment &added = segments_.back();
+
+            // A crashed writer leaves the file at full size; only trust complete records
+            const std::size_t used = std::min<std::size_t>(std::max<std::size_t>(header.usedBytes, HEADER_BYTES), size);
+            added.usedBytes = HEADER_BYTES + (used - HEADER_BYTES) / RECORD_BYTES * RECORD_BYTES;
+            ::madvise(const_cast<std::uint8_t *>(added.base), size, MADV_SEQUENTIAL);
+
+            if (added.usedBytes > HEADER_BYTES)
+            {
+                added.index = loadIndex(journal::segmentPath(directory, sequence, ".idx"), added.usedBytes);
+                if (added.index.empty())
+                {
+                    rebuildIndex(added);
+                }
+            }
+        }
+    }
+    catch (...)
+    {
+        for (const Segment &segment : segments_)
+        {
+            ::munmap(const_cast<std::uint8_t *>(segment.base), segment.mappedBytes);
+        }
+        throw;
+    }
+}
+
+JournalReader::~JournalReader()
+{
+    for (const Segment &segment : segments_)
+    {
+        ::munmap(const_cast<std::uint8_t *>(segment.base), segment.mappedBytes);
+    }
+}
+
+std::uint64_t JournalReader::replayInto(Aggregator &aggregator, const Query &query) const
+{
+    struct Feed
+    {
+        Aggregator &aggregator;
+        void operator()(const GnssSample &sample) { aggregator.addGnss(sample); }
+        void operator()(const EngineSample &sample) { aggregator.addEngine(sample); }
+    };
+    return replay(Feed{aggregator}, query);
+}
+
+std::uint64_t JournalReader::records() const
+{
+    std::uint64_t total = 0;
+    for (const Segment &segment : segments_)
+    {
+        total += (segment.usedBytes - HEADER_BYTES) / RECORD_BYTES;
+    }
+    return total;
+}
+
+// For segments whose writer never sealed them
+void JournalReader::rebuildIndex(Segment &segment)
+{
+    const auto *records = reinterpret_cast<const journal::Record *>(segment.base + HEADER_BYTES);
+    const std::size_t count = (segment.usedBytes - HEADER_BYTES) / RECORD_BYTES;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const journal::Record &record = records[i];
+        if (i % journal::DEFAULT_BLOCK_RECORDS == 0)
+        {
+            journal::IndexEntry entry{};
+            entry.offset = HEADER_BYTES + i * RECORD_BYTES;
+            entry.minTimestampMs = record.timestampMs;
+            entry.maxTimestampMs = record.timestampMs;
+            segment.index.push_back(entry);
+        }
+
+        journal::IndexEntry &entry = segment.index.back();
+        entry.minTimestampMs = std::min(entry.minTimestampMs, record.timestampMs);
+        entry.maxTimestampMs = std::max(entry.maxTimestampMs, record.timestampMs);
+        const unsigned bit = journal::vehicleBit(record.vehicle);
+        entry.vehicleBits[bit / 64] |= std::uint64_t{1} << (bit % 64);
+    }
+}
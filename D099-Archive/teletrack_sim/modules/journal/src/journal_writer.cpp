@@ -0,0 +1,210 @@
+#include "journal.h"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr std::size_t HEADER_BYTES = sizeof(journal::SegmentHeader);
+    constexpr std::size_t RECORD_BYTES = sizeof(journal::Record);
+
+    [[noreturn]] void fail(const std::string &what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+}
+
+namespace journal
+{
+    std::uint64_t segmentSequence(const std::string &fileName)
+    {
+        if (fileName.size() != 17 || fileName.compare(0, 8, "segment-") != 0 || fileName.compare(14, 3, ".tj") != 0)
+        {
+            return 0;
+        }
+        std::uint64_t sequence = 0;
+        for (std::size_t i = 8; i < 14; ++i)
+        {
+            if (fileName[i] < '0' || fileName[i] > '9')
+            {
+                return 0;
+            }
+            sequence = sequence * 10 + static_cast<std::uint64_t>(fileName[i] - '0');
+        }
+        return sequence;
+    }
+
+    std::string segmentPath(const std::string &directory, std::uint64_t sequence, const char *extension)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "segment-%06llu%s", static_cast<unsigned long long>(sequence), extension);
+        return (std::filesystem::path(directory) / name).string();
+    }
+}
+
+JournalWriter::JournalWriter(Options options) : options_(std::move(options))
+{
+    if (options_.segmentBytes < HEADER_BYTES + RECORD_BYTES || options_.blockRecords == 0)
+    {
+        throw std::invalid_argument("JournalWriter: segment must hold a record and blocks at least one");
+    }
+    capacity_ = HEADER_BYTES + (options_.segmentBytes - HEADER_BYTES) / RECORD_BYTES * RECORD_BYTES;
+
+    // Continue after whatever an earlier run left behind
+    std::filesystem::create_directories(options_.directory);
+    for (const auto &entry : std::filesystem::directory_iterator(options_.directory))
+    {
+        const std::uint64_t sequence = journal::segmentSequence(entry.path().filename().string());
+        sequence_ = sequence > sequence_ ? sequence : sequence_;
+    }
+
+    openSegment();
+}
+
+JournalWriter::~JournalWriter()
+{
+    try
+    {
+        sealSegment();
+    }
+    catch (const std::exception &)
+    {
+        // Readers rebuild a missing index from the records
+    }
+}
+
+void JournalWriter::append(const GnssSample &sample)
+{
+    journal::Record record{};
+    record.type = journal::RECORD_GNSS;
+    record.vehicle = sample.vehicle;
+    record.timestampMs = sample.timestampMs;
+    record.gnss = journal::GnssPayload{sample.latitude, sample.longitude};
+    write(record);
+}
+
+void JournalWriter::append(const EngineSample &sample)
+{
+    journal::Record record{};
+    record.type = journal::RECORD_ENGINE;
+    record.vehicle = sample.vehicle;
+    record.timestampMs = sample.timestampMs;
+    record.engine = journal::EnginePayload{sample.rpm, sample.coolantTemp, sample.fuelRate, 0.0f};
+    write(record);
+}
+
+void JournalWriter::sync()
+{
+    if (base_ != nullptr && msync(base_, used_, MS_SYNC) != 0)
+    {
+        fail("JournalWriter: msync");
+    }
+}
+
+void JournalWriter::write(const journal::Record &record)
+{
+    if (used_ + RECORD_BYTES > capacity_)
+    {
+        sealSegment();
+        openSegment();
+    }
+
+    if (blockFill_ == 0)
+    {
+        journal::IndexEntry entry{};
+        entry.offset = used_;
+        entry.minTimestampMs = record.timestampMs;
+        entry.maxTimestampMs = record.timestampMs;
+        index_.push_back(entry);
+    }
+
+    journal::IndexEntry &entry = index_.back();
+    entry.minTimestampMs = record.timestampMs < entry.minTimestampMs ? record.timestampMs : entry.minTimestampMs;
+    entry.maxTimestampMs = record.timestampMs > entry.maxTimestampMs ? record.timestampMs : entry.maxTimestampMs;
+    const unsigned bit = journal::vehicleBit(record.vehicle);
+    entry.vehicleBits[bit / 64] |= std::uint64_t{1} << (bit % 64);
+
+    std::memcpy(base_ + used_, &record, RECORD_BYTES);
+    used_ += RECORD_BYTES;
+    reinterpret_cast<journal::SegmentHeader *>(base_)->usedBytes = used_;
+
+    blockFill_ = blockFill_ + 1 == options_.blockRecords ? 0 : blockFill_ + 1;
+    ++records_;
+}
+
+void JournalWriter::openSegment()
+{
+    ++sequence_;
+    const std::string path = journal::segmentPath(options_.directory, sequence_, ".tj");
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0)
+    {
+        fail("JournalWriter: open " + path);
+    }
+    if (::ftruncate(fd_, static_cast<off_t>(capacity_)) != 0)
+    {
+        fail("JournalWriter: ftruncate " + path);
+    }
+
+    void *mapping = ::mmap(nullptr, capacity_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+    if (mapping == MAP_FAILED)
+    {
+        fail("JournalWriter: mmap " + path);
+    }
+    base_ = static_cast<std::uint8_t *>(mapping);
+
+    journal::SegmentHeader header{};
+    std::memcpy(header.magic, journal::SEGMENT_MAGIC, sizeof(header.magic));
+    header.headerBytes = HEADER_BYTES;
+    header.recordBytes = RECORD_BYTES;
+    header.sequence = sequence_;
+    header.usedBytes = HEADER_BYTES;
+    std::memcpy(base_, &header, HEADER_BYTES);
+
+    used_ = HEADER_BYTES;
+    blockFill_ = 0;
+    index_.clear();
+}
+
+// Write the sparse index next to the segment (renamed into place, so a
+// reader never sees half of it) and trim the unused tail of the file
+void JournalWriter::sealSegment()
+{
+    if (base_ == nullptr)
+    {
+        return;
+    }
+
+    ::munmap(base_, capacity_);
+    base_ = nullptr;
+    const int fd = fd_;
+    fd_ = -1;
+    const bool trimmed = ::ftruncate(fd, static_cast<off_t>(used_)) == 0;
+    ::close(fd);
+    if (!trimmed)
+    {
+        fail("JournalWriter: ftruncate");
+    }
+
+    const std::string final = journal::segmentPath(options_.directory, sequence_, ".idx");
+    const std::string temporary = final + ".tmp";
+
+    std::FILE *file = std::fopen(temporary.c_str(), "wb");
+    if (file == nullptr)
+    {
+        fail("JournalWriter: create " + temporary);
+    }
+    const bool written = std::fwrite(index_.data(), sizeof(journal::IndexEntry), index_.size(), file) == index_.size();
+    if (std::fclose(file) != 0 || !written)
+    {
+        fail("JournalWriter: write " + temporary);
+    }
+    std::filesystem::rename(temporary, final);
+}
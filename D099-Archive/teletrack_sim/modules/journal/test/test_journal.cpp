@@ -0,0 +1,326 @@
+#include <gtest/gtest.h>
+#include "journal.h"
+#include "aggregator.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+namespace
+{
+    // Fresh journal directory per test, removed afterwards
+    class JournalTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            const auto *info = ::testing::UnitTest::GetInstance()->current_test_info();
+            directory = (std::filesystem::temp_directory_path() /
+                         ("journal_test_" + std::to_string(::getpid()) + "_" + info->name()))
+                            .string();
+            std::filesystem::remove_all(directory);
+        }
+
+        void TearDown() override { std::filesystem::remove_all(directory); }
+
+        JournalWriter::Options options(std::size_t segmentBytes = 64 * 1024 * 1024, std::size_t blockRecords = 512)
+        {
+            JournalWriter::Options result;
+            result.directory = directory;
+            result.segmentBytes = segmentBytes;
+            result.blockRecords = blockRecords;
+            return result;
+        }
+
+        std::string directory;
+    };
+
+    // Everything a replay visited, in order
+    struct Recorder
+    {
+        std::vector<GnssSample> gnss;
+        std::vector<EngineSample> engine;
+        std::vector<int> order; // 0 = gnss, 1 = engine
+
+        void operator()(const GnssSample &sample)
+        {
+            gnss.push_back(sample);
+            order.push_back(0);
+        }
+
+        void operator()(const EngineSample &sample)
+        {
+            engine.push_back(sample);
+            order.push_back(1);
+        }
+    };
+
+    // vehicles samples of each kind per 100 ms tick
+    void writeFleet(JournalWriter &writer, std::uint32_t vehicles, std::uint64_t ticks)
+    {
+        for (std::uint64_t tick = 0; tick < ticks; ++tick)
+        {
+            for (std::uint32_t v = 0; v < vehicles; ++v)
+            {
+                writer.append(GnssSample{v, tick * 100, 1.3 + 1e-4 * static_cast<double>(tick), 103.8 + v});
+                writer.append(EngineSample{v, tick * 100, 800.0f + static_cast<float>(tick), 90.0f, 2.5f});
+            }
+        }
+    }
+}
+
+TEST_F(JournalTest, ReplaysSamplesInAppendOrder)
+{
+    {
+        JournalWriter writer(options());
+        writer.append(GnssSample{7, 100, 1.25, 103.5});
+        writer.append(EngineSample{7, 100, 1500.0f, 85.5f, 3.25f});
+        writer.append(GnssSample{8, 200, -33.9, 151.2});
+        EXPECT_EQ(writer.records(), 3u);
+    }
+
+    JournalReader reader(directory);
+    EXPECT_EQ(reader.segments(), 1u);
+    EXPECT_EQ(reader.records(), 3u);
+
+    Recorder recorder;
+    EXPECT_EQ(reader.replay(recorder), 3u);
+    EXPECT_EQ(recorder.order, (std::vector<int>{0, 1, 0}));
+
+    ASSERT_EQ(recorder.gnss.size(), 2u);
+    EXPECT_EQ(recorder.gnss[0].vehicle, 7u);
+    EXPECT_EQ(recorder.gnss[0].timestampMs, 100u);
+    EXPECT_DOUBLE_EQ(recorder.gnss[0].latitude, 1.25);
+    EXPECT_DOUBLE_EQ(recorder.gnss[0].longitude, 103.5);
+    EXPECT_EQ(recorder.gnss[1].vehicle, 8u);
+    EXPECT_DOUBLE_EQ(recorder.gnss[1].latitude, -33.9);
+
+    ASSERT_EQ(recorder.engine.size(), 1u);
+    EXPECT_FLOAT_EQ(recorder.engine[0].rpm, 1500.0f);
+    EXPECT_FLOAT_EQ(recorder.engine[0].coolantTemp, 85.5f);
+    EXPECT_FLOAT_EQ(recorder.engine[0].fuelRate, 3.25f);
+}
+
+TEST_F(JournalTest, RollsOverToNewSegmentsAndTrimsSealedOnes)
+{
+    // Header plus 100 records per segment
+    const std::size_t segmentBytes = sizeof(journal::SegmentHeader) + 100 * sizeof(journal::Record);
+    {
+        JournalWriter writer(options(segmentBytes, 16));
+        writeFleet(writer, 10, 25); // 500 records
+        EXPECT_EQ(writer.segments(), 5u);
+    }
+
+    for (std::uint64_t sequence = 1; sequence <= 5; ++sequence)
+    {
+        EXPECT_EQ(std::filesystem::file_size(journal::segmentPath(directory, sequence, ".tj")), segmentBytes);
+        EXPECT_TRUE(std::filesystem::exists(journal::segmentPath(directory, sequence, ".idx")));
+    }
+
+    JournalReader reader(directory);
+    EXPECT_EQ(reader.segments(), 5u);
+    EXPECT_EQ(reader.records(), 500u);
+
+    Recorder recorder;
+    EXPECT_EQ(reader.replay(recorder), 500u);
+    for (std::size_t i = 1; i < recorder.gnss.size(); ++i)
+    {
+        EXPECT_LE(recorder.gnss[i - 1].timestampMs, recorder.gnss[i].timestampMs);
+    }
+}
+
+TEST_F(JournalTest, ReopeningContinuesAfterTheLastSegment)
+{
+    {
+        JournalWriter writer(options());
+        writeFleet(writer, 2, 5);
+    }
+    {
+        JournalWriter writer(options());
+        writeFleet(writer, 2, 5);
+        EXPECT_EQ(writer.segments(), 2u);
+    }
+
+    JournalReader reader(directory);
+    EXPECT_EQ(reader.segments(), 2u);
+    EXPECT_EQ(reader.records(), 40u);
+}
+
+TEST_F(JournalTest, TimeRangeQuerySkipsBlocksOutsideTheRange)
+{
+    {
+        JournalWriter writer(options(64 * 1024 * 1024, 20));
+        writeFleet(writer, 10, 100); // one 20 record block per tick
+    }
+
+    JournalReader reader(directory);
+    JournalReader::Query query;
+    query.fromMs = 5000;
+    query.toMs = 5900;
+
+    Recorder recorder;
+    EXPECT_EQ(reader.replay(recorder, query), 200u);
+    EXPECT_EQ(reader.blocksSkipped(), 90u);
+    for (const GnssSample &sample : recorder.gnss)
+    {
+        EXPECT_GE(sample.timestampMs, 5000u);
+        EXPECT_LE(sample.timestampMs, 5900u);
+    }
+}
+
+TEST_F(JournalTest, VehicleQueryReturnsOnlyThatVehicle)
+{
+    {
+        JournalWriter writer(options(64 * 1024 * 1024, 8));
+        // Vehicles 0..3 for the first 50 ticks, then vehicles 100..103
+        writeFleet(writer, 4, 50);
+        for (std::uint64_t tick = 50; tick < 100; ++tick)
+        {
+            for (std::uint32_t v = 100; v < 104; ++v)
+            {
+                writer.append(GnssSample{v, tick * 100, 1.3, 103.8});
+                writer.append(EngineSample{v, tick * 100, 900.0f, 90.0f, 2.0f});
+            }
+        }
+    }
+
+    JournalReader reader(directory);
+    JournalReader::Query query;
+    query.vehicle = 2;
+
+    Recorder recorder;
+    EXPECT_EQ(reader.replay(recorder, query), 100u);
+    for (const GnssSample &sample : recorder.gnss)
+    {
+        EXPECT_EQ(sample.vehicle, 2u);
+    }
+    for (const EngineSample &sample : recorder.engine)
+    {
+        EXPECT_EQ(sample.vehicle, 2u);
+    }
+
+    // Vehicle 2 never shares a block with 100..103 (unless their filter bits collide)
+    const unsigned bit = journal::vehicleBit(2);
+    bool collides = false;
+    for (std::uint32_t v = 100; v < 104; ++v)
+    {
+        collides = collides || journal::vehicleBit(v) == bit;
+    }
+    if (!collides)
+    {
+        EXPECT_GE(reader.blocksSkipped(), 50u);
+    }
+}
+
+TEST_F(JournalTest, UnsealedSegmentIsReadUpToTheLastCompleteRecord)
+{
+    {
+        JournalWriter writer(options());
+        writeFleet(writer, 3, 10);
+        writer.sync();
+
+        // Simulate a crash: the file stays at full size and has no index
+        JournalReader reader(directory);
+        EXPECT_EQ(reader.records(), 60u);
+        Recorder recorder;
+        EXPECT_EQ(reader.replay(recorder), 60u);
+    }
+
+    std::filesystem::remove(journal::segmentPath(directory, 1, ".idx"));
+    JournalReader reader(directory);
+    Recorder recorder;
+    EXPECT_EQ(reader.replay(recorder), 60u);
+}
+
+TEST_F(JournalTest, DamagedIndexIsRebuilt)
+{
+    {
+        JournalWriter writer(options(64 * 1024 * 1024, 16));
+        writeFleet(writer, 3, 10); // 60 records, 4 blocks
+    }
+    const std::string indexPath = journal::segmentPath(directory, 1, ".idx");
+    ASSERT_EQ(std::filesystem::file_size(indexPath), 4 * sizeof(journal::IndexEntry));
+
+    Recorder expected;
+    JournalReader(directory).replay(expected);
+    ASSERT_EQ(expected.order.size(), 60u);
+
+    const std::size_t recordBytes = sizeof(journal::Record);
+    auto replayWithIndex = [&](std::size_t entry, std::uint64_t offset)
+    {
+        std::vector<journal::IndexEntry> entries(4);
+        std::FILE *file = std::fopen(indexPath.c_str(), "r+b");
+        ASSERT_NE(file, nullptr);
+        ASSERT_EQ(std::fread(entries.data(), sizeof(journal::IndexEntry), 4, file), 4u);
+        entries[entry].offset = offset;
+        std::rewind(file);
+        std::fwrite(entries.data(), sizeof(journal::IndexEntry), 4, file);
+        std::fclose(file);
+
+        JournalReader reader(directory);
+        Recorder recorder;
+        EXPECT_EQ(reader.replay(recorder), 60u);
+        EXPECT_EQ(recorder.order, expected.order);
+        ASSERT_EQ(recorder.gnss.size(), expected.gnss.size());
+        for (std::size_t i = 0; i < recorder.gnss.size(); ++i)
+        {
+            EXPECT_EQ(recorder.gnss[i].timestampMs, expected.gnss[i].timestampMs);
+        }
+    };
+
+    const std::uint64_t header = sizeof(journal::SegmentHeader);
+    replayWithIndex(2, header + 32 * recordBytes + 3); // misaligned
+    replayWithIndex(2, header + 8 * recordBytes);      // behind the block before it
+}
+
+TEST_F(JournalTest, ReplayIntoAggregatorMatchesLiveRun)
+{
+    std::vector<WindowResult> live;
+    {
+        Aggregator aggregator(WindowSpec::tumbling(1000), [&](const WindowResult &result)
+                              { live.push_back(result); });
+        JournalWriter writer(options());
+
+        for (std::uint64_t tick = 0; tick < 50; ++tick)
+        {
+            for (std::uint32_t v = 0; v < 5; ++v)
+            {
+                const GnssSample gnss{v, tick * 100, 1.3 + 1e-4 * static_cast<double>(tick * (v + 1)), 103.8};
+                const EngineSample engine{v, tick * 100, 1000.0f + static_cast<float>(v * tick), 90.0f, 2.0f};
+                aggregator.addGnss(gnss);
+                aggregator.addEngine(engine);
+                writer.append(gnss);
+                writer.append(engine);
+            }
+        }
+        aggregator.flush();
+    }
+
+    std::vector<WindowResult> replayed;
+    Aggregator aggregator(WindowSpec::tumbling(1000), [&](const WindowResult &result)
+                          { replayed.push_back(result); });
+    JournalReader reader(directory);
+    EXPECT_EQ(reader.replayInto(aggregator), 500u);
+    aggregator.flush();
+
+    ASSERT_EQ(replayed.size(), live.size());
+    for (std::size_t i = 0; i < live.size(); ++i)
+    {
+        EXPECT_EQ(replayed[i].vehicle, live[i].vehicle);
+        EXPECT_EQ(replayed[i].startMs, live[i].startMs);
+        EXPECT_DOUBLE_EQ(replayed[i].stats.distanceM, live[i].stats.distanceM);
+        EXPECT_EQ(replayed[i].stats.rpm.count, live[i].stats.rpm.count);
+    }
+}
+
+TEST_F(JournalTest, RejectsFilesThatAreNotSegments)
+{
+    std::filesystem::create_directories(directory);
+    std::FILE *file = std::fopen(journal::segmentPath(directory, 1, ".tj").c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fputs("definitely not a journal segment, just some text padding it out to 64+ bytes ......", file);
+    std::fclose(file);
+
+    EXPECT_THROW(JournalReader reader(directory), std::runtime_error);
+}
@@ -0,0 +1,235 @@
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "spsc_ring.h"
+
+enum class LogLevel : std::uint8_t
+{
+    Debug,
+    Info,
+    Warn,
+    Error
+};
+
+// What a producer does when its ring is full
+enum class OverflowPolicy
+{
+    Drop,  // discard the record and count it in dropped()
+    Block  // spin until the background thread makes room
+};
+
+/**
+ * Binary log record: the format string pointer plus raw argument values.
+ * Nothing is formatted on the hot path.
+ */
+struct LogRecord
+{
+    static constexpr std::size_t MAX_ARGS = 6;
+
+    enum ArgType : std::uint8_t
+    {
+        ARG_INT,
+        ARG_UINT,
+        ARG_DOUBLE,
+        ARG_BOOL,
+        ARG_CHAR,
+        ARG_STRING // const char* with static lifetime (string literal)
+    };
+
+    union Arg
+    {
+        std::int64_t i;
+        std::uint64_t u;
+        double d;
+        const char *s;
+    };
+
+    std::uint64_t timestampNs; // system_clock, since epoch
+    const char *format;        // "{}" placeholders, must outlive the logger
+    LogLevel level;
+    std::uint8_t argCount;
+    std::uint16_t thread;      // producer index, in registration order
+    ArgType types[MAX_ARGS];
+    Arg args[MAX_ARGS];
+};
+
+/**
+ * Asynchronous logger for hot simulation threads.
+ *
+ * Each producing thread gets its own SpscRing of LogRecords on first use.
+ * log() only captures a timestamp and copies the raw arguments into the ring;
+ * a background thread drains every ring, formats the records and writes them
+ * to the file in large batches.
+ *
+ *     AsyncLogger logger({"teletrack.log"});
+ *     logger.info("vehicle {} at {} km/h", id, speed);
+ *
+ * Format strings and string arguments must be literals (or otherwise outlive
+ * the logger): only their pointers are stored.
+ *
+ * When a producer thread exits its ring goes back to the logger and is given
+ * to a new thread once the background thread has drained it, so short-lived
+ * worker threads can come and go for the logger's whole life. At most
+ * MAX_PRODUCERS threads can hold a ring at the same time; records from any
+ * thread beyond that are dropped and counted in dropped().
+ */
+class AsyncLogger
+{
+public:
+    struct Options
+    {
+        std::string path;                                // output file, truncated
+        std::size_t ringCapacity = 8192;                 // records per producer thread
+        OverflowPolicy overflow = OverflowPolicy::Drop;  // full ring behaviour
+        LogLevel minLevel = LogLevel::Debug;             // lower levels are ignored
+        std::chrono::microseconds idleSleep{500};        // background poll interval when idle
+    };
+
+    static constexpr std::size_t MAX_PRODUCERS = 256; // threads holding a ring at the same time
+
+    explicit AsyncLogger(Options options);
+    ~AsyncLogger(); // drains everything, then closes the file
+
+    AsyncLogger(const AsyncLogger &) = delete;
+    AsyncLogger &operator=(const AsyncLogger &) = delete;
+
+    // Enqueue one record, false if it was filtered or dropped
+    template <typename... Args>
+    bool log(LogLevel level, const char *format, const Args &...args);
+
+    template <typename... Args>
+    bool debug(const char *format, const Args &...args) { return log(LogLevel::Debug, format, args...); }
+    template <typename... Args>
+    bool info(const char *format, const Args &...args) { return log(LogLevel::Info, format, args...); }
+    template <typename... Args>
+    bool warn(const char *format, const Args &...args) { return log(LogLevel::Warn, format, args...); }
+    template <typename... Args>
+    bool error(const char *format, const Args &...args) { return log(LogLevel::Error, format, args...); }
+
+    // Block until every record enqueued before this call is in the file
+    void flush();
+
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    std::uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+
+private:
+    using Ring = SpscRing<LogRecord>;
+
+    struct ThreadRings; // per-thread ring cache, hands rings back when its thread exits
+    static thread_local ThreadRings threadRings_;
+
+    Ring *ringForThisThread(std::uint16_t &index);
+    void releaseRing(std::uint16_t index);
+    bool enqueue(LogRecord &record);
+    void run();
+    bool drainOnce(std::string &buffer);
+    void format(std::string &out, const LogRecord &record);
+
+    // Argument capture, one overload family per supported type
+    template <typename T>
+    static void capture(LogRecord &record, const T &value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "log arguments must be numbers, bool, char or string literals");
+        const std::size_t i = record.argCount++;
+        if constexpr (std::is_same<T, bool>::value)
+        {
+            record.types[i] = LogRecord::ARG_BOOL;
+            record.args[i].u = value ? 1 : 0;
+        }
+        else if constexpr (std::is_same<T, char>::value)
+        {
+            record.types[i] = LogRecord::ARG_CHAR;
+            record.args[i].u = static_cast<unsigned char>(value);
+        }
+        else if constexpr (std::is_floating_point<T>::value)
+        {
+            record.types[i] = LogRecord::ARG_DOUBLE;
+            record.args[i].d = static_cast<double>(value);
+        }
+        else if constexpr (std::is_signed<T>::value)
+        {
+            record.types[i] = LogRecord::ARG_INT;
+            record.args[i].i = static_cast<std::int64_t>(value);
+        }
+        else
+        {
+            record.types[i] = LogRecord::ARG_UINT;
+            record.args[i].u = static_cast<std::uint64_t>(value);
+        }
+    }
+
+    static void capture(LogRecord &record, const char *value)
+    {
+        const std::size_t i = record.argCount++;
+        record.types[i] = LogRecord::ARG_STRING;
+        record.args[i].s = value;
+    }
+
+    template <std::size_t N>
+    static void capture(LogRecord &record, const char (&value)[N])
+    {
+        capture(record, static_cast<const char *>(value));
+    }
+
+    // Only the pointer would be stored, which dangles once the string dies
+    static void capture(LogRecord &record, const std::string &value) = delete;
+
+    const Options options_;
+    const std::uint64_t id_; // distinguishes loggers in the per-thread ring cache
+    std::FILE *file_;
+
+    std::mutex registerMutex_;                       // producer registration only
+    std::unique_ptr<Ring> ownedRings_[MAX_PRODUCERS];
+    std::atomic<Ring *> rings_[MAX_PRODUCERS];
+    std::atomic<std::size_t> ringCount_{0};
+    std::vector<std::uint16_t> released_; // rings of exited threads, reused once drained
+
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> written_{0};
+
+    std::mutex passMutex_; // flush() waits on completed background passes
+    std::condition_variable passDone_;
+    std::uint64_t passes_ = 0;
+
+    std::atomic<bool> stopping_{false};
+    std::thread worker_;
+
+    // Cache of the last formatted second for timestamps
+    std::uint64_t cachedSecond_ = ~std::uint64_t{0};
+    char cachedStamp_[32] = {};
+};
+
+template <typename... Args>
+bool AsyncLogger::log(LogLevel level, const char *format, const Args &...args)
+{
+    static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "too many log arguments");
+
+    if (level < options_.minLevel)
+    {
+        return false;
+    }
+
+    LogRecord record;
+    record.timestampNs = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    record.format = format;
+    record.level = level;
+    record.argCount = 0;
+    record.thread = 0;
+    (capture(record, args), ...);
+
+    return enqueue(record);
+}
+
+#endif // ASYNC_LOGGER_H
@@ -0,0 +1,93 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**
+ * Bounded single-producer / single-consumer ring buffer.
+ *
+ * Capacity is rounded up to a power of two. The producer and consumer indices
+ * sit on separate cache lines and each side caches the other's index, so the
+ * common case of push/pop touches no shared cache line at all.
+ */
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(std::size_t capacity)
+        : capacity_(roundUp(capacity)), mask_(capacity_ - 1), slots_(new T[capacity_]) {}
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    // Producer side: false when full
+    bool tryPush(const T &value)
+    {
+        const std::size_t tail = tail_.value.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == capacity_)
+        {
+            cachedHead_ = head_.value.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == capacity_)
+            {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = value;
+        tail_.value.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: false when empty
+    bool tryPop(T &out)
+    {
+        const std::size_t head = head_.value.load(std::memory_order_relaxed);
+        if (head == cachedTail_)
+        {
+            cachedTail_ = tail_.value.load(std::memory_order_acquire);
+            if (head == cachedTail_)
+            {
+                return false;
+            }
+        }
+        out = slots_[head & mask_];
+        head_.value.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side snapshot, may be stale by the time it is used
+    bool empty() const
+    {
+        return head_.value.load(std::memory_order_acquire) == tail_.value.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return capacity_; }
+
+private:
+    struct alignas(64) Index
+    {
+        std::atomic<std::size_t> value{0};
+    };
+
+    static std::size_t roundUp(std::size_t capacity)
+    {
+        std::size_t rounded = 2;
+        while (rounded < capacity)
+        {
+            rounded <<= 1;
+        }
+        return rounded;
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::unique_ptr<T[]> slots_;
+
+    Index head_;                                // next slot to pop (consumer)
+    Index tail_;                                // next slot to push (producer)
+    alignas(64) std::size_t cachedHead_ = 0;    // producer's copy of head_
+    alignas(64) std::size_t cachedTail_ = 0;    // consumer's copy of tail_
+};
+
+#endif // SPSC_RING_H
@@ -0,0 +1,311 @@
+#include "async_logger.h"
+#include <charconv>
+#include <ctime>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::atomic<std::uint64_t> nextLoggerId{1};
+
+    // Loggers still alive, so an exiting thread only hands rings back to those
+    std::mutex liveMutex;
+    std::unordered_map<std::uint64_t, AsyncLogger *> liveLoggers;
+
+    const char *levelName(LogLevel level)
+    {
+        switch (level)
+        {
+        case LogLevel::Debug:
+            return "DEBUG";
+        case LogLevel::Info:
+            return "INFO ";
+        case LogLevel::Warn:
+            return "WARN ";
+        case LogLevel::Error:
+            return "ERROR";
+        }
+        return "?????";
+    }
+
+    template <typename T>
+    void appendNumber(std::string &out, T value)
+    {
+        char digits[32];
+        const auto result = std::to_chars(digits, digits + sizeof(digits), value);
+        out.append(digits, result.ptr);
+    }
+
+    void appendArg(std::string &out, LogRecord::ArgType type, const LogRecord::Arg &arg)
+    {
+        switch (type)
+        {
+        case LogRecord::ARG_INT:
+            appendNumber(out, arg.i);
+            break;
+        case LogRecord::ARG_UINT:
+            appendNumber(out, arg.u);
+            break;
+        case LogRecord::ARG_DOUBLE:
+            appendNumber(out, arg.d);
+            break;
+        case LogRecord::ARG_BOOL:
+            out += arg.u ? "true" : "false";
+            break;
+        case LogRecord::ARG_CHAR:
+            out += static_cast<char>(arg.u);
+            break;
+        case LogRecord::ARG_STRING:
+            out += arg.s ? arg.s : "(null)";
+            break;
+        }
+    }
+}
+
+// Rings this thread already registered, keyed by logger id so a thread can
+// log to several loggers (ids are never reused)
+struct AsyncLogger::ThreadRings
+{
+    struct Entry
+    {
+        std::uint64_t logger;
+        Ring *ring;
+        std::uint16_t index;
+    };
+
+    std::vector<Entry> entries;
+
+    ~ThreadRings()
+    {
+        std::lock_guard<std::mutex> lock(liveMutex);
+        for (const Entry &entry : entries)
+        {
+            const auto live = liveLoggers.find(entry.logger);
+            if (live != liveLoggers.end())
+            {
+                live->second->releaseRing(entry.index);
+            }
+        }
+    }
+};
+
+thread_local AsyncLogger::ThreadRings AsyncLogger::threadRings_;
+
+AsyncLogger::AsyncLogger(Options options)
+    : options_(std::move(options)), id_(nextLoggerId.fetch_add(1, std::memory_order_relaxed)),
+      file_(std::fopen(options_.path.c_str(), "w"))
+{
+    if (!file_)
+    {
+        throw std::runtime_error("AsyncLogger: cannot open " + options_.path);
+    }
+    for (std::atomic<Ring *> &ring : rings_)
+    {
+        ring.store(nullptr, std::memory_order_relaxed);
+    }
+    worker_ = std::thread(&AsyncLogger::run, this);
+
+    std::lock_guard<std::mutex> lock(liveMutex);
+    liveLoggers.emplace(id_, this);
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    {
+        // No thread can hand a ring back from here on
+        std::lock_guard<std::mutex> lock(liveMutex);
+        liveLoggers.erase(id_);
+    }
+    stopping_.store(true, std::memory_order_release);
+    worker_.join();
+    std::fclose(file_);
+}
+
+void AsyncLogger::flush()
+{
+    // The pass running now may already have walked past our ring: wait for it
+    // plus one full pass that started after this call
+    std::unique_lock<std::mutex> lock(passMutex_);
+    const std::uint64_t target = passes_ + 2;
+    passDone_.wait(lock, [&]
+                   { return passes_ >= target; });
+}
+
+// Lazily registers one ring per producer thread, nullptr while MAX_PRODUCERS threads hold one
+AsyncLogger::Ring *AsyncLogger::ringForThisThread(std::uint16_t &index)
+{
+    for (const ThreadRings::Entry &entry : threadRings_.entries)
+    {
+        if (entry.logger == id_)
+        {
+            index = entry.index;
+            return entry.ring;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(registerMutex_);
+
+    // A ring whose thread has exited is ours once its last records are written
+    for (std::size_t i = 0; i < released_.size(); ++i)
+    {
+        Ring *ring = rings_[released_[i]].load(std::memory_order_relaxed);
+        if (ring->empty())
+        {
+            index = released_[i];
+            released_.erase(released_.begin() + static_cast<std::ptrdiff_t>(i));
+            threadRings_.entries.push_back(ThreadRings::Entry{id_, ring, index});
+            return ring;
+        }
+    }
+
+    const std::size_t count = ringCount_.load(std::memory_order_relaxed);
+    if (count == MAX_PRODUCERS)
+    {
+        return nullptr;
+    }
+
+    ownedRings_[count] = std::make_unique<Ring>(options_.ringCapacity);
+    Ring *ring = ownedRings_[count].get();
+    rings_[count].store(ring, std::memory_order_release);
+    ringCount_.store(count + 1, std::memory_order_release);
+
+    index = static_cast<std::uint16_t>(count);
+    threadRings_.entries.push_back(ThreadRings::Entry{id_, ring, index});
+    return ring;
+}
+
+// Called as a producer thread exits; the background thread keeps draining the ring
+void AsyncLogger::releaseRing(std::uint16_t index)
+{
+    std::lock_guard<std::mutex> lock(registerMutex_);
+    released_.push_back(index);
+}
+
+bool AsyncLogger::enqueue(LogRecord &record)
+{
+    Ring *ring = ringForThisThread(record.thread);
+    if (!ring)
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (ring->tryPush(record))
+    {
+        return true;
+    }
+    if (options_.overflow == OverflowPolicy::Drop)
+    {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    while (!ring->tryPush(record))
+    {
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+void AsyncLogger::run()
+{
+    std::string buffer;
+    buffer.reserve(1 << 16);
+
+    for (;;)
+    {
+        // Read the flag before draining so records pushed before the
+        // destructor ran are always part of the final pass
+        const bool stop = stopping_.load(std::memory_order_acquire);
+        const bool busy = drainOnce(buffer);
+
+        {
+            std::lock_guard<std::mutex> lock(passMutex_);
+            ++passes_;
+        }
+        passDone_.notify_all();
+
+        if (stop && !busy)
+        {
+            return;
+        }
+        if (!busy)
+        {
+            std::this_thread::sleep_for(options_.idleSleep);
+        }
+    }
+}
+
+// One pass over every ring; writes what it found as a single batch
+bool AsyncLogger::drainOnce(std::string &buffer)
+{
+    // Bound the work per ring so one chatty thread cannot starve the others
+    const std::size_t budget = options_.ringCapacity;
+    std::size_t count = 0;
+
+    const std::size_t rings = ringCount_.load(std::memory_order_acquire);
+    for (std::size_t r = 0; r < rings; ++r)
+    {
+        Ring *ring = rings_[r].load(std::memory_order_acquire);
+        LogRecord record;
+        for (std::size_t n = 0; n < budget && ring->tryPop(record); ++n)
+        {
+            format(buffer, record);
+            ++count;
+        }
+    }
+
+    if (count == 0)
+    {
+        return false;
+    }
+
+    std::fwrite(buffer.data(), 1, buffer.size(), file_);
+    std::fflush(file_);
+    buffer.clear();
+    written_.fetch_add(count, std::memory_order_relaxed);
+    return true;
+}
+
+// "2026-01-31 12:00:00.123456 INFO  [t0] message"
+void AsyncLogger::format(std::string &out, const LogRecord &record)
+{
+    const std::uint64_t second = record.timestampNs / 1000000000u;
+    if (second != cachedSecond_)
+    {
+        const std::time_t seconds = static_cast<std::time_t>(second);
+        std::tm utc{};
+        gmtime_r(&seconds, &utc);
+        std::strftime(cachedStamp_, sizeof(cachedStamp_), "%Y-%m-%d %H:%M:%S", &utc);
+        cachedSecond_ = second;
+    }
+
+    char micros[8];
+    std::snprintf(micros, sizeof(micros), ".%06u", static_cast<unsigned>((record.timestampNs / 1000u) % 1000000u));
+
+    out += cachedStamp_;
+    out += micros;
+    out += ' ';
+    out += levelName(record.level);
+    out += " [t";
+    appendNumber(out, static_cast<unsigned>(record.thread));
+    out += "] ";
+
+    // Substitute "{}" placeholders in order; surplus placeholders stay as text
+    std::size_t arg = 0;
+    for (const char *p = record.format; *p; ++p)
+    {
+        if (p[0] == '{' && p[1] == '}' && arg < record.argCount)
+        {
+            appendArg(out, record.types[arg], record.args[arg]);
+            ++arg;
+            ++p;
+        }
+        else
+        {
+            out += *p;
+        }
+    }
+    out += '\n';
+}
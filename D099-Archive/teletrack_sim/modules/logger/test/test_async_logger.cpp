@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+#include "async_logger.h"
+#include "spsc_ring.h"
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::string tempPath(const char *name)
+    {
+        return std::string(::testing::TempDir()) + name;
+    }
+
+    std::vector<std::string> readLines(const std::string &path)
+    {
+        std::ifstream in(path);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(in, line);)
+        {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    // Text after "[tN] "
+    std::string message(const std::string &line)
+    {
+        return line.substr(line.find("] ") + 2);
+    }
+}
+
+TEST(SpscRingTest, PushPopInOrderUntilFull)
+{
+    SpscRing<int> ring(3); // rounded up to 4
+    ASSERT_EQ(ring.capacity(), 4u);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.tryPush(i));
+    }
+    ASSERT_FALSE(ring.tryPush(99));
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i)
+    {
+        ASSERT_TRUE(ring.tryPop(value));
+        ASSERT_EQ(value, i);
+    }
+    ASSERT_FALSE(ring.tryPop(value));
+    ASSERT_TRUE(ring.empty());
+}
+
+TEST(SpscRingTest, ProducerAndConsumerThreads)
+{
+    SpscRing<std::uint64_t> ring(64);
+    const std::uint64_t count = 200000;
+
+    std::thread producer([&]
+                         {
+                             for (std::uint64_t i = 0; i < count; ++i)
+                             {
+                                 while (!ring.tryPush(i))
+                                 {
+                                     std::this_thread::yield();
+                                 }
+                             } });
+
+    std::uint64_t expected = 0;
+    std::uint64_t value = 0;
+    while (expected < count)
+    {
+        if (ring.tryPop(value))
+        {
+            ASSERT_EQ(value, expected);
+            ++expected;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+}
+
+TEST(AsyncLoggerTest, FormatsPlaceholdersAndLevels)
+{
+    const std::string path = tempPath("async_logger_format.log");
+    {
+        AsyncLogger logger({path});
+        logger.info("vehicle {} at {} km/h", 42, 87.5);
+        logger.warn("engine {} hot: {}", "E1", true);
+        logger.error("code {} / {}", static_cast<std::uint64_t>(7), 'x');
+        logger.debug("no args {}");
+        logger.flush();
+        EXPECT_EQ(logger.written(), 4u);
+    }
+
+    const auto lines = readLines(path);
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_NE(lines[0].find(" INFO  [t0] "), std::string::npos);
+    EXPECT_EQ(message(lines[0]), "vehicle 42 at 87.5 km/h");
+    EXPECT_NE(lines[1].find(" WARN  "), std::string::npos);
+    EXPECT_EQ(message(lines[1]), "engine E1 hot: true");
+    EXPECT_EQ(message(lines[2]), "code 7 / x");
+    EXPECT_NE(lines[3].find(" DEBUG "), std::string::npos);
+    EXPECT_EQ(message(lines[3]), "no args {}");
+
+    // "YYYY-MM-DD HH:MM:SS.uuuuuu "
+    EXPECT_EQ(lines[0][4], '-');
+    EXPECT_EQ(lines[0][19], '.');
+    EXPECT_EQ(lines[0][26], ' ');
+    std::remove(path.c_str());
+}
+
+TEST(AsyncLoggerTest, FiltersBelowMinLevel)
+{
+    const std::string path = tempPath("async_logger_level.log");
+    AsyncLogger::Options options{path};
+    options.minLevel = LogLevel::Warn;
+    {
+        AsyncLogger logger(options);
+        EXPECT_FALSE(logger.info("hidden"));
+        EXPECT_TRUE(logger.error("shown"));
+    }
+
+    const auto lines = readLines(path);
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(message(lines[0]), "shown");
+    std::remove(path.c_str());
+}
+
+TEST(AsyncLoggerTest, DropPolicyCountsLostRecords)
+{
+    const std::string path = tempPath("async_logger_drop.log");
+    AsyncLogger::Options options{path};
+    options.ringCapacity = 4;
+    options.idleSleep = std::chrono::milliseconds(50);
+
+    std::uint64_t accepted = 0;
+    std::uint64_t dropped = 0;
+    {
+        AsyncLogger logger(options);
+        for (int i = 0; i < 10000; ++i)
+        {
+            logger.info("burst {}", i);
+        }
+        logger.flush();
+        dropped = logger.dropped();
+        accepted = logger.written();
+    }
+
+    EXPECT_GT(dropped, 0u);
+    EXPECT_EQ(accepted + dropped, 10000u);
+    EXPECT_EQ(readLines(path).size(), accepted);
+    std::remove(path.c_str());
+}
+
+TEST(AsyncLoggerTest, BlockPolicyKeepsEveryRecordFromEveryThread)
+{
+    const std::string path = tempPath("async_logger_threads.log");
+    AsyncLogger::Options options{path};
+    options.ringCapacity = 64;
+    options.overflow = OverflowPolicy::Block;
+
+    const int threads = 4;
+    const int perThread = 20000;
+    {
+        AsyncLogger logger(options);
+        std::vector<std::thread> producers;
+        for (int t = 0; t < threads; ++t)
+        {
+            producers.emplace_back([&logger, t]
+                                   {
+                                       for (int i = 0; i < perThread; ++i)
+                                       {
+                                           logger.info("{} {}", t, i);
+                                       } });
+        }
+        for (std::thread &producer : producers)
+        {
+            producer.join();
+        }
+        EXPECT_EQ(logger.dropped(), 0u);
+    }
+
+    // Each producer's records keep their order
+    std::vector<int> next(threads, 0);
+    std::set<std::string> rings;
+    const auto lines = readLines(path);
+    ASSERT_EQ(lines.size(), static_cast<std::size_t>(threads * perThread));
+    for (const std::string &line : lines)
+    {
+        int t = -1;
+        int i = -1;
+        ASSERT_EQ(std::sscanf(message(line).c_str(), "%d %d", &t, &i), 2);
+        ASSERT_EQ(i, next[t]);
+        ++next[t];
+        rings.insert(line.substr(line.find("[t"), 4));
+    }
+    EXPECT_EQ(rings.size(), static_cast<std::size_t>(threads));
+    std::remove(path.c_str());
+}
+
+TEST(AsyncLoggerTest, RingsOfExitedThreadsAreReused)
+{
+    const std::string path = tempPath("async_logger_churn.log");
+    AsyncLogger::Options options{path};
+    options.ringCapacity = 16;
+
+    // Far more threads over the logger's life than it has rings
+    const std::size_t threads = AsyncLogger::MAX_PRODUCERS + 100;
+    {
+        AsyncLogger logger(options);
+        for (std::size_t t = 0; t < threads; ++t)
+        {
+            std::thread([&logger, t]
+                        { EXPECT_TRUE(logger.info("worker {}", t)); })
+                .join();
+            logger.flush(); // lets the exited thread's ring drain
+        }
+        EXPECT_EQ(logger.dropped(), 0u);
+        EXPECT_EQ(logger.written(), threads);
+    }
+
+    EXPECT_EQ(readLines(path).size(), threads);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,80 @@
+#ifndef LOOPBACK_BROKER_H
+#define LOOPBACK_BROKER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "mqtt_packet.h"
+
+/**
+ * In-process stand-in for an MQTT broker, for offline tests and benchmarks.
+ *
+ * Owns one end of a socketpair and serves it on a background thread:
+ * answers CONNECT with CONNACK, counts PUBLISH packets (optionally handing
+ * them to a callback) and acknowledges QoS 1 with PUBACK, batching all
+ * replies produced by one read into a single write. It does not route or
+ * retain anything.
+ */
+class LoopbackBroker
+{
+public:
+    struct Message
+    {
+        std::string topic;
+        std::string payload;
+        mqtt::QoS qos;
+        std::uint16_t packetId;
+        bool dup;
+    };
+
+    // Runs on the broker thread
+    using MessageCallback = std::function<void(const Message &)>;
+
+    explicit LoopbackBroker(MessageCallback onMessage = nullptr);
+    ~LoopbackBroker();
+
+    LoopbackBroker(const LoopbackBroker &) = delete;
+    LoopbackBroker &operator=(const LoopbackBroker &) = delete;
+
+    // The client end of the socketpair; the caller takes ownership (call once)
+    int takeClientFd();
+
+    // Hold back PUBACKs (false) or send them, including the held ones (true)
+    void setAcking(bool enabled) { acking_.store(enabled, std::memory_order_release); }
+
+    // Wait until at least count PUBLISH packets arrived; false on timeout
+    bool waitForMessages(std::uint64_t count, std::chrono::milliseconds timeout);
+
+    std::uint64_t messages() const { return messages_.load(std::memory_order_acquire); }
+    std::uint64_t bytes() const { return bytes_.load(std::memory_order_relaxed); }
+    bool connected() const { return connected_.load(std::memory_order_acquire); }
+
+private:
+    void run();
+    bool handle(std::vector<std::uint8_t> &rx, std::vector<std::uint8_t> &replies);
+
+    MessageCallback onMessage_;
+    int brokerFd_ = -1;
+    int clientFd_ = -1;
+
+    std::atomic<bool> acking_{true};
+    std::vector<std::uint16_t> heldAcks_; // broker thread only
+
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> connected_{false};
+    std::atomic<std::uint64_t> messages_{0};
+    std::atomic<std::uint64_t> bytes_{0};
+
+    std::mutex mutex_;
+    std::condition_variable arrived_;
+
+    std::thread thread_;
+};
+
+#endif // LOOPBACK_BROKER_H
@@ -0,0 +1,75 @@
+#ifndef MQTT_PACKET_H
+#define MQTT_PACKET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * Minimal MQTT 3.1.1 wire codec: just the packets a telemetry publisher and
+ * its loopback broker exchange. Encoders append to a caller-owned buffer so
+ * the same storage is reused for every packet.
+ */
+namespace mqtt
+{
+    enum PacketType : std::uint8_t
+    {
+        CONNECT = 1,
+        CONNACK = 2,
+        PUBLISH = 3,
+        PUBACK = 4,
+        PINGREQ = 12,
+        PINGRESP = 13,
+        DISCONNECT = 14
+    };
+
+    enum class QoS : std::uint8_t
+    {
+        AtMostOnce = 0,
+        AtLeastOnce = 1
+    };
+
+    constexpr std::uint8_t PUBLISH_DUP = 0x08; // fixed header flag on retransmission
+    constexpr std::uint32_t MAX_REMAINING_LENGTH = 268435455; // 4 length bytes
+
+    // Decoded fixed header of one packet
+    struct FixedHeader
+    {
+        std::uint8_t type;
+        std::uint8_t flags;
+        std::uint32_t remainingLength;
+        std::size_t headerSize; // 1 type byte + 1..4 length bytes
+    };
+
+    enum class DecodeStatus
+    {
+        Ok,
+        NeedMore,
+        Malformed
+    };
+
+    // Variable length "remaining length", returns the bytes written (1..4)
+    std::size_t encodeRemainingLength(std::uint32_t length, std::uint8_t *out);
+
+    // Parse the fixed header at the start of data
+    DecodeStatus decodeFixedHeader(const std::uint8_t *data, std::size_t size, FixedHeader &out);
+
+    // Exact size of a PUBLISH packet with this topic and payload size
+    std::size_t publishSize(std::string_view topic, std::size_t payloadSize, QoS qos);
+
+    void appendConnect(std::vector<std::uint8_t> &out, std::string_view clientId, std::uint16_t keepAliveSeconds,
+                       bool cleanSession = true);
+    void appendConnack(std::vector<std::uint8_t> &out, std::uint8_t returnCode);
+
+    // packetId is ignored for QoS 0
+    void appendPublish(std::vector<std::uint8_t> &out, std::string_view topic, const void *payload,
+                       std::size_t payloadSize, QoS qos, std::uint16_t packetId);
+
+    void appendPuback(std::vector<std::uint8_t> &out, std::uint16_t packetId);
+    void appendPingreq(std::vector<std::uint8_t> &out);
+    void appendPingresp(std::vector<std::uint8_t> &out);
+    void appendDisconnect(std::vector<std::uint8_t> &out);
+}
+
+#endif // MQTT_PACKET_H
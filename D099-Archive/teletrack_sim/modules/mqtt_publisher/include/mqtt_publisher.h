@@ -0,0 +1,127 @@
+#ifndef MQTT_PUBLISHER_H
+#define MQTT_PUBLISHER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sys/uio.h>
+#include "mqtt_packet.h"
+
+/**
+ * Batching MQTT 3.1.1 publisher over an already connected stream socket.
+ *
+ * publish() encodes the PUBLISH packet straight into the current send chunk
+ * (reused between batches, never freed). Nothing hits the socket until a
+ * batch is full or flush() is called; then every chunk goes out in a single
+ * gather write (sendmsg, i.e. writev with MSG_NOSIGNAL), so thousands of
+ * samples cost one syscall.
+ *
+ * QoS 1 packets get a packet id and a copy in the in-flight table until their
+ * PUBACK arrives; acks are read opportunistically on every flush. When the
+ * table is full, publish() waits for acks. Ack round-trip times are kept as
+ * latency statistics.
+ *
+ * The socket is switched to non-blocking mode: a flush that cannot write
+ * keeps reading acks, so a broker blocked on sending acks never deadlocks us.
+ * Socket errors throw std::system_error.
+ */
+class MqttPublisher
+{
+public:
+    struct Options
+    {
+        std::string clientId = "teletrack";
+        std::uint16_t keepAliveSeconds = 60;
+        std::size_t chunkBytes = 64 * 1024;  // size of one send chunk (one iovec)
+        std::size_t maxChunks = 16;          // chunks per gather write; reaching it flushes
+        std::size_t maxInflight = 1024;      // unacknowledged QoS 1 packets
+    };
+
+    // Takes ownership of fd
+    MqttPublisher(int fd, Options options);
+    explicit MqttPublisher(int fd) : MqttPublisher(fd, Options{}) {}
+    ~MqttPublisher();
+
+    MqttPublisher(const MqttPublisher &) = delete;
+    MqttPublisher &operator=(const MqttPublisher &) = delete;
+
+    // Send CONNECT and wait for CONNACK; throws if refused or timed out
+    void connect(std::chrono::milliseconds timeout = std::chrono::seconds(5));
+
+    // Queue one message. QoS 1 returns its packet id, QoS 0 returns 0.
+    std::uint16_t publish(std::string_view topic, const void *payload, std::size_t size,
+                          mqtt::QoS qos = mqtt::QoS::AtMostOnce);
+
+    std::uint16_t publish(std::string_view topic, std::string_view payload, mqtt::QoS qos = mqtt::QoS::AtMostOnce)
+    {
+        return publish(topic, payload.data(), payload.size(), qos);
+    }
+
+    // Write everything queued (one gather write per maxChunks chunks) and read pending acks
+    void flush();
+
+    // Flush, then wait until every QoS 1 packet is acknowledged; false on timeout
+    bool waitForAcks(std::chrono::milliseconds timeout);
+
+    // Queue every unacknowledged QoS 1 packet again with the DUP flag, e.g. after a reconnect
+    void resendInflight();
+
+    // Flush and send DISCONNECT
+    void disconnect();
+
+    std::size_t inflight() const { return inflightCount_; }
+
+    struct Stats
+    {
+        std::uint64_t published = 0;  // packets queued
+        std::uint64_t bytes = 0;      // bytes written to the socket
+        std::uint64_t writeCalls = 0; // gather write syscalls that wrote something
+        std::uint64_t acked = 0;      // PUBACKs matched to an in-flight packet
+        std::chrono::nanoseconds ackLatencyTotal{0};
+        std::chrono::nanoseconds ackLatencyMax{0};
+
+        std::chrono::nanoseconds meanAckLatency() const
+        {
+            return acked ? ackLatencyTotal / static_cast<std::int64_t>(acked) : std::chrono::nanoseconds{0};
+        }
+    };
+
+    const Stats &stats() const { return stats_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Inflight
+    {
+        std::uint16_t id = 0; // 0: free
+        Clock::time_point sent;
+        std::vector<std::uint8_t> packet; // kept for resendInflight()
+    };
+
+    std::vector<std::uint8_t> &chunkFor(std::size_t bytes);
+    std::uint16_t allocateId();
+    void writeAll();
+    bool readAvailable();
+    void handleIncoming();
+    bool waitReadable(Clock::time_point deadline, bool wantWrite);
+
+    int fd_;
+    Options options_;
+
+    std::vector<std::vector<std::uint8_t>> chunks_; // reused send chunks
+    std::size_t used_ = 1;                          // chunks holding data (the first may be empty)
+    std::vector<iovec> iov_;
+
+    std::vector<Inflight> inflightTable_; // indexed by packet id % maxInflight
+    std::size_t inflightCount_ = 0;
+    std::uint16_t nextId_ = 1;
+
+    std::vector<std::uint8_t> rx_;
+    bool connected_ = false;
+    Stats stats_;
+};
+
+#endif // MQTT_PUBLISHER_H
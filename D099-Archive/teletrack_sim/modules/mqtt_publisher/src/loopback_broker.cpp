@@ -0,0 +1,205 @@
+#include "loopback_broker.h"
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+LoopbackBroker::LoopbackBroker(MessageCallback onMessage) : onMessage_(std::move(onMessage))
+{
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "broker: socketpair");
+    }
+    brokerFd_ = fds[0];
+    clientFd_ = fds[1];
+    thread_ = std::thread(&LoopbackBroker::run, this);
+}
+
+LoopbackBroker::~LoopbackBroker()
+{
+    stopping_.store(true, std::memory_order_release);
+    ::shutdown(brokerFd_, SHUT_RDWR);
+    thread_.join();
+    ::close(brokerFd_);
+    if (clientFd_ >= 0)
+    {
+        ::close(clientFd_);
+    }
+}
+
+int LoopbackBroker::takeClientFd()
+{
+    const int fd = clientFd_;
+    clientFd_ = -1;
+    return fd;
+}
+
+bool LoopbackBroker::waitForMessages(std::uint64_t count, std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return arrived_.wait_for(lock, timeout, [&]
+                             { return messages_.load(std::memory_order_acquire) >= count; });
+}
+
+void LoopbackBroker::run()
+{
+    std::vector<std::uint8_t> rx;
+    std::vector<std::uint8_t> replies;
+    std::uint8_t buffer[64 * 1024];
+
+    while (!stopping_.load(std::memory_order_acquire))
+    {
+        // Short timeout so setAcking(true) releases held acks promptly
+        pollfd entry{brokerFd_, POLLIN, 0};
+        const int ready = ::poll(&entry, 1, 10);
+        if (ready < 0 && errno != EINTR)
+        {
+            return;
+        }
+
+        if (ready > 0)
+        {
+            const ssize_t got = ::recv(brokerFd_, buffer, sizeof(buffer), 0);
+            if (got <= 0)
+            {
+                return; // client closed or shut down
+            }
+            bytes_.fetch_add(static_cast<std::uint64_t>(got), std::memory_order_relaxed);
+            rx.insert(rx.end(), buffer, buffer + got);
+        }
+
+        if (!handle(rx, replies))
+        {
+            return;
+        }
+
+        if (acking_.load(std::memory_order_acquire))
+        {
+            for (std::uint16_t id : heldAcks_)
+            {
+                mqtt::appendPuback(replies, id);
+            }
+            heldAcks_.clear();
+        }
+
+        // All replies of this round in one write
+        std::size_t sent = 0;
+        while (sent < replies.size())
+        {
+            const ssize_t n = ::send(brokerFd_, replies.data() + sent, replies.size() - sent, MSG_NOSIGNAL);
+            if (n < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return;
+            }
+            sent += static_cast<std::size_t>(n);
+        }
+        replies.clear();
+    }
+}
+
+// Consume complete packets from rx and queue replies; false on DISCONNECT or garbage
+bool LoopbackBroker::handle(std::vector<std::uint8_t> &rx, std::vector<std::uint8_t> &replies)
+{
+    std::size_t offset = 0;
+    std::uint64_t published = 0;
+    bool open = true;
+
+    while (open)
+    {
+        mqtt::FixedHeader header;
+        const mqtt::DecodeStatus status = mqtt::decodeFixedHeader(rx.data() + offset, rx.size() - offset, header);
+        if (status == mqtt::DecodeStatus::Malformed)
+        {
+            open = false;
+            break;
+        }
+        if (status == mqtt::DecodeStatus::NeedMore || rx.size() - offset < header.headerSize + header.remainingLength)
+        {
+            break;
+        }
+
+        const std::uint8_t *body = rx.data() + offset + header.headerSize;
+        switch (header.type)
+        {
+        case mqtt::CONNECT:
+            mqtt::appendConnack(replies, 0);
+            connected_.store(true, std::memory_order_release);
+            break;
+
+        case mqtt::PUBLISH:
+        {
+            // Topic length, topic and packet id must all fit in the packet, else drop the client
+            const auto qos = static_cast<mqtt::QoS>((header.flags >> 1) & 0x03);
+            const std::size_t idBytes = qos == mqtt::QoS::AtLeastOnce ? 2 : 0;
+            if (header.remainingLength < 2 + idBytes)
+            {
+                open = false;
+                break;
+            }
+            const std::size_t topicLength = static_cast<std::size_t>((body[0] << 8) | body[1]);
+            if (header.remainingLength < 2 + topicLength + idBytes)
+            {
+                open = false;
+                break;
+            }
+            std::size_t at = 2 + topicLength;
+            std::uint16_t id = 0;
+            if (qos == mqtt::QoS::AtLeastOnce)
+            {
+                id = static_cast<std::uint16_t>((body[at] << 8) | body[at + 1]);
+                at += 2;
+                if (acking_.load(std::memory_order_relaxed))
+                {
+                    mqtt::appendPuback(replies, id);
+                }
+                else
+                {
+                    heldAcks_.push_back(id);
+                }
+            }
+
+            if (onMessage_)
+            {
+                onMessage_(Message{std::string(reinterpret_cast<const char *>(body + 2), topicLength),
+                                   std::string(reinterpret_cast<const char *>(body + at), header.remainingLength - at),
+                                   qos, id, (header.flags & 0x08) != 0});
+            }
+            ++published;
+            break;
+        }
+
+        case mqtt::PINGREQ:
+            mqtt::appendPingresp(replies);
+            break;
+
+        case mqtt::DISCONNECT:
+            connected_.store(false, std::memory_order_release);
+            open = false;
+            break;
+
+        default:
+            break;
+        }
+        offset += header.headerSize + header.remainingLength;
+    }
+
+    rx.erase(rx.begin(), rx.begin() + static_cast<std::ptrdiff_t>(offset));
+
+    if (published)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            messages_.fetch_add(published, std::memory_order_release);
+        }
+        arrived_.notify_all();
+    }
+    return open;
+}
@@ -0,0 +1,155 @@
+#include "mqtt_packet.h"
+#include <stdexcept>
+
+namespace mqtt
+{
+    namespace
+    {
+        std::size_t remainingLengthSize(std::uint32_t length)
+        {
+            return length < 128 ? 1 : length < 16384 ? 2 : length < 2097152 ? 3 : 4;
+        }
+
+        void appendFixedHeader(std::vector<std::uint8_t> &out, std::uint8_t first, std::uint32_t remaining)
+        {
+            if (remaining > MAX_REMAINING_LENGTH)
+            {
+                throw std::length_error("mqtt: packet too large");
+            }
+            std::uint8_t header[5];
+            header[0] = first;
+            const std::size_t size = 1 + encodeRemainingLength(remaining, header + 1);
+            out.insert(out.end(), header, header + size);
+        }
+
+        void appendU16(std::vector<std::uint8_t> &out, std::uint16_t value)
+        {
+            out.push_back(static_cast<std::uint8_t>(value >> 8));
+            out.push_back(static_cast<std::uint8_t>(value & 0xFF));
+        }
+
+        // UTF-8 string with a 16 bit length prefix
+        void appendString(std::vector<std::uint8_t> &out, std::string_view text)
+        {
+            if (text.size() > 0xFFFF)
+            {
+                throw std::length_error("mqtt: string too long");
+            }
+            appendU16(out, static_cast<std::uint16_t>(text.size()));
+            out.insert(out.end(), text.begin(), text.end());
+        }
+    }
+
+    std::size_t encodeRemainingLength(std::uint32_t length, std::uint8_t *out)
+    {
+        std::size_t size = 0;
+        do
+        {
+            std::uint8_t byte = length % 128;
+            length /= 128;
+            if (length > 0)
+            {
+                byte |= 0x80;
+            }
+            out[size++] = byte;
+        } while (length > 0);
+        return size;
+    }
+
+    DecodeStatus decodeFixedHeader(const std::uint8_t *data, std::size_t size, FixedHeader &out)
+    {
+        if (size < 2)
+        {
+            return DecodeStatus::NeedMore;
+        }
+
+        std::uint32_t length = 0;
+        std::uint32_t multiplier = 1;
+        for (std::size_t i = 1; i <= 4; ++i)
+        {
+            if (i >= size)
+            {
+                return DecodeStatus::NeedMore;
+            }
+            length += (data[i] & 0x7F) * multiplier;
+            if ((data[i] & 0x80) == 0)
+            {
+                out.type = data[0] >> 4;
+                out.flags = data[0] & 0x0F;
+                out.remainingLength = length;
+                out.headerSize = i + 1;
+                return DecodeStatus::Ok;
+            }
+            multiplier *= 128;
+        }
+        return DecodeStatus::Malformed;
+    }
+
+    std::size_t publishSize(std::string_view topic, std::size_t payloadSize, QoS qos)
+    {
+        const std::size_t remaining = 2 + topic.size() + (qos == QoS::AtLeastOnce ? 2 : 0) + payloadSize;
+        return 1 + remainingLengthSize(static_cast<std::uint32_t>(remaining)) + remaining;
+    }
+
+    void appendConnect(std::vector<std::uint8_t> &out, std::string_view clientId, std::uint16_t keepAliveSeconds,
+                       bool cleanSession)
+    {
+        // Protocol name, level 4, flags, keep alive, client id
+        const std::uint32_t remaining = static_cast<std::uint32_t>(2 + 4 + 1 + 1 + 2 + 2 + clientId.size());
+        appendFixedHeader(out, CONNECT << 4, remaining);
+        appendString(out, "MQTT");
+        out.push_back(4);
+        out.push_back(cleanSession ? 0x02 : 0x00);
+        appendU16(out, keepAliveSeconds);
+        appendString(out, clientId);
+    }
+
+    void appendConnack(std::vector<std::uint8_t> &out, std::uint8_t returnCode)
+    {
+        appendFixedHeader(out, CONNACK << 4, 2);
+        out.push_back(0); // no session present
+        out.push_back(returnCode);
+    }
+
+    void appendPublish(std::vector<std::uint8_t> &out, std::string_view topic, const void *payload,
+                       std::size_t payloadSize, QoS qos, std::uint16_t packetId)
+    {
+        const bool acked = qos == QoS::AtLeastOnce;
+        const std::size_t remaining = 2 + topic.size() + (acked ? 2 : 0) + payloadSize;
+        if (remaining > MAX_REMAINING_LENGTH)
+        {
+            throw std::length_error("mqtt: packet too large");
+        }
+
+        appendFixedHeader(out, static_cast<std::uint8_t>((PUBLISH << 4) | (static_cast<std::uint8_t>(qos) << 1)),
+                          static_cast<std::uint32_t>(remaining));
+        appendString(out, topic);
+        if (acked)
+        {
+            appendU16(out, packetId);
+        }
+        const auto *bytes = static_cast<const std::uint8_t *>(payload);
+        out.insert(out.end(), bytes, bytes + payloadSize);
+    }
+
+    void appendPuback(std::vector<std::uint8_t> &out, std::uint16_t packetId)
+    {
+        appendFixedHeader(out, PUBACK << 4, 2);
+        appendU16(out, packetId);
+    }
+
+    void appendPingreq(std::vector<std::uint8_t> &out)
+    {
+        appendFixedHeader(out, PINGREQ << 4, 0);
+    }
+
+    void appendPingresp(std::vector<std::uint8_t> &out)
+    {
+        appendFixedHeader(out, PINGRESP << 4, 0);
+    }
+
+    void appendDisconnect(std::vector<std::uint8_t> &out)
+    {
+        appendFixedHeader(out, DISCONNECT << 4, 0);
+    }
+}
@@ -0,0 +1,348 @@
+#include "mqtt_publisher.h"
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr std::size_t MAX_IOV = 1024; // IOV_MAX on Linux
+    constexpr std::size_t READ_BYTES = 16 * 1024;
+
+    [[noreturn]] void throwErrno(const char *what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+}
+
+MqttPublisher::MqttPublisher(int fd, Options options)
+    : fd_(fd), options_(std::move(options))
+{
+    options_.maxChunks = std::clamp<std::size_t>(options_.maxChunks, 1, MAX_IOV);
+    options_.maxInflight = std::clamp<std::size_t>(options_.maxInflight, 1, 0xFFFF);
+
+    const int flags = ::fcntl(fd_, F_GETFL, 0);
+    if (flags < 0 || ::fcntl(fd_, F_SETFL, flags | O_NONBLOCK) < 0)
+    {
+        throwErrno("mqtt: fcntl");
+    }
+
+    chunks_.resize(1);
+    chunks_[0].reserve(options_.chunkBytes);
+    inflightTable_.resize(options_.maxInflight);
+}
+
+MqttPublisher::~MqttPublisher()
+{
+    ::close(fd_);
+}
+
+void MqttPublisher::connect(std::chrono::milliseconds timeout)
+{
+    mqtt::appendConnect(chunkFor(64 + options_.clientId.size()), options_.clientId, options_.keepAliveSeconds);
+    writeAll();
+
+    const Clock::time_point deadline = Clock::now() + timeout;
+    while (!connected_)
+    {
+        if (!waitReadable(deadline, false))
+        {
+            throw std::runtime_error("mqtt: no CONNACK");
+        }
+        readAvailable();
+        handleIncoming();
+    }
+}
+
+std::uint16_t MqttPublisher::publish(std::string_view topic, const void *payload, std::size_t size, mqtt::QoS qos)
+{
+    const std::uint16_t id = qos == mqtt::QoS::AtLeastOnce ? allocateId() : 0;
+
+    std::vector<std::uint8_t> &chunk = chunkFor(mqtt::publishSize(topic, size, qos));
+    const std::size_t at = chunk.size();
+    mqtt::appendPublish(chunk, topic, payload, size, qos, id);
+    ++stats_.published;
+
+    if (id != 0)
+    {
+        Inflight &slot = inflightTable_[id % options_.maxInflight];
+        slot.id = id;
+        slot.sent = Clock::now();
+        slot.packet.assign(chunk.begin() + static_cast<std::ptrdiff_t>(at), chunk.end());
+        ++inflightCount_;
+    }
+    return id;
+}
+
+void MqttPublisher::flush()
+{
+    writeAll();
+    if (readAvailable())
+    {
+        handleIncoming();
+    }
+}
+
+bool MqttPublisher::waitForAcks(std::chrono::milliseconds timeout)
+{
+    writeAll();
+
+    const Clock::time_point deadline = Clock::now() + timeout;
+    while (inflightCount_ > 0)
+    {
+        if (!waitReadable(deadline, false))
+        {
+            return false;
+        }
+        readAvailable();
+        handleIncoming();
+    }
+    return true;
+}
+
+void MqttPublisher::resendInflight()
+{
+    // The slot after the newest id holds the oldest one still in flight
+    const std::size_t slots = inflightTable_.size();
+    for (std::size_t k = 0; k < slots; ++k)
+    {
+        Inflight &slot = inflightTable_[(nextId_ + k) % slots];
+        if (slot.id == 0)
+        {
+            continue;
+        }
+        slot.packet[0] |= mqtt::PUBLISH_DUP;
+        slot.sent = Clock::now();
+        std::vector<std::uint8_t> &chunk = chunkFor(slot.packet.size());
+        chunk.insert(chunk.end(), slot.packet.begin(), slot.packet.end());
+    }
+}
+
+void MqttPublisher::disconnect()
+{
+    mqtt::appendDisconnect(chunkFor(2));
+    writeAll();
+    connected_ = false;
+}
+
+// Chunk with room for bytes more, flushing when every chunk is in use
+std::vector<std::uint8_t> &MqttPublisher::chunkFor(std::size_t bytes)
+{
+    std::vector<std::uint8_t> *chunk = &chunks_[used_ - 1];
+    if (!chunk->empty() && chunk->size() + bytes > options_.chunkBytes)
+    {
+        if (used_ == options_.maxChunks)
+        {
+            writeAll();
+            return chunks_[0];
+        }
+
+        ++used_;
+        if (chunks_.size() < used_)
+        {
+            chunks_.emplace_back();
+            chunks_.back().reserve(options_.chunkBytes);
+        }
+        chunk = &chunks_[used_ - 1];
+    }
+    return *chunk;
+}
+
+// Next free packet id; waits for acks while its in-flight slot is taken
+std::uint16_t MqttPublisher::allocateId()
+{
+    const std::uint16_t id = nextId_;
+    Inflight &slot = inflightTable_[id % options_.maxInflight];
+
+    if (slot.id != 0)
+    {
+        writeAll();
+        const Clock::time_point deadline = Clock::now() + std::chrono::seconds(std::max<int>(options_.keepAliveSeconds, 1));
+        while (slot.id != 0)
+        {
+            if (!waitReadable(deadline, false))
+            {
+                throw std::runtime_error("mqtt: in-flight window full, no PUBACK");
+            }
+            readAvailable();
+            handleIncoming();
+        }
+    }
+
+    nextId_ = id == 0xFFFF ? 1 : static_cast<std::uint16_t>(id + 1);
+    return id;
+}
+
+// Send every queued chunk with as few gather writes as the socket allows
+void MqttPublisher::writeAll()
+{
+    iov_.clear();
+    for (std::size_t i = 0; i < used_; ++i)
+    {
+        if (!chunks_[i].empty())
+        {
+            iov_.push_back(iovec{chunks_[i].data(), chunks_[i].size()});
+        }
+    }
+
+    std::size_t first = 0;
+    while (first < iov_.size())
+    {
+        // Gather write of every chunk; sendmsg() is writev() plus MSG_NOSIGNAL,
+        // so a dropped broker connection throws instead of raising SIGPIPE
+        msghdr message{};
+        message.msg_iov = iov_.data() + first;
+        message.msg_iovlen = iov_.size() - first;
+        const ssize_t written = ::sendmsg(fd_, &message, MSG_NOSIGNAL);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                throwErrno("mqtt: sendmsg");
+            }
+            // Socket full: keep draining acks so the peer can make progress
+            waitReadable(Clock::time_point::max(), true);
+            if (readAvailable())
+            {
+                handleIncoming();
+            }
+            continue;
+        }
+
+        ++stats_.writeCalls;
+        stats_.bytes += static_cast<std::uint64_t>(written);
+
+        // Skip what went out, trimming a partially written iovec
+        auto left = static_cast<std::size_t>(written);
+        while (first < iov_.size() && left >= iov_[first].iov_len)
+        {
+            left -= iov_[first].iov_len;
+            ++first;
+        }
+        if (left > 0)
+        {
+            iov_[first].iov_base = static_cast<std::uint8_t *>(iov_[first].iov_base) + left;
+            iov_[first].iov_len -= left;
+        }
+    }
+
+    for (std::size_t i = 0; i < used_; ++i)
+    {
+        chunks_[i].clear();
+    }
+    used_ = 1;
+}
+
+// Append whatever the socket has to rx_, true if anything arrived
+bool MqttPublisher::readAvailable()
+{
+    std::uint8_t buffer[READ_BYTES];
+    bool any = false;
+    for (;;)
+    {
+        const ssize_t got = ::recv(fd_, buffer, sizeof(buffer), MSG_DONTWAIT);
+        if (got > 0)
+        {
+            rx_.insert(rx_.end(), buffer, buffer + got);
+            any = true;
+            continue;
+        }
+        if (got == 0)
+        {
+            throw std::runtime_error("mqtt: connection closed by broker");
+        }
+        if (errno == EINTR)
+        {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            return any;
+        }
+        throwErrno("mqtt: recv");
+    }
+}
+
+// Consume every complete packet in rx_
+void MqttPublisher::handleIncoming()
+{
+    std::size_t offset = 0;
+    for (;;)
+    {
+        mqtt::FixedHeader header;
+        const mqtt::DecodeStatus status = mqtt::decodeFixedHeader(rx_.data() + offset, rx_.size() - offset, header);
+        if (status == mqtt::DecodeStatus::Malformed)
+        {
+            throw std::runtime_error("mqtt: malformed packet from broker");
+        }
+        if (status == mqtt::DecodeStatus::NeedMore || rx_.size() - offset < header.headerSize + header.remainingLength)
+        {
+            break;
+        }
+
+        const std::uint8_t *body = rx_.data() + offset + header.headerSize;
+        if (header.type == mqtt::CONNACK && header.remainingLength >= 2)
+        {
+            if (body[1] != 0)
+            {
+                throw std::runtime_error("mqtt: connection refused, code " + std::to_string(body[1]));
+            }
+            connected_ = true;
+        }
+        else if (header.type == mqtt::PUBACK && header.remainingLength >= 2)
+        {
+            const auto id = static_cast<std::uint16_t>((body[0] << 8) | body[1]);
+            Inflight &slot = inflightTable_[id % options_.maxInflight];
+            if (slot.id == id)
+            {
+                const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - slot.sent);
+                stats_.ackLatencyTotal += latency;
+                stats_.ackLatencyMax = std::max(stats_.ackLatencyMax, latency);
+                ++stats_.acked;
+                slot.id = 0;
+                --inflightCount_;
+            }
+        }
+        offset += header.headerSize + header.remainingLength;
+    }
+
+    rx_.erase(rx_.begin(), rx_.begin() + static_cast<std::ptrdiff_t>(offset));
+}
+
+// poll() until the socket is readable (or writable when wantWrite), false at the deadline
+bool MqttPublisher::waitReadable(Clock::time_point deadline, bool wantWrite)
+{
+    for (;;)
+    {
+        int timeoutMs = -1;
+        if (deadline != Clock::time_point::max())
+        {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count();
+            if (left <= 0)
+            {
+                return false;
+            }
+            timeoutMs = static_cast<int>(std::min<long long>(left, 1000 * 60));
+        }
+
+        pollfd entry{fd_, static_cast<short>(POLLIN | (wantWrite ? POLLOUT : 0)), 0};
+        const int ready = ::poll(&entry, 1, timeoutMs);
+        if (ready > 0)
+        {
+            return true;
+        }
+        if (ready < 0 && errno != EINTR)
+        {
+            throwErrno("mqtt: poll");
+        }
+    }
+}
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+#include "loopback_broker.h"
+#include "mqtt_packet.h"
+#include "mqtt_publisher.h"
+#include <mutex>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+TEST(MqttPacketTest, RemainingLengthBoundaries)
+{
+    const std::uint32_t lengths[] = {0, 127, 128, 16383, 16384, 2097151, 2097152, mqtt::MAX_REMAINING_LENGTH};
+    const std::size_t sizes[] = {1, 1, 2, 2, 3, 3, 4, 4};
+
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        std::uint8_t bytes[5] = {0x30};
+        const std::size_t size = mqtt::encodeRemainingLength(lengths[i], bytes + 1);
+        ASSERT_EQ(size, sizes[i]);
+
+        mqtt::FixedHeader header;
+        ASSERT_EQ(mqtt::decodeFixedHeader(bytes, size + 1, header), mqtt::DecodeStatus::Ok);
+        EXPECT_EQ(header.remainingLength, lengths[i]);
+        EXPECT_EQ(header.headerSize, size + 1);
+
+        EXPECT_EQ(mqtt::decodeFixedHeader(bytes, size, header), mqtt::DecodeStatus::NeedMore);
+    }
+
+    const std::uint8_t tooLong[] = {0x30, 0xFF, 0xFF, 0xFF, 0xFF, 0x01};
+    mqtt::FixedHeader header;
+    EXPECT_EQ(mqtt::decodeFixedHeader(tooLong, sizeof(tooLong), header), mqtt::DecodeStatus::Malformed);
+}
+
+TEST(MqttPacketTest, PublishLayout)
+{
+    std::vector<std::uint8_t> out;
+    mqtt::appendPublish(out, "a/b", "hi", 2, mqtt::QoS::AtLeastOnce, 0x1234);
+
+    const std::vector<std::uint8_t> expected = {0x32, 9, 0, 3, 'a', '/', 'b', 0x12, 0x34, 'h', 'i'};
+    EXPECT_EQ(out, expected);
+    EXPECT_EQ(mqtt::publishSize("a/b", 2, mqtt::QoS::AtLeastOnce), expected.size());
+
+    out.clear();
+    mqtt::appendPublish(out, "t", "x", 1, mqtt::QoS::AtMostOnce, 99);
+    const std::vector<std::uint8_t> qos0 = {0x30, 4, 0, 1, 't', 'x'};
+    EXPECT_EQ(out, qos0);
+}
+
+TEST(MqttPacketTest, AppendingPacketsGrowsGeometrically)
+{
+    std::vector<std::uint8_t> out;
+    std::size_t reallocations = 0;
+    for (int i = 0; i < 10000; ++i)
+    {
+        const std::size_t capacity = out.capacity();
+        mqtt::appendPublish(out, "fleet/7/gnss", "{\"lat\":48.1}", 13, mqtt::QoS::AtMostOnce, 0);
+        reallocations += out.capacity() != capacity;
+    }
+    EXPECT_LT(reallocations, 40u);
+}
+
+TEST(MqttPacketTest, ConnectLayout)
+{
+    std::vector<std::uint8_t> out;
+    mqtt::appendConnect(out, "id", 30);
+    const std::vector<std::uint8_t> expected = {0x10, 14, 0, 4, 'M', 'Q', 'T', 'T', 4, 0x02, 0, 30, 0, 2, 'i', 'd'};
+    EXPECT_EQ(out, expected);
+}
+
+TEST(LoopbackBrokerTest, PublishTooShortForItsTopicLengthDropsTheClient)
+{
+    const std::vector<std::vector<std::uint8_t>> malformed = {
+        {0x30, 1, 0x00},                 // no room for the topic length
+        {0x32, 4, 0x00, 0x09, 'a', 'b'}, // topic length past the end
+        {0x32, 3, 0x00, 0x01, 't'}};     // no room for the packet id
+
+    for (const std::vector<std::uint8_t> &packet : malformed)
+    {
+        LoopbackBroker broker;
+        const int fd = broker.takeClientFd();
+
+        std::vector<std::uint8_t> out;
+        mqtt::appendConnect(out, "id", 30);
+        out.insert(out.end(), packet.begin(), packet.end());
+        mqtt::appendPublish(out, "t", "x", 1, mqtt::QoS::AtMostOnce, 0);
+        ASSERT_EQ(::send(fd, out.data(), out.size(), MSG_NOSIGNAL), static_cast<ssize_t>(out.size()));
+
+        EXPECT_FALSE(broker.waitForMessages(1, 100ms));
+        EXPECT_EQ(broker.messages(), 0u);
+        ::close(fd);
+    }
+}
+
+TEST(MqttPublisherTest, DeliversQos0InOrderWithFewWrites)
+{
+    std::mutex mutex;
+    std::vector<std::string> payloads;
+    LoopbackBroker broker([&](const LoopbackBroker::Message &message)
+                          {
+                              std::lock_guard<std::mutex> lock(mutex);
+                              EXPECT_EQ(message.topic, "fleet/7/gnss");
+                              EXPECT_EQ(message.qos, mqtt::QoS::AtMostOnce);
+                              payloads.push_back(message.payload); });
+
+    MqttPublisher publisher(broker.takeClientFd());
+    publisher.connect();
+    EXPECT_TRUE(broker.connected());
+
+    const int count = 20000;
+    for (int i = 0; i < count; ++i)
+    {
+        const std::string payload = "{\"seq\":" + std::to_string(i) + "}";
+        EXPECT_EQ(publisher.publish("fleet/7/gnss", payload), 0);
+    }
+    publisher.flush();
+
+    ASSERT_TRUE(broker.waitForMessages(count, 5s));
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(payloads.size(), static_cast<std::size_t>(count));
+    for (int i = 0; i < count; ++i)
+    {
+        ASSERT_EQ(payloads[i], "{\"seq\":" + std::to_string(i) + "}");
+    }
+
+    // Coalesced: far fewer syscalls than packets
+    EXPECT_EQ(publisher.stats().published, static_cast<std::uint64_t>(count));
+    EXPECT_LT(publisher.stats().writeCalls, static_cast<std::uint64_t>(count / 100));
+    EXPECT_EQ(publisher.stats().bytes, broker.bytes());
+}
+
+TEST(MqttPublisherTest, Qos1TracksInflightUntilAcked)
+{
+    LoopbackBroker broker;
+    MqttPublisher publisher(broker.takeClientFd());
+    publisher.connect();
+
+    broker.setAcking(false);
+    const std::uint16_t first = publisher.publish("fleet/1/engine", "a", mqtt::QoS::AtLeastOnce);
+    const std::uint16_t second = publisher.publish("fleet/1/engine", "b", mqtt::QoS::AtLeastOnce);
+    EXPECT_EQ(first, 1);
+    EXPECT_EQ(second, 2);
+    EXPECT_EQ(publisher.inflight(), 2u);
+
+    EXPECT_FALSE(publisher.waitForAcks(50ms));
+    EXPECT_EQ(publisher.inflight(), 2u);
+
+    broker.setAcking(true);
+    EXPECT_TRUE(publisher.waitForAcks(5s));
+    EXPECT_EQ(publisher.inflight(), 0u);
+    EXPECT_EQ(publisher.stats().acked, 2u);
+    EXPECT_GT(publisher.stats().meanAckLatency().count(), 0);
+}
+
+TEST(MqttPublisherTest, FullInflightWindowWaitsForAcks)
+{
+    LoopbackBroker broker;
+    MqttPublisher::Options options;
+    options.maxInflight = 8;
+    MqttPublisher publisher(broker.takeClientFd(), options);
+    publisher.connect();
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        publisher.publish("fleet/2/engine", "sample", mqtt::QoS::AtLeastOnce);
+        ASSERT_LE(publisher.inflight(), 8u);
+    }
+    EXPECT_TRUE(publisher.waitForAcks(5s));
+    EXPECT_EQ(publisher.stats().acked, 1000u);
+    EXPECT_EQ(broker.messages(), 1000u);
+}
+
+TEST(MqttPublisherTest, ResendMarksDuplicates)
+{
+    std::mutex mutex;
+    std::vector<LoopbackBroker::Message> messages;
+    LoopbackBroker broker([&](const LoopbackBroker::Message &message)
+                          {
+                              std::lock_guard<std::mutex> lock(mutex);
+                              messages.push_back(message); });
+
+    MqttPublisher publisher(broker.takeClientFd());
+    publisher.connect();
+
+    broker.setAcking(false);
+    publisher.publish("t", "one", mqtt::QoS::AtLeastOnce);
+    publisher.publish("t", "two", mqtt::QoS::AtLeastOnce);
+    publisher.flush();
+    ASSERT_TRUE(broker.waitForMessages(2, 5s));
+
+    publisher.resendInflight();
+    broker.setAcking(true);
+    ASSERT_TRUE(publisher.waitForAcks(5s));
+    ASSERT_TRUE(broker.waitForMessages(4, 5s));
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(messages.size(), 4u);
+    EXPECT_FALSE(messages[0].dup);
+    EXPECT_TRUE(messages[2].dup);
+    EXPECT_TRUE(messages[3].dup);
+    EXPECT_EQ(messages[2].payload, "one");
+    EXPECT_EQ(messages[3].payload, "two");
+    EXPECT_EQ(messages[2].packetId, messages[0].packetId);
+}
+
+TEST(MqttPublisherTest, OversizedPayloadGetsItsOwnChunk)
+{
+    std::mutex mutex;
+    std::string received;
+    LoopbackBroker broker([&](const LoopbackBroker::Message &message)
+                          {
+                              std::lock_guard<std::mutex> lock(mutex);
+                              received = message.payload; });
+
+    MqttPublisher::Options options;
+    options.chunkBytes = 256;
+    MqttPublisher publisher(broker.takeClientFd(), options);
+    publisher.connect();
+
+    const std::string big(100000, 'x');
+    publisher.publish("t", "small");
+    publisher.publish("t", big);
+    publisher.flush();
+
+    ASSERT_TRUE(broker.waitForMessages(2, 5s));
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(received, big);
+}
@@ -0,0 +1,122 @@
+#ifndef TICK_SCHEDULER_H
+#define TICK_SCHEDULER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Runs the simulation as a sequence of ticks, each a DAG of stages.
+ *
+ * A stage declares the named resources it reads and writes. At addStage()
+ * it is made to depend on every earlier stage it conflicts with (write/read,
+ * read/write or write/write on a shared resource), so registration order
+ * decides who goes first and stages that share nothing run in parallel.
+ * A stage may also be split into a fixed number of partitions that run
+ * concurrently, each on its own slice of the data.
+ *
+ * Results do not depend on the thread count: the partition count is part of
+ * the stage, conflicting stages always run in registration order, and every
+ * partition gets a seed derived only from the scheduler seed, stage, tick
+ * and partition. runTick() returns once every stage of the tick finished
+ * (the barrier); the calling thread works alongside the pool.
+ */
+class TickScheduler
+{
+public:
+    struct TickContext
+    {
+        std::uint64_t tick;
+        std::size_t partition;
+        std::size_t partitions;
+        std::uint64_t seed;
+
+        // This partition's slice [first, second) of items
+        std::pair<std::size_t, std::size_t> range(std::size_t items) const
+        {
+            return {items * partition / partitions, items * (partition + 1) / partitions};
+        }
+    };
+
+    using StageFn = std::function<void(const TickContext &)>;
+
+    struct Stage
+    {
+        std::string name;
+        std::vector<std::string> reads;
+        std::vector<std::string> writes;
+        StageFn run;
+        std::size_t partitions = 1; // fixed, never derived from the thread count
+    };
+
+    // threads counts the caller of runTick(), so 1 runs everything inline
+    TickScheduler(unsigned threads, std::uint64_t seed);
+    ~TickScheduler();
+
+    TickScheduler(const TickScheduler &) = delete;
+    TickScheduler &operator=(const TickScheduler &) = delete;
+
+    // Returns the stage index; not allowed while a tick is running
+    std::size_t addStage(Stage stage);
+
+    // Run every stage once. A stage that throws does not stop the others;
+    // the first exception is rethrown after the barrier.
+    void runTick();
+    void run(std::uint64_t ticks);
+
+    std::uint64_t tick() const { return tick_; } // ticks completed
+    unsigned threadCount() const { return static_cast<unsigned>(workers_.size()) + 1; }
+    std::size_t stageCount() const { return stages_.size(); }
+    const std::string &stageName(std::size_t stage) const { return stages_[stage].spec.name; }
+
+    // Earlier stages that must finish before this one starts
+    const std::vector<std::size_t> &dependencies(std::size_t stage) const { return stages_[stage].dependsOn; }
+
+    // Seed handed to one partition of one stage in one tick
+    static std::uint64_t partitionSeed(std::uint64_t seed, std::size_t stage, std::uint64_t tick, std::size_t partition);
+
+private:
+    struct Task
+    {
+        std::size_t stage;
+        std::size_t partition;
+    };
+
+    struct StageState
+    {
+        Stage spec;
+        std::vector<std::size_t> dependsOn;
+        std::vector<std::size_t> dependents;
+        std::size_t waitingFor = 0;   // dependencies not finished this tick
+        std::size_t partitionsLeft = 0;
+    };
+
+    void workerLoop();
+    void execute(const Task &task);
+    void complete(const Task &task); // mutex_ held
+    void release(std::size_t stage); // mutex_ held
+
+    const std::uint64_t seed_;
+    std::uint64_t tick_ = 0;
+    std::vector<StageState> stages_;
+
+    // Everything below is guarded by mutex_
+    std::mutex mutex_;
+    std::condition_variable wake_; // tasks queued, tick finished or stopping
+    std::deque<Task> ready_;
+    std::size_t stagesLeft_ = 0;
+    bool running_ = false;
+    bool stopping_ = false;
+    std::exception_ptr error_;
+
+    std::vector<std::thread> workers_;
+};
+
+#endif // TICK_SCHEDULER_H
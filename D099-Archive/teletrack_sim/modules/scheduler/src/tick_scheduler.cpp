@@ -0,0 +1,220 @@
+#include "tick_scheduler.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    std::uint64_t splitmix(std::uint64_t x)
+    {
+        x += 0x9e3779b97f4a7c15ull;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    bool shares(const std::vector<std::string> &a, const std::vector<std::string> &b)
+    {
+        for (const std::string &name : a)
+        {
+            if (std::find(b.begin(), b.end(), name) != b.end())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+TickScheduler::TickScheduler(unsigned threads, std::uint64_t seed) : seed_(seed)
+{
+    for (unsigned i = 1; i < std::max(threads, 1u); ++i)
+    {
+        workers_.emplace_back(&TickScheduler::workerLoop, this);
+    }
+}
+
+TickScheduler::~TickScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread &worker : workers_)
+    {
+        worker.join();
+    }
+}
+
+std::size_t TickScheduler::addStage(Stage stage)
+{
+    if (!stage.run || stage.partitions == 0)
+    {
+        throw std::invalid_argument("TickScheduler: stage '" + stage.name + "' needs a function and a partition");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_)
+    {
+        throw std::logic_error("TickScheduler: cannot add stages during a tick");
+    }
+
+    const std::size_t index = stages_.size();
+    StageState state;
+    for (std::size_t earlier = 0; earlier < index; ++earlier)
+    {
+        const Stage &other = stages_[earlier].spec;
+        if (shares(other.writes, stage.reads) || shares(other.reads, stage.writes) || shares(other.writes, stage.writes))
+        {
+            state.dependsOn.push_back(earlier);
+            stages_[earlier].dependents.push_back(index);
+        }
+    }
+    state.spec = std::move(stage);
+    stages_.push_back(std::move(state));
+    return index;
+}
+
+std::uint64_t TickScheduler::partitionSeed(std::uint64_t seed, std::size_t stage, std::uint64_t tick,
+                                           std::size_t partition)
+{
+    std::uint64_t x = splitmix(seed);
+    x = splitmix(x ^ stage);
+    x = splitmix(x ^ tick);
+    return splitmix(x ^ partition);
+}
+
+void TickScheduler::runTick()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stages_.empty())
+    {
+        ++tick_;
+        return;
+    }
+
+    running_ = true;
+    stagesLeft_ = stages_.size();
+    for (std::size_t s = 0; s < stages_.size(); ++s)
+    {
+        stages_[s].waitingFor = stages_[s].dependsOn.size();
+        stages_[s].partitionsLeft = stages_[s].spec.partitions;
+    }
+    for (std::size_t s = 0; s < stages_.size(); ++s)
+    {
+        if (stages_[s].waitingFor == 0)
+        {
+            release(s);
+        }
+    }
+    wake_.notify_all();
+
+    // Work until the whole tick is done
+    while (stagesLeft_ > 0)
+    {
+        if (ready_.empty())
+        {
+            wake_.wait(lock);
+            continue;
+        }
+        const Task task = ready_.front();
+        ready_.pop_front();
+        lock.unlock();
+        execute(task);
+        lock.lock();
+        complete(task);
+    }
+
+    running_ = false;
+    ++tick_;
+
+    if (error_)
+    {
+        std::exception_ptr error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void TickScheduler::run(std::uint64_t ticks)
+{
+    for (std::uint64_t i = 0; i < ticks; ++i)
+    {
+        runTick();
+    }
+}
+
+void TickScheduler::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        wake_.wait(lock, [this]
+                   { return stopping_ || !ready_.empty(); });
+        if (stopping_)
+        {
+            return;
+        }
+
+        const Task task = ready_.front();
+        ready_.pop_front();
+        lock.unlock();
+        execute(task);
+        lock.lock();
+        complete(task);
+    }
+}
+
+// Runs without the lock; the stage only touches its declared resources
+void TickScheduler::execute(const Task &task)
+{
+    const StageState &stage = stages_[task.stage];
+    const TickContext context{tick_, task.partition, stage.spec.partitions,
+                              partitionSeed(seed_, task.stage, tick_, task.partition)};
+    try
+    {
+        stage.spec.run(context);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (!error_)
+        {
+            error_ = std::current_exception();
+        }
+    }
+}
+
+// A partition finished: release dependents once the whole stage is done
+void TickScheduler::complete(const Task &task)
+{
+    StageState &stage = stages_[task.stage];
+    if (--stage.partitionsLeft > 0)
+    {
+        return;
+    }
+
+    bool released = false;
+    for (std::size_t dependent : stage.dependents)
+    {
+        if (--stages_[dependent].waitingFor == 0)
+        {
+            release(dependent);
+            released = true;
+        }
+    }
+
+    if (--stagesLeft_ == 0 || released)
+    {
+        wake_.notify_all();
+    }
+}
+
+// Queue every partition of a stage whose dependencies are done
+void TickScheduler::release(std::size_t stage)
+{
+    for (std::size_t p = 0; p < stages_[stage].spec.partitions; ++p)
+    {
+        ready_.push_back(Task{stage, p});
+    }
+}
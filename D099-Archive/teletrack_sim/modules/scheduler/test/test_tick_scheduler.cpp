@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+#include "tick_scheduler.h"
+#include "aggregator.h"
+#include "engine_fleet.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // A fleet wired the way main.cpp wires it: independent GNSS and engine
+    // stages, then aggregation, then logging and publishing side by side
+    struct Simulation
+    {
+        static constexpr std::size_t VEHICLES = 2000;
+
+        std::vector<double> latitude;
+        std::vector<double> longitude;
+        EngineFleet engines;
+        Aggregator aggregator;
+        std::vector<WindowResult> windows; // this tick's closed windows
+        std::vector<std::string> log;
+        std::vector<std::string> outbox;
+        TickScheduler scheduler;
+
+        Simulation(unsigned threads, std::uint64_t seed)
+            : latitude(VEHICLES, 1.30), longitude(VEHICLES, 103.80), engines(VEHICLES, 7),
+              aggregator(WindowSpec::tumbling(1000), [this](const WindowResult &result)
+                         { windows.push_back(result); }),
+              scheduler(threads, seed)
+        {
+            scheduler.addStage({"gnss", {}, {"positions"}, [this](const TickScheduler::TickContext &context)
+                                {
+                                    std::mt19937_64 rng(context.seed);
+                                    std::uniform_real_distribution<double> step(-1e-4, 1e-4);
+                                    const auto [begin, end] = context.range(VEHICLES);
+                                    for (std::size_t i = begin; i < end; ++i)
+                                    {
+                                        latitude[i] += step(rng);
+                                        longitude[i] += step(rng);
+                                    }
+                                },
+                                8});
+
+            scheduler.addStage({"engine", {}, {"engine"}, [this](const TickScheduler::TickContext &context)
+                                {
+                                    const auto [begin, end] = context.range(VEHICLES);
+                                    engines.simulate(begin, end);
+                                },
+                                8});
+
+            scheduler.addStage({"aggregate", {"positions", "engine"}, {"windows"}, [this](const TickScheduler::TickContext &context)
+                                {
+                                    windows.clear();
+                                    const std::uint64_t t = context.tick * 100;
+                                    for (std::uint32_t v = 0; v < VEHICLES; ++v)
+                                    {
+                                        aggregator.addGnss(GnssSample{v, t, latitude[v], longitude[v]});
+                                        aggregator.addEngine(EngineSample{v, t, engines.rpm(v), engines.coolantTemp(v), engines.fuelRate(v)});
+                                    }
+                                }});
+
+            scheduler.addStage({"log", {"windows"}, {"log"}, [this](const TickScheduler::TickContext &)
+                                {
+                                    for (const WindowResult &w : windows)
+                                    {
+                                        char line[96];
+                                        std::snprintf(line, sizeof(line), "%u %llu %.6f", w.vehicle,
+                                                      static_cast<unsigned long long>(w.startMs), w.stats.distanceM);
+                                        log.emplace_back(line);
+                                    }
+                                }});
+
+            scheduler.addStage({"publish", {"windows"}, {"outbox"}, [this](const TickScheduler::TickContext &)
+                                {
+                                    for (const WindowResult &w : windows)
+                                    {
+                                        char payload[96];
+                                        std::snprintf(payload, sizeof(payload), "{\"v\":%u,\"rpm\":%.3f}", w.vehicle, w.stats.rpm.mean());
+                                        outbox.emplace_back(payload);
+                                    }
+                                }});
+        }
+    };
+}
+
+TEST(TickSchedulerTest, DerivesDependenciesFromDeclaredResources)
+{
+    Simulation simulation(1, 1);
+    const TickScheduler &scheduler = simulation.scheduler;
+
+    ASSERT_EQ(scheduler.stageCount(), 5u);
+    EXPECT_TRUE(scheduler.dependencies(0).empty());                           // gnss
+    EXPECT_TRUE(scheduler.dependencies(1).empty());                           // engine
+    EXPECT_EQ(scheduler.dependencies(2), (std::vector<std::size_t>{0, 1}));   // aggregate
+    EXPECT_EQ(scheduler.dependencies(3), (std::vector<std::size_t>{2}));      // log (read/write on windows)
+    EXPECT_EQ(scheduler.dependencies(4), (std::vector<std::size_t>{2}));      // publish, parallel to log
+}
+
+TEST(TickSchedulerTest, SameSeedGivesSameRunForAnyThreadCount)
+{
+    Simulation reference(1, 42);
+    reference.scheduler.run(50);
+    ASSERT_FALSE(reference.log.empty());
+    EXPECT_EQ(reference.log.size(), reference.outbox.size());
+
+    for (unsigned threads : {2u, 4u, 8u})
+    {
+        Simulation simulation(threads, 42);
+        simulation.scheduler.run(50);
+        EXPECT_EQ(simulation.scheduler.tick(), 50u);
+        EXPECT_EQ(simulation.log, reference.log) << threads << " threads";
+        EXPECT_EQ(simulation.outbox, reference.outbox) << threads << " threads";
+        EXPECT_EQ(simulation.latitude, reference.latitude) << threads << " threads";
+    }
+
+    Simulation other(4, 43);
+    other.scheduler.run(50);
+    EXPECT_NE(other.log, reference.log);
+}
+
+TEST(TickSchedulerTest, WritersOfTheSameResourceRunInRegistrationOrder)
+{
+    for (unsigned threads : {1u, 4u})
+    {
+        TickScheduler scheduler(threads, 0);
+        std::string trace;
+        for (char name : std::string("abcdef"))
+        {
+            scheduler.addStage({std::string(1, name), {}, {"trace"}, [&trace, name](const TickScheduler::TickContext &)
+                                { trace += name; }});
+        }
+        scheduler.run(3);
+        EXPECT_EQ(trace, "abcdefabcdefabcdef");
+    }
+}
+
+TEST(TickSchedulerTest, IndependentStagesRunConcurrently)
+{
+    TickScheduler scheduler(2, 0);
+    std::atomic<int> arrived{0};
+    std::atomic<bool> metEachOther{true};
+
+    // Each stage waits (bounded) for the other to start
+    const auto rendezvous = [&](const TickScheduler::TickContext &)
+    {
+        arrived.fetch_add(1);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (arrived.load() < 2)
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                metEachOther = false;
+                return;
+            }
+            std::this_thread::yield();
+        }
+    };
+    scheduler.addStage({"left", {}, {"a"}, rendezvous});
+    scheduler.addStage({"right", {}, {"b"}, rendezvous});
+
+    scheduler.runTick();
+    EXPECT_TRUE(metEachOther);
+}
+
+TEST(TickSchedulerTest, PartitionsCoverTheRangeWithFixedSeeds)
+{
+    TickScheduler scheduler(3, 9);
+    std::vector<int> hits(1000, 0);
+    std::vector<std::uint64_t> seeds(5, 0);
+
+    scheduler.addStage({"fill", {}, {"hits"}, [&](const TickScheduler::TickContext &context)
+                        {
+                            const auto [begin, end] = context.range(hits.size());
+                            for (std::size_t i = begin; i < end; ++i)
+                            {
+                                ++hits[i];
+                            }
+                            seeds[context.partition] = context.seed;
+                        },
+                        5});
+    scheduler.runTick();
+
+    for (int hit : hits)
+    {
+        EXPECT_EQ(hit, 1);
+    }
+    for (std::size_t p = 0; p < seeds.size(); ++p)
+    {
+        EXPECT_EQ(seeds[p], TickScheduler::partitionSeed(9, 0, 0, p));
+    }
+    EXPECT_NE(seeds[0], seeds[1]);
+}
+
+TEST(TickSchedulerTest, StageFailureIsRethrownAfterTheBarrier)
+{
+    TickScheduler scheduler(2, 0);
+    int ranAfter = 0;
+    bool fail = true;
+
+    scheduler.addStage({"flaky", {}, {"x"}, [&](const TickScheduler::TickContext &)
+                        {
+                            if (fail)
+                            {
+                                throw std::runtime_error("sensor offline");
+                            }
+                        }});
+    scheduler.addStage({"next", {"x"}, {}, [&](const TickScheduler::TickContext &)
+                        { ++ranAfter; }});
+
+    EXPECT_THROW(scheduler.runTick(), std::runtime_error);
+    EXPECT_EQ(ranAfter, 1);
+    EXPECT_EQ(scheduler.tick(), 1u);
+
+    fail = false;
+    EXPECT_NO_THROW(scheduler.runTick());
+    EXPECT_EQ(ranAfter, 2);
+}
+
+TEST(TickSchedulerTest, RejectsStagesWithoutWork)
+{
+    TickScheduler scheduler(1, 0);
+    EXPECT_THROW(scheduler.addStage({"empty", {}, {}, nullptr}), std::invalid_argument);
+    EXPECT_THROW(scheduler.addStage({"none", {}, {}, [](const TickScheduler::TickContext &) {}, 0}), std::invalid_argument);
+}
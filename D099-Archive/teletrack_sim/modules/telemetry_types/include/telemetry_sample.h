@@ -0,0 +1,25 @@
+#ifndef TELEMETRY_SAMPLE_H
+#define TELEMETRY_SAMPLE_H
+
+#include <cstdint>
+
+// One GNSS fix of one vehicle
+struct GnssSample
+{
+    std::uint32_t vehicle;
+    std::uint64_t timestampMs;
+    double latitude;  // degrees
+    double longitude; // degrees
+};
+
+// One engine reading of one vehicle
+struct EngineSample
+{
+    std::uint32_t vehicle;
+    std::uint64_t timestampMs;
+    float rpm;
+    float coolantTemp; // deg C
+    float fuelRate;    // litres per hour
+};
+
+#endif // TELEMETRY_SAMPLE_H
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "calculator.h"
+
+// D003 and D004 share calculator.cpp; only the call site differs
+
+namespace
+{
+    constexpr std::size_t OPERANDS = 1024;
+
+    std::vector<int> operands()
+    {
+        std::vector<int> values(OPERANDS);
+        for (std::size_t i = 0; i < OPERANDS; ++i)
+        {
+            values[i] = static_cast<int>(i % 97) + 1;
+        }
+        return values;
+    }
+}
+
+// Baseline: the compiler sees the callee
+static void BM_DirectCall(benchmark::State &state)
+{
+    const std::vector<int> values = operands();
+    for (auto _ : state)
+    {
+        int sum = 0;
+        for (int value : values)
+        {
+            sum += add(value, 5);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * OPERANDS));
+}
+
+// D003: execute(a, b, op) calls through the MathOp it is handed
+static void BM_ExecuteCallback(benchmark::State &state)
+{
+    const std::vector<int> values = operands();
+    MathOp op = add;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(op); // opaque: no devirtualising the pointer
+        int sum = 0;
+        for (int value : values)
+        {
+            sum += execute(value, 5, op);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * OPERANDS));
+}
+
+// D004: index a dispatch table, a different operation on every call
+static void BM_DispatchTable(benchmark::State &state)
+{
+    const std::vector<int> values = operands();
+    MathOp operations[] = {add, subtract, multiply, divide};
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(operations);
+        int sum = 0;
+        for (std::size_t i = 0; i < OPERANDS; ++i)
+        {
+            sum += operations[i & 3](values[i], 5);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * OPERANDS));
+}
+
+BENCHMARK(BM_DirectCall);
+BENCHMARK(BM_ExecuteCallback);
+BENCHMARK(BM_DispatchTable);
+
+BENCHMARK_MAIN();
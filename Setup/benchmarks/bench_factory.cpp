@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Car.h"
+#include "Ship.h"
+#include "TransportFactory.h"
+
+// Creation only: the vehicle is released straight away
+
+// Baseline: one heap allocation per vehicle
+static void BM_CreateNew(benchmark::State &state)
+{
+    for (auto _ : state)
+    {
+        std::unique_ptr<Transport> car(new Car());
+        benchmark::DoNotOptimize(car.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Typed entry point, straight to the Car pool
+static void BM_CreateCar(benchmark::State &state)
+{
+    TransportFactory factory;
+    for (auto _ : state)
+    {
+        TransportHandle car = factory.createCar();
+        benchmark::DoNotOptimize(car.get());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Kind picked at run time, alternating so the branch cannot be learned away
+static void BM_CreateByKind(benchmark::State &state)
+{
+    TransportFactory factory;
+    TransportKind kind = TransportKind::Car;
+    for (auto _ : state)
+    {
+        TransportHandle vehicle = factory.create(kind);
+        benchmark::DoNotOptimize(vehicle.get());
+        kind = kind == TransportKind::Car ? TransportKind::Ship : TransportKind::Car;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Many live handles at once: slab growth and free-list reuse
+static void BM_CreateBatch(benchmark::State &state)
+{
+    TransportFactory factory;
+    std::vector<TransportHandle> live;
+    live.reserve(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < state.range(0); ++i)
+        {
+            live.push_back(factory.create(i % 2 == 0 ? TransportKind::Car : TransportKind::Ship));
+        }
+        benchmark::DoNotOptimize(live.data());
+        live.clear();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_CreateNew);
+BENCHMARK(BM_CreateCar);
+BENCHMARK(BM_CreateByKind);
+BENCHMARK(BM_CreateBatch)->RangeMultiplier(10)->Range(100, 10000);
+
+BENCHMARK_MAIN();
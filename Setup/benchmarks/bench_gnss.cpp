@@ -0,0 +1,37 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "gnss.h"
+
+// One receiver, one fixed step per call
+static void BM_GnssSimulate(benchmark::State &state)
+{
+    gnss::GNSS gnss(1.3521, 103.8198);
+    for (auto _ : state)
+    {
+        gnss.simulate();
+        benchmark::DoNotOptimize(gnss);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+// The same call over a vector of receivers, as the simulator loop does it
+static void BM_GnssSimulateVector(benchmark::State &state)
+{
+    std::vector<gnss::GNSS> receivers(static_cast<std::size_t>(state.range(0)), gnss::GNSS(1.3521, 103.8198));
+    for (auto _ : state)
+    {
+        for (gnss::GNSS &gnss : receivers)
+        {
+            gnss.simulate();
+        }
+        benchmark::DoNotOptimize(receivers.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_GnssSimulate);
+BENCHMARK(BM_GnssSimulateVector)->RangeMultiplier(10)->Range(1000, 100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+#include <list>
+#include <string>
+#include <vector>
+#include "event_bus.h"
+#include "telemetry.h"
+#include "typed_event_bus.h"
+
+// Notify cost per observer count. Subject::Notify prints on every call, so
+// the list walk it does is reproduced here without the printing.
+
+class StringSink : public IObserver
+{
+public:
+    void Update(const std::string &message_from_subject) override
+    {
+        benchmark::DoNotOptimize(message_from_subject.data());
+    }
+};
+
+class TypedSink : public ITypedObserver<GnssFix>
+{
+public:
+    void Update(const Payload<GnssFix> &sample) override
+    {
+        benchmark::DoNotOptimize(sample->latitude);
+    }
+};
+
+// Subject::Notify: walk a std::list<IObserver *>, virtual Update per node
+static void BM_SubjectNotify(benchmark::State &state)
+{
+    std::vector<StringSink> sinks(static_cast<std::size_t>(state.range(0)));
+    std::list<IObserver *> observers;
+    for (StringSink &sink : sinks)
+    {
+        observers.push_back(&sink);
+    }
+
+    const std::string message = "Hello world";
+    for (auto _ : state)
+    {
+        for (IObserver *observer : observers)
+        {
+            observer->Update(message);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// EventBus::Publish: lock-free snapshot of a contiguous subscriber array
+static void BM_EventBusNotify(benchmark::State &state)
+{
+    EventBus bus;
+    std::vector<StringSink> sinks(static_cast<std::size_t>(state.range(0)));
+    for (StringSink &sink : sinks)
+    {
+        bus.Attach(&sink);
+    }
+
+    const std::string message = "Hello world";
+    for (auto _ : state)
+    {
+        bus.Publish(message);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// TypedEventBus::Publish: one shared payload, no formatting
+static void BM_TypedBusNotify(benchmark::State &state)
+{
+    TypedEventBus<GnssFix> bus;
+    std::vector<TypedSink> sinks(static_cast<std::size_t>(state.range(0)));
+    for (TypedSink &sink : sinks)
+    {
+        bus.Attach(&sink);
+    }
+
+    const Payload<GnssFix> fix = MakePayload<GnssFix>(GnssFix{0, 1, 9, 1.3521, 103.8198});
+    for (auto _ : state)
+    {
+        bus.Publish(fix);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SubjectNotify)->Arg(1)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK(BM_EventBusNotify)->Arg(1)->Arg(8)->Arg(64)->Arg(512);
+BENCHMARK(BM_TypedBusNotify)->Arg(1)->Arg(8)->Arg(64)->Arg(512);
+
+BENCHMARK_MAIN();
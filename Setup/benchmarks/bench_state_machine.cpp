@@ -0,0 +1,72 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include "state_machine.h"
+#include "traffic_grid.h"
+
+// The traffic light actions print, so single-machine dispatch runs on a
+// table of the same shape whose actions only count
+
+namespace
+{
+    std::size_t actionsRun = 0;
+
+    void countAction() { ++actionsRun; }
+
+    using QuietTransition = fsm::Transition<StateID, Event, void (*)()>;
+
+    inline constexpr QuietTransition quietRed[] = {{EVT_TIMER_EXPIRE, STATE_GREEN, countAction}};
+    inline constexpr QuietTransition quietGreen[] = {{EVT_TIMER_EXPIRE, STATE_YELLOW, countAction}};
+    inline constexpr QuietTransition quietYellow[] = {{EVT_TIMER_EXPIRE, STATE_RED, countAction}};
+
+    using QuietTable = fsm::Table<StateID, Event, void (*)(), STATE_COUNT, EVT_COUNT>;
+
+    constexpr QuietTable buildQuietTable()
+    {
+        QuietTable table;
+        table.on(STATE_RED, quietRed)
+            .on(STATE_GREEN, quietGreen)
+            .on(STATE_YELLOW, quietYellow)
+            .onEnter(STATE_RED, countAction)
+            .onEnter(STATE_GREEN, countAction)
+            .onEnter(STATE_YELLOW, countAction);
+        return table;
+    }
+
+    inline constexpr QuietTable quietTable = buildQuietTable();
+}
+
+// One event through one machine: table lookup, transition action, entry action
+static void BM_Dispatch(benchmark::State &state)
+{
+    fsm::StateMachine<quietTable> light(STATE_RED);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(light.dispatch(EVT_TIMER_EXPIRE));
+    }
+
+    benchmark::DoNotOptimize(actionsRun);
+    state.SetItemsProcessed(state.iterations());
+}
+
+// A whole city for one full red-green-yellow cycle: timer wheel expiries
+// dispatched in a batch, actions not run
+static void BM_TrafficGridCycle(benchmark::State &state)
+{
+    constexpr PhaseDurations PHASES{30, 25, 5};
+    constexpr TimerWheel::Tick CYCLE = PHASES.red + PHASES.green + PHASES.yellow;
+
+    TrafficGrid grid(static_cast<std::size_t>(state.range(0)), PHASES);
+    std::size_t dispatched = 0;
+    for (auto _ : state)
+    {
+        dispatched += grid.advanceTo(grid.now() + CYCLE);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(dispatched));
+}
+
+BENCHMARK(BM_Dispatch);
+BENCHMARK(BM_TrafficGridCycle)->RangeMultiplier(10)->Range(1000, 100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Compare two Google Benchmark JSON runs and flag regressions.
+
+Usage:
+    compare_benchmarks.py BASELINE CANDIDATE [--threshold PERCENT] [--metric cpu_time|real_time]
+
+BASELINE and CANDIDATE are either single --benchmark_out JSON files or
+directories written by the run_benchmarks target (files matched by name).
+With --benchmark_repetitions the median aggregate is compared, otherwise
+the mean of the plain iterations.
+
+Exits 1 if any benchmark got slower by more than the threshold, so it can
+gate a CI job.
+"""
+
+import argparse
+import json
+import statistics
+import sys
+from pathlib import Path
+
+
+def load_run(path):
+    """Map "file:benchmark name" -> time in ns for one JSON file."""
+    with open(path) as f:
+        data = json.load(f)
+
+    medians = {}
+    samples = {}
+    for bench in data.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        if bench.get("run_type") == "aggregate":
+            if bench.get("aggregate_name") == "median":
+                medians[bench["run_name"]] = bench
+            continue
+        samples.setdefault(bench.get("run_name", bench["name"]), []).append(bench)
+
+    return medians, samples
+
+
+def to_ns(bench, metric):
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}[bench.get("time_unit", "ns")]
+    return bench[metric] * scale
+
+
+def load(path, metric):
+    path = Path(path)
+    files = sorted(path.glob("*.json")) if path.is_dir() else [path]
+
+    times = {}
+    for file in files:
+        medians, samples = load_run(file)
+        for name, runs in samples.items():
+            key = f"{file.stem}:{name}" if path.is_dir() else name
+            if name in medians:
+                times[key] = to_ns(medians[name], metric)
+            else:
+                times[key] = statistics.mean(to_ns(run, metric) for run in runs)
+    return times
+
+
+def format_ns(ns):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= scale:
+            return f"{ns / scale:.2f} {unit}"
+    return f"{ns:.1f} ns"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flag regressions between two Google Benchmark runs")
+    parser.add_argument("baseline", help="JSON file or run_benchmarks results directory")
+    parser.add_argument("candidate", help="JSON file or run_benchmarks results directory")
+    parser.add_argument("--threshold", type=float, default=5.0, help="percent slower that counts as a regression (default 5)")
+    parser.add_argument("--metric", choices=("cpu_time", "real_time"), default="cpu_time")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline, args.metric)
+    candidate = load(args.candidate, args.metric)
+
+    regressions = 0
+    width = max((len(name) for name in baseline.keys() | candidate.keys()), default=9)
+    print(f"{'benchmark':<{width}}  {'baseline':>10}  {'candidate':>10}  {'change':>8}")
+
+    for name in sorted(baseline.keys() | candidate.keys()):
+        if name not in candidate:
+            print(f"{name:<{width}}  {format_ns(baseline[name]):>10}  {'-':>10}  {'removed':>8}")
+            continue
+        if name not in baseline:
+            print(f"{name:<{width}}  {'-':>10}  {format_ns(candidate[name]):>10}  {'new':>8}")
+            continue
+
+        change = (candidate[name] - baseline[name]) / baseline[name] * 100.0 if baseline[name] > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        elif change < -args.threshold:
+            flag = "  faster"
+        print(f"{name:<{width}}  {format_ns(baseline[name]):>10}  {format_ns(candidate[name]):>10}  {change:+7.1f}%{flag}")
+
+    if regressions:
+        print(f"\n{regressions} benchmark(s) more than {args.threshold:g}% slower ({args.metric})")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -15,3 +15,4 @@ class ProjectTeletrackSimRecipe(ConanFile):
         # self.requires("sfml/2.6.1")
         # self.requires("poco/1.13.3")
         self.requires("gtest/1.14.0")
+        self.requires("benchmark/1.8.3")
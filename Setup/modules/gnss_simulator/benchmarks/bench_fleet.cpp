@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "fleet.h"
+#include "gnss.h"
+#include "kinematics.h"
+
+// Array-of-objects baseline: one GNSS per vehicle
+static void BM_VectorOfGNSS(benchmark::State &state)
+{
+    std::vector<gnss::GNSS> vehicles(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        for (gnss::GNSS &gnss : vehicles)
+        {
+            gnss.simulate();
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Structure-of-arrays fleet advanced in one call
+static void BM_FleetSimulateAll(benchmark::State &state)
+{
+    gnss::Fleet fleet(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        fleet.simulateAll();
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Heading and speed kernel, variant picked from CPUID
+static void BM_FleetAdvance(benchmark::State &state)
+{
+    gnss::Fleet fleet(static_cast<std::size_t>(state.range(0)));
+    for (std::size_t i = 0; i < fleet.size(); ++i)
+    {
+        fleet.setMotion(i, 0.01 * static_cast<double>(i), 0.0001);
+    }
+
+    for (auto _ : state)
+    {
+        fleet.advance(0.1);
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(gnss::kernelName(gnss::activeKernel()));
+}
+
+BENCHMARK(BM_VectorOfGNSS)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(BM_FleetSimulateAll)->RangeMultiplier(10)->Range(1000, 1000000);
+BENCHMARK(BM_FleetAdvance)->RangeMultiplier(10)->Range(1000, 1000000);
+
+BENCHMARK_MAIN();
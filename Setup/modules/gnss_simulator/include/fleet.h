@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * The GNSS module
+ */
+namespace gnss
+{
+    /**
+     * Structure-of-arrays container for many GNSS positions.
+     *
+     * Latitudes and longitudes live in two separate contiguous arrays so that
+     * simulateAll() is one straight loop the compiler can vectorize.
+     * Every vehicle moves exactly like GNSS::simulate() would move it.
+     */
+    class Fleet
+    {
+    public:
+        Fleet() = default;                                  // Empty fleet
+        explicit Fleet(std::size_t count);                  // count vehicles at (0,0)
+        Fleet(std::size_t count, double lat, double lon);   // count vehicles at (lat, lon)
+        ~Fleet() = default;                                 // Defaulted Destructor
+
+        std::size_t add(double lat, double lon);            // Append a vehicle, returns its index
+        void reserve(std::size_t count);                    // Preallocate room for count vehicles
+        void simulateAll() noexcept;                        // Advance every vehicle by GNSS::DELTA
+        void setMotion(std::size_t index, double headingRad, double speed); // Heading (0 = north) and degrees per second
+        void advance(double dt) noexcept;                   // Move every vehicle along its heading for dt seconds
+
+        std::size_t size() const noexcept;                  // Number of vehicles
+        double latitude(std::size_t index) const noexcept;  // Latitude of one vehicle
+        double longitude(std::size_t index) const noexcept; // Longitude of one vehicle
+        const double *latitudes() const noexcept;           // Contiguous latitude array
+        const double *longitudes() const noexcept;          // Contiguous longitude array
+
+    private:
+        std::vector<double> lat_;        // latitude per vehicle
+        std::vector<double> lon_;        // longitude per vehicle
+        std::vector<double> headingCos_; // cos(heading) per vehicle
+        std::vector<double> headingSin_; // sin(heading) per vehicle
+        std::vector<double> speed_;      // degrees per second per vehicle
+    };
+}
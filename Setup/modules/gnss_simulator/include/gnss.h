@@ -18,9 +18,10 @@ namespace gnss
         double latitude() const noexcept;  // Getter for current latitude
         double longitude() const noexcept; // Getter for current longitude
 
+        static constexpr double DELTA = 0.0001; // Step size for simulate, shared with Fleet
+
     private:
-        double lat_;                            // current latitide
-        double lon_;                            // current longitude
-        static constexpr double DELTA = 0.0001; // Step size for simulate
+        double lat_; // current latitide
+        double lon_; // current longitude
     };
 }
\ No newline at end of file
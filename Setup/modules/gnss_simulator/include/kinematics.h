@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+
+/**
+ * The GNSS module
+ */
+namespace gnss
+{
+    /**
+     * Instruction set used by advancePositions()
+     */
+    enum class KernelVariant
+    {
+        Scalar, // Portable C++ loop, always available
+        SSE2,   // 2 doubles per step
+        AVX2,   // 4 doubles per step
+        AVX512  // 8 doubles per step
+    };
+
+    /**
+     * Views over the structure-of-arrays motion state of a batch of vehicles.
+     * Heading is stored as its cosine (north) and sine (east) components so the
+     * kernel only needs multiplies and adds; speed is in degrees per second.
+     */
+    struct MotionBatch
+    {
+        double *lat;               // latitude per vehicle, updated in place
+        double *lon;               // longitude per vehicle, updated in place
+        const double *headingCos;  // cos(heading), heading 0 = north, clockwise
+        const double *headingSin;  // sin(heading)
+        const double *speed;       // degrees per second
+        std::size_t count;         // number of vehicles
+    };
+
+    // Advance every vehicle by speed * dt along its heading with the variant picked at startup
+    void advancePositions(const MotionBatch &batch, double dt) noexcept;
+
+    // Same as advancePositions() but forces a variant, must be supported
+    void advancePositionsWith(KernelVariant variant, const MotionBatch &batch, double dt) noexcept;
+
+    bool kernelSupported(KernelVariant variant) noexcept; // Compiled in and supported by this CPU
+    KernelVariant activeKernel() noexcept;                // Best supported variant (CPUID)
+    const char *kernelName(KernelVariant variant) noexcept; // Human readable name
+}
@@ -0,0 +1,85 @@
+#include "fleet.h"
+#include "gnss.h"
+#include "kinematics.h"
+
+#include <cmath>
+
+namespace gnss
+{
+    Fleet::Fleet(std::size_t count) : Fleet(count, 0.0, 0.0) {}
+
+    Fleet::Fleet(std::size_t count, double lat, double lon)
+        : lat_(count, lat), lon_(count, lon), headingCos_(count, 1.0), headingSin_(count, 0.0), speed_(count, 0.0) {}
+
+    std::size_t Fleet::add(double lat, double lon)
+    {
+        lat_.push_back(lat);
+        lon_.push_back(lon);
+        headingCos_.push_back(1.0);
+        headingSin_.push_back(0.0);
+        speed_.push_back(0.0);
+        return lat_.size() - 1;
+    }
+
+    void Fleet::reserve(std::size_t count)
+    {
+        lat_.reserve(count);
+        lon_.reserve(count);
+        headingCos_.reserve(count);
+        headingSin_.reserve(count);
+        speed_.reserve(count);
+    }
+
+    void Fleet::simulateAll() noexcept
+    {
+        // Same single addition per coordinate as GNSS::simulate(), so the
+        // results stay bit-identical while the loop vectorizes
+        double *lat = lat_.data();
+        double *lon = lon_.data();
+        const std::size_t count = lat_.size();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            lat[i] += GNSS::DELTA;
+            lon[i] += GNSS::DELTA;
+        }
+    }
+
+    void Fleet::setMotion(std::size_t index, double headingRad, double speed)
+    {
+        headingCos_[index] = std::cos(headingRad);
+        headingSin_[index] = std::sin(headingRad);
+        speed_[index] = speed;
+    }
+
+    void Fleet::advance(double dt) noexcept
+    {
+        const MotionBatch batch{lat_.data(), lon_.data(), headingCos_.data(), headingSin_.data(), speed_.data(), lat_.size()};
+        advancePositions(batch, dt);
+    }
+
+    std::size_t Fleet::size() const noexcept
+    {
+        return lat_.size();
+    }
+
+    double Fleet::latitude(std::size_t index) const noexcept
+    {
+        return lat_[index];
+    }
+
+    double Fleet::longitude(std::size_t index) const noexcept
+    {
+        return lon_[index];
+    }
+
+    const double *Fleet::latitudes() const noexcept
+    {
+        return lat_.data();
+    }
+
+    const double *Fleet::longitudes() const noexcept
+    {
+        return lon_.data();
+    }
+}
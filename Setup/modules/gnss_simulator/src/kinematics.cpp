@@ -0,0 +1,121 @@
+#include "kinematics.h"
+#include "kinematics_kernels.h"
+
+namespace gnss
+{
+    namespace detail
+    {
+        void advanceScalar(const MotionBatch &batch, double dt, std::size_t begin) noexcept
+        {
+            for (std::size_t i = begin; i < batch.count; ++i)
+            {
+                const double step = batch.speed[i] * dt;
+                batch.lat[i] = batch.lat[i] + step * batch.headingCos[i];
+                batch.lon[i] = batch.lon[i] + step * batch.headingSin[i];
+            }
+        }
+    }
+
+    namespace
+    {
+        using KernelFunction = void (*)(const MotionBatch &, double) noexcept;
+
+        void scalarKernel(const MotionBatch &batch, double dt) noexcept
+        {
+            detail::advanceScalar(batch, dt, 0);
+        }
+
+        KernelFunction kernelFor(KernelVariant variant) noexcept
+        {
+            switch (variant)
+            {
+#if defined(GNSS_X86_KERNELS)
+            case KernelVariant::SSE2:
+                return detail::advanceSse2;
+            case KernelVariant::AVX2:
+                return detail::advanceAvx2;
+            case KernelVariant::AVX512:
+                return detail::advanceAvx512;
+#endif
+            default:
+                return scalarKernel;
+            }
+        }
+
+        KernelVariant detectKernel() noexcept
+        {
+            // Widest first
+            constexpr KernelVariant preference[] = {KernelVariant::AVX512, KernelVariant::AVX2, KernelVariant::SSE2};
+
+            for (KernelVariant variant : preference)
+            {
+                if (kernelSupported(variant))
+                {
+                    return variant;
+                }
+            }
+            return KernelVariant::Scalar;
+        }
+
+        // Resolved once, the first time a batch is advanced
+        KernelFunction activeKernelFunction() noexcept
+        {
+            static const KernelFunction kernel = kernelFor(detectKernel());
+            return kernel;
+        }
+    }
+
+    void advancePositions(const MotionBatch &batch, double dt) noexcept
+    {
+        activeKernelFunction()(batch, dt);
+    }
+
+    void advancePositionsWith(KernelVariant variant, const MotionBatch &batch, double dt) noexcept
+    {
+        kernelFor(variant)(batch, dt);
+    }
+
+    bool kernelSupported(KernelVariant variant) noexcept
+    {
+        switch (variant)
+        {
+        case KernelVariant::Scalar:
+            return true;
+#if defined(GNSS_X86_KERNELS)
+        // __builtin_cpu_supports reads CPUID (and XCR0 for the AVX states)
+        case KernelVariant::SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2");
+        case KernelVariant::AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+        case KernelVariant::AVX512:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+        }
+    }
+
+    KernelVariant activeKernel() noexcept
+    {
+        static const KernelVariant variant = detectKernel();
+        return variant;
+    }
+
+    const char *kernelName(KernelVariant variant) noexcept
+    {
+        switch (variant)
+        {
+        case KernelVariant::SSE2:
+            return "SSE2";
+        case KernelVariant::AVX2:
+            return "AVX2";
+        case KernelVariant::AVX512:
+            return "AVX-512";
+        default:
+            return "Scalar";
+        }
+    }
+}
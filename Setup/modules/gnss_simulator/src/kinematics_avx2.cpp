@@ -0,0 +1,23 @@
+#include <immintrin.h>
+#include "kinematics_kernels.h"
+
+namespace gnss::detail
+{
+    // 4 vehicles per iteration, remainder handled by the scalar loop
+    void advanceAvx2(const MotionBatch &batch, double dt) noexcept
+    {
+        const __m256d vdt = _mm256_set1_pd(dt);
+        std::size_t i = 0;
+
+        for (; i + 4 <= batch.count; i += 4)
+        {
+            const __m256d step = _mm256_mul_pd(_mm256_loadu_pd(batch.speed + i), vdt);
+            const __m256d dLat = _mm256_mul_pd(step, _mm256_loadu_pd(batch.headingCos + i));
+            const __m256d dLon = _mm256_mul_pd(step, _mm256_loadu_pd(batch.headingSin + i));
+            _mm256_storeu_pd(batch.lat + i, _mm256_add_pd(_mm256_loadu_pd(batch.lat + i), dLat));
+            _mm256_storeu_pd(batch.lon + i, _mm256_add_pd(_mm256_loadu_pd(batch.lon + i), dLon));
+        }
+
+        advanceScalar(batch, dt, i);
+    }
+}
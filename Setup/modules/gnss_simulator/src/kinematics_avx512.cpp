@@ -0,0 +1,23 @@
+#include <immintrin.h>
+#include "kinematics_kernels.h"
+
+namespace gnss::detail
+{
+    // 8 vehicles per iteration, remainder handled by the scalar loop
+    void advanceAvx512(const MotionBatch &batch, double dt) noexcept
+    {
+        const __m512d vdt = _mm512_set1_pd(dt);
+        std::size_t i = 0;
+
+        for (; i + 8 <= batch.count; i += 8)
+        {
+            const __m512d step = _mm512_mul_pd(_mm512_loadu_pd(batch.speed + i), vdt);
+            const __m512d dLat = _mm512_mul_pd(step, _mm512_loadu_pd(batch.headingCos + i));
+            const __m512d dLon = _mm512_mul_pd(step, _mm512_loadu_pd(batch.headingSin + i));
+            _mm512_storeu_pd(batch.lat + i, _mm512_add_pd(_mm512_loadu_pd(batch.lat + i), dLat));
+            _mm512_storeu_pd(batch.lon + i, _mm512_add_pd(_mm512_loadu_pd(batch.lon + i), dLon));
+        }
+
+        advanceScalar(batch, dt, i);
+    }
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "kinematics.h"
+
+/**
+ * Per instruction set entry points behind advancePositions().
+ *
+ * Every variant computes, per vehicle and in this order:
+ *     step = speed * dt
+ *     lat  = lat + step * headingCos
+ *     lon  = lon + step * headingSin
+ * with separate multiplies and adds (no FMA, sources built with
+ * -ffp-contract=off), so all of them produce bit-identical results.
+ */
+namespace gnss::detail
+{
+    void advanceScalar(const MotionBatch &batch, double dt, std::size_t begin) noexcept;
+
+#if defined(GNSS_X86_KERNELS)
+    void advanceSse2(const MotionBatch &batch, double dt) noexcept;
+    void advanceAvx2(const MotionBatch &batch, double dt) noexcept;
+    void advanceAvx512(const MotionBatch &batch, double dt) noexcept;
+#endif
+}
@@ -0,0 +1,23 @@
+#include <emmintrin.h>
+#include "kinematics_kernels.h"
+
+namespace gnss::detail
+{
+    // 2 vehicles per iteration, remainder handled by the scalar loop
+    void advanceSse2(const MotionBatch &batch, double dt) noexcept
+    {
+        const __m128d vdt = _mm_set1_pd(dt);
+        std::size_t i = 0;
+
+        for (; i + 2 <= batch.count; i += 2)
+        {
+            const __m128d step = _mm_mul_pd(_mm_loadu_pd(batch.speed + i), vdt);
+            const __m128d dLat = _mm_mul_pd(step, _mm_loadu_pd(batch.headingCos + i));
+            const __m128d dLon = _mm_mul_pd(step, _mm_loadu_pd(batch.headingSin + i));
+            _mm_storeu_pd(batch.lat + i, _mm_add_pd(_mm_loadu_pd(batch.lat + i), dLat));
+            _mm_storeu_pd(batch.lon + i, _mm_add_pd(_mm_loadu_pd(batch.lon + i), dLon));
+        }
+
+        advanceScalar(batch, dt, i);
+    }
+}
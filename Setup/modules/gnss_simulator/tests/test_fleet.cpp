@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "fleet.h"
+#include "gnss.h"
+
+using gnss::Fleet;
+using gnss::GNSS;
+
+TEST(Fleet_Constructor, Starts_At_Given_Position)
+{
+    Fleet fleet(4, 10.0, 11.0);
+    ASSERT_EQ(fleet.size(), 4u);
+    for (std::size_t i = 0; i < fleet.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(fleet.latitude(i), 10.0);
+        EXPECT_DOUBLE_EQ(fleet.longitude(i), 11.0);
+    }
+}
+
+TEST(Fleet_Add, Returns_Index_Of_New_Vehicle)
+{
+    Fleet fleet;
+    EXPECT_EQ(fleet.add(1.0, 2.0), 0u);
+    EXPECT_EQ(fleet.add(3.0, 4.0), 1u);
+    EXPECT_DOUBLE_EQ(fleet.latitude(1), 3.0);
+    EXPECT_DOUBLE_EQ(fleet.longitude(1), 4.0);
+}
+
+TEST(Fleet_SimulateAll, Bit_Identical_To_GNSS_Simulate)
+{
+    // Odd count so the vectorized loops also run their scalar tail
+    std::vector<GNSS> reference;
+    Fleet fleet;
+    for (int i = 0; i < 1027; ++i)
+    {
+        const double lat = -90.0 + 0.173 * i;
+        const double lon = 180.0 - 0.311 * i;
+        reference.emplace_back(lat, lon);
+        fleet.add(lat, lon);
+    }
+
+    for (int tick = 0; tick < 100; ++tick)
+    {
+        for (GNSS &gnss : reference)
+        {
+            gnss.simulate();
+        }
+        fleet.simulateAll();
+    }
+
+    for (std::size_t i = 0; i < reference.size(); ++i)
+    {
+        // Exact comparison on purpose: the fleet must not drift from GNSS
+        EXPECT_EQ(fleet.latitude(i), reference[i].latitude());
+        EXPECT_EQ(fleet.longitude(i), reference[i].longitude());
+    }
+}
+
+TEST(Fleet_Advance, Moves_Each_Vehicle_Along_Its_Heading)
+{
+    Fleet fleet(2, 10.0, 20.0);
+    fleet.setMotion(0, 0.0, 0.001);  // north
+    fleet.setMotion(1, 3.14159265358979323846 / 2.0, 0.002); // east
+
+    fleet.advance(10.0);
+
+    EXPECT_DOUBLE_EQ(fleet.latitude(0), 10.01);
+    EXPECT_DOUBLE_EQ(fleet.longitude(0), 20.0);
+    EXPECT_NEAR(fleet.latitude(1), 10.0, 1e-12);
+    EXPECT_DOUBLE_EQ(fleet.longitude(1), 20.02);
+}
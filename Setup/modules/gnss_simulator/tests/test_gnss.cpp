@@ -1,7 +1,12 @@
 #include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
 #include "gnss.h"
+#include "kinematics.h"
 
 using gnss::GNSS;
+using gnss::KernelVariant;
+using gnss::MotionBatch;
 
 TEST(GNSS_Default_Constuctor, Starts_At_Origin)
 {
@@ -23,4 +28,87 @@ TEST(GNSS_Moves_By_Delta, Moves_By_Delta)
     gnss.simulate();
     EXPECT_DOUBLE_EQ(gnss.latitude(), 10.0001);
     EXPECT_DOUBLE_EQ(gnss.longitude(), 11.0001);
-}
\ No newline at end of file
+}
+
+/**
+ * Motion state for a batch of vehicles, with varied headings and speeds
+ */
+struct MotionState
+{
+    explicit MotionState(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const double heading = 0.37 * static_cast<double>(i);
+            lat.push_back(1.3521 + 0.001 * static_cast<double>(i));
+            lon.push_back(103.8198 - 0.002 * static_cast<double>(i));
+            headingCos.push_back(std::cos(heading));
+            headingSin.push_back(std::sin(heading));
+            speed.push_back(0.0001 * static_cast<double>(i % 17));
+        }
+    }
+
+    MotionBatch batch()
+    {
+        return MotionBatch{lat.data(), lon.data(), headingCos.data(), headingSin.data(), speed.data(), lat.size()};
+    }
+
+    std::vector<double> lat, lon, headingCos, headingSin, speed;
+};
+
+TEST(GNSS_Kernel_Scalar, Moves_Along_Heading)
+{
+    MotionState state(1);
+    state.headingCos[0] = 0.0; // due east
+    state.headingSin[0] = 1.0;
+    state.speed[0] = 0.5;
+
+    MotionBatch batch = state.batch();
+    gnss::advancePositionsWith(KernelVariant::Scalar, batch, 2.0);
+
+    EXPECT_DOUBLE_EQ(state.lat[0], 1.3521);
+    EXPECT_DOUBLE_EQ(state.lon[0], 104.8198);
+}
+
+TEST(GNSS_Kernel_Dispatch, Active_Kernel_Is_Supported)
+{
+    EXPECT_TRUE(gnss::kernelSupported(KernelVariant::Scalar));
+    EXPECT_TRUE(gnss::kernelSupported(gnss::activeKernel()));
+}
+
+class GNSS_Kernel_Variant : public ::testing::TestWithParam<KernelVariant>
+{
+};
+
+TEST_P(GNSS_Kernel_Variant, Matches_Scalar_Bit_For_Bit)
+{
+    if (!gnss::kernelSupported(GetParam()))
+    {
+        GTEST_SKIP() << gnss::kernelName(GetParam()) << " not supported on this CPU";
+    }
+
+    // 1029 is not a multiple of any vector width, so the tail loop runs too
+    MotionState expected(1029);
+    MotionState actual(1029);
+    MotionBatch expectedBatch = expected.batch();
+    MotionBatch actualBatch = actual.batch();
+
+    for (int tick = 0; tick < 50; ++tick)
+    {
+        gnss::advancePositionsWith(KernelVariant::Scalar, expectedBatch, 0.1);
+        gnss::advancePositionsWith(GetParam(), actualBatch, 0.1);
+    }
+
+    for (std::size_t i = 0; i < expected.lat.size(); ++i)
+    {
+        ASSERT_EQ(actual.lat[i], expected.lat[i]) << "vehicle " << i;
+        ASSERT_EQ(actual.lon[i], expected.lon[i]) << "vehicle " << i;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(AllVariants, GNSS_Kernel_Variant,
+                         ::testing::Values(KernelVariant::SSE2, KernelVariant::AVX2, KernelVariant::AVX512),
+                         [](const ::testing::TestParamInfo<KernelVariant> &info)
+                         {
+                             return std::string(info.param == KernelVariant::AVX512 ? "AVX512" : gnss::kernelName(info.param));
+                         });
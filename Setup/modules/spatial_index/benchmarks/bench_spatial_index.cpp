@@ -0,0 +1,120 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "fleet.h"
+#include "geofence.h"
+#include "spatial_grid.h"
+
+namespace
+{
+    const spatial::Bounds AREA{1.20, 103.60, 1.48, 104.05}; // ~31 x 50 km
+    constexpr double CELL_DEG = 0.0005;                     // ~55 m, ~2 vehicles per cell at 1M
+
+    // count vehicles spread over AREA, each driving at up to ~70 km/h
+    gnss::Fleet movingFleet(std::size_t count)
+    {
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<double> lat(AREA.minLat, AREA.maxLat);
+        std::uniform_real_distribution<double> lon(AREA.minLon, AREA.maxLon);
+        std::uniform_real_distribution<double> heading(0.0, 6.283);
+        std::uniform_real_distribution<double> speed(0.0, 0.00018); // degrees per second
+
+        gnss::Fleet fleet;
+        fleet.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            fleet.setMotion(fleet.add(lat(rng), lon(rng)), heading(rng), speed(rng));
+        }
+        return fleet;
+    }
+}
+
+// One 100 ms tick: move every vehicle, then update the index in place
+static void BM_UpdateTick(benchmark::State &state)
+{
+    gnss::Fleet fleet = movingFleet(static_cast<std::size_t>(state.range(0)));
+    spatial::SpatialGrid grid(AREA, CELL_DEG);
+    grid.updateAll(fleet);
+
+    for (auto _ : state)
+    {
+        fleet.advance(0.1);
+        grid.updateAll(fleet);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_UpdateTick)->Arg(100000)->Arg(1000000)->Unit(benchmark::kMillisecond);
+
+// k nearest vehicles to random points
+static void BM_Nearest(benchmark::State &state)
+{
+    const gnss::Fleet fleet = movingFleet(1000000);
+    spatial::SpatialGrid grid(AREA, CELL_DEG);
+    grid.updateAll(fleet);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> lat(AREA.minLat, AREA.maxLat);
+    std::uniform_real_distribution<double> lon(AREA.minLon, AREA.maxLon);
+    std::vector<spatial::Neighbor> found;
+
+    for (auto _ : state)
+    {
+        grid.nearest(lat(rng), lon(rng), static_cast<std::size_t>(state.range(0)), found);
+        benchmark::DoNotOptimize(found.data());
+    }
+}
+BENCHMARK(BM_Nearest)->Arg(1)->Arg(10)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+// Vehicles inside a box of the given side in metres
+static void BM_QueryBox(benchmark::State &state)
+{
+    const gnss::Fleet fleet = movingFleet(1000000);
+    spatial::SpatialGrid grid(AREA, CELL_DEG);
+    grid.updateAll(fleet);
+
+    const double half = static_cast<double>(state.range(0)) / 2.0 / 111195.0;
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> lat(AREA.minLat + half, AREA.maxLat - half);
+    std::uniform_real_distribution<double> lon(AREA.minLon + half, AREA.maxLon - half);
+    std::vector<std::uint32_t> ids;
+
+    for (auto _ : state)
+    {
+        const double la = lat(rng);
+        const double lo = lon(rng);
+        grid.queryBox(spatial::Bounds{la - half, lo - half, la + half, lo + half}, ids);
+        benchmark::DoNotOptimize(ids.data());
+    }
+}
+BENCHMARK(BM_QueryBox)->Arg(500)->Arg(2000)->Unit(benchmark::kMicrosecond);
+
+// Geofence check for a 1M fleet against 1000 circular fences, per tick
+static void BM_GeofenceTick(benchmark::State &state)
+{
+    gnss::Fleet fleet = movingFleet(1000000);
+    spatial::GeofenceMonitor monitor(AREA, 0.005);
+
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<double> lat(AREA.minLat, AREA.maxLat);
+    std::uniform_real_distribution<double> lon(AREA.minLon, AREA.maxLon);
+    for (int i = 0; i < 1000; ++i)
+    {
+        monitor.addCircle(lat(rng), lon(rng), 200.0);
+    }
+
+    std::vector<spatial::GeofenceEvent> events;
+    monitor.updateAll(fleet, events);
+
+    for (auto _ : state)
+    {
+        events.clear();
+        fleet.advance(0.1);
+        monitor.updateAll(fleet, events);
+        benchmark::DoNotOptimize(events.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 1000000);
+}
+BENCHMARK(BM_GeofenceTick)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
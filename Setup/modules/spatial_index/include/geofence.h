@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "spatial_grid.h"
+
+namespace spatial
+{
+    struct LatLon
+    {
+        double lat;
+        double lon;
+    };
+
+    // A vehicle crossed a fence boundary since its previous update
+    struct GeofenceEvent
+    {
+        enum class Kind
+        {
+            Entered,
+            Exited
+        };
+
+        std::uint32_t vehicle;
+        std::uint32_t fence;
+        Kind kind;
+    };
+
+    /**
+     * Entry and exit detection for many vehicles against circular and
+     * polygonal fences.
+     *
+     * Fences are rasterized onto the same kind of uniform grid SpatialGrid
+     * uses, so an update only tests the fences overlapping the vehicle's cell;
+     * a vehicle far from every fence costs one cell lookup. The monitor keeps
+     * the set of fences each vehicle is inside and reports the difference.
+     * A vehicle's first update reports Entered for every fence it starts in.
+     */
+    class GeofenceMonitor
+    {
+    public:
+        GeofenceMonitor(const Bounds &bounds, double cellDeg);
+
+        std::uint32_t addCircle(double lat, double lon, double radiusM); // Returns the fence id
+        std::uint32_t addPolygon(std::vector<LatLon> vertices);          // Simple polygon, 3+ vertices
+
+        // Move a vehicle and append its Entered / Exited events
+        void update(std::uint32_t vehicle, double lat, double lon, std::vector<GeofenceEvent> &events);
+
+        // Vehicle i = fleet vehicle i
+        void updateAll(const gnss::Fleet &fleet, std::vector<GeofenceEvent> &events);
+
+        bool inside(std::uint32_t vehicle, std::uint32_t fence) const;
+        std::size_t fenceCount() const noexcept { return fences_.size(); }
+
+        // Point in fence test, without any state
+        bool contains(std::uint32_t fence, double lat, double lon) const;
+
+    private:
+        struct Fence
+        {
+            Bounds box;
+            double centerLat;             // circles only
+            double centerLon;
+            double radiusDeg2;            // circles: squared radius in scaled degrees, 0 for polygons
+            double lonScale;              // circles: cos(centerLat)
+            std::vector<LatLon> vertices; // polygons only
+        };
+
+        void index(std::uint32_t fence);
+        void buildCells();
+
+        GridGeometry geometry_;
+        std::vector<Fence> fences_;
+        std::vector<std::uint64_t> rasters_; // (cell << 32 | fence) for every cell a fence overlaps
+        bool dirty_ = true;                  // rasters_ changed since buildCells()
+        std::vector<std::uint32_t> cellStart_;   // CSR: fences of cell c are cellFences_[cellStart_[c] .. cellStart_[c + 1])
+        std::vector<std::uint32_t> cellFences_;
+        std::vector<std::vector<std::uint32_t>> insideOf_; // per vehicle, sorted fence ids
+        std::vector<std::uint32_t> scratch_;
+    };
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gnss
+{
+    class Fleet;
+}
+
+/**
+ * The spatial index module
+ */
+namespace spatial
+{
+    /**
+     * Area covered by a grid, in degrees. Positions outside it are still
+     * accepted; they are kept in the nearest edge cell.
+     */
+    struct Bounds
+    {
+        double minLat;
+        double minLon;
+        double maxLat;
+        double maxLon;
+    };
+
+    /**
+     * Uniform lat/lon cells over Bounds, shared by SpatialGrid and GeofenceMonitor
+     */
+    class GridGeometry
+    {
+    public:
+        GridGeometry(const Bounds &bounds, double cellDeg); // throws std::invalid_argument on empty bounds or cell
+
+        std::uint32_t column(double lon) const noexcept;   // Clamped to [0, columns)
+        std::uint32_t row(double lat) const noexcept;      // Clamped to [0, rows)
+        std::uint32_t cellOf(double lat, double lon) const noexcept { return row(lat) * columns_ + column(lon); }
+
+        std::uint32_t columns() const noexcept { return columns_; }
+        std::uint32_t rows() const noexcept { return rows_; }
+        std::size_t cellCount() const noexcept { return static_cast<std::size_t>(columns_) * rows_; }
+        double cellDeg() const noexcept { return cellDeg_; }
+        const Bounds &bounds() const noexcept { return bounds_; }
+
+    private:
+        Bounds bounds_;
+        double cellDeg_;
+        double inverseCell_;
+        std::uint32_t columns_;
+        std::uint32_t rows_;
+    };
+
+    // One result of SpatialGrid::nearest()
+    struct Neighbor
+    {
+        std::uint32_t id;
+        double distanceM; // equirectangular, accurate for the short ranges dispatch cares about
+    };
+
+    /**
+     * Uniform grid index over moving points, updated in place every tick.
+     *
+     * Each cell stores copies of its points' coordinates next to their ids, so
+     * queries scan contiguous memory without touching per-point state. Moving
+     * a point within its cell is one store; crossing into another cell is a
+     * swap-remove from the old cell and an append to the new one. Nothing is
+     * ever rebuilt.
+     *
+     * Pick cellDeg so a cell holds a handful of points on average.
+     */
+    class SpatialGrid
+    {
+    public:
+        SpatialGrid(const Bounds &bounds, double cellDeg);
+
+        void update(std::uint32_t id, double lat, double lon); // Insert or move a point
+        bool remove(std::uint32_t id);                         // false if id is not indexed
+        void updateAll(const gnss::Fleet &fleet);              // Point i = vehicle i of the fleet
+        void reserve(std::size_t points);                      // Preallocate per-point state
+
+        bool contains(std::uint32_t id) const noexcept;
+        std::size_t size() const noexcept { return size_; }
+        const GridGeometry &geometry() const noexcept { return geometry_; }
+
+        // The k points closest to (lat, lon), nearest first (fewer if the grid holds fewer)
+        void nearest(double lat, double lon, std::size_t k, std::vector<Neighbor> &out) const;
+
+        // Ids of every point inside the box (edges inclusive), in no particular order
+        void queryBox(const Bounds &box, std::vector<std::uint32_t> &out) const;
+
+        // visit(id, lat, lon) for every point inside the box
+        template <typename Visitor>
+        void forEachInBox(const Bounds &box, Visitor &&visit) const;
+
+    private:
+        struct Entry
+        {
+            double lat;
+            double lon;
+            std::uint32_t id;
+        };
+
+        static constexpr std::uint32_t NO_CELL = 0xFFFFFFFFu;
+
+        GridGeometry geometry_;
+        std::vector<std::vector<Entry>> cells_;
+        std::vector<std::uint32_t> cellOf_; // per id, NO_CELL when not indexed
+        std::vector<std::uint32_t> slotOf_; // per id, position inside its cell
+        std::size_t size_ = 0;
+    };
+
+    template <typename Visitor>
+    void SpatialGrid::forEachInBox(const Bounds &box, Visitor &&visit) const
+    {
+        const std::uint32_t row0 = geometry_.row(box.minLat);
+        const std::uint32_t row1 = geometry_.row(box.maxLat);
+        const std::uint32_t col0 = geometry_.column(box.minLon);
+        const std::uint32_t col1 = geometry_.column(box.maxLon);
+
+        for (std::uint32_t row = row0; row <= row1; ++row)
+        {
+            for (std::uint32_t col = col0; col <= col1; ++col)
+            {
+                for (const Entry &entry : cells_[row * geometry_.columns() + col])
+                {
+                    if (entry.lat >= box.minLat && entry.lat <= box.maxLat && entry.lon >= box.minLon &&
+                        entry.lon <= box.maxLon)
+                    {
+                        visit(entry.id, entry.lat, entry.lon);
+                    }
+                }
+            }
+        }
+    }
+}
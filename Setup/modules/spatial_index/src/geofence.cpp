@@ -0,0 +1,209 @@
+#include "geofence.h"
+#include "fleet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    constexpr double PI = 3.14159265358979323846;
+    constexpr double METERS_PER_DEGREE = 6371008.8 * PI / 180.0;
+
+    // Even-odd ray cast in the lat/lon plane
+    bool insidePolygon(const std::vector<spatial::LatLon> &vertices, double lat, double lon)
+    {
+        bool inside = false;
+        for (std::size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
+        {
+            const spatial::LatLon &a = vertices[i];
+            const spatial::LatLon &b = vertices[j];
+            if ((a.lat > lat) != (b.lat > lat) && lon < (b.lon - a.lon) * (lat - a.lat) / (b.lat - a.lat) + a.lon)
+            {
+                inside = !inside;
+            }
+        }
+        return inside;
+    }
+}
+
+namespace spatial
+{
+    GeofenceMonitor::GeofenceMonitor(const Bounds &bounds, double cellDeg) : geometry_(bounds, cellDeg) {}
+
+    std::uint32_t GeofenceMonitor::addCircle(double lat, double lon, double radiusM)
+    {
+        if (!(radiusM > 0.0))
+        {
+            throw std::invalid_argument("geofence circle needs a positive radius");
+        }
+
+        const double radiusDeg = radiusM / METERS_PER_DEGREE;
+        const double lonScale = std::cos(lat * PI / 180.0);
+        const double lonRadius = radiusDeg / std::max(lonScale, 1e-6); // wider in longitude away from the equator
+
+        Fence fence;
+        fence.box = Bounds{lat - radiusDeg, lon - lonRadius, lat + radiusDeg, lon + lonRadius};
+        fence.centerLat = lat;
+        fence.centerLon = lon;
+        fence.radiusDeg2 = radiusDeg * radiusDeg;
+        fence.lonScale = lonScale;
+        fences_.push_back(std::move(fence));
+
+        const auto id = static_cast<std::uint32_t>(fences_.size() - 1);
+        index(id);
+        return id;
+    }
+
+    std::uint32_t GeofenceMonitor::addPolygon(std::vector<LatLon> vertices)
+    {
+        if (vertices.size() < 3)
+        {
+            throw std::invalid_argument("geofence polygon needs at least 3 vertices");
+        }
+
+        Fence fence{};
+        fence.box = Bounds{vertices[0].lat, vertices[0].lon, vertices[0].lat, vertices[0].lon};
+        for (const LatLon &vertex : vertices)
+        {
+            fence.box.minLat = std::min(fence.box.minLat, vertex.lat);
+            fence.box.minLon = std::min(fence.box.minLon, vertex.lon);
+            fence.box.maxLat = std::max(fence.box.maxLat, vertex.lat);
+            fence.box.maxLon = std::max(fence.box.maxLon, vertex.lon);
+        }
+        fence.vertices = std::move(vertices);
+        fences_.push_back(std::move(fence));
+
+        const auto id = static_cast<std::uint32_t>(fences_.size() - 1);
+        index(id);
+        return id;
+    }
+
+    bool GeofenceMonitor::contains(std::uint32_t fence, double lat, double lon) const
+    {
+        const Fence &f = fences_.at(fence);
+        if (lat < f.box.minLat || lat > f.box.maxLat || lon < f.box.minLon || lon > f.box.maxLon)
+        {
+            return false;
+        }
+
+        if (f.vertices.empty())
+        {
+            const double dy = lat - f.centerLat;
+            const double dx = (lon - f.centerLon) * f.lonScale;
+            return dx * dx + dy * dy <= f.radiusDeg2;
+        }
+        return insidePolygon(f.vertices, lat, lon);
+    }
+
+    bool GeofenceMonitor::inside(std::uint32_t vehicle, std::uint32_t fence) const
+    {
+        if (vehicle >= insideOf_.size())
+        {
+            return false;
+        }
+        const std::vector<std::uint32_t> &fences = insideOf_[vehicle];
+        return std::binary_search(fences.begin(), fences.end(), fence);
+    }
+
+    void GeofenceMonitor::update(std::uint32_t vehicle, double lat, double lon, std::vector<GeofenceEvent> &events)
+    {
+        if (dirty_)
+        {
+            buildCells();
+        }
+        if (vehicle >= insideOf_.size())
+        {
+            insideOf_.resize(vehicle + std::size_t{1});
+        }
+
+        const std::uint32_t cell = geometry_.cellOf(lat, lon);
+        const std::uint32_t begin = cellStart_[cell];
+        const std::uint32_t end = cellStart_[cell + 1];
+        std::vector<std::uint32_t> &before = insideOf_[vehicle];
+
+        // Far from every fence and inside none: nothing to do
+        if (begin == end && before.empty())
+        {
+            return;
+        }
+
+        // Candidates are sorted by fence id, so scratch_ comes out sorted too
+        scratch_.clear();
+        for (std::uint32_t i = begin; i < end; ++i)
+        {
+            if (contains(cellFences_[i], lat, lon))
+            {
+                scratch_.push_back(cellFences_[i]);
+            }
+        }
+
+        // Merge the two sorted sets: only in scratch_ = entered, only in before = exited
+        std::size_t a = 0;
+        std::size_t b = 0;
+        while (a < scratch_.size() || b < before.size())
+        {
+            if (b == before.size() || (a < scratch_.size() && scratch_[a] < before[b]))
+            {
+                events.push_back(GeofenceEvent{vehicle, scratch_[a++], GeofenceEvent::Kind::Entered});
+            }
+            else if (a == scratch_.size() || before[b] < scratch_[a])
+            {
+                events.push_back(GeofenceEvent{vehicle, before[b++], GeofenceEvent::Kind::Exited});
+            }
+            else
+            {
+                ++a;
+                ++b;
+            }
+        }
+
+        before.assign(scratch_.begin(), scratch_.end());
+    }
+
+    void GeofenceMonitor::updateAll(const gnss::Fleet &fleet, std::vector<GeofenceEvent> &events)
+    {
+        const double *lat = fleet.latitudes();
+        const double *lon = fleet.longitudes();
+        const auto count = static_cast<std::uint32_t>(fleet.size());
+
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            update(i, lat[i], lon[i], events);
+        }
+    }
+
+    // Record every cell the fence's bounding box overlaps
+    void GeofenceMonitor::index(std::uint32_t fence)
+    {
+        const Bounds &box = fences_[fence].box;
+        for (std::uint32_t row = geometry_.row(box.minLat); row <= geometry_.row(box.maxLat); ++row)
+        {
+            for (std::uint32_t col = geometry_.column(box.minLon); col <= geometry_.column(box.maxLon); ++col)
+            {
+                const std::uint64_t cell = row * geometry_.columns() + col;
+                rasters_.push_back(cell << 32 | fence);
+            }
+        }
+        dirty_ = true;
+    }
+
+    // Sort rasters_ by cell (then fence) and lay them out as per-cell CSR arrays
+    void GeofenceMonitor::buildCells()
+    {
+        std::sort(rasters_.begin(), rasters_.end());
+
+        cellStart_.assign(geometry_.cellCount() + 1, 0);
+        cellFences_.resize(rasters_.size());
+        for (std::size_t i = 0; i < rasters_.size(); ++i)
+        {
+            ++cellStart_[(rasters_[i] >> 32) + 1];
+            cellFences_[i] = static_cast<std::uint32_t>(rasters_[i]);
+        }
+        for (std::size_t c = 0; c < geometry_.cellCount(); ++c)
+        {
+            cellStart_[c + 1] += cellStart_[c];
+        }
+        dirty_ = false;
+    }
+}
@@ -0,0 +1,239 @@
+#include "spatial_grid.h"
+#include "fleet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+    constexpr double PI = 3.14159265358979323846;
+    constexpr double EARTH_RADIUS_M = 6371008.8;
+    constexpr double METERS_PER_DEGREE = EARTH_RADIUS_M * PI / 180.0;
+}
+
+namespace spatial
+{
+    GridGeometry::GridGeometry(const Bounds &bounds, double cellDeg) : bounds_(bounds), cellDeg_(cellDeg)
+    {
+        if (!(cellDeg > 0.0) || !(bounds.maxLat > bounds.minLat) || !(bounds.maxLon > bounds.minLon))
+        {
+            throw std::invalid_argument("spatial grid needs non-empty bounds and a positive cell size");
+        }
+        inverseCell_ = 1.0 / cellDeg;
+        columns_ = static_cast<std::uint32_t>(std::ceil((bounds.maxLon - bounds.minLon) * inverseCell_));
+        rows_ = static_cast<std::uint32_t>(std::ceil((bounds.maxLat - bounds.minLat) * inverseCell_));
+        if (static_cast<double>(columns_) * rows_ >= 4294967295.0)
+        {
+            throw std::invalid_argument("spatial grid has too many cells, use a larger cell size");
+        }
+    }
+
+    std::uint32_t GridGeometry::column(double lon) const noexcept
+    {
+        const double x = (lon - bounds_.minLon) * inverseCell_;
+        return x <= 0.0 ? 0u : std::min(static_cast<std::uint32_t>(x), columns_ - 1); // NaN lands in cell 0
+    }
+
+    std::uint32_t GridGeometry::row(double lat) const noexcept
+    {
+        const double y = (lat - bounds_.minLat) * inverseCell_;
+        return y <= 0.0 ? 0u : std::min(static_cast<std::uint32_t>(y), rows_ - 1);
+    }
+
+    SpatialGrid::SpatialGrid(const Bounds &bounds, double cellDeg)
+        : geometry_(bounds, cellDeg), cells_(geometry_.cellCount()) {}
+
+    void SpatialGrid::reserve(std::size_t points)
+    {
+        cellOf_.reserve(points);
+        slotOf_.reserve(points);
+    }
+
+    bool SpatialGrid::contains(std::uint32_t id) const noexcept
+    {
+        return id < cellOf_.size() && cellOf_[id] != NO_CELL;
+    }
+
+    void SpatialGrid::update(std::uint32_t id, double lat, double lon)
+    {
+        if (id >= cellOf_.size())
+        {
+            cellOf_.resize(id + std::size_t{1}, NO_CELL);
+            slotOf_.resize(id + std::size_t{1}, 0);
+        }
+
+        const std::uint32_t cell = geometry_.cellOf(lat, lon);
+        const std::uint32_t previous = cellOf_[id];
+
+        // Most ticks a vehicle stays in its cell: overwrite the copy in place
+        if (cell == previous)
+        {
+            Entry &entry = cells_[cell][slotOf_[id]];
+            entry.lat = lat;
+            entry.lon = lon;
+            return;
+        }
+
+        if (previous != NO_CELL)
+        {
+            remove(id);
+        }
+
+        std::vector<Entry> &target = cells_[cell];
+        slotOf_[id] = static_cast<std::uint32_t>(target.size());
+        cellOf_[id] = cell;
+        target.push_back(Entry{lat, lon, id});
+        ++size_;
+    }
+
+    bool SpatialGrid::remove(std::uint32_t id)
+    {
+        if (!contains(id))
+        {
+            return false;
+        }
+
+        // Swap-remove: the last entry of the cell takes the freed slot
+        std::vector<Entry> &cell = cells_[cellOf_[id]];
+        const std::uint32_t slot = slotOf_[id];
+        cell[slot] = cell.back();
+        slotOf_[cell[slot].id] = slot;
+        cell.pop_back();
+
+        cellOf_[id] = NO_CELL;
+        --size_;
+        return true;
+    }
+
+    void SpatialGrid::updateAll(const gnss::Fleet &fleet)
+    {
+        const double *lat = fleet.latitudes();
+        const double *lon = fleet.longitudes();
+        const auto count = static_cast<std::uint32_t>(fleet.size());
+
+        reserve(count);
+
+        // Vehicle order is unrelated to cell order, so every update touches a
+        // random cell: prefetch the cell header, then the entry itself, ahead
+        constexpr std::uint32_t AHEAD = 16;
+        const std::uint32_t known = static_cast<std::uint32_t>(std::min<std::size_t>(cellOf_.size(), count));
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            if (i + AHEAD < known && cellOf_[i + AHEAD] != NO_CELL)
+            {
+                __builtin_prefetch(&cells_[cellOf_[i + AHEAD]]);
+            }
+            if (i + AHEAD / 2 < known && cellOf_[i + AHEAD / 2] != NO_CELL)
+            {
+                __builtin_prefetch(cells_[cellOf_[i + AHEAD / 2]].data() + slotOf_[i + AHEAD / 2], 1);
+            }
+            update(i, lat[i], lon[i]);
+        }
+    }
+
+    void SpatialGrid::queryBox(const Bounds &box, std::vector<std::uint32_t> &out) const
+    {
+        out.clear();
+        forEachInBox(box, [&out](std::uint32_t id, double, double)
+                     { out.push_back(id); });
+    }
+
+    // Visit rings of cells around the query cell, nearest ring first, keeping
+    // a max-heap of the best k. Points beyond ring r are at least r cells away
+    // on one axis, so once the k-th best is closer than that the search stops.
+    // Distances are in degrees with longitude scaled by cos(query latitude).
+    void SpatialGrid::nearest(double lat, double lon, std::size_t k, std::vector<Neighbor> &out) const
+    {
+        out.clear();
+        if (k == 0 || size_ == 0)
+        {
+            return;
+        }
+
+        struct Candidate
+        {
+            double distance2;
+            std::uint32_t id;
+            bool operator<(const Candidate &other) const { return distance2 < other.distance2; }
+        };
+
+        std::vector<Candidate> heap;
+        heap.reserve(k + 1);
+
+        const double lonScale = std::cos(lat * PI / 180.0);
+        const auto scan = [&](std::uint32_t cell)
+        {
+            for (const Entry &entry : cells_[cell])
+            {
+                const double dy = entry.lat - lat;
+                const double dx = (entry.lon - lon) * lonScale;
+                const double d2 = dx * dx + dy * dy;
+                if (heap.size() < k)
+                {
+                    heap.push_back(Candidate{d2, entry.id});
+                    std::push_heap(heap.begin(), heap.end());
+                }
+                else if (d2 < heap.front().distance2)
+                {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = Candidate{d2, entry.id};
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+        };
+
+        const auto cx = static_cast<std::int64_t>(geometry_.column(lon));
+        const auto cy = static_cast<std::int64_t>(geometry_.row(lat));
+        const std::int64_t columns = geometry_.columns();
+        const std::int64_t rows = geometry_.rows();
+        const std::int64_t lastRing = std::max(std::max(cx, columns - 1 - cx), std::max(cy, rows - 1 - cy));
+        const double ringStep = geometry_.cellDeg() * std::min(1.0, std::fabs(lonScale));
+
+        for (std::int64_t r = 0; r <= lastRing; ++r)
+        {
+            if (heap.size() == k)
+            {
+                const double reach = static_cast<double>(r - 1) * ringStep;
+                if (r > 0 && heap.front().distance2 <= reach * reach)
+                {
+                    break;
+                }
+            }
+
+            const std::int64_t y0 = std::max<std::int64_t>(cy - r, 0);
+            const std::int64_t y1 = std::min<std::int64_t>(cy + r, rows - 1);
+            for (std::int64_t y = y0; y <= y1; ++y)
+            {
+                const bool edgeRow = y == cy - r || y == cy + r;
+                if (edgeRow)
+                {
+                    const std::int64_t x0 = std::max<std::int64_t>(cx - r, 0);
+                    const std::int64_t x1 = std::min<std::int64_t>(cx + r, columns - 1);
+                    for (std::int64_t x = x0; x <= x1; ++x)
+                    {
+                        scan(static_cast<std::uint32_t>(y * columns + x));
+                    }
+                }
+                else
+                {
+                    if (cx - r >= 0)
+                    {
+                        scan(static_cast<std::uint32_t>(y * columns + cx - r));
+                    }
+                    if (r > 0 && cx + r < columns)
+                    {
+                        scan(static_cast<std::uint32_t>(y * columns + cx + r));
+                    }
+                }
+            }
+        }
+
+        std::sort_heap(heap.begin(), heap.end());
+        out.reserve(heap.size());
+        for (const Candidate &candidate : heap)
+        {
+            out.push_back(Neighbor{candidate.id, std::sqrt(candidate.distance2) * METERS_PER_DEGREE});
+        }
+    }
+}
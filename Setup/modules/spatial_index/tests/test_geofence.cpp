@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "fleet.h"
+#include "geofence.h"
+
+using spatial::Bounds;
+using spatial::GeofenceEvent;
+using spatial::GeofenceMonitor;
+using spatial::LatLon;
+
+namespace
+{
+    const Bounds AREA{1.20, 103.60, 1.48, 104.05};
+}
+
+TEST(Geofence_Contains, Circle_And_Polygon)
+{
+    GeofenceMonitor monitor(AREA, 0.01);
+    const std::uint32_t circle = monitor.addCircle(1.30, 103.80, 500.0);
+    const std::uint32_t square = monitor.addPolygon({{1.40, 103.90}, {1.40, 103.95}, {1.45, 103.95}, {1.45, 103.90}});
+    EXPECT_EQ(monitor.fenceCount(), 2u);
+
+    EXPECT_TRUE(monitor.contains(circle, 1.30, 103.80));
+    EXPECT_TRUE(monitor.contains(circle, 1.304, 103.80));  // ~445 m north
+    EXPECT_FALSE(monitor.contains(circle, 1.305, 103.80)); // ~556 m north
+    EXPECT_TRUE(monitor.contains(circle, 1.30, 103.804));
+    EXPECT_FALSE(monitor.contains(circle, 1.30, 103.805));
+
+    EXPECT_TRUE(monitor.contains(square, 1.42, 103.92));
+    EXPECT_FALSE(monitor.contains(square, 1.42, 103.96));
+    EXPECT_FALSE(monitor.contains(square, 1.39, 103.92));
+}
+
+TEST(Geofence_Contains, Concave_Polygon)
+{
+    GeofenceMonitor monitor(AREA, 0.01);
+    // U shape open to the north
+    const std::uint32_t u = monitor.addPolygon(
+        {{1.30, 103.70}, {1.30, 103.76}, {1.36, 103.76}, {1.36, 103.74}, {1.32, 103.74}, {1.32, 103.72}, {1.36, 103.72}, {1.36, 103.70}});
+
+    EXPECT_TRUE(monitor.contains(u, 1.31, 103.73));  // bottom of the U
+    EXPECT_TRUE(monitor.contains(u, 1.34, 103.71));  // left arm
+    EXPECT_FALSE(monitor.contains(u, 1.34, 103.73)); // the gap
+}
+
+TEST(Geofence_Update, Reports_Entry_And_Exit_Once)
+{
+    GeofenceMonitor monitor(AREA, 0.01);
+    const std::uint32_t depot = monitor.addCircle(1.30, 103.80, 300.0);
+
+    std::vector<GeofenceEvent> events;
+    monitor.update(7, 1.29, 103.80, events); // ~1.1 km south
+    EXPECT_TRUE(events.empty());
+
+    monitor.update(7, 1.299, 103.80, events);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].vehicle, 7u);
+    EXPECT_EQ(events[0].fence, depot);
+    EXPECT_EQ(events[0].kind, GeofenceEvent::Kind::Entered);
+    EXPECT_TRUE(monitor.inside(7, depot));
+
+    events.clear();
+    monitor.update(7, 1.3, 103.80, events); // still inside
+    EXPECT_TRUE(events.empty());
+
+    monitor.update(7, 1.31, 103.80, events);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].kind, GeofenceEvent::Kind::Exited);
+    EXPECT_FALSE(monitor.inside(7, depot));
+}
+
+TEST(Geofence_Update, Overlapping_Fences_And_Fences_Added_Later)
+{
+    GeofenceMonitor monitor(AREA, 0.01);
+    const std::uint32_t big = monitor.addCircle(1.30, 103.80, 2000.0);
+
+    std::vector<GeofenceEvent> events;
+    monitor.update(1, 1.30, 103.80, events);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].fence, big);
+
+    // A fence added while the vehicle is already inside is entered on the next update
+    const std::uint32_t small = monitor.addPolygon({{1.295, 103.795}, {1.295, 103.805}, {1.305, 103.805}, {1.305, 103.795}});
+    events.clear();
+    monitor.update(1, 1.30, 103.80, events);
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].fence, small);
+    EXPECT_EQ(events[0].kind, GeofenceEvent::Kind::Entered);
+
+    // Leaving both at once reports both exits
+    events.clear();
+    monitor.update(1, 1.45, 104.0, events);
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].kind, GeofenceEvent::Kind::Exited);
+    EXPECT_EQ(events[1].kind, GeofenceEvent::Kind::Exited);
+}
+
+TEST(Geofence_UpdateAll, Fleet_Driving_Through_A_Fence)
+{
+    GeofenceMonitor monitor(AREA, 0.005);
+    const std::uint32_t zone = monitor.addPolygon({{1.30, 103.80}, {1.30, 103.81}, {1.31, 103.81}, {1.31, 103.80}});
+
+    // Three vehicles heading east along different latitudes, one misses the zone
+    gnss::Fleet fleet;
+    fleet.add(1.305, 103.79);
+    fleet.add(1.301, 103.79);
+    fleet.add(1.320, 103.79);
+    for (std::size_t i = 0; i < fleet.size(); ++i)
+    {
+        fleet.setMotion(i, 3.14159265358979323846 / 2, 0.001); // east, 0.001 deg/s
+    }
+
+    std::vector<GeofenceEvent> events;
+    int entered = 0;
+    int exited = 0;
+    for (int tick = 0; tick < 40; ++tick)
+    {
+        events.clear();
+        monitor.updateAll(fleet, events);
+        for (const GeofenceEvent &event : events)
+        {
+            EXPECT_EQ(event.fence, zone);
+            EXPECT_NE(event.vehicle, 2u);
+            (event.kind == GeofenceEvent::Kind::Entered ? entered : exited)++;
+        }
+        fleet.advance(1.0);
+    }
+    EXPECT_EQ(entered, 2);
+    EXPECT_EQ(exited, 2);
+}
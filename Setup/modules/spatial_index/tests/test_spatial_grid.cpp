@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "fleet.h"
+#include "spatial_grid.h"
+
+using spatial::Bounds;
+using spatial::Neighbor;
+using spatial::SpatialGrid;
+
+namespace
+{
+    const Bounds AREA{1.20, 103.60, 1.48, 104.05}; // roughly Singapore
+
+    // Same metric as SpatialGrid::nearest(), for brute force comparisons
+    double scaledDistance2(double lat, double lon, double qLat, double qLon)
+    {
+        const double dy = lat - qLat;
+        const double dx = (lon - qLon) * std::cos(qLat * 3.14159265358979323846 / 180.0);
+        return dx * dx + dy * dy;
+    }
+
+    gnss::Fleet randomFleet(std::size_t count, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> lat(AREA.minLat, AREA.maxLat);
+        std::uniform_real_distribution<double> lon(AREA.minLon, AREA.maxLon);
+        gnss::Fleet fleet;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            fleet.add(lat(rng), lon(rng));
+        }
+        return fleet;
+    }
+
+    std::vector<std::uint32_t> bruteForceNearest(const gnss::Fleet &fleet, double lat, double lon, std::size_t k)
+    {
+        std::vector<std::uint32_t> ids(fleet.size());
+        for (std::uint32_t i = 0; i < ids.size(); ++i)
+        {
+            ids[i] = i;
+        }
+        std::sort(ids.begin(), ids.end(), [&](std::uint32_t a, std::uint32_t b)
+                  { return scaledDistance2(fleet.latitude(a), fleet.longitude(a), lat, lon) <
+                           scaledDistance2(fleet.latitude(b), fleet.longitude(b), lat, lon); });
+        ids.resize(std::min(k, ids.size()));
+        return ids;
+    }
+}
+
+TEST(SpatialGrid_Constructor, Rejects_Empty_Bounds_And_Cell)
+{
+    EXPECT_THROW(SpatialGrid(Bounds{1.0, 1.0, 1.0, 2.0}, 0.01), std::invalid_argument);
+    EXPECT_THROW(SpatialGrid(AREA, 0.0), std::invalid_argument);
+}
+
+TEST(SpatialGrid_Update, Inserts_Moves_And_Removes)
+{
+    SpatialGrid grid(AREA, 0.01);
+    grid.update(5, 1.30, 103.80);
+    grid.update(9, 1.31, 103.81);
+    EXPECT_EQ(grid.size(), 2u);
+    EXPECT_TRUE(grid.contains(5));
+    EXPECT_FALSE(grid.contains(6));
+
+    // Move 5 across many cells, then within its cell
+    grid.update(5, 1.45, 104.00);
+    grid.update(5, 1.4501, 104.0001);
+    EXPECT_EQ(grid.size(), 2u);
+
+    std::vector<std::uint32_t> ids;
+    grid.queryBox(Bounds{1.44, 103.99, 1.46, 104.01}, ids);
+    EXPECT_EQ(ids, (std::vector<std::uint32_t>{5}));
+
+    EXPECT_TRUE(grid.remove(5));
+    EXPECT_FALSE(grid.remove(5));
+    EXPECT_EQ(grid.size(), 1u);
+    grid.queryBox(AREA, ids);
+    EXPECT_EQ(ids, (std::vector<std::uint32_t>{9}));
+}
+
+TEST(SpatialGrid_QueryBox, Matches_Brute_Force_While_Moving)
+{
+    gnss::Fleet fleet = randomFleet(5000, 1);
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<double> heading(0.0, 6.283);
+    for (std::size_t i = 0; i < fleet.size(); ++i)
+    {
+        fleet.setMotion(i, heading(rng), 0.001);
+    }
+
+    SpatialGrid grid(AREA, 0.005);
+    const Bounds box{1.30, 103.75, 1.35, 103.85};
+    std::vector<std::uint32_t> ids;
+
+    for (int tick = 0; tick < 20; ++tick)
+    {
+        grid.updateAll(fleet);
+        grid.queryBox(box, ids);
+        std::sort(ids.begin(), ids.end());
+
+        std::vector<std::uint32_t> expected;
+        for (std::uint32_t i = 0; i < fleet.size(); ++i)
+        {
+            const double lat = fleet.latitude(i);
+            const double lon = fleet.longitude(i);
+            if (lat >= box.minLat && lat <= box.maxLat && lon >= box.minLon && lon <= box.maxLon)
+            {
+                expected.push_back(i);
+            }
+        }
+        ASSERT_EQ(ids, expected) << "tick " << tick;
+        fleet.advance(1.0);
+    }
+}
+
+TEST(SpatialGrid_Nearest, Matches_Brute_Force)
+{
+    const gnss::Fleet fleet = randomFleet(5000, 3);
+    SpatialGrid grid(AREA, 0.005);
+    grid.updateAll(fleet);
+
+    std::vector<Neighbor> found;
+    for (const auto &[lat, lon] : std::vector<std::pair<double, double>>{
+             {1.35, 103.82}, {1.2001, 103.6001}, {1.47, 104.04}, {1.0, 103.0}, {1.34, 105.0}})
+    {
+        grid.nearest(lat, lon, 10, found);
+        const std::vector<std::uint32_t> expected = bruteForceNearest(fleet, lat, lon, 10);
+        ASSERT_EQ(found.size(), expected.size());
+        for (std::size_t i = 0; i < found.size(); ++i)
+        {
+            EXPECT_EQ(found[i].id, expected[i]) << "query " << lat << "," << lon << " rank " << i;
+        }
+        for (std::size_t i = 1; i < found.size(); ++i)
+        {
+            EXPECT_LE(found[i - 1].distanceM, found[i].distanceM);
+        }
+    }
+}
+
+TEST(SpatialGrid_Nearest, Returns_Metres_And_Handles_Small_Grids)
+{
+    SpatialGrid grid(AREA, 0.01);
+    grid.update(1, 1.30, 103.80);
+    grid.update(2, 1.31, 103.80);
+
+    std::vector<Neighbor> found;
+    grid.nearest(1.30, 103.80, 5, found);
+    ASSERT_EQ(found.size(), 2u);
+    EXPECT_EQ(found[0].id, 1u);
+    EXPECT_DOUBLE_EQ(found[0].distanceM, 0.0);
+    EXPECT_EQ(found[1].id, 2u);
+    EXPECT_NEAR(found[1].distanceM, 1112.0, 1.0); // 0.01 degrees of latitude
+
+    grid.nearest(1.30, 103.80, 0, found);
+    EXPECT_TRUE(found.empty());
+}
+
+TEST(SpatialGrid_Update, Points_Outside_Bounds_Stay_Queryable)
+{
+    SpatialGrid grid(AREA, 0.01);
+    grid.update(1, 0.50, 102.00); // below and left of AREA
+    grid.update(2, 1.30, 103.80);
+
+    std::vector<std::uint32_t> ids;
+    grid.queryBox(Bounds{0.0, 101.0, 1.0, 103.0}, ids);
+    EXPECT_EQ(ids, (std::vector<std::uint32_t>{1}));
+
+    std::vector<Neighbor> found;
+    grid.nearest(0.5, 102.0, 1, found);
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0].id, 1u);
+}
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "telemetry_frame.h"
+
+namespace
+{
+    constexpr std::uint32_t VEHICLES = 1000;
+
+    // One tick of fixes for the whole fleet, every vehicle moved by GNSS::DELTA
+    std::vector<wire::Fix> tickOfFixes(std::uint64_t tick)
+    {
+        std::vector<wire::Fix> fixes;
+        for (std::uint32_t v = 0; v < VEHICLES; ++v)
+        {
+            const auto step = static_cast<std::int32_t>(1000 * tick);
+            fixes.push_back(wire::Fix{v, 100 * tick, 13521000 + static_cast<std::int32_t>(v) * 977 + step,
+                                      1038198000 - static_cast<std::int32_t>(v) * 911 + step});
+        }
+        return fixes;
+    }
+}
+
+// Delta-encode one fleet tick per iteration
+static void BM_EncodeFleetTick(benchmark::State &state)
+{
+    std::vector<wire::Fix> history(VEHICLES);
+    wire::Encoder encoder(wire::History{history.data(), history.size()});
+    std::vector<std::uint8_t> buffer(64 * 1024);
+
+    std::uint64_t tick = 0;
+    std::vector<wire::Fix> fixes = tickOfFixes(tick);
+    std::size_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        for (wire::Fix &fix : fixes)
+        {
+            fix.timestampMs += 100;
+            fix.lat += 1000;
+            fix.lon += 1000;
+        }
+        encoder.begin(buffer.data(), buffer.size());
+        for (const wire::Fix &fix : fixes)
+        {
+            encoder.add(fix);
+        }
+        bytes = encoder.finish();
+        benchmark::DoNotOptimize(buffer.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * VEHICLES);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * bytes));
+    state.counters["bytes_per_fix"] = static_cast<double>(bytes) / VEHICLES;
+}
+
+// Validate and decode one fleet tick per iteration
+static void BM_DecodeFleetTick(benchmark::State &state)
+{
+    std::vector<wire::Fix> encodeHistory(VEHICLES);
+    wire::Encoder encoder(wire::History{encodeHistory.data(), encodeHistory.size()});
+    std::vector<std::uint8_t> keyFrame(64 * 1024);
+    std::vector<std::uint8_t> deltaFrame(64 * 1024);
+
+    encoder.begin(keyFrame.data(), keyFrame.size());
+    for (const wire::Fix &fix : tickOfFixes(0))
+    {
+        encoder.add(fix);
+    }
+    const std::size_t keySize = encoder.finish();
+    encoder.begin(deltaFrame.data(), deltaFrame.size());
+    for (const wire::Fix &fix : tickOfFixes(1))
+    {
+        encoder.add(fix);
+    }
+    const std::size_t deltaSize = encoder.finish();
+
+    std::vector<wire::Fix> decodeHistory(VEHICLES);
+    wire::Decoder decoder(wire::History{decodeHistory.data(), decodeHistory.size()});
+    std::size_t frameSize = 0;
+    wire::Fix fix{};
+
+    for (auto _ : state)
+    {
+        // Re-seed the references so the same delta frame decodes every time
+        state.PauseTiming();
+        decoder.resetHistory(); // replaying frame 0 is a new stream, not a gap
+        decoder.open(keyFrame.data(), keySize, frameSize);
+        while (decoder.next(fix))
+        {
+        }
+        state.ResumeTiming();
+
+        decoder.open(deltaFrame.data(), deltaSize, frameSize);
+        while (decoder.next(fix))
+        {
+            benchmark::DoNotOptimize(fix);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * VEHICLES);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * deltaSize));
+}
+
+BENCHMARK(BM_EncodeFleetTick);
+BENCHMARK(BM_DecodeFleetTick);
+
+BENCHMARK_MAIN();
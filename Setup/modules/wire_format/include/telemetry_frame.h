@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "varint.h"
+
+/**
+ * The wire format module
+ */
+namespace wire
+{
+    /**
+     * Binary telemetry frames.
+     *
+     * A frame is a 12 byte header, a run of position records and a CRC-32:
+     *
+     *     'T' 'W' version flags | count:u16 | payload bytes:u16 | sequence:u32 | records... | crc32:u32
+     *
+     * (integers little endian, the CRC covers header and records). The
+     * sequence counts the frames of one encoder, so a decoder can tell a
+     * lost frame from a late one.
+     *
+     * Positions are fixed point, 1e-7 degree units (about 1 cm). A record is
+     *
+     *     varint(vehicle << 1 | key)  then
+     *     key:   varint(timestampMs)    zigzag(lat)     zigzag(lon)
+     *     delta: varint(ms since prev)  zigzag(dlat)    zigzag(dlon)
+     *
+     * where delta records are relative to the previous fix of the same vehicle
+     * in the stream. A GNSS::simulate() step (DELTA = 1000 units) at 10 Hz
+     * encodes in 6 bytes, against 28 for the raw id / time / double pair.
+     *
+     * Encoder and decoder never allocate: frames go to and come from caller
+     * buffers, and the per-vehicle reference fixes live in a caller-owned
+     * History array indexed by vehicle id.
+     */
+
+    constexpr std::uint8_t MAGIC_0 = 'T';
+    constexpr std::uint8_t MAGIC_1 = 'W';
+    constexpr std::uint8_t VERSION = 2;
+    constexpr std::size_t HEADER_BYTES = 12;
+    constexpr std::size_t TRAILER_BYTES = 4;
+    constexpr std::size_t MAX_PAYLOAD_BYTES = 0xFFFF;
+    constexpr std::size_t MAX_RECORD_BYTES = 4 * MAX_VARINT_BYTES;
+
+    constexpr double FIXED_SCALE = 1e7; // units per degree
+
+    std::int32_t toFixed(double degrees) noexcept;   // Round to the nearest 1e-7 degree
+    double toDegrees(std::int32_t fixed) noexcept;   // Back to degrees
+
+    /**
+     * One position sample in fixed point
+     */
+    struct Fix
+    {
+        std::uint32_t vehicle;
+        std::uint64_t timestampMs;
+        std::int32_t lat; // 1e-7 degrees
+        std::int32_t lon; // 1e-7 degrees
+    };
+
+    constexpr std::uint32_t NO_VEHICLE = 0xFFFFFFFF; // marks an empty History slot
+
+    /**
+     * Last fix of each vehicle, in caller-owned storage of `size` slots.
+     * Vehicles with an id >= size are always sent as key records.
+     */
+    struct History
+    {
+        Fix *fixes = nullptr;
+        std::size_t size = 0;
+
+        void clear() noexcept;                                  // Forget every vehicle
+        const Fix *find(std::uint32_t vehicle) const noexcept;  // Previous fix or nullptr
+        void update(const Fix &fix) noexcept;                   // Remember fix as the reference
+    };
+
+    enum class DecodeStatus
+    {
+        Ok,
+        Truncated,   // buffer ends before the frame does
+        BadMagic,
+        BadVersion,
+        BadChecksum,
+        Malformed,   // checksum matched but the records do not parse
+        Gap          // frame is valid but follows a lost one; see Decoder
+    };
+
+    const char *statusName(DecodeStatus status) noexcept; // Human readable name
+
+    std::uint32_t crc32(const std::uint8_t *data, std::size_t size, std::uint32_t crc = 0) noexcept; // IEEE 802.3
+
+    /**
+     * Writes fixes into frames. The history carries over from frame to frame,
+     * so a stream has to be decoded in order; resetHistory() makes the next
+     * fix of every vehicle a key record (e.g. for a new subscriber).
+     */
+    class Encoder
+    {
+    public:
+        explicit Encoder(History history) noexcept;
+
+        void begin(std::uint8_t *buffer, std::size_t capacity) noexcept; // Start a frame in buffer
+        bool add(const Fix &fix) noexcept;   // Append a record, false if the frame is full
+        std::size_t finish() noexcept;       // Seal the frame, returns its total size (0 if no frame)
+
+        void resetHistory() noexcept;                        // Next fix of every vehicle is a key record
+        std::size_t records() const noexcept { return count_; } // Records in the open frame
+
+    private:
+        History history_;
+        std::uint8_t *buffer_ = nullptr;
+        std::size_t capacity_ = 0;
+        std::size_t used_ = 0;   // header + records written so far
+        std::size_t count_ = 0;
+        std::uint32_t sequence_ = 0; // of the next frame
+    };
+
+    /**
+     * Reads frames produced by Encoder, with its own History of the same size.
+     *
+     * When a frame's sequence does not follow the previous one, open() clears
+     * the history and returns Gap. The frame can still be read: key records
+     * decode as usual, and delta records of vehicles whose key has not arrived
+     * since the gap are skipped (counted by skipped()) instead of being added
+     * to a stale reference. Ask the encoder for resetHistory() to resync.
+     */
+    class Decoder
+    {
+    public:
+        explicit Decoder(History history) noexcept;
+
+        // Validate the frame at the start of data; frameSize is set when Ok or Gap
+        DecodeStatus open(const std::uint8_t *data, std::size_t size, std::size_t &frameSize) noexcept;
+
+        // Next fix of the opened frame, false at its end. status() tells a clean end from an error.
+        bool next(Fix &out) noexcept;
+
+        DecodeStatus status() const noexcept { return status_; }
+        std::size_t remaining() const noexcept { return remaining_; } // Records not read yet
+        std::size_t skipped() const noexcept { return skipped_; }     // Deltas dropped after a gap
+        void resetHistory() noexcept; // Also starts a new stream: the next frame is never a Gap
+
+    private:
+        bool readRecord(Fix &out) noexcept; // false when the record was skipped or bad
+
+        History history_;
+        const std::uint8_t *cursor_ = nullptr;
+        const std::uint8_t *end_ = nullptr;
+        std::size_t remaining_ = 0;
+        std::size_t skipped_ = 0;
+        std::uint32_t expected_ = 0;   // sequence of the next frame
+        bool started_ = false;         // a frame of this stream was opened
+        bool resyncing_ = false;       // a gap happened, unreferenced deltas are skipped
+        DecodeStatus status_ = DecodeStatus::Ok;
+    };
+}
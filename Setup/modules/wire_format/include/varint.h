@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * The wire format module
+ */
+namespace wire
+{
+    constexpr std::size_t MAX_VARINT_BYTES = 10; // 64 bits in 7 bit groups
+
+    // Map signed to unsigned so small magnitudes of either sign stay small: 0,-1,1,-2 -> 0,1,2,3
+    constexpr std::uint64_t zigzagEncode(std::int64_t value) noexcept
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    constexpr std::int64_t zigzagDecode(std::uint64_t value) noexcept
+    {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    // LEB128 varint, returns the bytes written to out (room for MAX_VARINT_BYTES)
+    inline std::size_t putVarint(std::uint64_t value, std::uint8_t *out) noexcept
+    {
+        std::size_t size = 0;
+        while (value >= 0x80)
+        {
+            out[size++] = static_cast<std::uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        out[size++] = static_cast<std::uint8_t>(value);
+        return size;
+    }
+
+    // Read one varint from [in, end), returns the byte after it or nullptr if truncated or too long
+    inline const std::uint8_t *getVarint(const std::uint8_t *in, const std::uint8_t *end, std::uint64_t &value) noexcept
+    {
+        value = 0;
+        for (unsigned shift = 0; shift < 64 && in < end; shift += 7)
+        {
+            const std::uint8_t byte = *in++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return in;
+            }
+        }
+        return nullptr;
+    }
+}
@@ -0,0 +1,319 @@
+#include "telemetry_frame.h"
+#include <cmath>
+#include <cstring>
+
+namespace wire
+{
+    namespace
+    {
+        // Byte-wise CRC-32 table, reflected polynomial 0xEDB88320
+        struct CrcTable
+        {
+            std::uint32_t entries[256];
+
+            constexpr CrcTable() : entries{}
+            {
+                for (std::uint32_t i = 0; i < 256; ++i)
+                {
+                    std::uint32_t crc = i;
+                    for (int bit = 0; bit < 8; ++bit)
+                    {
+                        crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+                    }
+                    entries[i] = crc;
+                }
+            }
+        };
+
+        constexpr CrcTable CRC_TABLE;
+
+        void putU16(std::uint8_t *out, std::size_t value) noexcept
+        {
+            out[0] = static_cast<std::uint8_t>(value);
+            out[1] = static_cast<std::uint8_t>(value >> 8);
+        }
+
+        void putU32(std::uint8_t *out, std::uint32_t value) noexcept
+        {
+            for (int i = 0; i < 4; ++i)
+            {
+                out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+            }
+        }
+
+        std::uint32_t getU16(const std::uint8_t *in) noexcept
+        {
+            return static_cast<std::uint32_t>(in[0]) | (static_cast<std::uint32_t>(in[1]) << 8);
+        }
+
+        std::uint32_t getU32(const std::uint8_t *in) noexcept
+        {
+            return getU16(in) | (getU16(in + 2) << 16);
+        }
+    }
+
+    std::int32_t toFixed(double degrees) noexcept
+    {
+        return static_cast<std::int32_t>(std::lround(degrees * FIXED_SCALE));
+    }
+
+    double toDegrees(std::int32_t fixed) noexcept
+    {
+        return static_cast<double>(fixed) / FIXED_SCALE;
+    }
+
+    void History::clear() noexcept
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            fixes[i].vehicle = NO_VEHICLE;
+        }
+    }
+
+    const Fix *History::find(std::uint32_t vehicle) const noexcept
+    {
+        if (vehicle >= size || fixes[vehicle].vehicle != vehicle)
+        {
+            return nullptr;
+        }
+        return &fixes[vehicle];
+    }
+
+    void History::update(const Fix &fix) noexcept
+    {
+        if (fix.vehicle < size)
+        {
+            fixes[fix.vehicle] = fix;
+        }
+    }
+
+    const char *statusName(DecodeStatus status) noexcept
+    {
+        switch (status)
+        {
+        case DecodeStatus::Ok:
+            return "ok";
+        case DecodeStatus::Truncated:
+            return "truncated";
+        case DecodeStatus::BadMagic:
+            return "bad magic";
+        case DecodeStatus::BadVersion:
+            return "bad version";
+        case DecodeStatus::BadChecksum:
+            return "bad checksum";
+        case DecodeStatus::Malformed:
+            return "malformed";
+        case DecodeStatus::Gap:
+            return "gap";
+        }
+        return "unknown";
+    }
+
+    std::uint32_t crc32(const std::uint8_t *data, std::size_t size, std::uint32_t crc) noexcept
+    {
+        crc = ~crc;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            crc = CRC_TABLE.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    Encoder::Encoder(History history) noexcept : history_(history)
+    {
+        history_.clear();
+    }
+
+    void Encoder::begin(std::uint8_t *buffer, std::size_t capacity) noexcept
+    {
+        buffer_ = buffer;
+        capacity_ = capacity;
+        used_ = HEADER_BYTES;
+        count_ = 0;
+    }
+
+    bool Encoder::add(const Fix &fix) noexcept
+    {
+        if (!buffer_ || count_ == 0xFFFF)
+        {
+            return false;
+        }
+
+        // Encode into scratch first: the record size is only known afterwards
+        std::uint8_t record[MAX_RECORD_BYTES];
+        std::size_t size = 0;
+
+        const Fix *previous = history_.find(fix.vehicle);
+        const bool key = !previous || fix.timestampMs < previous->timestampMs;
+
+        size += putVarint((static_cast<std::uint64_t>(fix.vehicle) << 1) | (key ? 1u : 0u), record + size);
+        if (key)
+        {
+            size += putVarint(fix.timestampMs, record + size);
+            size += putVarint(zigzagEncode(fix.lat), record + size);
+            size += putVarint(zigzagEncode(fix.lon), record + size);
+        }
+        else
+        {
+            size += putVarint(fix.timestampMs - previous->timestampMs, record + size);
+            size += putVarint(zigzagEncode(static_cast<std::int64_t>(fix.lat) - previous->lat), record + size);
+            size += putVarint(zigzagEncode(static_cast<std::int64_t>(fix.lon) - previous->lon), record + size);
+        }
+
+        if (used_ + size + TRAILER_BYTES > capacity_ || used_ - HEADER_BYTES + size > MAX_PAYLOAD_BYTES)
+        {
+            return false;
+        }
+
+        std::memcpy(buffer_ + used_, record, size);
+        used_ += size;
+        ++count_;
+        history_.update(fix);
+        return true;
+    }
+
+    std::size_t Encoder::finish() noexcept
+    {
+        if (!buffer_ || used_ + TRAILER_BYTES > capacity_)
+        {
+            return 0;
+        }
+
+        buffer_[0] = MAGIC_0;
+        buffer_[1] = MAGIC_1;
+        buffer_[2] = VERSION;
+        buffer_[3] = 0; // flags, reserved
+        putU16(buffer_ + 4, count_);
+        putU16(buffer_ + 6, used_ - HEADER_BYTES);
+        putU32(buffer_ + 8, sequence_++);
+        putU32(buffer_ + used_, crc32(buffer_, used_));
+
+        const std::size_t size = used_ + TRAILER_BYTES;
+        buffer_ = nullptr;
+        return size;
+    }
+
+    void Encoder::resetHistory() noexcept
+    {
+        history_.clear();
+    }
+
+    Decoder::Decoder(History history) noexcept : history_(history)
+    {
+        history_.clear();
+    }
+
+    DecodeStatus Decoder::open(const std::uint8_t *data, std::size_t size, std::size_t &frameSize) noexcept
+    {
+        cursor_ = end_ = nullptr;
+        remaining_ = 0;
+
+        if (size < HEADER_BYTES)
+        {
+            return status_ = DecodeStatus::Truncated;
+        }
+        if (data[0] != MAGIC_0 || data[1] != MAGIC_1)
+        {
+            return status_ = DecodeStatus::BadMagic;
+        }
+        if (data[2] != VERSION)
+        {
+            return status_ = DecodeStatus::BadVersion;
+        }
+
+        const std::size_t payload = getU16(data + 6);
+        const std::size_t total = HEADER_BYTES + payload + TRAILER_BYTES;
+        if (size < total)
+        {
+            return status_ = DecodeStatus::Truncated;
+        }
+        if (crc32(data, HEADER_BYTES + payload) != getU32(data + HEADER_BYTES + payload))
+        {
+            return status_ = DecodeStatus::BadChecksum;
+        }
+
+        // A missing frame leaves the references stale: forget them all
+        const std::uint32_t sequence = getU32(data + 8);
+        const bool gap = started_ && sequence != expected_;
+        if (gap)
+        {
+            history_.clear();
+            resyncing_ = true;
+        }
+        started_ = true;
+        expected_ = sequence + 1;
+
+        cursor_ = data + HEADER_BYTES;
+        end_ = cursor_ + payload;
+        remaining_ = getU16(data + 4);
+        frameSize = total;
+        return status_ = gap ? DecodeStatus::Gap : DecodeStatus::Ok;
+    }
+
+    bool Decoder::next(Fix &out) noexcept
+    {
+        while (remaining_ != 0 && (status_ == DecodeStatus::Ok || status_ == DecodeStatus::Gap))
+        {
+            if (readRecord(out))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Decoder::readRecord(Fix &out) noexcept
+    {
+        std::uint64_t head, time, lat, lon;
+        const std::uint8_t *p = getVarint(cursor_, end_, head);
+        p = p ? getVarint(p, end_, time) : nullptr;
+        p = p ? getVarint(p, end_, lat) : nullptr;
+        p = p ? getVarint(p, end_, lon) : nullptr;
+        if (!p)
+        {
+            status_ = DecodeStatus::Malformed;
+            return false;
+        }
+
+        out.vehicle = static_cast<std::uint32_t>(head >> 1);
+        if (head & 1)
+        {
+            out.timestampMs = time;
+            out.lat = static_cast<std::int32_t>(zigzagDecode(lat));
+            out.lon = static_cast<std::int32_t>(zigzagDecode(lon));
+        }
+        else
+        {
+            const Fix *previous = history_.find(out.vehicle);
+            if (!previous && resyncing_)
+            {
+                // Reference lost in the gap: wait for the vehicle's next key
+                cursor_ = p;
+                --remaining_;
+                ++skipped_;
+                return false;
+            }
+            if (!previous)
+            {
+                // Delta without its key: the stream was joined half way
+                status_ = DecodeStatus::Malformed;
+                return false;
+            }
+            out.timestampMs = previous->timestampMs + time;
+            out.lat = static_cast<std::int32_t>(previous->lat + zigzagDecode(lat));
+            out.lon = static_cast<std::int32_t>(previous->lon + zigzagDecode(lon));
+        }
+
+        history_.update(out);
+        cursor_ = p;
+        --remaining_;
+        return true;
+    }
+
+    void Decoder::resetHistory() noexcept
+    {
+        history_.clear();
+        started_ = false;
+        resyncing_ = false;
+    }
+}
@@ -0,0 +1,268 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+#include "gnss.h"
+#include "telemetry_frame.h"
+
+using wire::DecodeStatus;
+using wire::Fix;
+
+namespace
+{
+    // Caller-owned history storage for one encoder or decoder
+    struct HistoryStore
+    {
+        explicit HistoryStore(std::size_t vehicles) : fixes(vehicles) {}
+
+        wire::History history() { return wire::History{fixes.data(), fixes.size()}; }
+
+        std::vector<Fix> fixes;
+    };
+
+    bool sameFix(const Fix &a, const Fix &b)
+    {
+        return a.vehicle == b.vehicle && a.timestampMs == b.timestampMs && a.lat == b.lat && a.lon == b.lon;
+    }
+}
+
+TEST(FixedPoint, Round_Trips_To_A_Tenth_Of_A_Microdegree)
+{
+    EXPECT_EQ(wire::toFixed(1.3521), 13521000);
+    EXPECT_EQ(wire::toFixed(-103.8198), -1038198000);
+    EXPECT_EQ(wire::toFixed(gnss::GNSS::DELTA), 1000);
+    EXPECT_NEAR(wire::toDegrees(wire::toFixed(179.9999999)), 179.9999999, 1e-9);
+}
+
+TEST(Frame, Round_Trips_Simulated_Fleet_In_Few_Bytes_Per_Record)
+{
+    const std::uint32_t vehicles = 50;
+    const int ticks = 40;
+
+    HistoryStore encoderStore(vehicles);
+    HistoryStore decoderStore(vehicles);
+    wire::Encoder encoder(encoderStore.history());
+    wire::Decoder decoder(decoderStore.history());
+
+    std::vector<gnss::GNSS> fleet;
+    for (std::uint32_t v = 0; v < vehicles; ++v)
+    {
+        fleet.emplace_back(1.3 + 0.01 * v, 103.8 - 0.01 * v);
+    }
+
+    std::vector<std::uint8_t> buffer(4096);
+    std::size_t encodedBytes = 0;
+    std::size_t records = 0;
+    std::vector<Fix> sent;
+    sent.reserve(vehicles);
+
+    for (int tick = 0; tick < ticks; ++tick)
+    {
+        // One frame per tick, 100 ms apart
+        sent.clear();
+        encoder.begin(buffer.data(), buffer.size());
+        for (std::uint32_t v = 0; v < vehicles; ++v)
+        {
+            fleet[v].simulate();
+            const Fix fix{v, 1700000000000ull + 100ull * tick, wire::toFixed(fleet[v].latitude()),
+                          wire::toFixed(fleet[v].longitude())};
+            ASSERT_TRUE(encoder.add(fix));
+            sent.push_back(fix);
+        }
+        const std::size_t frameSize = encoder.finish();
+        ASSERT_GT(frameSize, 0u);
+        encodedBytes += frameSize;
+        records += sent.size();
+
+        std::size_t opened = 0;
+        ASSERT_EQ(decoder.open(buffer.data(), frameSize, opened), DecodeStatus::Ok);
+        EXPECT_EQ(opened, frameSize);
+        EXPECT_EQ(decoder.remaining(), vehicles);
+
+        Fix fix{};
+        for (const Fix &expected : sent)
+        {
+            ASSERT_TRUE(decoder.next(fix));
+            ASSERT_TRUE(sameFix(fix, expected));
+        }
+        EXPECT_FALSE(decoder.next(fix));
+        EXPECT_EQ(decoder.status(), DecodeStatus::Ok);
+    }
+
+    // Key records in the first frame, then 6 byte deltas; raw would be 28 bytes
+    const double perRecord = static_cast<double>(encodedBytes) / static_cast<double>(records);
+    EXPECT_LT(perRecord, 7.0);
+}
+
+TEST(Frame, Delta_Record_Is_Six_Bytes)
+{
+    HistoryStore store(4);
+    wire::Encoder encoder(store.history());
+    std::uint8_t buffer[64];
+
+    encoder.begin(buffer, sizeof(buffer));
+    ASSERT_TRUE(encoder.add(Fix{3, 1000, 13521000, 1038198000}));
+    const std::size_t keyFrame = encoder.finish();
+
+    encoder.begin(buffer, sizeof(buffer));
+    ASSERT_TRUE(encoder.add(Fix{3, 1100, 13522000, 1038199000}));
+    EXPECT_EQ(encoder.finish(), wire::HEADER_BYTES + 6 + wire::TRAILER_BYTES);
+    EXPECT_GT(keyFrame, wire::HEADER_BYTES + 6 + wire::TRAILER_BYTES);
+}
+
+TEST(Frame, Backwards_Time_And_Unknown_Vehicles_Use_Key_Records)
+{
+    HistoryStore encoderStore(2);
+    HistoryStore decoderStore(2);
+    wire::Encoder encoder(encoderStore.history());
+    wire::Decoder decoder(decoderStore.history());
+
+    const Fix fixes[] = {
+        {1, 5000, 10, 20},
+        {1, 4000, 11, 21},     // earlier than the reference
+        {99, 7000, -5, -6},    // beyond the history
+        {99, 7100, -4, -5},
+    };
+
+    std::uint8_t buffer[256];
+    encoder.begin(buffer, sizeof(buffer));
+    for (const Fix &fix : fixes)
+    {
+        ASSERT_TRUE(encoder.add(fix));
+    }
+    const std::size_t size = encoder.finish();
+
+    std::size_t frameSize = 0;
+    ASSERT_EQ(decoder.open(buffer, size, frameSize), DecodeStatus::Ok);
+    Fix fix{};
+    for (const Fix &expected : fixes)
+    {
+        ASSERT_TRUE(decoder.next(fix));
+        EXPECT_TRUE(sameFix(fix, expected));
+    }
+}
+
+TEST(Frame, Detects_Corruption_And_Truncation)
+{
+    HistoryStore store(1);
+    wire::Encoder encoder(store.history());
+    std::uint8_t buffer[64];
+    encoder.begin(buffer, sizeof(buffer));
+    encoder.add(Fix{0, 1, 2, 3});
+    const std::size_t size = encoder.finish();
+
+    HistoryStore decoderStore(1);
+    wire::Decoder decoder(decoderStore.history());
+    std::size_t frameSize = 0;
+
+    EXPECT_EQ(decoder.open(buffer, size - 1, frameSize), DecodeStatus::Truncated);
+    EXPECT_EQ(decoder.open(buffer, 3, frameSize), DecodeStatus::Truncated);
+
+    buffer[wire::HEADER_BYTES] ^= 0x01;
+    EXPECT_EQ(decoder.open(buffer, size, frameSize), DecodeStatus::BadChecksum);
+    buffer[wire::HEADER_BYTES] ^= 0x01;
+
+    buffer[2] = 9;
+    EXPECT_EQ(decoder.open(buffer, size, frameSize), DecodeStatus::BadVersion);
+    buffer[2] = wire::VERSION;
+
+    buffer[0] = 'X';
+    EXPECT_EQ(decoder.open(buffer, size, frameSize), DecodeStatus::BadMagic);
+    EXPECT_STREQ(wire::statusName(DecodeStatus::BadMagic), "bad magic");
+}
+
+TEST(Frame, Delta_Without_Key_Is_Malformed)
+{
+    HistoryStore encoderStore(1);
+    wire::Encoder encoder(encoderStore.history());
+    std::uint8_t first[64];
+    std::uint8_t second[64];
+
+    encoder.begin(first, sizeof(first));
+    encoder.add(Fix{0, 100, 0, 0});
+    encoder.finish();
+    encoder.begin(second, sizeof(second));
+    encoder.add(Fix{0, 200, 1000, 1000});
+    const std::size_t size = encoder.finish();
+
+    // A decoder that never saw the first frame
+    HistoryStore decoderStore(1);
+    wire::Decoder decoder(decoderStore.history());
+    std::size_t frameSize = 0;
+    ASSERT_EQ(decoder.open(second, size, frameSize), DecodeStatus::Ok);
+    Fix fix{};
+    EXPECT_FALSE(decoder.next(fix));
+    EXPECT_EQ(decoder.status(), DecodeStatus::Malformed);
+}
+
+TEST(Frame, Lost_Frame_Is_Reported_And_Its_Deltas_Are_Not_Applied)
+{
+    HistoryStore encoderStore(3);
+    HistoryStore decoderStore(3);
+    wire::Encoder encoder(encoderStore.history());
+    wire::Decoder decoder(decoderStore.history());
+
+    // Frame per tick: vehicles 0 and 1 move, vehicle 2 is new in tick 2
+    std::uint8_t frames[4][64];
+    std::size_t sizes[4];
+    for (std::uint32_t tick = 0; tick < 4; ++tick)
+    {
+        if (tick == 3)
+        {
+            encoder.resetHistory(); // the subscriber asked for keys
+        }
+        encoder.begin(frames[tick], sizeof(frames[tick]));
+        for (std::uint32_t v = 0; v < 2; ++v)
+        {
+            const std::int32_t at = static_cast<std::int32_t>(1000 * (tick + 1) + v);
+            ASSERT_TRUE(encoder.add(Fix{v, 100ull * tick, at, -at}));
+        }
+        if (tick == 2)
+        {
+            ASSERT_TRUE(encoder.add(Fix{2, 200, 7, 8}));
+        }
+        sizes[tick] = encoder.finish();
+    }
+
+    std::size_t frameSize = 0;
+    Fix fix{};
+    ASSERT_EQ(decoder.open(frames[0], sizes[0], frameSize), DecodeStatus::Ok);
+    while (decoder.next(fix))
+    {
+    }
+
+    // Frame 1 is lost: the deltas of frame 2 must not land on frame 0's fixes
+    ASSERT_EQ(decoder.open(frames[2], sizes[2], frameSize), DecodeStatus::Gap);
+    ASSERT_TRUE(decoder.next(fix));
+    EXPECT_TRUE(sameFix(fix, Fix{2, 200, 7, 8}));
+    EXPECT_FALSE(decoder.next(fix));
+    EXPECT_EQ(decoder.status(), DecodeStatus::Gap);
+    EXPECT_EQ(decoder.skipped(), 2u);
+    EXPECT_STREQ(wire::statusName(DecodeStatus::Gap), "gap");
+
+    // The next key records bring every vehicle back
+    ASSERT_EQ(decoder.open(frames[3], sizes[3], frameSize), DecodeStatus::Ok);
+    for (std::uint32_t v = 0; v < 2; ++v)
+    {
+        ASSERT_TRUE(decoder.next(fix));
+        EXPECT_TRUE(sameFix(fix, Fix{v, 300, static_cast<std::int32_t>(4000 + v), -static_cast<std::int32_t>(4000 + v)}));
+    }
+    EXPECT_FALSE(decoder.next(fix));
+    EXPECT_EQ(decoder.status(), DecodeStatus::Ok);
+}
+
+TEST(Frame, Add_Fails_Once_The_Buffer_Is_Full)
+{
+    HistoryStore store(0);
+    wire::Encoder encoder(store.history());
+    std::uint8_t buffer[32];
+    encoder.begin(buffer, sizeof(buffer));
+
+    std::size_t added = 0;
+    while (encoder.add(Fix{static_cast<std::uint32_t>(added), 1, 2, 3}))
+    {
+        ++added;
+    }
+    EXPECT_GT(added, 0u);
+    EXPECT_EQ(encoder.records(), added);
+    EXPECT_LE(encoder.finish(), sizeof(buffer));
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include "varint.h"
+
+TEST(ZigZag, Small_Magnitudes_Stay_Small)
+{
+    EXPECT_EQ(wire::zigzagEncode(0), 0u);
+    EXPECT_EQ(wire::zigzagEncode(-1), 1u);
+    EXPECT_EQ(wire::zigzagEncode(1), 2u);
+    EXPECT_EQ(wire::zigzagEncode(-2), 3u);
+    EXPECT_EQ(wire::zigzagEncode(1000), 2000u);
+}
+
+TEST(ZigZag, Round_Trips_Extremes)
+{
+    const std::int64_t values[] = {0, 1, -1, 123456789, -987654321, std::numeric_limits<std::int64_t>::max(),
+                                   std::numeric_limits<std::int64_t>::min()};
+    for (std::int64_t value : values)
+    {
+        EXPECT_EQ(wire::zigzagDecode(wire::zigzagEncode(value)), value);
+    }
+}
+
+TEST(Varint, Sizes_And_Round_Trip)
+{
+    const std::uint64_t values[] = {0, 127, 128, 16383, 16384, 0xFFFFFFFFull, std::numeric_limits<std::uint64_t>::max()};
+    const std::size_t sizes[] = {1, 1, 2, 2, 3, 5, 10};
+
+    for (std::size_t i = 0; i < 7; ++i)
+    {
+        std::uint8_t buffer[wire::MAX_VARINT_BYTES];
+        const std::size_t size = wire::putVarint(values[i], buffer);
+        EXPECT_EQ(size, sizes[i]);
+
+        std::uint64_t decoded = 0;
+        EXPECT_EQ(wire::getVarint(buffer, buffer + size, decoded), buffer + size);
+        EXPECT_EQ(decoded, values[i]);
+
+        // One byte short is reported, not read past
+        EXPECT_EQ(wire::getVarint(buffer, buffer + size - 1, decoded), nullptr);
+    }
+}
+
+TEST(Varint, Rejects_Overlong_Encoding)
+{
+    std::uint8_t buffer[11];
+    for (std::uint8_t &byte : buffer)
+    {
+        byte = 0x80;
+    }
+    std::uint64_t value = 0;
+    EXPECT_EQ(wire::getVarint(buffer, buffer + sizeof(buffer), value), nullptr);
+}
@@ -1,5 +1,7 @@
+#include <cstdint>
 #include <iostream>
 #include "gnss.h"
+#include "telemetry_frame.h"
 
 int main()
 {
@@ -9,12 +11,31 @@ int main()
               << ">>> latitude: " << gnss.latitude() << "\n"
               << ">>> longitude: " << gnss.longitude() << "\n";
 
+    // Binary frames for both fixes: a key record, then a delta record
+    wire::Fix history[1];
+    wire::Encoder encoder(wire::History{history, 1});
+    std::uint8_t frame[64];
+
+    encoder.begin(frame, sizeof(frame));
+    encoder.add(wire::Fix{0, 0, wire::toFixed(gnss.latitude()), wire::toFixed(gnss.longitude())});
+    const std::size_t keyBytes = encoder.finish();
+
     gnss.simulate();
 
+    encoder.begin(frame, sizeof(frame));
+    encoder.add(wire::Fix{0, 100, wire::toFixed(gnss.latitude()), wire::toFixed(gnss.longitude())});
+    const std::size_t deltaBytes = encoder.finish();
+
     std::cout
         << "\nAfter Simulate: " << "\n"
         << ">>> latitude: " << gnss.latitude() << "\n"
         << ">>> longitude: " << gnss.longitude() << "\n";
 
+    std::cout
+        << "\nWire frames: " << "\n"
+        << ">>> first fix: " << keyBytes << " bytes\n"
+        << ">>> next fix: " << deltaBytes << " bytes (" << deltaBytes - wire::HEADER_BYTES - wire::TRAILER_BYTES
+        << " byte record)\n";
+
     return 0;
-}
\ No newline at end of file
+}